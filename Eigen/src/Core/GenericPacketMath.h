@@ -56,6 +56,7 @@ struct default_packet_traits
     HasConj   = 1,
     HasSetLinear = 1,
     HasBlend  = 0,
+    HasShift  = 0,
 
     HasDiv    = 0,
     HasSqrt   = 0,
@@ -120,6 +121,27 @@ template<typename T> struct packet_traits : default_packet_traits
 
 template<typename T> struct packet_traits<const T> : packet_traits<T> { };
 
+/** \internal Wraps a native SIMD type \a T into a distinct C++ type.
+  * This is needed when two packet types share the same underlying register type
+  * (e.g., 32-bit and 64-bit integers both stored in a __m256i) but must still be
+  * distinguishable for template specialization and overloading.
+  * The \a unique_id parameter disambiguates different wrappers of the same type.
+  */
+template<typename T, int unique_id = 0>
+struct eigen_packet_wrapper
+{
+  EIGEN_ALWAYS_INLINE operator T&() { return m_val; }
+  EIGEN_ALWAYS_INLINE operator const T&() const { return m_val; }
+  EIGEN_ALWAYS_INLINE eigen_packet_wrapper() {}
+  EIGEN_ALWAYS_INLINE eigen_packet_wrapper(const T &v) : m_val(v) {}
+  EIGEN_ALWAYS_INLINE eigen_packet_wrapper& operator=(const T &v) {
+    m_val = v;
+    return *this;
+  }
+
+  T m_val;
+};
+
 template <typename Src, typename Tgt> struct type_casting_traits {
   enum {
     VectorizedCast = 0,
@@ -210,6 +232,24 @@ pxor(const Packet& a, const Packet& b) { return a ^ b; }
 template<typename Packet> EIGEN_DEVICE_FUNC inline Packet
 pandnot(const Packet& a, const Packet& b) { return a & (!b); }
 
+/** \internal \returns \a a arithmetically shifted by N bits to the right */
+template<int N> EIGEN_DEVICE_FUNC inline int
+parithmetic_shift_right(const int& a) { return a >> N; }
+template<int N> EIGEN_DEVICE_FUNC inline numext::int64_t
+parithmetic_shift_right(const numext::int64_t& a) { return a >> N; }
+
+/** \internal \returns \a a logically shifted by N bits to the right */
+template<int N> EIGEN_DEVICE_FUNC inline int
+plogical_shift_right(const int& a) { return static_cast<int>(static_cast<numext::uint32_t>(a) >> N); }
+template<int N> EIGEN_DEVICE_FUNC inline numext::int64_t
+plogical_shift_right(const numext::int64_t& a) { return static_cast<numext::int64_t>(static_cast<numext::uint64_t>(a) >> N); }
+
+/** \internal \returns \a a shifted by N bits to the left */
+template<int N> EIGEN_DEVICE_FUNC inline int
+plogical_shift_left(const int& a) { return static_cast<int>(static_cast<numext::uint32_t>(a) << N); }
+template<int N> EIGEN_DEVICE_FUNC inline numext::int64_t
+plogical_shift_left(const numext::int64_t& a) { return static_cast<numext::int64_t>(static_cast<numext::uint64_t>(a) << N); }
+
 /** \internal \returns a packet version of \a *from, from must be 16 bytes aligned */
 template<typename Packet> EIGEN_DEVICE_FUNC inline Packet
 pload(const typename unpacket_traits<Packet>::type* from) { return *from; }
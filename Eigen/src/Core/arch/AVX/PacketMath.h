@@ -31,6 +31,9 @@ namespace internal {
 typedef __m256  Packet8f;
 typedef __m256i Packet8i;
 typedef __m256d Packet4d;
+// 64-bit integers share the __m256i register type with Packet8i, so they need a
+// distinct wrapper type to be selectable by the packet functions.
+typedef eigen_packet_wrapper<__m256i, 1> Packet4l;
 
 template<> struct is_arithmetic<__m256>  { enum { value = true }; };
 template<> struct is_arithmetic<__m256i> { enum { value = true }; };
@@ -100,22 +103,43 @@ template<> struct packet_traits<double> : default_packet_traits
 template<> struct scalar_div_cost<float,true> { enum { value = 14 }; };
 template<> struct scalar_div_cost<double,true> { enum { value = 16 }; };
 
-/* Proper support for integers is only provided by AVX2. In the meantime, we'll
-   use SSE instructions and packets to deal with integers.
+#if defined(EIGEN_VECTORIZE_AVX2) && !defined(EIGEN_VECTORIZE_AVX512)
+// Proper support for integers is only provided by AVX2. Without it we keep using
+// SSE instructions and packets to deal with integers.
 template<> struct packet_traits<int>    : default_packet_traits
 {
   typedef Packet8i type;
+  typedef Packet4i half;
   enum {
     Vectorizable = 1,
     AlignedOnScalar = 1,
-    size=8
+    size=8,
+    HasHalfPacket = 1,
+
+    HasBlend = 1,
+    HasShift = 1
+  };
+};
+template<> struct packet_traits<numext::int64_t> : default_packet_traits
+{
+  typedef Packet4l type;
+  typedef Packet4l half;
+  enum {
+    Vectorizable = 1,
+    AlignedOnScalar = 1,
+    size=4,
+    HasHalfPacket = 0,
+
+    HasBlend = 1,
+    HasShift = 1
   };
 };
-*/
+#endif
 
 template<> struct unpacket_traits<Packet8f> { typedef float  type; typedef Packet4f half; enum {size=8, alignment=Aligned32}; };
 template<> struct unpacket_traits<Packet4d> { typedef double type; typedef Packet2d half; enum {size=4, alignment=Aligned32}; };
 template<> struct unpacket_traits<Packet8i> { typedef int    type; typedef Packet4i half; enum {size=8, alignment=Aligned32}; };
+template<> struct unpacket_traits<Packet4l> { typedef numext::int64_t type; typedef Packet4l half; enum {size=4, alignment=Aligned32}; };
 
 template<> EIGEN_STRONG_INLINE Packet8f pset1<Packet8f>(const float&  from) { return _mm256_set1_ps(from); }
 template<> EIGEN_STRONG_INLINE Packet4d pset1<Packet4d>(const double& from) { return _mm256_set1_pd(from); }
@@ -636,6 +660,315 @@ template<> EIGEN_STRONG_INLINE Packet4d pinsertlast(const Packet4d& a, double b)
   return _mm256_blend_pd(a,pset1<Packet4d>(b),(1<<3));
 }
 
+#ifdef EIGEN_VECTORIZE_AVX2
+
+// Integer arithmetic on 256-bit registers requires AVX2.
+
+template<> EIGEN_STRONG_INLINE Packet8i plset<Packet8i>(const int& a) { return _mm256_add_epi32(_mm256_set1_epi32(a), _mm256_set_epi32(7,6,5,4,3,2,1,0)); }
+
+template<> EIGEN_STRONG_INLINE Packet8i padd<Packet8i>(const Packet8i& a, const Packet8i& b) { return _mm256_add_epi32(a,b); }
+template<> EIGEN_STRONG_INLINE Packet8i psub<Packet8i>(const Packet8i& a, const Packet8i& b) { return _mm256_sub_epi32(a,b); }
+template<> EIGEN_STRONG_INLINE Packet8i pnegate(const Packet8i& a) { return _mm256_sub_epi32(_mm256_setzero_si256(), a); }
+template<> EIGEN_STRONG_INLINE Packet8i pmul<Packet8i>(const Packet8i& a, const Packet8i& b) { return _mm256_mullo_epi32(a,b); }
+
+template<> EIGEN_STRONG_INLINE Packet8i pmin<Packet8i>(const Packet8i& a, const Packet8i& b) { return _mm256_min_epi32(a,b); }
+template<> EIGEN_STRONG_INLINE Packet8i pmax<Packet8i>(const Packet8i& a, const Packet8i& b) { return _mm256_max_epi32(a,b); }
+template<> EIGEN_STRONG_INLINE Packet8i pabs(const Packet8i& a) { return _mm256_abs_epi32(a); }
+
+template<> EIGEN_STRONG_INLINE Packet8i pand<Packet8i>(const Packet8i& a, const Packet8i& b) { return _mm256_and_si256(a,b); }
+template<> EIGEN_STRONG_INLINE Packet8i por<Packet8i>(const Packet8i& a, const Packet8i& b) { return _mm256_or_si256(a,b); }
+template<> EIGEN_STRONG_INLINE Packet8i pxor<Packet8i>(const Packet8i& a, const Packet8i& b) { return _mm256_xor_si256(a,b); }
+template<> EIGEN_STRONG_INLINE Packet8i pandnot<Packet8i>(const Packet8i& a, const Packet8i& b) { return _mm256_andnot_si256(a,b); }
+
+template<int N> EIGEN_STRONG_INLINE Packet8i parithmetic_shift_right(const Packet8i& a) { return _mm256_srai_epi32(a,N); }
+template<int N> EIGEN_STRONG_INLINE Packet8i plogical_shift_right(const Packet8i& a) { return _mm256_srli_epi32(a,N); }
+template<int N> EIGEN_STRONG_INLINE Packet8i plogical_shift_left(const Packet8i& a) { return _mm256_slli_epi32(a,N); }
+
+// Loads 4 ints from memory a returns the packet {a0, a0  a1, a1, a2, a2, a3, a3}
+template<> EIGEN_STRONG_INLINE Packet8i ploaddup<Packet8i>(const int* from)
+{
+  Packet8i tmp = _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(from)));
+  return _mm256_permutevar8x32_epi32(tmp, _mm256_set_epi32(3,3,2,2,1,1,0,0));
+}
+// Loads 2 ints from memory a returns the packet {a0, a0  a0, a0, a1, a1, a1, a1}
+template<> EIGEN_STRONG_INLINE Packet8i ploadquad<Packet8i>(const int* from)
+{
+  return _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_set1_epi32(from[0])), _mm_set1_epi32(from[1]), 1);
+}
+
+template<> EIGEN_DEVICE_FUNC inline Packet8i pgather<int, Packet8i>(const int* from, Index stride)
+{
+  return _mm256_set_epi32(from[7*stride], from[6*stride], from[5*stride], from[4*stride],
+                          from[3*stride], from[2*stride], from[1*stride], from[0*stride]);
+}
+template<> EIGEN_DEVICE_FUNC inline void pscatter<int, Packet8i>(int* to, const Packet8i& from, Index stride)
+{
+  __m128i low = _mm256_castsi256_si128(from);
+  to[stride*0] = _mm_cvtsi128_si32(low);
+  to[stride*1] = _mm_extract_epi32(low, 1);
+  to[stride*2] = _mm_extract_epi32(low, 2);
+  to[stride*3] = _mm_extract_epi32(low, 3);
+
+  __m128i high = _mm256_extracti128_si256(from, 1);
+  to[stride*4] = _mm_cvtsi128_si32(high);
+  to[stride*5] = _mm_extract_epi32(high, 1);
+  to[stride*6] = _mm_extract_epi32(high, 2);
+  to[stride*7] = _mm_extract_epi32(high, 3);
+}
+
+template<> EIGEN_STRONG_INLINE Packet8i preverse(const Packet8i& a)
+{
+  return _mm256_permutevar8x32_epi32(a, _mm256_set_epi32(0,1,2,3,4,5,6,7));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8i preduxp<Packet8i>(const Packet8i* vecs)
+{
+  __m256i hsum1 = _mm256_hadd_epi32(vecs[0], vecs[1]);
+  __m256i hsum2 = _mm256_hadd_epi32(vecs[2], vecs[3]);
+  __m256i hsum3 = _mm256_hadd_epi32(vecs[4], vecs[5]);
+  __m256i hsum4 = _mm256_hadd_epi32(vecs[6], vecs[7]);
+
+  __m256i hsum5 = _mm256_hadd_epi32(hsum1, hsum1);
+  __m256i hsum6 = _mm256_hadd_epi32(hsum2, hsum2);
+  __m256i hsum7 = _mm256_hadd_epi32(hsum3, hsum3);
+  __m256i hsum8 = _mm256_hadd_epi32(hsum4, hsum4);
+
+  __m256i perm1 = _mm256_permute2x128_si256(hsum5, hsum5, 0x23);
+  __m256i perm2 = _mm256_permute2x128_si256(hsum6, hsum6, 0x23);
+  __m256i perm3 = _mm256_permute2x128_si256(hsum7, hsum7, 0x23);
+  __m256i perm4 = _mm256_permute2x128_si256(hsum8, hsum8, 0x23);
+
+  __m256i sum1 = _mm256_add_epi32(perm1, hsum5);
+  __m256i sum2 = _mm256_add_epi32(perm2, hsum6);
+  __m256i sum3 = _mm256_add_epi32(perm3, hsum7);
+  __m256i sum4 = _mm256_add_epi32(perm4, hsum8);
+
+  __m256i blend1 = _mm256_blend_epi32(sum1, sum2, 0xcc);
+  __m256i blend2 = _mm256_blend_epi32(sum3, sum4, 0xcc);
+
+  return _mm256_blend_epi32(blend1, blend2, 0xf0);
+}
+
+template<> EIGEN_STRONG_INLINE Packet4i predux_downto4<Packet8i>(const Packet8i& a)
+{
+  return _mm_add_epi32(_mm256_castsi256_si128(a), _mm256_extracti128_si256(a,1));
+}
+template<> EIGEN_STRONG_INLINE int predux<Packet8i>(const Packet8i& a)
+{
+  return predux(predux_downto4<Packet8i>(a));
+}
+template<> EIGEN_STRONG_INLINE int predux_mul<Packet8i>(const Packet8i& a)
+{
+  return predux_mul(Packet4i(_mm_mullo_epi32(_mm256_castsi256_si128(a), _mm256_extracti128_si256(a,1))));
+}
+template<> EIGEN_STRONG_INLINE int predux_min<Packet8i>(const Packet8i& a)
+{
+  return predux_min(Packet4i(_mm_min_epi32(_mm256_castsi256_si128(a), _mm256_extracti128_si256(a,1))));
+}
+template<> EIGEN_STRONG_INLINE int predux_max<Packet8i>(const Packet8i& a)
+{
+  return predux_max(Packet4i(_mm_max_epi32(_mm256_castsi256_si128(a), _mm256_extracti128_si256(a,1))));
+}
+
+template<int Offset>
+struct palign_impl<Offset,Packet8i>
+{
+  static EIGEN_STRONG_INLINE void run(Packet8i& first, const Packet8i& second)
+  {
+    if (Offset!=0)
+    {
+      // Rotate both packets by Offset and take the last Offset elements from the second one.
+      const __m256i idx = _mm256_set_epi32(Offset+7, Offset+6, Offset+5, Offset+4,
+                                           Offset+3, Offset+2, Offset+1, Offset);
+      first = _mm256_blend_epi32(_mm256_permutevar8x32_epi32(first, idx),
+                                 _mm256_permutevar8x32_epi32(second, idx), (0xFF << (8-Offset)) & 0xFF);
+    }
+  }
+};
+
+EIGEN_DEVICE_FUNC inline void
+ptranspose(PacketBlock<Packet8i,8>& kernel) {
+  PacketBlock<Packet8f,8> tmp;
+  for (int i=0; i<8; ++i) tmp.packet[i] = _mm256_castsi256_ps(kernel.packet[i]);
+  ptranspose(tmp);
+  for (int i=0; i<8; ++i) kernel.packet[i] = _mm256_castps_si256(tmp.packet[i]);
+}
+
+EIGEN_DEVICE_FUNC inline void
+ptranspose(PacketBlock<Packet8i,4>& kernel) {
+  PacketBlock<Packet8f,4> tmp;
+  for (int i=0; i<4; ++i) tmp.packet[i] = _mm256_castsi256_ps(kernel.packet[i]);
+  ptranspose(tmp);
+  for (int i=0; i<4; ++i) kernel.packet[i] = _mm256_castps_si256(tmp.packet[i]);
+}
+
+template<> EIGEN_STRONG_INLINE Packet8i pblend(const Selector<8>& ifPacket, const Packet8i& thenPacket, const Packet8i& elsePacket) {
+  const __m256i select = _mm256_set_epi32(ifPacket.select[7], ifPacket.select[6], ifPacket.select[5], ifPacket.select[4], ifPacket.select[3], ifPacket.select[2], ifPacket.select[1], ifPacket.select[0]);
+  __m256i false_mask = _mm256_cmpeq_epi32(select, _mm256_setzero_si256());
+  return _mm256_blendv_epi8(thenPacket, elsePacket, false_mask);
+}
+
+template<> EIGEN_STRONG_INLINE Packet8i pinsertfirst(const Packet8i& a, int b)
+{
+  return _mm256_blend_epi32(a,pset1<Packet8i>(b),1);
+}
+
+template<> EIGEN_STRONG_INLINE Packet8i pinsertlast(const Packet8i& a, int b)
+{
+  return _mm256_blend_epi32(a,pset1<Packet8i>(b),(1<<7));
+}
+
+// 64-bit integers
+
+template<> EIGEN_STRONG_INLINE Packet4l pset1<Packet4l>(const numext::int64_t& from) { return _mm256_set1_epi64x(from); }
+template<> EIGEN_STRONG_INLINE Packet4l plset<Packet4l>(const numext::int64_t& a) { return _mm256_add_epi64(_mm256_set1_epi64x(a), _mm256_set_epi64x(3,2,1,0)); }
+
+template<> EIGEN_STRONG_INLINE Packet4l pload<Packet4l>(const numext::int64_t* from) { EIGEN_DEBUG_ALIGNED_LOAD return _mm256_load_si256(reinterpret_cast<const __m256i*>(from)); }
+template<> EIGEN_STRONG_INLINE Packet4l ploadu<Packet4l>(const numext::int64_t* from) { EIGEN_DEBUG_UNALIGNED_LOAD return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(from)); }
+// Loads 2 int64 from memory a returns the packet {a0, a0  a1, a1}
+template<> EIGEN_STRONG_INLINE Packet4l ploaddup<Packet4l>(const numext::int64_t* from)
+{
+  return _mm256_permute4x64_epi64(_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(from))), _MM_SHUFFLE(1,1,0,0));
+}
+template<> EIGEN_STRONG_INLINE void pstore<numext::int64_t>(numext::int64_t* to, const Packet4l& from) { EIGEN_DEBUG_ALIGNED_STORE _mm256_store_si256(reinterpret_cast<__m256i*>(to), from); }
+template<> EIGEN_STRONG_INLINE void pstoreu<numext::int64_t>(numext::int64_t* to, const Packet4l& from) { EIGEN_DEBUG_UNALIGNED_STORE _mm256_storeu_si256(reinterpret_cast<__m256i*>(to), from); }
+
+template<> EIGEN_DEVICE_FUNC inline Packet4l pgather<numext::int64_t, Packet4l>(const numext::int64_t* from, Index stride)
+{
+  return _mm256_set_epi64x(from[3*stride], from[2*stride], from[1*stride], from[0*stride]);
+}
+template<> EIGEN_DEVICE_FUNC inline void pscatter<numext::int64_t, Packet4l>(numext::int64_t* to, const Packet4l& from, Index stride)
+{
+  __m128i low = _mm256_castsi256_si128(from);
+  to[stride*0] = _mm_cvtsi128_si64(low);
+  to[stride*1] = _mm_extract_epi64(low, 1);
+  __m128i high = _mm256_extracti128_si256(from, 1);
+  to[stride*2] = _mm_cvtsi128_si64(high);
+  to[stride*3] = _mm_extract_epi64(high, 1);
+}
+
+template<> EIGEN_STRONG_INLINE numext::int64_t pfirst<Packet4l>(const Packet4l& a) {
+  return _mm_cvtsi128_si64(_mm256_castsi256_si128(a));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4l padd<Packet4l>(const Packet4l& a, const Packet4l& b) { return _mm256_add_epi64(a,b); }
+template<> EIGEN_STRONG_INLINE Packet4l psub<Packet4l>(const Packet4l& a, const Packet4l& b) { return _mm256_sub_epi64(a,b); }
+template<> EIGEN_STRONG_INLINE Packet4l pnegate(const Packet4l& a) { return _mm256_sub_epi64(_mm256_setzero_si256(), a); }
+template<> EIGEN_STRONG_INLINE Packet4l pconj(const Packet4l& a) { return a; }
+template<> EIGEN_STRONG_INLINE Packet4l pmul<Packet4l>(const Packet4l& a, const Packet4l& b)
+{
+  // There is no 64-bit multiplication in AVX2, so build the low 64 bits of the
+  // product from 32x32->64 bits products: lo(a)*lo(b) + ((hi(a)*lo(b) + lo(a)*hi(b)) << 32)
+  __m256i lo = _mm256_mul_epu32(a, b);
+  __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+                                   _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+  return _mm256_add_epi64(lo, _mm256_slli_epi64(cross, 32));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4l pmin<Packet4l>(const Packet4l& a, const Packet4l& b) { return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b)); }
+template<> EIGEN_STRONG_INLINE Packet4l pmax<Packet4l>(const Packet4l& a, const Packet4l& b) { return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(b, a)); }
+template<> EIGEN_STRONG_INLINE Packet4l pabs(const Packet4l& a)
+{
+  __m256i sign = _mm256_cmpgt_epi64(_mm256_setzero_si256(), a);
+  return _mm256_sub_epi64(_mm256_xor_si256(a, sign), sign);
+}
+
+template<> EIGEN_STRONG_INLINE Packet4l pand<Packet4l>(const Packet4l& a, const Packet4l& b) { return _mm256_and_si256(a,b); }
+template<> EIGEN_STRONG_INLINE Packet4l por<Packet4l>(const Packet4l& a, const Packet4l& b) { return _mm256_or_si256(a,b); }
+template<> EIGEN_STRONG_INLINE Packet4l pxor<Packet4l>(const Packet4l& a, const Packet4l& b) { return _mm256_xor_si256(a,b); }
+template<> EIGEN_STRONG_INLINE Packet4l pandnot<Packet4l>(const Packet4l& a, const Packet4l& b) { return _mm256_andnot_si256(a,b); }
+
+template<int N> EIGEN_STRONG_INLINE Packet4l parithmetic_shift_right(const Packet4l& a)
+{
+  // There is no 64-bit arithmetic shift in AVX2: shift the sign bits back in by hand.
+  __m256i sign = _mm256_cmpgt_epi64(_mm256_setzero_si256(), a);
+  return _mm256_or_si256(_mm256_srli_epi64(a, N), _mm256_slli_epi64(sign, 64-N));
+}
+template<int N> EIGEN_STRONG_INLINE Packet4l plogical_shift_right(const Packet4l& a) { return _mm256_srli_epi64(a,N); }
+template<int N> EIGEN_STRONG_INLINE Packet4l plogical_shift_left(const Packet4l& a) { return _mm256_slli_epi64(a,N); }
+
+template<> EIGEN_STRONG_INLINE Packet4l preverse(const Packet4l& a)
+{
+  return _mm256_permute4x64_epi64(a, _MM_SHUFFLE(0,1,2,3));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4l preduxp<Packet4l>(const Packet4l* vecs)
+{
+  __m256i tmp0 = _mm256_add_epi64(_mm256_unpacklo_epi64(vecs[0], vecs[1]), _mm256_unpackhi_epi64(vecs[0], vecs[1]));
+  __m256i tmp1 = _mm256_add_epi64(_mm256_unpacklo_epi64(vecs[2], vecs[3]), _mm256_unpackhi_epi64(vecs[2], vecs[3]));
+  return _mm256_add_epi64(_mm256_permute2x128_si256(tmp0, tmp1, 0x20), _mm256_permute2x128_si256(tmp0, tmp1, 0x31));
+}
+
+template<> EIGEN_STRONG_INLINE numext::int64_t predux<Packet4l>(const Packet4l& a)
+{
+  __m128i tmp = _mm_add_epi64(_mm256_castsi256_si128(a), _mm256_extracti128_si256(a,1));
+  return _mm_cvtsi128_si64(tmp) + _mm_extract_epi64(tmp, 1);
+}
+template<> EIGEN_STRONG_INLINE numext::int64_t predux_mul<Packet4l>(const Packet4l& a)
+{
+  Packet4l tmp = pmul<Packet4l>(a, _mm256_permute4x64_epi64(a, _MM_SHUFFLE(1,0,3,2)));
+  return pfirst(pmul<Packet4l>(tmp, _mm256_shuffle_epi32(tmp, _MM_SHUFFLE(1,0,3,2))));
+}
+template<> EIGEN_STRONG_INLINE numext::int64_t predux_min<Packet4l>(const Packet4l& a)
+{
+  Packet4l tmp = pmin<Packet4l>(a, _mm256_permute4x64_epi64(a, _MM_SHUFFLE(1,0,3,2)));
+  return pfirst(pmin<Packet4l>(tmp, _mm256_shuffle_epi32(tmp, _MM_SHUFFLE(1,0,3,2))));
+}
+template<> EIGEN_STRONG_INLINE numext::int64_t predux_max<Packet4l>(const Packet4l& a)
+{
+  Packet4l tmp = pmax<Packet4l>(a, _mm256_permute4x64_epi64(a, _MM_SHUFFLE(1,0,3,2)));
+  return pfirst(pmax<Packet4l>(tmp, _mm256_shuffle_epi32(tmp, _MM_SHUFFLE(1,0,3,2))));
+}
+
+template<int Offset>
+struct palign_impl<Offset,Packet4l>
+{
+  static EIGEN_STRONG_INLINE void run(Packet4l& first, const Packet4l& second)
+  {
+    if (Offset==1)
+    {
+      first = _mm256_blend_epi32(first, second, 0x03);
+      first = _mm256_permute4x64_epi64(first, _MM_SHUFFLE(0,3,2,1));
+    }
+    else if (Offset==2)
+    {
+      first = _mm256_blend_epi32(first, second, 0x0F);
+      first = _mm256_permute4x64_epi64(first, _MM_SHUFFLE(1,0,3,2));
+    }
+    else if (Offset==3)
+    {
+      first = _mm256_blend_epi32(first, second, 0x3F);
+      first = _mm256_permute4x64_epi64(first, _MM_SHUFFLE(2,1,0,3));
+    }
+  }
+};
+
+EIGEN_DEVICE_FUNC inline void
+ptranspose(PacketBlock<Packet4l,4>& kernel) {
+  PacketBlock<Packet4d,4> tmp;
+  for (int i=0; i<4; ++i) tmp.packet[i] = _mm256_castsi256_pd(kernel.packet[i]);
+  ptranspose(tmp);
+  for (int i=0; i<4; ++i) kernel.packet[i] = _mm256_castpd_si256(tmp.packet[i]);
+}
+
+template<> EIGEN_STRONG_INLINE Packet4l pblend(const Selector<4>& ifPacket, const Packet4l& thenPacket, const Packet4l& elsePacket) {
+  const __m256i select = _mm256_set_epi64x(ifPacket.select[3], ifPacket.select[2], ifPacket.select[1], ifPacket.select[0]);
+  __m256i false_mask = _mm256_cmpeq_epi64(select, _mm256_setzero_si256());
+  return _mm256_blendv_epi8(thenPacket, elsePacket, false_mask);
+}
+
+template<> EIGEN_STRONG_INLINE Packet4l pinsertfirst(const Packet4l& a, numext::int64_t b)
+{
+  return _mm256_blend_epi32(a,pset1<Packet4l>(b),0x03);
+}
+
+template<> EIGEN_STRONG_INLINE Packet4l pinsertlast(const Packet4l& a, numext::int64_t b)
+{
+  return _mm256_blend_epi32(a,pset1<Packet4l>(b),0xC0);
+}
+
+#endif // EIGEN_VECTORIZE_AVX2
+
 } // end namespace internal
 
 } // end namespace Eigen
@@ -14,12 +14,18 @@ namespace Eigen {
 
 namespace internal {
 
-// For now we use SSE to handle integers, so we can't use AVX instructions to cast
-// from int to float
+// Without AVX2 integers are handled by SSE packets, so we can't use AVX
+// instructions to cast from int to float
+#ifdef EIGEN_VECTORIZE_AVX2
+#define EIGEN_AVX_INT_VECTORIZED_CAST 1
+#else
+#define EIGEN_AVX_INT_VECTORIZED_CAST 0
+#endif
+
 template <>
 struct type_casting_traits<float, int> {
   enum {
-    VectorizedCast = 0,
+    VectorizedCast = EIGEN_AVX_INT_VECTORIZED_CAST,
     SrcCoeffRatio = 1,
     TgtCoeffRatio = 1
   };
@@ -28,16 +34,17 @@ struct type_casting_traits<float, int> {
 template <>
 struct type_casting_traits<int, float> {
   enum {
-    VectorizedCast = 0,
+    VectorizedCast = EIGEN_AVX_INT_VECTORIZED_CAST,
     SrcCoeffRatio = 1,
     TgtCoeffRatio = 1
   };
 };
 
-
+#undef EIGEN_AVX_INT_VECTORIZED_CAST
 
 template<> EIGEN_STRONG_INLINE Packet8i pcast<Packet8f, Packet8i>(const Packet8f& a) {
-  return _mm256_cvtps_epi32(a);
+  // Truncate towards zero like the scalar conversion does.
+  return _mm256_cvttps_epi32(a);
 }
 
 template<> EIGEN_STRONG_INLINE Packet8f pcast<Packet8i, Packet8f>(const Packet8i& a) {
@@ -31,6 +31,7 @@ namespace internal {
 typedef __m512 Packet16f;
 typedef __m512i Packet16i;
 typedef __m512d Packet8d;
+typedef eigen_packet_wrapper<__m512i, 1> Packet8l;
 
 template <>
 struct is_arithmetic<__m512> {
@@ -82,17 +83,32 @@ template<> struct packet_traits<double> : default_packet_traits
   };
 };
 
-/* TODO Implement AVX512 for integers
 template<> struct packet_traits<int>    : default_packet_traits
 {
   typedef Packet16i type;
+  typedef Packet8i half;
+  enum {
+    Vectorizable = 1,
+    AlignedOnScalar = 1,
+    size = 16,
+    HasHalfPacket = 1,
+    HasBlend = 1,
+    HasShift = 1
+  };
+};
+template<> struct packet_traits<numext::int64_t> : default_packet_traits
+{
+  typedef Packet8l type;
+  typedef Packet4l half;
   enum {
     Vectorizable = 1,
     AlignedOnScalar = 1,
-    size=8
+    size = 8,
+    HasHalfPacket = 1,
+    HasBlend = 1,
+    HasShift = 1
   };
 };
-*/
 
 template <>
 struct unpacket_traits<Packet16f> {
@@ -112,6 +128,12 @@ struct unpacket_traits<Packet16i> {
   typedef Packet8i half;
   enum { size = 16, alignment=Aligned64 };
 };
+template <>
+struct unpacket_traits<Packet8l> {
+  typedef numext::int64_t type;
+  typedef Packet4l half;
+  enum { size = 8, alignment=Aligned64 };
+};
 
 template <>
 EIGEN_STRONG_INLINE Packet16f pset1<Packet16f>(const float& from) {
@@ -465,7 +487,7 @@ EIGEN_STRONG_INLINE Packet16i ploadu<Packet16i>(const int* from) {
 // {a0, a0  a1, a1, a2, a2, a3, a3, a4, a4, a5, a5, a6, a6, a7, a7}
 template <>
 EIGEN_STRONG_INLINE Packet16f ploaddup<Packet16f>(const float* from) {
-  __m256i low_half = _mm256_load_si256(reinterpret_cast<const __m256i*>(from));
+  __m256i low_half = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(from));
   __m512 even_elements = _mm512_castsi512_ps(_mm512_cvtepu32_epi64(low_half));
   __m512 pairs = _mm512_permute_ps(even_elements, _MM_SHUFFLE(2, 2, 0, 0));
   return pairs;
@@ -474,12 +496,8 @@ EIGEN_STRONG_INLINE Packet16f ploaddup<Packet16f>(const float* from) {
 // a3}
 template <>
 EIGEN_STRONG_INLINE Packet8d ploaddup<Packet8d>(const double* from) {
- __m512d x = _mm512_setzero_pd();
-  x = _mm512_insertf64x2(x, _mm_loaddup_pd(&from[0]), 0);
-  x = _mm512_insertf64x2(x, _mm_loaddup_pd(&from[1]), 1);
-  x = _mm512_insertf64x2(x, _mm_loaddup_pd(&from[2]), 2);
-  x = _mm512_insertf64x2(x, _mm_loaddup_pd(&from[3]), 3);
-  return x;
+  __m512d x = _mm512_castpd256_pd512(_mm256_loadu_pd(from));
+  return _mm512_permutexvar_pd(_mm512_set_epi64(3, 3, 2, 2, 1, 1, 0, 0), x);
 }
 
 // Loads 4 floats from memory a returns the packet
@@ -1265,18 +1283,481 @@ EIGEN_DEVICE_FUNC inline void ptranspose(PacketBlock<Packet8d, 8>& kernel) {
   PACK_OUTPUT_SQ_D(kernel.packet, tmp.packet, 7, 8);
 }
 template <>
-EIGEN_STRONG_INLINE Packet16f pblend(const Selector<16>& /*ifPacket*/,
-                                     const Packet16f& /*thenPacket*/,
-                                     const Packet16f& /*elsePacket*/) {
-  assert(false && "To be implemented");
-  return Packet16f();
+EIGEN_STRONG_INLINE Packet16f pblend(const Selector<16>& ifPacket,
+                                     const Packet16f& thenPacket,
+                                     const Packet16f& elsePacket) {
+  __mmask16 mask = 0;
+  for (int i = 0; i < 16; ++i) {
+    if (ifPacket.select[i]) mask |= (1 << i);
+  }
+  return _mm512_mask_blend_ps(mask, elsePacket, thenPacket);
+}
+template <>
+EIGEN_STRONG_INLINE Packet8d pblend(const Selector<8>& ifPacket,
+                                    const Packet8d& thenPacket,
+                                    const Packet8d& elsePacket) {
+  __mmask8 mask = 0;
+  for (int i = 0; i < 8; ++i) {
+    if (ifPacket.select[i]) mask |= (1 << i);
+  }
+  return _mm512_mask_blend_pd(mask, elsePacket, thenPacket);
+}
+
+// Integer packets
+
+template <>
+EIGEN_STRONG_INLINE Packet16i plset<Packet16i>(const int& a) {
+  return _mm512_add_epi32(
+      _mm512_set1_epi32(a),
+      _mm512_set_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+}
+
+template <>
+EIGEN_STRONG_INLINE Packet16i padd<Packet16i>(const Packet16i& a,
+                                              const Packet16i& b) {
+  return _mm512_add_epi32(a, b);
+}
+template <>
+EIGEN_STRONG_INLINE Packet16i psub<Packet16i>(const Packet16i& a,
+                                              const Packet16i& b) {
+  return _mm512_sub_epi32(a, b);
+}
+template <>
+EIGEN_STRONG_INLINE Packet16i pnegate(const Packet16i& a) {
+  return _mm512_sub_epi32(_mm512_setzero_si512(), a);
+}
+template <>
+EIGEN_STRONG_INLINE Packet16i pmul<Packet16i>(const Packet16i& a,
+                                              const Packet16i& b) {
+  return _mm512_mullo_epi32(a, b);
+}
+
+template <>
+EIGEN_STRONG_INLINE Packet16i pmin<Packet16i>(const Packet16i& a,
+                                              const Packet16i& b) {
+  return _mm512_min_epi32(a, b);
+}
+template <>
+EIGEN_STRONG_INLINE Packet16i pmax<Packet16i>(const Packet16i& a,
+                                              const Packet16i& b) {
+  return _mm512_max_epi32(a, b);
+}
+template <>
+EIGEN_STRONG_INLINE Packet16i pabs(const Packet16i& a) {
+  return _mm512_abs_epi32(a);
+}
+
+template <>
+EIGEN_STRONG_INLINE Packet16i pand<Packet16i>(const Packet16i& a,
+                                              const Packet16i& b) {
+  return _mm512_and_si512(a, b);
+}
+template <>
+EIGEN_STRONG_INLINE Packet16i por<Packet16i>(const Packet16i& a,
+                                             const Packet16i& b) {
+  return _mm512_or_si512(a, b);
+}
+template <>
+EIGEN_STRONG_INLINE Packet16i pxor<Packet16i>(const Packet16i& a,
+                                              const Packet16i& b) {
+  return _mm512_xor_si512(a, b);
+}
+template <>
+EIGEN_STRONG_INLINE Packet16i pandnot<Packet16i>(const Packet16i& a,
+                                                 const Packet16i& b) {
+  return _mm512_andnot_si512(a, b);
+}
+
+template <int N>
+EIGEN_STRONG_INLINE Packet16i parithmetic_shift_right(const Packet16i& a) {
+  return _mm512_srai_epi32(a, N);
+}
+template <int N>
+EIGEN_STRONG_INLINE Packet16i plogical_shift_right(const Packet16i& a) {
+  return _mm512_srli_epi32(a, N);
+}
+template <int N>
+EIGEN_STRONG_INLINE Packet16i plogical_shift_left(const Packet16i& a) {
+  return _mm512_slli_epi32(a, N);
+}
+
+// Loads 8 ints from memory and returns the packet
+// {a0, a0, a1, a1, a2, a2, a3, a3, a4, a4, a5, a5, a6, a6, a7, a7}
+template <>
+EIGEN_STRONG_INLINE Packet16i ploaddup<Packet16i>(const int* from) {
+  __m512i tmp = _mm512_castsi256_si512(
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(from)));
+  return _mm512_permutexvar_epi32(
+      _mm512_set_epi32(7, 7, 6, 6, 5, 5, 4, 4, 3, 3, 2, 2, 1, 1, 0, 0), tmp);
+}
+// Loads 4 ints from memory and returns the packet
+// {a0, a0, a0, a0, a1, a1, a1, a1, a2, a2, a2, a2, a3, a3, a3, a3}
+template <>
+EIGEN_STRONG_INLINE Packet16i ploadquad<Packet16i>(const int* from) {
+  __m512i tmp = _mm512_castsi128_si512(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(from)));
+  return _mm512_permutexvar_epi32(
+      _mm512_set_epi32(3, 3, 3, 3, 2, 2, 2, 2, 1, 1, 1, 1, 0, 0, 0, 0), tmp);
+}
+
+template <>
+EIGEN_DEVICE_FUNC inline Packet16i pgather<int, Packet16i>(const int* from,
+                                                           Index stride) {
+  Packet16i stride_vector = _mm512_set1_epi32(stride);
+  Packet16i stride_multiplier =
+      _mm512_set_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+  Packet16i indices = _mm512_mullo_epi32(stride_vector, stride_multiplier);
+
+  return _mm512_i32gather_epi32(indices, from, 4);
+}
+template <>
+EIGEN_DEVICE_FUNC inline void pscatter<int, Packet16i>(int* to,
+                                                       const Packet16i& from,
+                                                       Index stride) {
+  Packet16i stride_vector = _mm512_set1_epi32(stride);
+  Packet16i stride_multiplier =
+      _mm512_set_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+  Packet16i indices = _mm512_mullo_epi32(stride_vector, stride_multiplier);
+  _mm512_i32scatter_epi32(to, indices, from, 4);
+}
+
+template <>
+EIGEN_STRONG_INLINE Packet16i preverse(const Packet16i& a) {
+  return _mm512_permutexvar_epi32(
+      _mm512_set_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), a);
+}
+
+template <>
+EIGEN_STRONG_INLINE Packet8i predux_downto4<Packet16i>(const Packet16i& a) {
+  return _mm256_add_epi32(_mm512_castsi512_si256(a),
+                          _mm512_extracti64x4_epi64(a, 1));
+}
+template <>
+EIGEN_STRONG_INLINE int predux<Packet16i>(const Packet16i& a) {
+  return predux<Packet8i>(predux_downto4<Packet16i>(a));
+}
+template <>
+EIGEN_STRONG_INLINE int predux_mul<Packet16i>(const Packet16i& a) {
+  return predux_mul<Packet8i>(_mm256_mullo_epi32(
+      _mm512_castsi512_si256(a), _mm512_extracti64x4_epi64(a, 1)));
+}
+template <>
+EIGEN_STRONG_INLINE int predux_min<Packet16i>(const Packet16i& a) {
+  return predux_min<Packet8i>(_mm256_min_epi32(
+      _mm512_castsi512_si256(a), _mm512_extracti64x4_epi64(a, 1)));
+}
+template <>
+EIGEN_STRONG_INLINE int predux_max<Packet16i>(const Packet16i& a) {
+  return predux_max<Packet8i>(_mm256_max_epi32(
+      _mm512_castsi512_si256(a), _mm512_extracti64x4_epi64(a, 1)));
+}
+
+template <int Offset>
+struct palign_impl<Offset, Packet16i> {
+  static EIGEN_STRONG_INLINE void run(Packet16i& first,
+                                      const Packet16i& second) {
+    if (Offset != 0) {
+      // The permutation only looks at the 4 lowest bits of each index, so the
+      // same rotation can be applied to both packets.
+      __m512i idx = _mm512_set_epi32(
+          Offset + 15, Offset + 14, Offset + 13, Offset + 12, Offset + 11,
+          Offset + 10, Offset + 9, Offset + 8, Offset + 7, Offset + 6,
+          Offset + 5, Offset + 4, Offset + 3, Offset + 2, Offset + 1, Offset);
+
+      unsigned short mask = 0xFFFF;
+      mask <<= (16 - Offset);
+
+      first = _mm512_mask_blend_epi32(mask, _mm512_permutexvar_epi32(idx, first),
+                                      _mm512_permutexvar_epi32(idx, second));
+    }
+  }
+};
+
+EIGEN_DEVICE_FUNC inline void ptranspose(PacketBlock<Packet16i, 16>& kernel) {
+  PacketBlock<Packet16f, 16> tmp;
+  for (int i = 0; i < 16; ++i) tmp.packet[i] = _mm512_castsi512_ps(kernel.packet[i]);
+  ptranspose(tmp);
+  for (int i = 0; i < 16; ++i) kernel.packet[i] = _mm512_castps_si512(tmp.packet[i]);
+}
+EIGEN_DEVICE_FUNC inline void ptranspose(PacketBlock<Packet16i, 4>& kernel) {
+  PacketBlock<Packet16f, 4> tmp;
+  for (int i = 0; i < 4; ++i) tmp.packet[i] = _mm512_castsi512_ps(kernel.packet[i]);
+  ptranspose(tmp);
+  for (int i = 0; i < 4; ++i) kernel.packet[i] = _mm512_castps_si512(tmp.packet[i]);
+}
+
+template <>
+EIGEN_STRONG_INLINE Packet16i preduxp<Packet16i>(const Packet16i* vecs) {
+  PacketBlock<Packet16i, 16> kernel;
+  for (int i = 0; i < 16; ++i) kernel.packet[i] = vecs[i];
+  ptranspose(kernel);
+  Packet16i res = kernel.packet[0];
+  for (int i = 1; i < 16; ++i) res = padd<Packet16i>(res, kernel.packet[i]);
+  return res;
+}
+
+template <>
+EIGEN_STRONG_INLINE Packet16i pblend(const Selector<16>& ifPacket,
+                                     const Packet16i& thenPacket,
+                                     const Packet16i& elsePacket) {
+  __mmask16 mask = 0;
+  for (int i = 0; i < 16; ++i) {
+    if (ifPacket.select[i]) mask |= (1 << i);
+  }
+  return _mm512_mask_blend_epi32(mask, elsePacket, thenPacket);
+}
+
+template <>
+EIGEN_STRONG_INLINE Packet16i pinsertfirst(const Packet16i& a, int b) {
+  return _mm512_mask_blend_epi32(1, a, pset1<Packet16i>(b));
+}
+template <>
+EIGEN_STRONG_INLINE Packet16i pinsertlast(const Packet16i& a, int b) {
+  return _mm512_mask_blend_epi32(1 << 15, a, pset1<Packet16i>(b));
+}
+
+// 64-bit integers
+
+template <>
+EIGEN_STRONG_INLINE Packet8l pset1<Packet8l>(const numext::int64_t& from) {
+  return _mm512_set1_epi64(from);
+}
+template <>
+EIGEN_STRONG_INLINE Packet8l plset<Packet8l>(const numext::int64_t& a) {
+  return _mm512_add_epi64(_mm512_set1_epi64(a),
+                          _mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0));
+}
+
+template <>
+EIGEN_STRONG_INLINE Packet8l pload<Packet8l>(const numext::int64_t* from) {
+  EIGEN_DEBUG_ALIGNED_LOAD return _mm512_load_si512(
+      reinterpret_cast<const void*>(from));
+}
+template <>
+EIGEN_STRONG_INLINE Packet8l ploadu<Packet8l>(const numext::int64_t* from) {
+  EIGEN_DEBUG_UNALIGNED_LOAD return _mm512_loadu_si512(
+      reinterpret_cast<const void*>(from));
+}
+// Loads 4 int64 from memory and returns the packet {a0, a0, a1, a1, a2, a2, a3, a3}
+template <>
+EIGEN_STRONG_INLINE Packet8l ploaddup<Packet8l>(const numext::int64_t* from) {
+  __m512i tmp = _mm512_castsi256_si512(
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(from)));
+  return _mm512_permutexvar_epi64(_mm512_set_epi64(3, 3, 2, 2, 1, 1, 0, 0), tmp);
+}
+// Loads 2 int64 from memory and returns the packet {a0, a0, a0, a0, a1, a1, a1, a1}
+template <>
+EIGEN_STRONG_INLINE Packet8l ploadquad<Packet8l>(const numext::int64_t* from) {
+  __m512i tmp = _mm512_castsi128_si512(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(from)));
+  return _mm512_permutexvar_epi64(_mm512_set_epi64(1, 1, 1, 1, 0, 0, 0, 0), tmp);
+}
+
+template <>
+EIGEN_STRONG_INLINE void pstore<numext::int64_t>(numext::int64_t* to,
+                                                 const Packet8l& from) {
+  EIGEN_DEBUG_ALIGNED_STORE _mm512_store_si512(reinterpret_cast<void*>(to),
+                                               from);
+}
+template <>
+EIGEN_STRONG_INLINE void pstoreu<numext::int64_t>(numext::int64_t* to,
+                                                  const Packet8l& from) {
+  EIGEN_DEBUG_UNALIGNED_STORE _mm512_storeu_si512(reinterpret_cast<void*>(to),
+                                                  from);
+}
+
+template <>
+EIGEN_DEVICE_FUNC inline Packet8l pgather<numext::int64_t, Packet8l>(
+    const numext::int64_t* from, Index stride) {
+  Packet8i stride_vector = _mm256_set1_epi32(stride);
+  Packet8i stride_multiplier = _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+  Packet8i indices = _mm256_mullo_epi32(stride_vector, stride_multiplier);
+
+  return _mm512_i32gather_epi64(indices, from, 8);
+}
+template <>
+EIGEN_DEVICE_FUNC inline void pscatter<numext::int64_t, Packet8l>(
+    numext::int64_t* to, const Packet8l& from, Index stride) {
+  Packet8i stride_vector = _mm256_set1_epi32(stride);
+  Packet8i stride_multiplier = _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+  Packet8i indices = _mm256_mullo_epi32(stride_vector, stride_multiplier);
+  _mm512_i32scatter_epi64(to, indices, from, 8);
+}
+
+template <>
+EIGEN_STRONG_INLINE numext::int64_t pfirst<Packet8l>(const Packet8l& a) {
+  return _mm_cvtsi128_si64(_mm512_castsi512_si128(a));
+}
+
+template <>
+EIGEN_STRONG_INLINE Packet8l padd<Packet8l>(const Packet8l& a,
+                                            const Packet8l& b) {
+  return _mm512_add_epi64(a, b);
+}
+template <>
+EIGEN_STRONG_INLINE Packet8l psub<Packet8l>(const Packet8l& a,
+                                            const Packet8l& b) {
+  return _mm512_sub_epi64(a, b);
+}
+template <>
+EIGEN_STRONG_INLINE Packet8l pnegate(const Packet8l& a) {
+  return _mm512_sub_epi64(_mm512_setzero_si512(), a);
+}
+template <>
+EIGEN_STRONG_INLINE Packet8l pconj(const Packet8l& a) {
+  return a;
+}
+template <>
+EIGEN_STRONG_INLINE Packet8l pmul<Packet8l>(const Packet8l& a,
+                                            const Packet8l& b) {
+#ifdef EIGEN_VECTORIZE_AVX512DQ
+  return _mm512_mullo_epi64(a, b);
+#else
+  // lo(a)*lo(b) + ((hi(a)*lo(b) + lo(a)*hi(b)) << 32)
+  __m512i lo = _mm512_mul_epu32(a, b);
+  __m512i cross = _mm512_add_epi64(_mm512_mul_epu32(_mm512_srli_epi64(a, 32), b),
+                                   _mm512_mul_epu32(a, _mm512_srli_epi64(b, 32)));
+  return _mm512_add_epi64(lo, _mm512_slli_epi64(cross, 32));
+#endif
+}
+
+template <>
+EIGEN_STRONG_INLINE Packet8l pmin<Packet8l>(const Packet8l& a,
+                                            const Packet8l& b) {
+  return _mm512_min_epi64(a, b);
+}
+template <>
+EIGEN_STRONG_INLINE Packet8l pmax<Packet8l>(const Packet8l& a,
+                                            const Packet8l& b) {
+  return _mm512_max_epi64(a, b);
+}
+template <>
+EIGEN_STRONG_INLINE Packet8l pabs(const Packet8l& a) {
+  return _mm512_abs_epi64(a);
+}
+
+template <>
+EIGEN_STRONG_INLINE Packet8l pand<Packet8l>(const Packet8l& a,
+                                            const Packet8l& b) {
+  return _mm512_and_si512(a, b);
+}
+template <>
+EIGEN_STRONG_INLINE Packet8l por<Packet8l>(const Packet8l& a,
+                                           const Packet8l& b) {
+  return _mm512_or_si512(a, b);
+}
+template <>
+EIGEN_STRONG_INLINE Packet8l pxor<Packet8l>(const Packet8l& a,
+                                            const Packet8l& b) {
+  return _mm512_xor_si512(a, b);
+}
+template <>
+EIGEN_STRONG_INLINE Packet8l pandnot<Packet8l>(const Packet8l& a,
+                                               const Packet8l& b) {
+  return _mm512_andnot_si512(a, b);
+}
+
+template <int N>
+EIGEN_STRONG_INLINE Packet8l parithmetic_shift_right(const Packet8l& a) {
+  return _mm512_srai_epi64(a, N);
+}
+template <int N>
+EIGEN_STRONG_INLINE Packet8l plogical_shift_right(const Packet8l& a) {
+  return _mm512_srli_epi64(a, N);
+}
+template <int N>
+EIGEN_STRONG_INLINE Packet8l plogical_shift_left(const Packet8l& a) {
+  return _mm512_slli_epi64(a, N);
+}
+
+template <>
+EIGEN_STRONG_INLINE Packet8l preverse(const Packet8l& a) {
+  return _mm512_permutexvar_epi64(_mm512_set_epi64(0, 1, 2, 3, 4, 5, 6, 7), a);
+}
+
+template <>
+EIGEN_STRONG_INLINE Packet4l predux_downto4<Packet8l>(const Packet8l& a) {
+  return _mm256_add_epi64(_mm512_castsi512_si256(a),
+                          _mm512_extracti64x4_epi64(a, 1));
+}
+template <>
+EIGEN_STRONG_INLINE numext::int64_t predux<Packet8l>(const Packet8l& a) {
+  return predux<Packet4l>(predux_downto4<Packet8l>(a));
+}
+template <>
+EIGEN_STRONG_INLINE numext::int64_t predux_mul<Packet8l>(const Packet8l& a) {
+  Packet8l tmp = pmul<Packet8l>(a, _mm512_shuffle_i64x2(a, a, _MM_SHUFFLE(1, 0, 3, 2)));
+  return predux_mul<Packet4l>(_mm512_castsi512_si256(tmp));
+}
+template <>
+EIGEN_STRONG_INLINE numext::int64_t predux_min<Packet8l>(const Packet8l& a) {
+  Packet8l tmp = _mm512_min_epi64(a, _mm512_shuffle_i64x2(a, a, _MM_SHUFFLE(1, 0, 3, 2)));
+  return predux_min<Packet4l>(_mm512_castsi512_si256(tmp));
+}
+template <>
+EIGEN_STRONG_INLINE numext::int64_t predux_max<Packet8l>(const Packet8l& a) {
+  Packet8l tmp = _mm512_max_epi64(a, _mm512_shuffle_i64x2(a, a, _MM_SHUFFLE(1, 0, 3, 2)));
+  return predux_max<Packet4l>(_mm512_castsi512_si256(tmp));
+}
+
+template <int Offset>
+struct palign_impl<Offset, Packet8l> {
+  static EIGEN_STRONG_INLINE void run(Packet8l& first, const Packet8l& second) {
+    if (Offset != 0) {
+      __m512i idx = _mm512_set_epi64(Offset + 7, Offset + 6, Offset + 5,
+                                     Offset + 4, Offset + 3, Offset + 2,
+                                     Offset + 1, Offset);
+
+      unsigned char mask = 0xFF;
+      mask <<= (8 - Offset);
+
+      first = _mm512_mask_blend_epi64(mask, _mm512_permutexvar_epi64(idx, first),
+                                      _mm512_permutexvar_epi64(idx, second));
+    }
+  }
+};
+
+EIGEN_DEVICE_FUNC inline void ptranspose(PacketBlock<Packet8l, 8>& kernel) {
+  PacketBlock<Packet8d, 8> tmp;
+  for (int i = 0; i < 8; ++i) tmp.packet[i] = _mm512_castsi512_pd(kernel.packet[i]);
+  ptranspose(tmp);
+  for (int i = 0; i < 8; ++i) kernel.packet[i] = _mm512_castpd_si512(tmp.packet[i]);
+}
+EIGEN_DEVICE_FUNC inline void ptranspose(PacketBlock<Packet8l, 4>& kernel) {
+  PacketBlock<Packet8d, 4> tmp;
+  for (int i = 0; i < 4; ++i) tmp.packet[i] = _mm512_castsi512_pd(kernel.packet[i]);
+  ptranspose(tmp);
+  for (int i = 0; i < 4; ++i) kernel.packet[i] = _mm512_castpd_si512(tmp.packet[i]);
+}
+
+template <>
+EIGEN_STRONG_INLINE Packet8l preduxp<Packet8l>(const Packet8l* vecs) {
+  PacketBlock<Packet8l, 8> kernel;
+  for (int i = 0; i < 8; ++i) kernel.packet[i] = vecs[i];
+  ptranspose(kernel);
+  Packet8l res = kernel.packet[0];
+  for (int i = 1; i < 8; ++i) res = padd<Packet8l>(res, kernel.packet[i]);
+  return res;
+}
+
+template <>
+EIGEN_STRONG_INLINE Packet8l pblend(const Selector<8>& ifPacket,
+                                    const Packet8l& thenPacket,
+                                    const Packet8l& elsePacket) {
+  __mmask8 mask = 0;
+  for (int i = 0; i < 8; ++i) {
+    if (ifPacket.select[i]) mask |= (1 << i);
+  }
+  return _mm512_mask_blend_epi64(mask, elsePacket, thenPacket);
+}
+
+template <>
+EIGEN_STRONG_INLINE Packet8l pinsertfirst(const Packet8l& a, numext::int64_t b) {
+  return _mm512_mask_blend_epi64(1, a, pset1<Packet8l>(b));
 }
 template <>
-EIGEN_STRONG_INLINE Packet8d pblend(const Selector<8>& /*ifPacket*/,
-                                    const Packet8d& /*thenPacket*/,
-                                    const Packet8d& /*elsePacket*/) {
-  assert(false && "To be implemented");
-  return Packet8d();
+EIGEN_STRONG_INLINE Packet8l pinsertlast(const Packet8l& a, numext::int64_t b) {
+  return _mm512_mask_blend_epi64(1 << 7, a, pset1<Packet8l>(b));
 }
 
 } // end namespace internal
@@ -362,17 +362,17 @@ struct packet_traits<half> : default_packet_traits {
     AlignedOnScalar = 1,
     size = 16,
     HasHalfPacket = 0,
-    HasAdd    = 0,
-    HasSub    = 0,
-    HasMul    = 0,
-    HasNegate = 0,
-    HasAbs    = 0,
+    HasAdd    = 1,
+    HasSub    = 1,
+    HasMul    = 1,
+    HasNegate = 1,
+    HasAbs    = 1,
     HasAbs2   = 0,
-    HasMin    = 0,
-    HasMax    = 0,
-    HasConj   = 0,
+    HasMin    = 1,
+    HasMax    = 1,
+    HasConj   = 1,
     HasSetLinear = 0,
-    HasDiv = 0,
+    HasDiv = 1,
     HasSqrt = 0,
     HasRsqrt = 0,
     HasExp = 0,
@@ -486,6 +486,30 @@ EIGEN_STRONG_INLINE Packet16h float2half(const Packet16f& a) {
 #endif
 }
 
+template<> EIGEN_STRONG_INLINE Packet16h ploaddup<Packet16h>(const Eigen::half* from) {
+  __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(from));
+  Packet16h result;
+  result.x = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_unpacklo_epi16(a, a)),
+                                     _mm_unpackhi_epi16(a, a), 1);
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet16h pconj(const Packet16h& a) { return a; }
+
+// Sign flips and absolute values only touch the sign bit, so they are done
+// directly on the fp16 bit patterns. Everything else is computed in float.
+template<> EIGEN_STRONG_INLINE Packet16h pnegate(const Packet16h& a) {
+  Packet16h result;
+  result.x = _mm256_xor_si256(a.x, _mm256_set1_epi16(static_cast<short>(0x8000)));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet16h pabs(const Packet16h& a) {
+  Packet16h result;
+  result.x = _mm256_and_si256(a.x, _mm256_set1_epi16(0x7fff));
+  return result;
+}
+
 template<> EIGEN_STRONG_INLINE Packet16h padd<Packet16h>(const Packet16h& a, const Packet16h& b) {
   Packet16f af = half2float(a);
   Packet16f bf = half2float(b);
@@ -493,6 +517,13 @@ template<> EIGEN_STRONG_INLINE Packet16h padd<Packet16h>(const Packet16h& a, con
   return float2half(rf);
 }
 
+template<> EIGEN_STRONG_INLINE Packet16h psub<Packet16h>(const Packet16h& a, const Packet16h& b) {
+  Packet16f af = half2float(a);
+  Packet16f bf = half2float(b);
+  Packet16f rf = psub(af, bf);
+  return float2half(rf);
+}
+
 template<> EIGEN_STRONG_INLINE Packet16h pmul<Packet16h>(const Packet16h& a, const Packet16h& b) {
   Packet16f af = half2float(a);
   Packet16f bf = half2float(b);
@@ -500,11 +531,63 @@ template<> EIGEN_STRONG_INLINE Packet16h pmul<Packet16h>(const Packet16h& a, con
   return float2half(rf);
 }
 
+template<> EIGEN_STRONG_INLINE Packet16h pdiv<Packet16h>(const Packet16h& a, const Packet16h& b) {
+  Packet16f af = half2float(a);
+  Packet16f bf = half2float(b);
+  Packet16f rf = pdiv(af, bf);
+  return float2half(rf);
+}
+
+template<> EIGEN_STRONG_INLINE Packet16h pmadd<Packet16h>(const Packet16h& a, const Packet16h& b, const Packet16h& c) {
+  Packet16f af = half2float(a);
+  Packet16f bf = half2float(b);
+  Packet16f cf = half2float(c);
+  Packet16f rf = pmadd(af, bf, cf);
+  return float2half(rf);
+}
+
+template<> EIGEN_STRONG_INLINE Packet16h pmin<Packet16h>(const Packet16h& a, const Packet16h& b) {
+  Packet16f af = half2float(a);
+  Packet16f bf = half2float(b);
+  Packet16f rf = pmin(af, bf);
+  return float2half(rf);
+}
+
+template<> EIGEN_STRONG_INLINE Packet16h pmax<Packet16h>(const Packet16h& a, const Packet16h& b) {
+  Packet16f af = half2float(a);
+  Packet16f bf = half2float(b);
+  Packet16f rf = pmax(af, bf);
+  return float2half(rf);
+}
+
 template<> EIGEN_STRONG_INLINE half predux<Packet16h>(const Packet16h& from) {
   Packet16f from_float = half2float(from);
   return half(predux(from_float));
 }
 
+template<> EIGEN_STRONG_INLINE half predux_max<Packet16h>(const Packet16h& from) {
+  Packet16f from_float = half2float(from);
+  return half(predux_max(from_float));
+}
+
+template<> EIGEN_STRONG_INLINE half predux_min<Packet16h>(const Packet16h& from) {
+  Packet16f from_float = half2float(from);
+  return half(predux_min(from_float));
+}
+
+template<> EIGEN_STRONG_INLINE half predux_mul<Packet16h>(const Packet16h& from) {
+  Packet16f from_float = half2float(from);
+  return half(predux_mul(from_float));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16h preverse(const Packet16h& a) {
+  const __m256i m = _mm256_setr_epi8(14,15,12,13,10,11,8,9,6,7,4,5,2,3,0,1,
+                                     14,15,12,13,10,11,8,9,6,7,4,5,2,3,0,1);
+  Packet16h result;
+  result.x = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(a.x, m), _MM_SHUFFLE(1,0,3,2));
+  return result;
+}
+
 template<> EIGEN_STRONG_INLINE Packet16h pgather<Eigen::half, Packet16h>(const Eigen::half* from, Index stride)
 {
   Packet16h result;
@@ -730,21 +813,21 @@ struct packet_traits<Eigen::half> : default_packet_traits {
     AlignedOnScalar = 1,
     size = 8,
     HasHalfPacket = 0,
-    HasAdd    = 0,
-    HasSub    = 0,
-    HasMul    = 0,
-    HasNegate = 0,
-    HasAbs    = 0,
+    HasAdd    = 1,
+    HasSub    = 1,
+    HasMul    = 1,
+    HasNegate = 1,
+    HasAbs    = 1,
     HasAbs2   = 0,
-    HasMin    = 0,
-    HasMax    = 0,
-    HasConj   = 0,
+    HasMin    = 1,
+    HasMax    = 1,
+    HasConj   = 1,
     HasSetLinear = 0,
-    HasDiv = 0,
-    HasSqrt = 0,
+    HasDiv = 1,
+    HasSqrt = 1,
     HasRsqrt = 0,
-    HasExp = 0,
-    HasLog = 0,
+    HasExp = 1,
+    HasLog = 1,
     HasBlend = 0
   };
 };
@@ -833,8 +916,29 @@ EIGEN_STRONG_INLINE Packet8h float2half(const Packet8f& a) {
 #endif
 }
 
+template<> EIGEN_STRONG_INLINE Packet8h ploaddup<Packet8h>(const Eigen::half* from) {
+  __m128i a = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(from));
+  Packet8h result;
+  result.x = _mm_unpacklo_epi16(a, a);
+  return result;
+}
+
 template<> EIGEN_STRONG_INLINE Packet8h pconj(const Packet8h& a) { return a; }
 
+// Sign flips and absolute values only touch the sign bit, so they are done
+// directly on the fp16 bit patterns. Everything else is computed in float.
+template<> EIGEN_STRONG_INLINE Packet8h pnegate(const Packet8h& a) {
+  Packet8h result;
+  result.x = _mm_xor_si128(a.x, _mm_set1_epi16(static_cast<short>(0x8000)));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet8h pabs(const Packet8h& a) {
+  Packet8h result;
+  result.x = _mm_and_si128(a.x, _mm_set1_epi16(0x7fff));
+  return result;
+}
+
 template<> EIGEN_STRONG_INLINE Packet8h padd<Packet8h>(const Packet8h& a, const Packet8h& b) {
   Packet8f af = half2float(a);
   Packet8f bf = half2float(b);
@@ -842,6 +946,13 @@ template<> EIGEN_STRONG_INLINE Packet8h padd<Packet8h>(const Packet8h& a, const
   return float2half(rf);
 }
 
+template<> EIGEN_STRONG_INLINE Packet8h psub<Packet8h>(const Packet8h& a, const Packet8h& b) {
+  Packet8f af = half2float(a);
+  Packet8f bf = half2float(b);
+  Packet8f rf = psub(af, bf);
+  return float2half(rf);
+}
+
 template<> EIGEN_STRONG_INLINE Packet8h pmul<Packet8h>(const Packet8h& a, const Packet8h& b) {
   Packet8f af = half2float(a);
   Packet8f bf = half2float(b);
@@ -849,6 +960,59 @@ template<> EIGEN_STRONG_INLINE Packet8h pmul<Packet8h>(const Packet8h& a, const
   return float2half(rf);
 }
 
+template<> EIGEN_STRONG_INLINE Packet8h pdiv<Packet8h>(const Packet8h& a, const Packet8h& b) {
+  Packet8f af = half2float(a);
+  Packet8f bf = half2float(b);
+  Packet8f rf = pdiv(af, bf);
+  return float2half(rf);
+}
+
+template<> EIGEN_STRONG_INLINE Packet8h pmadd<Packet8h>(const Packet8h& a, const Packet8h& b, const Packet8h& c) {
+  Packet8f af = half2float(a);
+  Packet8f bf = half2float(b);
+  Packet8f cf = half2float(c);
+  Packet8f rf = pmadd(af, bf, cf);
+  return float2half(rf);
+}
+
+template<> EIGEN_STRONG_INLINE Packet8h pmin<Packet8h>(const Packet8h& a, const Packet8h& b) {
+  Packet8f af = half2float(a);
+  Packet8f bf = half2float(b);
+  Packet8f rf = pmin(af, bf);
+  return float2half(rf);
+}
+
+template<> EIGEN_STRONG_INLINE Packet8h pmax<Packet8h>(const Packet8h& a, const Packet8h& b) {
+  Packet8f af = half2float(a);
+  Packet8f bf = half2float(b);
+  Packet8f rf = pmax(af, bf);
+  return float2half(rf);
+}
+
+template<> EIGEN_STRONG_INLINE Packet8h psqrt<Packet8h>(const Packet8h& a) {
+  Packet8f af = half2float(a);
+  Packet8f rf = psqrt(af);
+  return float2half(rf);
+}
+
+template<> EIGEN_STRONG_INLINE Packet8h pexp<Packet8h>(const Packet8h& a) {
+  Packet8f af = half2float(a);
+  Packet8f rf = pexp(af);
+  return float2half(rf);
+}
+
+template<> EIGEN_STRONG_INLINE Packet8h plog<Packet8h>(const Packet8h& a) {
+  Packet8f af = half2float(a);
+  Packet8f rf = plog(af);
+  return float2half(rf);
+}
+
+template<> EIGEN_STRONG_INLINE Packet8h preverse(const Packet8h& a) {
+  Packet8h result;
+  result.x = _mm_shuffle_epi8(a.x, _mm_set_epi8(1,0,3,2,5,4,7,6,9,8,11,10,13,12,15,14));
+  return result;
+}
+
 template<> EIGEN_STRONG_INLINE Packet8h pgather<Eigen::half, Packet8h>(const Eigen::half* from, Index stride)
 {
   Packet8h result;
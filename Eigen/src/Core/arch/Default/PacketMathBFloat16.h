@@ -0,0 +1,728 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2018 Eigen contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_PACKET_MATH_BFLOAT16_H
+#define EIGEN_PACKET_MATH_BFLOAT16_H
+
+namespace Eigen {
+
+namespace internal {
+
+// bfloat16 packets hold as many coefficients as the float packets of the same
+// instruction set, so that every operation can be carried out as a widening
+// conversion (a 16-bit shift), the float packet op, and a rounding narrowing
+// conversion. Sign manipulations are done directly on the bit patterns.
+
+#if defined EIGEN_VECTORIZE_SSE2 && !defined(EIGEN_VECTORIZE_CUDA)
+
+// Widens the lower/upper four bfloat16 of a into floats.
+EIGEN_STRONG_INLINE Packet4f pbf16lo_to_float(const __m128i& a) {
+  return _mm_castsi128_ps(_mm_unpacklo_epi16(_mm_setzero_si128(), a));
+}
+EIGEN_STRONG_INLINE Packet4f pbf16hi_to_float(const __m128i& a) {
+  return _mm_castsi128_ps(_mm_unpackhi_epi16(_mm_setzero_si128(), a));
+}
+
+// Rounds four floats to nearest even bfloat16. The results are returned
+// sign-extended in 32-bit lanes so that _mm_packs_epi32 keeps their bits.
+EIGEN_STRONG_INLINE __m128i pfloat_to_bf16_epi32(const Packet4f& a) {
+  const __m128i input = _mm_castps_si128(a);
+  const __m128i lsb = _mm_and_si128(_mm_srli_epi32(input, 16), _mm_set1_epi32(1));
+  __m128i rounded = _mm_add_epi32(input, _mm_add_epi32(lsb, _mm_set1_epi32(0x7fff)));
+  // NaNs must stay NaNs instead of being rounded up to infinity.
+  const __m128i nan_mask = _mm_castps_si128(_mm_cmpunord_ps(a, a));
+  rounded = _mm_or_si128(_mm_and_si128(nan_mask, _mm_set1_epi32(0x7fc00000)),
+                         _mm_andnot_si128(nan_mask, rounded));
+  return _mm_srai_epi32(rounded, 16);
+}
+
+#endif
+
+#if defined EIGEN_VECTORIZE_AVX512 && !defined(EIGEN_VECTORIZE_CUDA)
+
+typedef struct {
+  __m256i x;
+} Packet16bf;
+
+template<> struct is_arithmetic<Packet16bf> { enum { value = true }; };
+
+template <>
+struct packet_traits<bfloat16> : default_packet_traits {
+  typedef Packet16bf type;
+  // There is no half-size packet for Packet16bf.
+  typedef Packet16bf half;
+  enum {
+    Vectorizable = 1,
+    AlignedOnScalar = 1,
+    size = 16,
+    HasHalfPacket = 0,
+    HasAdd    = 1,
+    HasSub    = 1,
+    HasMul    = 1,
+    HasNegate = 1,
+    HasAbs    = 1,
+    HasAbs2   = 0,
+    HasMin    = 1,
+    HasMax    = 1,
+    HasConj   = 1,
+    HasSetLinear = 0,
+    HasDiv = 1,
+    HasSqrt = 0,
+    HasRsqrt = 0,
+    HasExp = 0,
+    HasLog = 0,
+    HasBlend = 0
+  };
+};
+
+template<> struct unpacket_traits<Packet16bf> { typedef bfloat16 type; enum {size=16, alignment=Aligned32}; typedef Packet16bf half; };
+
+EIGEN_STRONG_INLINE Packet16f Bf16ToF32(const Packet16bf& a) {
+  return _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(a.x), 16));
+}
+
+EIGEN_STRONG_INLINE Packet16bf F32ToBf16(const Packet16f& a) {
+  const __m512i input = _mm512_castps_si512(a);
+  const __m512i lsb = _mm512_and_si512(_mm512_srli_epi32(input, 16), _mm512_set1_epi32(1));
+  __m512i rounded = _mm512_add_epi32(input, _mm512_add_epi32(lsb, _mm512_set1_epi32(0x7fff)));
+  const __mmask16 nan_mask = _mm512_cmp_ps_mask(a, a, _CMP_UNORD_Q);
+  rounded = _mm512_mask_blend_epi32(nan_mask, rounded, _mm512_set1_epi32(0x7fc00000));
+  Packet16bf result;
+  result.x = _mm512_cvtepi32_epi16(_mm512_srli_epi32(rounded, 16));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pset1<Packet16bf>(const bfloat16& from) {
+  Packet16bf result;
+  result.x = _mm256_set1_epi16(from.value);
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 pfirst<Packet16bf>(const Packet16bf& from) {
+  return bfloat16_impl::raw_uint16_to_bfloat16(static_cast<unsigned short>(_mm256_extract_epi16(from.x, 0)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pload<Packet16bf>(const bfloat16* from) {
+  Packet16bf result;
+  result.x = _mm256_load_si256(reinterpret_cast<const __m256i*>(from));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf ploadu<Packet16bf>(const bfloat16* from) {
+  Packet16bf result;
+  result.x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(from));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE void pstore<bfloat16>(bfloat16* to, const Packet16bf& from) {
+  _mm256_store_si256(reinterpret_cast<__m256i*>(to), from.x);
+}
+
+template<> EIGEN_STRONG_INLINE void pstoreu<bfloat16>(bfloat16* to, const Packet16bf& from) {
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(to), from.x);
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf ploaddup<Packet16bf>(const bfloat16* from) {
+  __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(from));
+  Packet16bf result;
+  result.x = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_unpacklo_epi16(a, a)),
+                                     _mm_unpackhi_epi16(a, a), 1);
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf ploadquad<Packet16bf>(const bfloat16* from) {
+  Packet16bf result;
+  unsigned short a = from[0].value;
+  unsigned short b = from[1].value;
+  unsigned short c = from[2].value;
+  unsigned short d = from[3].value;
+  result.x = _mm256_set_epi16(d, d, d, d, c, c, c, c, b, b, b, b, a, a, a, a);
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pgather<bfloat16, Packet16bf>(const bfloat16* from, Index stride)
+{
+  Packet16bf result;
+  result.x = _mm256_set_epi16(
+      from[15*stride].value, from[14*stride].value, from[13*stride].value, from[12*stride].value,
+      from[11*stride].value, from[10*stride].value, from[9*stride].value, from[8*stride].value,
+      from[7*stride].value, from[6*stride].value, from[5*stride].value, from[4*stride].value,
+      from[3*stride].value, from[2*stride].value, from[1*stride].value, from[0*stride].value);
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE void pscatter<bfloat16, Packet16bf>(bfloat16* to, const Packet16bf& from, Index stride)
+{
+  EIGEN_ALIGN32 bfloat16 aux[16];
+  pstore(aux, from);
+  for (int i = 0; i < 16; ++i) to[stride*i] = aux[i];
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pconj(const Packet16bf& a) { return a; }
+
+template<> EIGEN_STRONG_INLINE Packet16bf pnegate(const Packet16bf& a) {
+  Packet16bf result;
+  result.x = _mm256_xor_si256(a.x, _mm256_set1_epi16(static_cast<short>(0x8000)));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pabs(const Packet16bf& a) {
+  Packet16bf result;
+  result.x = _mm256_and_si256(a.x, _mm256_set1_epi16(0x7fff));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf padd<Packet16bf>(const Packet16bf& a, const Packet16bf& b) {
+  return F32ToBf16(padd(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf psub<Packet16bf>(const Packet16bf& a, const Packet16bf& b) {
+  return F32ToBf16(psub(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pmul<Packet16bf>(const Packet16bf& a, const Packet16bf& b) {
+  return F32ToBf16(pmul(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pdiv<Packet16bf>(const Packet16bf& a, const Packet16bf& b) {
+  return F32ToBf16(pdiv(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pmadd<Packet16bf>(const Packet16bf& a, const Packet16bf& b, const Packet16bf& c) {
+  return F32ToBf16(pmadd(Bf16ToF32(a), Bf16ToF32(b), Bf16ToF32(c)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pmin<Packet16bf>(const Packet16bf& a, const Packet16bf& b) {
+  return F32ToBf16(pmin(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pmax<Packet16bf>(const Packet16bf& a, const Packet16bf& b) {
+  return F32ToBf16(pmax(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 predux<Packet16bf>(const Packet16bf& a) {
+  return bfloat16(predux(Bf16ToF32(a)));
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 predux_max<Packet16bf>(const Packet16bf& a) {
+  return bfloat16(predux_max(Bf16ToF32(a)));
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 predux_min<Packet16bf>(const Packet16bf& a) {
+  return bfloat16(predux_min(Bf16ToF32(a)));
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 predux_mul<Packet16bf>(const Packet16bf& a) {
+  return bfloat16(predux_mul(Bf16ToF32(a)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf preverse(const Packet16bf& a) {
+  const __m256i m = _mm256_setr_epi8(14,15,12,13,10,11,8,9,6,7,4,5,2,3,0,1,
+                                     14,15,12,13,10,11,8,9,6,7,4,5,2,3,0,1);
+  Packet16bf result;
+  result.x = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(a.x, m), _MM_SHUFFLE(1,0,3,2));
+  return result;
+}
+
+EIGEN_STRONG_INLINE void
+ptranspose(PacketBlock<Packet16bf,16>& kernel) {
+  PacketBlock<Packet16f,16> f;
+  for (int i = 0; i < 16; ++i) f.packet[i] = Bf16ToF32(kernel.packet[i]);
+  ptranspose(f);
+  for (int i = 0; i < 16; ++i) kernel.packet[i] = F32ToBf16(f.packet[i]);
+}
+
+EIGEN_STRONG_INLINE void
+ptranspose(PacketBlock<Packet16bf,4>& kernel) {
+  PacketBlock<Packet16f,4> f;
+  for (int i = 0; i < 4; ++i) f.packet[i] = Bf16ToF32(kernel.packet[i]);
+  ptranspose(f);
+  for (int i = 0; i < 4; ++i) kernel.packet[i] = F32ToBf16(f.packet[i]);
+}
+
+template <>
+struct type_casting_traits<bfloat16, float> {
+  enum {
+    VectorizedCast = 1,
+    SrcCoeffRatio = 1,
+    TgtCoeffRatio = 1
+  };
+};
+
+template<> EIGEN_STRONG_INLINE Packet16f pcast<Packet16bf, Packet16f>(const Packet16bf& a) {
+  return Bf16ToF32(a);
+}
+
+template <>
+struct type_casting_traits<float, bfloat16> {
+  enum {
+    VectorizedCast = 1,
+    SrcCoeffRatio = 1,
+    TgtCoeffRatio = 1
+  };
+};
+
+template<> EIGEN_STRONG_INLINE Packet16bf pcast<Packet16f, Packet16bf>(const Packet16f& a) {
+  return F32ToBf16(a);
+}
+
+#elif defined EIGEN_VECTORIZE_AVX && !defined(EIGEN_VECTORIZE_CUDA)
+
+typedef struct {
+  __m128i x;
+} Packet8bf;
+
+template<> struct is_arithmetic<Packet8bf> { enum { value = true }; };
+
+template <>
+struct packet_traits<bfloat16> : default_packet_traits {
+  typedef Packet8bf type;
+  // There is no half-size packet for Packet8bf.
+  typedef Packet8bf half;
+  enum {
+    Vectorizable = 1,
+    AlignedOnScalar = 1,
+    size = 8,
+    HasHalfPacket = 0,
+    HasAdd    = 1,
+    HasSub    = 1,
+    HasMul    = 1,
+    HasNegate = 1,
+    HasAbs    = 1,
+    HasAbs2   = 0,
+    HasMin    = 1,
+    HasMax    = 1,
+    HasConj   = 1,
+    HasSetLinear = 0,
+    HasDiv = 1,
+    HasSqrt = 1,
+    HasRsqrt = 0,
+    HasExp = 1,
+    HasLog = 1,
+    HasBlend = 0
+  };
+};
+
+template<> struct unpacket_traits<Packet8bf> { typedef bfloat16 type; enum {size=8, alignment=Aligned16}; typedef Packet8bf half; };
+
+EIGEN_STRONG_INLINE Packet8f Bf16ToF32(const Packet8bf& a) {
+  return _mm256_insertf128_ps(_mm256_castps128_ps256(pbf16lo_to_float(a.x)),
+                              pbf16hi_to_float(a.x), 1);
+}
+
+EIGEN_STRONG_INLINE Packet8bf F32ToBf16(const Packet8f& a) {
+  Packet8bf result;
+  result.x = _mm_packs_epi32(pfloat_to_bf16_epi32(_mm256_castps256_ps128(a)),
+                             pfloat_to_bf16_epi32(_mm256_extractf128_ps(a, 1)));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pset1<Packet8bf>(const bfloat16& from) {
+  Packet8bf result;
+  result.x = _mm_set1_epi16(from.value);
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 pfirst<Packet8bf>(const Packet8bf& from) {
+  return bfloat16_impl::raw_uint16_to_bfloat16(static_cast<unsigned short>(_mm_extract_epi16(from.x, 0)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pload<Packet8bf>(const bfloat16* from) {
+  Packet8bf result;
+  result.x = _mm_load_si128(reinterpret_cast<const __m128i*>(from));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf ploadu<Packet8bf>(const bfloat16* from) {
+  Packet8bf result;
+  result.x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(from));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE void pstore<bfloat16>(bfloat16* to, const Packet8bf& from) {
+  _mm_store_si128(reinterpret_cast<__m128i*>(to), from.x);
+}
+
+template<> EIGEN_STRONG_INLINE void pstoreu<bfloat16>(bfloat16* to, const Packet8bf& from) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(to), from.x);
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf ploaddup<Packet8bf>(const bfloat16* from) {
+  __m128i a = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(from));
+  Packet8bf result;
+  result.x = _mm_unpacklo_epi16(a, a);
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf ploadquad<Packet8bf>(const bfloat16* from) {
+  Packet8bf result;
+  unsigned short a = from[0].value;
+  unsigned short b = from[1].value;
+  result.x = _mm_set_epi16(b, b, b, b, a, a, a, a);
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pgather<bfloat16, Packet8bf>(const bfloat16* from, Index stride)
+{
+  Packet8bf result;
+  result.x = _mm_set_epi16(from[7*stride].value, from[6*stride].value, from[5*stride].value, from[4*stride].value,
+                           from[3*stride].value, from[2*stride].value, from[1*stride].value, from[0*stride].value);
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE void pscatter<bfloat16, Packet8bf>(bfloat16* to, const Packet8bf& from, Index stride)
+{
+  EIGEN_ALIGN16 bfloat16 aux[8];
+  pstore(aux, from);
+  for (int i = 0; i < 8; ++i) to[stride*i] = aux[i];
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pconj(const Packet8bf& a) { return a; }
+
+template<> EIGEN_STRONG_INLINE Packet8bf pnegate(const Packet8bf& a) {
+  Packet8bf result;
+  result.x = _mm_xor_si128(a.x, _mm_set1_epi16(static_cast<short>(0x8000)));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pabs(const Packet8bf& a) {
+  Packet8bf result;
+  result.x = _mm_and_si128(a.x, _mm_set1_epi16(0x7fff));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf padd<Packet8bf>(const Packet8bf& a, const Packet8bf& b) {
+  return F32ToBf16(padd(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf psub<Packet8bf>(const Packet8bf& a, const Packet8bf& b) {
+  return F32ToBf16(psub(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pmul<Packet8bf>(const Packet8bf& a, const Packet8bf& b) {
+  return F32ToBf16(pmul(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pdiv<Packet8bf>(const Packet8bf& a, const Packet8bf& b) {
+  return F32ToBf16(pdiv(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pmadd<Packet8bf>(const Packet8bf& a, const Packet8bf& b, const Packet8bf& c) {
+  return F32ToBf16(pmadd(Bf16ToF32(a), Bf16ToF32(b), Bf16ToF32(c)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pmin<Packet8bf>(const Packet8bf& a, const Packet8bf& b) {
+  return F32ToBf16(pmin(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pmax<Packet8bf>(const Packet8bf& a, const Packet8bf& b) {
+  return F32ToBf16(pmax(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf psqrt<Packet8bf>(const Packet8bf& a) {
+  return F32ToBf16(psqrt(Bf16ToF32(a)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pexp<Packet8bf>(const Packet8bf& a) {
+  return F32ToBf16(pexp(Bf16ToF32(a)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf plog<Packet8bf>(const Packet8bf& a) {
+  return F32ToBf16(plog(Bf16ToF32(a)));
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 predux<Packet8bf>(const Packet8bf& a) {
+  return bfloat16(predux(Bf16ToF32(a)));
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 predux_max<Packet8bf>(const Packet8bf& a) {
+  return bfloat16(predux_max(Bf16ToF32(a)));
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 predux_min<Packet8bf>(const Packet8bf& a) {
+  return bfloat16(predux_min(Bf16ToF32(a)));
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 predux_mul<Packet8bf>(const Packet8bf& a) {
+  return bfloat16(predux_mul(Bf16ToF32(a)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf preverse(const Packet8bf& a) {
+  Packet8bf result;
+  result.x = _mm_shuffle_epi8(a.x, _mm_set_epi8(1,0,3,2,5,4,7,6,9,8,11,10,13,12,15,14));
+  return result;
+}
+
+EIGEN_STRONG_INLINE void
+ptranspose(PacketBlock<Packet8bf,8>& kernel) {
+  PacketBlock<Packet8f,8> f;
+  for (int i = 0; i < 8; ++i) f.packet[i] = Bf16ToF32(kernel.packet[i]);
+  ptranspose(f);
+  for (int i = 0; i < 8; ++i) kernel.packet[i] = F32ToBf16(f.packet[i]);
+}
+
+EIGEN_STRONG_INLINE void
+ptranspose(PacketBlock<Packet8bf,4>& kernel) {
+  PacketBlock<Packet8f,4> f;
+  for (int i = 0; i < 4; ++i) f.packet[i] = Bf16ToF32(kernel.packet[i]);
+  ptranspose(f);
+  for (int i = 0; i < 4; ++i) kernel.packet[i] = F32ToBf16(f.packet[i]);
+}
+
+template <>
+struct type_casting_traits<bfloat16, float> {
+  enum {
+    VectorizedCast = 1,
+    SrcCoeffRatio = 1,
+    TgtCoeffRatio = 1
+  };
+};
+
+template<> EIGEN_STRONG_INLINE Packet8f pcast<Packet8bf, Packet8f>(const Packet8bf& a) {
+  return Bf16ToF32(a);
+}
+
+template <>
+struct type_casting_traits<float, bfloat16> {
+  enum {
+    VectorizedCast = 1,
+    SrcCoeffRatio = 1,
+    TgtCoeffRatio = 1
+  };
+};
+
+template<> EIGEN_STRONG_INLINE Packet8bf pcast<Packet8f, Packet8bf>(const Packet8f& a) {
+  return F32ToBf16(a);
+}
+
+#elif defined EIGEN_VECTORIZE_SSE2 && !defined(EIGEN_VECTORIZE_CUDA)
+
+// Four bfloat16 fit in the lower 64 bits of an SSE register.
+typedef struct {
+  __m128i x;
+} Packet4bf;
+
+template<> struct is_arithmetic<Packet4bf> { enum { value = true }; };
+
+template <>
+struct packet_traits<bfloat16> : default_packet_traits {
+  typedef Packet4bf type;
+  // There is no half-size packet for Packet4bf.
+  typedef Packet4bf half;
+  enum {
+    Vectorizable = 1,
+    AlignedOnScalar = 1,
+    size = 4,
+    HasHalfPacket = 0,
+    HasAdd    = 1,
+    HasSub    = 1,
+    HasMul    = 1,
+    HasNegate = 1,
+    HasAbs    = 1,
+    HasAbs2   = 0,
+    HasMin    = 1,
+    HasMax    = 1,
+    HasConj   = 1,
+    HasSetLinear = 0,
+    HasDiv = 1,
+    HasSqrt = 1,
+    HasRsqrt = 0,
+    HasExp = 1,
+    HasLog = 1,
+    HasBlend = 0
+  };
+};
+
+template<> struct unpacket_traits<Packet4bf> { typedef bfloat16 type; enum {size=4, alignment=Aligned8}; typedef Packet4bf half; };
+
+EIGEN_STRONG_INLINE Packet4f Bf16ToF32(const Packet4bf& a) {
+  return pbf16lo_to_float(a.x);
+}
+
+EIGEN_STRONG_INLINE Packet4bf F32ToBf16(const Packet4f& a) {
+  __m128i bits = pfloat_to_bf16_epi32(a);
+  Packet4bf result;
+  result.x = _mm_packs_epi32(bits, bits);
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pset1<Packet4bf>(const bfloat16& from) {
+  Packet4bf result;
+  result.x = _mm_set1_epi16(from.value);
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 pfirst<Packet4bf>(const Packet4bf& from) {
+  return bfloat16_impl::raw_uint16_to_bfloat16(static_cast<unsigned short>(_mm_extract_epi16(from.x, 0)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pload<Packet4bf>(const bfloat16* from) {
+  Packet4bf result;
+  result.x = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(from));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf ploadu<Packet4bf>(const bfloat16* from) {
+  Packet4bf result;
+  result.x = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(from));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE void pstore<bfloat16>(bfloat16* to, const Packet4bf& from) {
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(to), from.x);
+}
+
+template<> EIGEN_STRONG_INLINE void pstoreu<bfloat16>(bfloat16* to, const Packet4bf& from) {
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(to), from.x);
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf ploaddup<Packet4bf>(const bfloat16* from) {
+  Packet4bf result;
+  unsigned short a = from[0].value;
+  unsigned short b = from[1].value;
+  result.x = _mm_set_epi16(0, 0, 0, 0, b, b, a, a);
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf ploadquad<Packet4bf>(const bfloat16* from) {
+  return pset1<Packet4bf>(*from);
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pgather<bfloat16, Packet4bf>(const bfloat16* from, Index stride)
+{
+  Packet4bf result;
+  result.x = _mm_set_epi16(0, 0, 0, 0, from[3*stride].value, from[2*stride].value,
+                           from[1*stride].value, from[0*stride].value);
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE void pscatter<bfloat16, Packet4bf>(bfloat16* to, const Packet4bf& from, Index stride)
+{
+  EIGEN_ALIGN16 bfloat16 aux[8];
+  _mm_store_si128(reinterpret_cast<__m128i*>(aux), from.x);
+  for (int i = 0; i < 4; ++i) to[stride*i] = aux[i];
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pconj(const Packet4bf& a) { return a; }
+
+template<> EIGEN_STRONG_INLINE Packet4bf pnegate(const Packet4bf& a) {
+  Packet4bf result;
+  result.x = _mm_xor_si128(a.x, _mm_set1_epi16(static_cast<short>(0x8000)));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pabs(const Packet4bf& a) {
+  Packet4bf result;
+  result.x = _mm_and_si128(a.x, _mm_set1_epi16(0x7fff));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf padd<Packet4bf>(const Packet4bf& a, const Packet4bf& b) {
+  return F32ToBf16(padd(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf psub<Packet4bf>(const Packet4bf& a, const Packet4bf& b) {
+  return F32ToBf16(psub(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pmul<Packet4bf>(const Packet4bf& a, const Packet4bf& b) {
+  return F32ToBf16(pmul(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pdiv<Packet4bf>(const Packet4bf& a, const Packet4bf& b) {
+  return F32ToBf16(pdiv(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pmadd<Packet4bf>(const Packet4bf& a, const Packet4bf& b, const Packet4bf& c) {
+  return F32ToBf16(pmadd(Bf16ToF32(a), Bf16ToF32(b), Bf16ToF32(c)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pmin<Packet4bf>(const Packet4bf& a, const Packet4bf& b) {
+  return F32ToBf16(pmin(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pmax<Packet4bf>(const Packet4bf& a, const Packet4bf& b) {
+  return F32ToBf16(pmax(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf psqrt<Packet4bf>(const Packet4bf& a) {
+  return F32ToBf16(psqrt(Bf16ToF32(a)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pexp<Packet4bf>(const Packet4bf& a) {
+  return F32ToBf16(pexp(Bf16ToF32(a)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf plog<Packet4bf>(const Packet4bf& a) {
+  return F32ToBf16(plog(Bf16ToF32(a)));
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 predux<Packet4bf>(const Packet4bf& a) {
+  return bfloat16(predux(Bf16ToF32(a)));
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 predux_max<Packet4bf>(const Packet4bf& a) {
+  return bfloat16(predux_max(Bf16ToF32(a)));
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 predux_min<Packet4bf>(const Packet4bf& a) {
+  return bfloat16(predux_min(Bf16ToF32(a)));
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 predux_mul<Packet4bf>(const Packet4bf& a) {
+  return bfloat16(predux_mul(Bf16ToF32(a)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf preverse(const Packet4bf& a) {
+  Packet4bf result;
+  result.x = _mm_shufflelo_epi16(a.x, _MM_SHUFFLE(0,1,2,3));
+  return result;
+}
+
+EIGEN_STRONG_INLINE void
+ptranspose(PacketBlock<Packet4bf,4>& kernel) {
+  PacketBlock<Packet4f,4> f;
+  for (int i = 0; i < 4; ++i) f.packet[i] = Bf16ToF32(kernel.packet[i]);
+  ptranspose(f);
+  for (int i = 0; i < 4; ++i) kernel.packet[i] = F32ToBf16(f.packet[i]);
+}
+
+template <>
+struct type_casting_traits<bfloat16, float> {
+  enum {
+    VectorizedCast = 1,
+    SrcCoeffRatio = 1,
+    TgtCoeffRatio = 1
+  };
+};
+
+template<> EIGEN_STRONG_INLINE Packet4f pcast<Packet4bf, Packet4f>(const Packet4bf& a) {
+  return Bf16ToF32(a);
+}
+
+template <>
+struct type_casting_traits<float, bfloat16> {
+  enum {
+    VectorizedCast = 1,
+    SrcCoeffRatio = 1,
+    TgtCoeffRatio = 1
+  };
+};
+
+template<> EIGEN_STRONG_INLINE Packet4bf pcast<Packet4f, Packet4bf>(const Packet4f& a) {
+  return F32ToBf16(a);
+}
+
+#endif
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_PACKET_MATH_BFLOAT16_H
@@ -79,12 +79,13 @@ static void run(Index rows, Index cols, Index depth,
   gemm_pack_rhs<RhsScalar, Index, RhsMapper, Traits::nr, RhsStorageOrder> pack_rhs;
   gebp_kernel<LhsScalar, RhsScalar, Index, ResMapper, Traits::mr, Traits::nr, ConjugateLhs, ConjugateRhs> gebp;
 
-#ifdef EIGEN_HAS_OPENMP
+#if defined(EIGEN_HAS_OPENMP) || defined(EIGEN_GEMM_THREADPOOL)
   if(info)
   {
     // this is the parallel version!
-    int tid = omp_get_thread_num();
-    int threads = omp_get_num_threads();
+    int tid = int(info->logical_thread_id);
+    int threads = int(info->num_threads);
+    GemmParallelTaskInfo<Index>* task_info = info->task_info;
 
     LhsScalar* blockA = blocking.blockA();
     eigen_internal_assert(blockA!=0);
@@ -105,15 +106,15 @@ static void run(Index rows, Index cols, Index depth,
       // each thread packs the sub block A_k,i to A'_i where i is the thread id.
 
       // However, before copying to A'_i, we have to make sure that no other thread is still using it,
-      // i.e., we test that info[tid].users equals 0.
-      // Then, we set info[tid].users to the number of threads to mark that all other threads are going to use it.
-      while(info[tid].users!=0) {}
-      info[tid].users += threads;
+      // i.e., we test that task_info[tid].users equals 0.
+      // Then, we set task_info[tid].users to the number of threads to mark that all other threads are going to use it.
+      while(task_info[tid].users!=0) {}
+      task_info[tid].users += threads;
 
-      pack_lhs(blockA+info[tid].lhs_start*actual_kc, lhs.getSubMapper(info[tid].lhs_start,k), actual_kc, info[tid].lhs_length);
+      pack_lhs(blockA+task_info[tid].lhs_start*actual_kc, lhs.getSubMapper(task_info[tid].lhs_start,k), actual_kc, task_info[tid].lhs_length);
 
       // Notify the other threads that the part A'_i is ready to go.
-      info[tid].sync = k;
+      task_info[tid].sync = k;
 
       // Computes C_i += A' * B' per A'_i
       for(int shift=0; shift<threads; ++shift)
@@ -124,11 +125,11 @@ static void run(Index rows, Index cols, Index depth,
         // we use testAndSetOrdered to mimic a volatile access.
         // However, no need to wait for the B' part which has been updated by the current thread!
         if (shift>0) {
-          while(info[i].sync!=k) {
+          while(task_info[i].sync!=k) {
           }
         }
 
-        gebp(res.getSubMapper(info[i].lhs_start, 0), blockA+info[i].lhs_start*actual_kc, blockB, info[i].lhs_length, actual_kc, nc, alpha);
+        gebp(res.getSubMapper(task_info[i].lhs_start, 0), blockA+task_info[i].lhs_start*actual_kc, blockB, task_info[i].lhs_length, actual_kc, nc, alpha);
       }
 
       // Then keep going as usual with the remaining B'
@@ -146,12 +147,18 @@ static void run(Index rows, Index cols, Index depth,
       // Release all the sub blocks A'_i of A' for the current thread,
       // i.e., we simply decrement the number of users by 1
       for(Index i=0; i<threads; ++i)
+      {
+#ifdef EIGEN_GEMM_THREADPOOL
+        task_info[i].users -= 1;
+#else
         #pragma omp atomic
-        info[i].users -= 1;
+        task_info[i].users -= 1;
+#endif
+      }
     }
   }
   else
-#endif // EIGEN_HAS_OPENMP
+#endif // EIGEN_HAS_OPENMP || EIGEN_GEMM_THREADPOOL
   {
     EIGEN_UNUSED_VARIABLE(info);
 
@@ -205,11 +212,13 @@ static void run(Index rows, Index cols, Index depth,
 *  implementation of the high level wrapper to general_matrix_matrix_product
 **********************************************************************************/
 
-template<typename Scalar, typename Index, typename Gemm, typename Lhs, typename Rhs, typename Dest, typename BlockingType>
+template<typename Scalar, typename Index, typename Gemm, typename Lhs, typename Rhs, typename Dest, typename _BlockingType>
 struct gemm_functor
 {
+  typedef _BlockingType BlockingType;
+
   gemm_functor(const Lhs& lhs, const Rhs& rhs, Dest& dest, const Scalar& actualAlpha, BlockingType& blocking)
-    : m_lhs(lhs), m_rhs(rhs), m_dest(dest), m_actualAlpha(actualAlpha), m_blocking(blocking)
+    : m_lhs(lhs), m_rhs(rhs), m_dest(dest), m_actualAlpha(actualAlpha), m_blocking(blocking), m_partials(0), m_partialSlices(0)
   {}
 
   void initParallelSession(Index num_threads) const
@@ -230,14 +239,64 @@ struct gemm_functor
               m_actualAlpha, m_blocking, info);
   }
 
+  // The tiled parallel evaluation (see GemmTileSchedule) computes the depth slice 0 directly into the destination,
+  // while the other slices are accumulated into zero-initialized temporaries which are reduced at the end.
+  void initTiledSession(Index depth_slices) const
+  {
+    eigen_internal_assert(m_partials==0);
+    m_partialSlices = depth_slices-1;
+    if(m_partialSlices>0)
+    {
+      Index size = m_lhs.rows() * m_rhs.cols() * m_partialSlices;
+      m_partials = aligned_new<Scalar>(size);
+      Map<Matrix<Scalar,Dynamic,1> >(m_partials, size).setZero();
+    }
+  }
+
+  void runTile(Index row, Index rows, Index col, Index cols, Index k, Index depth, Index slice, BlockingType& blocking) const
+  {
+    Scalar* res = (Scalar*)&(m_dest.coeffRef(row,col));
+    Index resStride = m_dest.outerStride();
+    if(slice>0)
+    {
+      resStride = DestIsRowMajor ? m_rhs.cols() : m_lhs.rows();
+      res = m_partials + (slice-1) * m_lhs.rows() * m_rhs.cols()
+                       + (DestIsRowMajor ? row*resStride + col : col*resStride + row);
+    }
+
+    Gemm::run(rows, cols, depth,
+              &m_lhs.coeffRef(row,k), m_lhs.outerStride(),
+              &m_rhs.coeffRef(k,col), m_rhs.outerStride(),
+              res, resStride,
+              m_actualAlpha, blocking);
+  }
+
+  void finishTiledSession() const
+  {
+    if(m_partials==0)
+      return;
+
+    typedef Matrix<Scalar,Dynamic,Dynamic,DestIsRowMajor ? RowMajor : ColMajor> PartialType;
+    Index size = m_lhs.rows() * m_rhs.cols();
+    for(Index s=0; s<m_partialSlices; ++s)
+      m_dest += Map<const PartialType>(m_partials + s*size, m_lhs.rows(), m_rhs.cols());
+
+    aligned_delete(m_partials, size * m_partialSlices);
+    m_partials = 0;
+  }
+
   typedef typename Gemm::Traits Traits;
 
   protected:
+    enum { DestIsRowMajor = (Dest::Flags&RowMajorBit) ? 1 : 0 };
+
     const Lhs& m_lhs;
     const Rhs& m_rhs;
     Dest& m_dest;
     Scalar m_actualAlpha;
     BlockingType& m_blocking;
+    mutable Scalar* m_partials;
+    mutable Index m_partialSlices;
 };
 
 template<int StorageOrder, typename LhsScalar, typename RhsScalar, int MaxRows, int MaxCols, int MaxDepth, int KcFactor=1,
@@ -12,6 +12,109 @@
 
 namespace Eigen {
 
+#ifdef EIGEN_GEMM_THREADPOOL
+
+/** \class GemmParallelBackend
+  * \brief Abstract interface used to run the matrix-matrix products on a user supplied thread pool
+  *
+  * When \c EIGEN_GEMM_THREADPOOL is defined, large matrix products are dispatched to the backend
+  * returned by gemmParallelBackend() instead of OpenMP. The unsupported ThreadPool module provides
+  * ThreadPoolGemmBackend which implements this interface on top of any ThreadPoolInterface.
+  *
+  * The threads of a product share the packed blocks of the lhs and busy-wait on each other,
+  * therefore all the tasks submitted by a single call to run() must be able to make progress concurrently.
+  *
+  * \sa setGemmParallelBackend(), ScopedGemmParallelBackend
+  */
+class GemmParallelBackend
+{
+  public:
+    virtual ~GemmParallelBackend() {}
+
+    /** \returns the maximal number of tasks, including the calling thread, that can run concurrently */
+    virtual int numThreads() const = 0;
+
+    /** \returns true if the calling thread is one of the workers of this backend */
+    virtual bool isWorkerThread() const = 0;
+
+    /** Runs \a task(i) for i=0..\a n-1 concurrently and returns once all of them completed.
+      * The task 0 is expected to be run by the calling thread.
+      * \returns false, without calling \a task, if \a n concurrent tasks cannot be guaranteed (e.g., if the
+      * underlying pool is already running another product). The caller then falls back to a sequential product. */
+    virtual bool run(int n, const std::function<void(int)>& task) = 0;
+};
+
+namespace internal {
+
+/** \internal \returns the backend shared by all threads. It is atomic since it can be changed while other threads
+  * are running products. */
+inline std::atomic<GemmParallelBackend*>& gemm_parallel_backend_global()
+{
+  static std::atomic<GemmParallelBackend*> m_backend(nullptr);
+  return m_backend;
+}
+
+/** \internal \returns the backend overriding the global one for the calling thread */
+inline GemmParallelBackend*& gemm_parallel_backend_local()
+{
+  static thread_local GemmParallelBackend* m_backend = 0;
+  return m_backend;
+}
+
+}
+
+/** Sets the backend used by all threads to parallelize the matrix products.
+  * Passing a null pointer restores the default behavior (OpenMP if enabled, sequential otherwise).
+  * The backend must outlive all the products using it. It can be changed while other threads are running products,
+  * the products that already started keep using the previous backend.
+  * \sa gemmParallelBackend(), ScopedGemmParallelBackend */
+inline void setGemmParallelBackend(GemmParallelBackend* backend)
+{
+  internal::gemm_parallel_backend_global().store(backend, std::memory_order_release);
+}
+
+/** \returns the backend used by the calling thread to parallelize the matrix products, or a null pointer
+  * \sa setGemmParallelBackend() */
+inline GemmParallelBackend* gemmParallelBackend()
+{
+  GemmParallelBackend* local = internal::gemm_parallel_backend_local();
+  return local ? local : internal::gemm_parallel_backend_global().load(std::memory_order_acquire);
+}
+
+/** \class ScopedGemmParallelBackend
+  * \brief Overrides the parallel backend of the matrix products for the calling thread during its lifetime
+  *
+  * \code
+  * {
+  *   ScopedGemmParallelBackend scope(&backend);
+  *   C.noalias() = A * B;   // runs on backend
+  * }
+  * \endcode
+  *
+  * \sa setGemmParallelBackend() */
+class ScopedGemmParallelBackend
+{
+  public:
+    explicit ScopedGemmParallelBackend(GemmParallelBackend* backend)
+      : m_previous(internal::gemm_parallel_backend_local())
+    {
+      internal::gemm_parallel_backend_local() = backend;
+    }
+
+    ~ScopedGemmParallelBackend()
+    {
+      internal::gemm_parallel_backend_local() = m_previous;
+    }
+
+  private:
+    ScopedGemmParallelBackend(const ScopedGemmParallelBackend&);
+    ScopedGemmParallelBackend& operator=(const ScopedGemmParallelBackend&);
+
+    GemmParallelBackend* m_previous;
+};
+
+#endif // EIGEN_GEMM_THREADPOOL
+
 namespace internal {
 
 /** \internal */
@@ -27,6 +130,13 @@ inline void manage_multi_threading(Action action, int* v)
   else if(action==GetAction)
   {
     eigen_internal_assert(v!=0);
+    #ifdef EIGEN_GEMM_THREADPOOL
+    if(GemmParallelBackend* backend = gemmParallelBackend())
+    {
+      *v = m_maxThreads>0 ? (std::min)(m_maxThreads, backend->numThreads()) : backend->numThreads();
+      return;
+    }
+    #endif
     #ifdef EIGEN_HAS_OPENMP
     if(m_maxThreads>0)
       *v = m_maxThreads;
@@ -71,23 +181,216 @@ inline void setNbThreads(int v)
 
 namespace internal {
 
-template<typename Index> struct GemmParallelInfo
+template<typename Index> struct GemmParallelTaskInfo
 {
-  GemmParallelInfo() : sync(-1), users(0), lhs_start(0), lhs_length(0) {}
+  GemmParallelTaskInfo() : sync(-1), users(0), lhs_start(0), lhs_length(0) {}
 
+#ifdef EIGEN_GEMM_THREADPOOL
+  std::atomic<Index> sync;
+  std::atomic<int> users;
+#else
   Index volatile sync;
   int volatile users;
+#endif
 
   Index lhs_start;
   Index lhs_length;
 };
 
+template<typename Index> struct GemmParallelInfo
+{
+  GemmParallelInfo(Index _logical_thread_id, Index _num_threads, GemmParallelTaskInfo<Index>* _task_info)
+    : logical_thread_id(_logical_thread_id), num_threads(_num_threads), task_info(_task_info) {}
+
+  Index logical_thread_id;
+  Index num_threads;
+  GemmParallelTaskInfo<Index>* task_info;
+};
+
+/** \internal Runs the share \a i out of \a threads of a parallel matrix product */
+template<typename Functor, typename Index>
+void run_gemm_parallel_task(const Functor& func, Index i, Index threads, Index rows, Index cols,
+                            GemmParallelTaskInfo<Index>* task_info, bool transpose)
+{
+  Index blockCols = (cols / threads) & ~Index(0x3);
+  Index blockRows = (rows / threads);
+  blockRows = (blockRows/Functor::Traits::mr)*Functor::Traits::mr;
+
+  Index r0 = i*blockRows;
+  Index actualBlockRows = (i+1==threads) ? rows-r0 : blockRows;
+
+  Index c0 = i*blockCols;
+  Index actualBlockCols = (i+1==threads) ? cols-c0 : blockCols;
+
+  task_info[i].lhs_start = r0;
+  task_info[i].lhs_length = actualBlockRows;
+
+  GemmParallelInfo<Index> info(i, threads, task_info);
+  if(transpose) func(c0, actualBlockCols, 0, rows, &info);
+  else          func(0, rows, c0, actualBlockCols, &info);
+}
+
+/** \internal \returns the number of threads, at most \a max_threads, worth using for a \a rows x \a depth
+  * times \a depth x \a cols product.
+  *
+  * Waking up and synchronizing a thread costs in the order of a few thousands cycles, so each thread must be
+  * given at least kMinTaskCycles cycles of work. The work is estimated from the number of multiply-adds,
+  * assuming that the kernel retires one packet of them per cycle, plus the time needed to stream the operands
+  * and the destination from memory.
+  */
+template<typename Traits, typename Index>
+Index gemm_cost_model_threads(Index rows, Index cols, Index depth, Index max_threads)
+{
+  typedef typename Traits::LhsScalar LhsScalar;
+  typedef typename Traits::RhsScalar RhsScalar;
+  typedef typename Traits::ResScalar ResScalar;
+
+  const double kMinTaskCycles = 32768;
+  const double kBytesPerCycle = 8;
+
+  double compute = double(rows) * double(cols) * double(depth) * double(NumTraits<ResScalar>::MulCost)
+                 / double(Traits::ResPacketSize);
+  double memory = ( double(rows) * double(depth) * double(sizeof(LhsScalar))
+                  + double(depth) * double(cols) * double(sizeof(RhsScalar))
+                  + 2. * double(rows) * double(cols) * double(sizeof(ResScalar)) ) / kBytesPerCycle;
+  double threads = (compute + memory) / kMinTaskCycles;
+
+  return threads >= double(max_threads) ? max_threads : (std::max)(Index(1), Index(threads));
+}
+
+/** \internal
+  * Partition of a (col-major) \a rows x \a cols destination into tiles of \a tile_rows x \a tile_cols coefficients,
+  * and of the \a depth into \a depth_slices slices of \a tile_depth. The tasks, i.e., the pairs (tile, slice),
+  * are handed out dynamically to the threads, the consecutive tasks sharing the same block of the rhs.
+  *
+  * The initial tile sizes are the cache blocking sizes computed by computeProductBlockingSizes, which are
+  * then halved along the longest dimension, counted in register blocks, until every thread gets at least two tiles.
+  * If this is still not enough to keep all the threads busy, the depth is split too, as long as each slice
+  * remains at least one cache block deep.
+  */
+template<typename Index> struct GemmTileSchedule
+{
+  template<typename Traits>
+  void init(Index _rows, Index _cols, Index _depth, Index threads)
+  {
+    enum { mr = Traits::mr, nr = Traits::nr, kr = 8 };
+    rows = _rows;
+    cols = _cols;
+    depth = _depth;
+
+    Index kc = depth;
+    tile_rows = rows;
+    tile_cols = cols;
+    computeProductBlockingSizes<typename Traits::LhsScalar,typename Traits::RhsScalar>(kc, tile_rows, tile_cols);
+
+    const Index min_tiles = 2*threads;
+    for(;;)
+    {
+      row_tiles = numext::div_ceil(rows, tile_rows);
+      col_tiles = numext::div_ceil(cols, tile_cols);
+      if(row_tiles*col_tiles >= min_tiles)
+        break;
+      bool can_split_rows = tile_rows > Index(mr);
+      bool can_split_cols = tile_cols > Index(nr);
+      if(can_split_rows && (!can_split_cols || tile_rows/mr >= tile_cols/nr))
+        tile_rows = round_up(numext::div_ceil(tile_rows, Index(2)), Index(mr));
+      else if(can_split_cols)
+        tile_cols = round_up(numext::div_ceil(tile_cols, Index(2)), Index(nr));
+      else
+        break;
+    }
+
+    tile_depth = depth;
+    depth_slices = 1;
+    Index tiles = row_tiles*col_tiles;
+    if(tiles < threads && depth > kc)
+    {
+      Index slices = (std::min)(numext::div_ceil(threads, tiles), depth / kc);
+      tile_depth = round_up(numext::div_ceil(depth, slices), Index(kr));
+      depth_slices = numext::div_ceil(depth, tile_depth);
+    }
+  }
+
+  Index tasks() const { return row_tiles*col_tiles*depth_slices; }
+
+  static Index round_up(Index x, Index multiple) { return numext::div_ceil(x, multiple) * multiple; }
+
+  Index rows, cols, depth;
+  Index tile_rows, tile_cols, tile_depth;
+  Index row_tiles, col_tiles, depth_slices;
+};
+
+/** \internal Computes the task \a t of \a schedule using the packing buffers of \a blocking */
+template<typename Functor, typename Index>
+void run_gemm_tile(const Functor& func, const GemmTileSchedule<Index>& schedule, Index t,
+                   typename Functor::BlockingType& blocking, bool transpose)
+{
+  Index tiles = schedule.row_tiles*schedule.col_tiles;
+  Index slice = t / tiles;
+  Index i = ((t % tiles) % schedule.row_tiles) * schedule.tile_rows;
+  Index j = ((t % tiles) / schedule.row_tiles) * schedule.tile_cols;
+  Index k = slice * schedule.tile_depth;
+
+  Index actual_rows = (std::min)(schedule.tile_rows, schedule.rows-i);
+  Index actual_cols = (std::min)(schedule.tile_cols, schedule.cols-j);
+  Index actual_depth = (std::min)(schedule.tile_depth, schedule.depth-k);
+
+  if(transpose) func.runTile(j, actual_cols, i, actual_rows, k, actual_depth, slice, blocking);
+  else          func.runTile(i, actual_rows, j, actual_cols, k, actual_depth, slice, blocking);
+}
+
+/** \internal Calls \a func(begin,end) on consecutive ranges of at most \a chunk indices covering [0,size), using up to
+  * \a threads threads of the parallel backend, or of OpenMP. The ranges are handed out dynamically to the threads, they
+  * must be independent of each other. The whole range is processed by the calling thread if multi-threading is disabled
+  * or if we are already running in parallel.
+  */
+template<typename Index, typename Functor>
+void parallelize_ranges(Index size, Index chunk, Index threads, const Functor& func)
+{
+  chunk = (std::max)(chunk, Index(1));
+  const Index chunks = numext::div_ceil(size, chunk);
+  threads = (std::min)(threads, chunks);
+#ifdef EIGEN_GEMM_THREADPOOL
+  if(GemmParallelBackend* backend = gemmParallelBackend())
+  {
+    if(threads>1 && !backend->isWorkerThread())
+    {
+      std::atomic<Index> next(0);
+      auto worker = [&](int) {
+        for(Index c = next++; c < chunks; c = next++)
+          func(c*chunk, (std::min)(size, (c+1)*chunk));
+      };
+      // the ranges do not depend on each other, so if the backend is busy the calling thread processes them all
+      if(!backend->run(int(threads), worker))
+        worker(0);
+      return;
+    }
+    if(size>0)
+      func(Index(0), size);
+    return;
+  }
+#endif
+#ifdef EIGEN_HAS_OPENMP
+  if(threads>1 && omp_get_num_threads()==1)
+  {
+    #pragma omp parallel for schedule(dynamic) num_threads(threads)
+    for(Index c=0; c<chunks; ++c)
+      func(c*chunk, (std::min)(size, (c+1)*chunk));
+    return;
+  }
+#else
+  EIGEN_UNUSED_VARIABLE(threads);
+#endif
+  if(size>0)
+    func(Index(0), size);
+}
+
 template<bool Condition, typename Functor, typename Index>
 void parallelize_gemm(const Functor& func, Index rows, Index cols, Index depth, bool transpose)
 {
   // TODO when EIGEN_USE_BLAS is defined,
   // we should still enable OMP for other scalar types
-#if !(defined (EIGEN_HAS_OPENMP)) || defined (EIGEN_USE_BLAS)
+#if !(defined (EIGEN_HAS_OPENMP) || defined (EIGEN_GEMM_THREADPOOL)) || defined (EIGEN_USE_BLAS)
   // FIXME the transpose variable is only needed to properly split
   // the matrix product when multithreading is enabled. This is a temporary
   // fix to support row-major destination matrices. This whole
@@ -97,26 +400,81 @@ void parallelize_gemm(const Functor& func, Index rows, Index cols, Index depth,
   func(0,rows, 0,cols);
 #else
 
-  // Dynamically check whether we should enable or disable OpenMP.
+  // Dynamically check whether we should enable or disable multi-threading.
   // The conditions are:
   // - the max number of threads we can create is greater than 1
   // - we are not already in a parallel code
   // - the sizes are large enough
 
-  // compute the maximal number of threads from the size of the product:
-  // This first heuristic takes into account that the product kernel is fully optimized when working with nr columns at once.
-  Index size = transpose ? rows : cols;
-  Index pb_max_threads = std::max<Index>(1,size / Functor::Traits::nr);
+  typedef typename Functor::Traits Traits;
+  typedef typename Functor::BlockingType BlockingType;
+
+  // dimensions of the product as seen by the column-major kernel
+  Index actual_rows = transpose ? cols : rows;
+  Index actual_cols = transpose ? rows : cols;
+
+  // compute the number of threads we are going to use from the total amount of work
+  Index threads = gemm_cost_model_threads<Traits>(actual_rows, actual_cols, depth, Index(nbThreads()));
+
+  // Sharing the packed lhs between the threads (see GemmParallelInfo) is the most efficient strategy when
+  // each thread gets a vertical panel of the destination that is at least a few register blocks wide.
+  // Otherwise, e.g., for tall-skinny products, the destination (and possibly the depth) is split into tiles
+  // which are handed out dynamically, each thread packing its own blocks of the operands.
+  bool share_lhs = actual_cols / threads >= 4*Index(Traits::nr) && actual_rows / threads >= Index(Traits::mr);
+
+  GemmTileSchedule<Index> schedule;
+  if(Condition && threads>1 && !share_lhs)
+  {
+    schedule.template init<Traits>(actual_rows, actual_cols, depth, threads);
+    threads = (std::min)(threads, schedule.tasks());
+  }
 
-  // compute the maximal number of threads from the total amount of work:
-  double work = static_cast<double>(rows) * static_cast<double>(cols) *
-      static_cast<double>(depth);
-  double kMinTaskSize = 50000;  // FIXME improve this heuristic.
-  pb_max_threads = std::max<Index>(1, std::min<Index>(pb_max_threads, work / kMinTaskSize));
+#ifdef EIGEN_GEMM_THREADPOOL
+  if(GemmParallelBackend* backend = gemmParallelBackend())
+  {
+    // if multi-threading is explicitely disabled, not useful, or if we are already running on one
+    // of the workers (the nested tasks could never be scheduled), then abort multi-threading
+    if((!Condition) || (threads<=1) || backend->isWorkerThread())
+      return func(0,rows, 0,cols);
+
+    Eigen::initParallel();
+
+    if(share_lhs)
+    {
+      func.initParallelSession(threads);
+
+      ei_declare_aligned_stack_constructed_variable(GemmParallelTaskInfo<Index>,task_info,threads,0);
+
+      // The backend refuses to run if it cannot guarantee that all the shares make progress concurrently,
+      // in which case we fall back to the sequential product.
+      if(!backend->run(int(threads), [&](int i) {
+           run_gemm_parallel_task(func, Index(i), threads, actual_rows, actual_cols, task_info, transpose);
+         }))
+        func(0,rows, 0,cols);
+    }
+    else
+    {
+      func.initTiledSession(schedule.depth_slices);
 
-  // compute the number of threads we are going to use
-  Index threads = std::min<Index>(nbThreads(), pb_max_threads);
+      std::atomic<Index> next(0);
+      auto worker = [&](int) {
+        BlockingType blocking(transpose ? schedule.tile_cols : schedule.tile_rows,
+                              transpose ? schedule.tile_rows : schedule.tile_cols, schedule.tile_depth, 1, true);
+        blocking.allocateAll();
+        for(Index t = next++; t < schedule.tasks(); t = next++)
+          run_gemm_tile(func, schedule, t, blocking, transpose);
+      };
+      // the tiles do not depend on each other, so if the backend is busy the calling thread computes them all
+      if(!backend->run(int(threads), worker))
+        worker(0);
 
+      func.finishTiledSession();
+    }
+    return;
+  }
+#endif
+
+#ifdef EIGEN_HAS_OPENMP
   // if multi-threading is explicitely disabled, not useful, or if we already are in a parallel session,
   // then abort multi-threading
   // FIXME omp_get_num_threads()>1 only works for openmp, what if the user does not use openmp?
@@ -124,35 +482,43 @@ void parallelize_gemm(const Functor& func, Index rows, Index cols, Index depth,
     return func(0,rows, 0,cols);
 
   Eigen::initParallel();
-  func.initParallelSession(threads);
 
-  if(transpose)
-    std::swap(rows,cols);
-
-  ei_declare_aligned_stack_constructed_variable(GemmParallelInfo<Index>,info,threads,0);
-
-  #pragma omp parallel num_threads(threads)
+  if(share_lhs)
   {
-    Index i = omp_get_thread_num();
-    // Note that the actual number of threads might be lower than the number of request ones.
-    Index actual_threads = omp_get_num_threads();
+    func.initParallelSession(threads);
+
+    ei_declare_aligned_stack_constructed_variable(GemmParallelTaskInfo<Index>,task_info,threads,0);
 
-    Index blockCols = (cols / actual_threads) & ~Index(0x3);
-    Index blockRows = (rows / actual_threads);
-    blockRows = (blockRows/Functor::Traits::mr)*Functor::Traits::mr;
+    #pragma omp parallel num_threads(threads)
+    {
+      Index i = omp_get_thread_num();
+      // Note that the actual number of threads might be lower than the number of request ones.
+      Index actual_threads = omp_get_num_threads();
 
-    Index r0 = i*blockRows;
-    Index actualBlockRows = (i+1==actual_threads) ? rows-r0 : blockRows;
+      run_gemm_parallel_task(func, i, actual_threads, actual_rows, actual_cols, task_info, transpose);
+    }
+  }
+  else
+  {
+    func.initTiledSession(schedule.depth_slices);
 
-    Index c0 = i*blockCols;
-    Index actualBlockCols = (i+1==actual_threads) ? cols-c0 : blockCols;
+    const Index tasks = schedule.tasks();
+    #pragma omp parallel num_threads(threads)
+    {
+      BlockingType blocking(transpose ? schedule.tile_cols : schedule.tile_rows,
+                            transpose ? schedule.tile_rows : schedule.tile_cols, schedule.tile_depth, 1, true);
+      blocking.allocateAll();
 
-    info[i].lhs_start = r0;
-    info[i].lhs_length = actualBlockRows;
+      #pragma omp for schedule(dynamic)
+      for(Index t=0; t<tasks; ++t)
+        run_gemm_tile(func, schedule, t, blocking, transpose);
+    }
 
-    if(transpose) func(c0, actualBlockCols, 0, rows, info);
-    else          func(0, rows, c0, actualBlockCols, info);
+    func.finishTiledSession();
   }
+#else
+  func(0,rows, 0,cols);
+#endif
 #endif
 }
 
@@ -697,8 +697,10 @@ namespace Eigen {
 // If the user explicitly disable vectorization, then we also disable alignment
 #if defined(EIGEN_DONT_VECTORIZE)
   #define EIGEN_IDEAL_MAX_ALIGN_BYTES 0
-#elif defined(EIGEN_VECTORIZE_AVX512)
-  // 64 bytes static alignment is preferred only if really required
+#elif defined(EIGEN_VECTORIZE_AVX512) || defined(__AVX512F__)
+  // 64 bytes static alignment is preferred only if really required.
+  // Note that EIGEN_VECTORIZE_AVX512 is only defined after this file has been
+  // parsed, hence the additional check on the compiler flag.
   #define EIGEN_IDEAL_MAX_ALIGN_BYTES 64
 #elif defined(__AVX__)
   // 32 bytes static alignment is preferred only if really required
@@ -16,12 +16,32 @@
 #include <math_constants.h>
 #endif
 
-#if EIGEN_COMP_ICC>=1600 &&  __cplusplus >= 201103L
+#if EIGEN_HAS_CXX11 || (EIGEN_COMP_ICC>=1600 &&  __cplusplus >= 201103L)
 #include <cstdint>
+#else
+// Without c++11, all compilers able to compile Eigen also
+// provide the C99 stdint.h header file.
+#include <stdint.h>
 #endif
 
 namespace Eigen {
 
+namespace numext {
+// Portable fixed-width integer types, mainly used to select the integer
+// packets of the vectorization engine.
+#if EIGEN_HAS_CXX11 || (EIGEN_COMP_ICC>=1600 &&  __cplusplus >= 201103L)
+typedef std::int32_t  int32_t;
+typedef std::uint32_t uint32_t;
+typedef std::int64_t  int64_t;
+typedef std::uint64_t uint64_t;
+#else
+typedef ::int32_t  int32_t;
+typedef ::uint32_t uint32_t;
+typedef ::int64_t  int64_t;
+typedef ::uint64_t uint64_t;
+#endif
+}
+
 typedef EIGEN_DEFAULT_DENSE_INDEX_TYPE DenseIndex;
 
 /**
@@ -113,6 +133,22 @@ template<> struct is_integral<signed long>            { enum { value = true }; }
 template<> struct is_integral<unsigned long>          { enum { value = true }; };
 #endif
 
+#if EIGEN_HAS_CXX11
+using std::make_unsigned;
+#else
+// Only the integer types of is_integral are supported
+template<typename T> struct make_unsigned;
+template<> struct make_unsigned<char>                 { typedef unsigned char type; };
+template<> struct make_unsigned<signed char>          { typedef unsigned char type; };
+template<> struct make_unsigned<unsigned char>        { typedef unsigned char type; };
+template<> struct make_unsigned<signed short>         { typedef unsigned short type; };
+template<> struct make_unsigned<unsigned short>       { typedef unsigned short type; };
+template<> struct make_unsigned<signed int>           { typedef unsigned int type; };
+template<> struct make_unsigned<unsigned int>         { typedef unsigned int type; };
+template<> struct make_unsigned<signed long>          { typedef unsigned long type; };
+template<> struct make_unsigned<unsigned long>        { typedef unsigned long type; };
+#endif
+
 
 template <typename T> struct add_const { typedef const T type; };
 template <typename T> struct add_const<T&> { typedef T& type; };
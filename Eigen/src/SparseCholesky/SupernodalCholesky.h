@@ -0,0 +1,958 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_SUPERNODAL_CHOLESKY_H
+#define EIGEN_SUPERNODAL_CHOLESKY_H
+
+namespace Eigen {
+
+namespace internal {
+
+// Dense LDL^T factorization without pivoting of the lower triangular part of a matrix, used on the diagonal blocks of
+// the supernodes. The unit lower triangular factor overwrites the strictly lower part, the diagonal D is stored in
+// diag. Returns the index of the first zero pivot, or -1.
+template<typename Scalar> struct supernodal_ldlt
+{
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef Ref<Matrix<Scalar,Dynamic,Dynamic> > MatrixRef;
+  typedef Ref<Matrix<Scalar,Dynamic,1> > VectorRef;
+
+  static Index unblocked(MatrixRef mat, VectorRef diag)
+  {
+    const Index size = mat.rows();
+    Matrix<Scalar,Dynamic,1> temp(size);
+    for(Index k = 0; k < size; ++k)
+    {
+      const Index rs = size-k-1;
+      if(k>0)
+      {
+        // A(k:,k) -= L(k:,0:k) * D(0:k) * L(k,0:k)^*
+        temp.head(k) = diag.head(k).cwiseProduct(mat.row(k).head(k).adjoint());
+        mat.col(k).tail(size-k).noalias() -= mat.block(k,0,size-k,k) * temp.head(k);
+      }
+      const RealScalar d = numext::real(mat.coeff(k,k));
+      diag(k) = d;
+      if(d == RealScalar(0))
+        return k;
+      if(rs>0)
+        mat.col(k).tail(rs) /= d;
+    }
+    return -1;
+  }
+
+  static Index blocked(MatrixRef mat, VectorRef diag)
+  {
+    const Index size = mat.rows();
+    if(size<32)
+      return unblocked(mat, diag);
+
+    const Index blockSize = 64;
+    for(Index k=0; k<size; k+=blockSize)
+    {
+      const Index bs = (std::min)(blockSize, size-k);
+      const Index rs = size - k - bs;
+      Index ret;
+      if((ret=unblocked(mat.block(k,k,bs,bs), diag.segment(k,bs)))>=0)
+        return k+ret;
+      if(rs>0)
+        update(mat.block(k,k,bs,bs), mat.block(k+bs,k,rs,bs), diag.segment(k,bs), mat.block(k+bs,k+bs,rs,rs));
+    }
+    return -1;
+  }
+
+  // Given the factored diagonal block A11, computes L21 in place of A21 and A22 -= L21 * D * L21^* (lower part)
+  static void update(MatrixRef A11, MatrixRef A21, VectorRef diag, MatrixRef A22)
+  {
+    A11.adjoint().template triangularView<UnitUpper>().template solveInPlace<OnTheRight>(A21);
+    const Matrix<Scalar,Dynamic,Dynamic> A21D = A21;
+    A21 = A21 * diag.asDiagonal().inverse();
+    A22.template triangularView<Lower>() -= A21D * A21.adjoint();
+  }
+};
+
+// Elimination tree of a matrix whose upper triangular part is stored in the column major matrix ap.
+template<typename CholMatrixType, typename IndexVector>
+void supernodal_etree(const CholMatrixType& ap, IndexVector& parent)
+{
+  typedef typename IndexVector::Scalar StorageIndex;
+  const Index size = ap.cols();
+  parent.setConstant(size, -1);
+  // ancestor(i) is a shortcut towards the root of the current subtree of i
+  IndexVector ancestor = IndexVector::Constant(size, -1);
+  for(Index k = 0; k < size; ++k)
+  {
+    for(typename CholMatrixType::InnerIterator it(ap,k); it; ++it)
+    {
+      for(Index i = it.index(); i != -1 && i < k; )
+      {
+        const Index next = ancestor(i);
+        ancestor(i) = StorageIndex(k);
+        if(next == -1)
+          parent(i) = StorageIndex(k);
+        i = next;
+      }
+    }
+  }
+}
+
+// Postorder of a forest: post(k) is the k-th node, the children of a node are visited in increasing order.
+template<typename IndexVector>
+void supernodal_postorder(const IndexVector& parent, IndexVector& post)
+{
+  typedef typename IndexVector::Scalar StorageIndex;
+  const Index size = parent.size();
+  IndexVector firstChild = IndexVector::Constant(size, -1), nextSibling(size), stack(size);
+  for(Index j = size-1; j >= 0; --j)
+  {
+    if(parent(j) != -1)
+    {
+      nextSibling(j) = firstChild(parent(j));
+      firstChild(parent(j)) = StorageIndex(j);
+    }
+  }
+  post.resize(size);
+  Index k = 0;
+  for(Index root = 0; root < size; ++root)
+  {
+    if(parent(root) != -1)
+      continue;
+    Index top = 0;
+    stack(0) = StorageIndex(root);
+    while(top >= 0)
+    {
+      const StorageIndex p = stack(top);
+      const StorageIndex child = firstChild(p);
+      if(child == -1)
+      {
+        --top;
+        post(k++) = p;
+      }
+      else
+      {
+        // the children are removed from the list once visited
+        firstChild(p) = nextSibling(child);
+        stack(++top) = child;
+      }
+    }
+  }
+}
+
+// Factorizes independent subtrees of supernodes, each range [begin,end) of tasks at once.
+template<typename Solver, bool DoLDLT>
+struct supernodal_subtrees_task
+{
+  typedef typename Solver::CholMatrixType CholMatrixType;
+  typedef typename Solver::DenseMatrix DenseMatrix;
+  typedef typename Solver::VectorI VectorI;
+
+  supernodal_subtrees_task(Solver& solver, const CholMatrixType& ap, std::vector<DenseMatrix>& updates,
+                           const VectorI& first, const VectorI& last, std::vector<unsigned char>& failed)
+    : m_solver(solver), m_ap(ap), m_updates(updates), m_first(first), m_last(last), m_failed(failed)
+  {}
+
+  void operator()(Index begin, Index end) const
+  {
+    VectorI map(m_ap.rows());
+    for(Index t = begin; t < end; ++t)
+    {
+      for(Index s = m_first(t); s <= m_last(t); ++s)
+      {
+        if(!m_solver.template factorizeSupernode<DoLDLT>(s, m_ap, m_updates, map))
+        {
+          m_failed[t] = 1;
+          break;
+        }
+      }
+    }
+  }
+
+  Solver& m_solver;
+  const CholMatrixType& m_ap;
+  std::vector<DenseMatrix>& m_updates;
+  const VectorI& m_first;
+  const VectorI& m_last;
+  std::vector<unsigned char>& m_failed;
+};
+
+} // end namespace internal
+
+/** \ingroup SparseCholesky_Module
+  * \brief A base class for supernodal sparse Cholesky factorizations
+  *
+  * This is a base class for supernodal LL^T and LDL^T Cholesky factorizations of sparse matrices that are
+  * selfadjoint and positive definite.
+  *
+  * The columns of the factor that share the same pattern below their diagonal block are grouped into supernodes,
+  * which are detected from the elimination tree. Small supernodes are further merged with their parent at the price
+  * of a few explicit zeros. The factorization is multifrontal: every supernode is stored as a dense panel that is
+  * factorized with the dense Cholesky kernels, and its contribution to the rest of the matrix is a dense update
+  * computed by a matrix-matrix product. For matrices with a significant fill-in, like the ones of 2D or 3D meshes,
+  * this is much faster than the column by column factorization of SimplicialLLT and SimplicialLDLT.
+  *
+  * The independent subtrees of the supernodal elimination tree are factorized in parallel when Eigen is
+  * parallelized (see \ref TopicMultiThreading).
+  *
+  * In order to reduce the fill-in, a symmetric permutation P is applied prior to the factorization such that the
+  * factorized matrix is P A P^-1. P is the fill-reducing ordering combined with a postorder of the elimination tree.
+  *
+  * \tparam Derived the type of the derived class, that is the actual factorization type.
+  */
+template<typename Derived>
+class SupernodalCholeskyBase : public SparseSolverBase<Derived>
+{
+    typedef SparseSolverBase<Derived> Base;
+    using Base::m_isInitialized;
+
+  public:
+    typedef typename internal::traits<Derived>::MatrixType MatrixType;
+    typedef typename internal::traits<Derived>::OrderingType OrderingType;
+    enum { UpLo = internal::traits<Derived>::UpLo };
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::RealScalar RealScalar;
+    typedef typename MatrixType::StorageIndex StorageIndex;
+    typedef SparseMatrix<Scalar,ColMajor,StorageIndex> CholMatrixType;
+    typedef Matrix<Scalar,Dynamic,1> VectorType;
+    typedef Matrix<StorageIndex,Dynamic,1> VectorI;
+    typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+
+    enum {
+      ColsAtCompileTime = MatrixType::ColsAtCompileTime,
+      MaxColsAtCompileTime = MatrixType::MaxColsAtCompileTime
+    };
+
+    using Base::derived;
+
+    /** Default constructor */
+    SupernodalCholeskyBase()
+      : m_info(Success), m_factorizationIsOk(false), m_analysisIsOk(false), m_size(0), m_shiftOffset(0), m_shiftScale(1)
+    {}
+
+    inline Index cols() const { return m_size; }
+    inline Index rows() const { return m_size; }
+
+    /** \brief Reports whether previous computation was successful.
+      *
+      * \returns \c Success if computation was succesful,
+      *          \c NumericalIssue if the matrix appears not to be positive definite.
+      */
+    ComputationInfo info() const
+    {
+      eigen_assert(m_isInitialized && "Decomposition is not initialized.");
+      return m_info;
+    }
+
+    /** \returns the permutation P
+      * \sa permutationPinv() */
+    const PermutationMatrix<Dynamic,Dynamic,StorageIndex>& permutationP() const
+    { return m_P; }
+
+    /** \returns the inverse P^-1 of the permutation P
+      * \sa permutationP() */
+    const PermutationMatrix<Dynamic,Dynamic,StorageIndex>& permutationPinv() const
+    { return m_Pinv; }
+
+    /** \returns the number of supernodes found by analyzePattern() */
+    Index nbSupernodes() const
+    {
+      eigen_assert(m_analysisIsOk && "You must first call analyzePattern()");
+      return m_superStart.size()-1;
+    }
+
+    /** Sets the shift parameters that will be used to adjust the diagonal coefficients during the numerical factorization.
+      *
+      * During the numerical factorization, the diagonal coefficients are transformed by the following linear model:\n
+      * \c d_ii = \a offset + \a scale * \c d_ii
+      *
+      * The default is the identity transformation with \a offset=0, and \a scale=1.
+      *
+      * \returns a reference to \c *this.
+      */
+    Derived& setShift(const RealScalar& offset, const RealScalar& scale = 1)
+    {
+      m_shiftOffset = offset;
+      m_shiftScale = scale;
+      return derived();
+    }
+
+    /** Performs a symbolic decomposition on the sparsity of \a a: computes the ordering, the elimination tree and
+      * the supernodes.
+      *
+      * This function is particularly useful when solving for several problems having the same structure.
+      *
+      * \sa factorize()
+      */
+    void analyzePattern(const MatrixType& a);
+
+#ifndef EIGEN_PARSED_BY_DOXYGEN
+    /** \internal */
+    template<typename Rhs,typename Dest>
+    void _solve_impl(const MatrixBase<Rhs> &b, MatrixBase<Dest> &dest) const;
+
+    template<typename Rhs,typename Dest>
+    void _solve_impl(const SparseMatrixBase<Rhs> &b, SparseMatrixBase<Dest> &dest) const
+    {
+      internal::solve_sparse_through_dense_panels(derived(), b, dest);
+    }
+
+    /** \internal Assembles and factorizes the supernode \a s, and computes its update. map is a workspace. */
+    template<bool DoLDLT>
+    bool factorizeSupernode(Index s, const CholMatrixType& ap, std::vector<DenseMatrix>& updates, VectorI& map);
+#endif // EIGEN_PARSED_BY_DOXYGEN
+
+  protected:
+
+    /** Computes the sparse Cholesky decomposition of \a matrix */
+    template<bool DoLDLT>
+    void compute(const MatrixType& matrix)
+    {
+      analyzePattern(matrix);
+      factorize<DoLDLT>(matrix);
+    }
+
+    template<bool DoLDLT>
+    void factorize(const MatrixType& a);
+
+    /** \returns the factor L of P A P^-1 as a sparse matrix */
+    CholMatrixType factorL(bool unitDiagonal) const;
+
+    /** \returns the product of the diagonal coefficients of L */
+    Scalar diagonalProduct() const;
+
+    mutable ComputationInfo m_info;
+    bool m_factorizationIsOk;
+    bool m_analysisIsOk;
+    Index m_size;
+
+    // The supernode s holds the columns [m_superStart(s),m_superStart(s+1)) of the factor. Its dense panel stores the
+    // rows m_rowIndices[m_rowStart(s):m_rowStart(s+1)), starting with the ones of its own columns, in column major
+    // order at m_values[m_valueStart(s)].
+    VectorI m_superStart;
+    VectorI m_superParent;
+    VectorI m_firstChild;
+    VectorI m_nextSibling;
+    Matrix<Index,Dynamic,1> m_rowStart;
+    Matrix<Index,Dynamic,1> m_valueStart;
+    VectorI m_rowIndices;
+    VectorType m_values;
+    VectorType m_diag;                                       // the diagonal coefficients (LDLT mode)
+    PermutationMatrix<Dynamic,Dynamic,StorageIndex> m_P;     // the permutation
+    PermutationMatrix<Dynamic,Dynamic,StorageIndex> m_Pinv;  // the inverse permutation
+
+    RealScalar m_shiftOffset;
+    RealScalar m_shiftScale;
+};
+
+template<typename _MatrixType, int _UpLo = Lower, typename _Ordering = AMDOrdering<typename _MatrixType::StorageIndex> > class SupernodalLLT;
+template<typename _MatrixType, int _UpLo = Lower, typename _Ordering = AMDOrdering<typename _MatrixType::StorageIndex> > class SupernodalLDLT;
+
+namespace internal {
+
+template<typename _MatrixType, int _UpLo, typename _Ordering> struct traits<SupernodalLLT<_MatrixType,_UpLo,_Ordering> >
+{
+  typedef _MatrixType MatrixType;
+  typedef _Ordering OrderingType;
+  enum { UpLo = _UpLo };
+};
+
+template<typename _MatrixType, int _UpLo, typename _Ordering> struct traits<SupernodalLDLT<_MatrixType,_UpLo,_Ordering> >
+{
+  typedef _MatrixType MatrixType;
+  typedef _Ordering OrderingType;
+  enum { UpLo = _UpLo };
+};
+
+} // end namespace internal
+
+/** \ingroup SparseCholesky_Module
+  * \class SupernodalLLT
+  * \brief A supernodal direct sparse LLT Cholesky factorization
+  *
+  * This class provides a LL^T Cholesky factorization of sparse matrices that are selfadjoint and positive definite.
+  * The factorization allows for solving A.X = B where X and B can be either dense or sparse. It has the same
+  * interface as SimplicialLLT but factorizes groups of columns, the supernodes, with dense matrix kernels. See
+  * SupernodalCholeskyBase for the details.
+  *
+  * In order to reduce the fill-in, a symmetric permutation P is applied prior to the factorization
+  * such that the factorized matrix is P A P^-1.
+  *
+  * \tparam _MatrixType the type of the sparse matrix A, it must be a SparseMatrix<>
+  * \tparam _UpLo the triangular part that will be used for the computations. It can be Lower
+  *               or Upper. Default is Lower.
+  * \tparam _Ordering The ordering method to use, either AMDOrdering<> or NaturalOrdering<>. Default is AMDOrdering<>
+  *
+  * \implsparsesolverconcept
+  *
+  * \sa class SupernodalLDLT, class SimplicialLLT, class AMDOrdering, class NaturalOrdering
+  */
+template<typename _MatrixType, int _UpLo, typename _Ordering>
+class SupernodalLLT : public SupernodalCholeskyBase<SupernodalLLT<_MatrixType,_UpLo,_Ordering> >
+{
+  public:
+    typedef _MatrixType MatrixType;
+    enum { UpLo = _UpLo };
+    typedef SupernodalCholeskyBase<SupernodalLLT> Base;
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::RealScalar RealScalar;
+    typedef typename MatrixType::StorageIndex StorageIndex;
+    typedef typename Base::CholMatrixType CholMatrixType;
+
+    /** Default constructor */
+    SupernodalLLT() : Base() {}
+
+    /** Constructs and performs the LLT factorization of \a matrix */
+    explicit SupernodalLLT(const MatrixType& matrix) : Base()
+    {
+      compute(matrix);
+    }
+
+    /** \returns the lower triangular factor L as a sparse matrix. It is built from the supernodes by this call. */
+    CholMatrixType matrixL() const
+    {
+      eigen_assert(Base::m_factorizationIsOk && "Supernodal LLT not factorized");
+      return Base::factorL(false);
+    }
+
+    /** Computes the sparse Cholesky decomposition of \a matrix */
+    SupernodalLLT& compute(const MatrixType& matrix)
+    {
+      Base::template compute<false>(matrix);
+      return *this;
+    }
+
+    /** Performs a numeric decomposition of \a a
+      *
+      * The given matrix must have the same sparsity as the matrix on which the symbolic decomposition has been performed.
+      *
+      * \sa analyzePattern()
+      */
+    void factorize(const MatrixType& a)
+    {
+      Base::template factorize<false>(a);
+    }
+
+    /** \returns the determinant of the underlying matrix from the current factorization */
+    Scalar determinant() const
+    {
+      return numext::abs2(Base::diagonalProduct());
+    }
+};
+
+/** \ingroup SparseCholesky_Module
+  * \class SupernodalLDLT
+  * \brief A supernodal direct sparse LDLT Cholesky factorization without square root
+  *
+  * This class provides a LDL^T Cholesky factorization without square root of sparse matrices that are selfadjoint and
+  * positive definite. The factorization allows for solving A.X = B where X and B can be either dense or sparse. It has
+  * the same interface as SimplicialLDLT but factorizes groups of columns, the supernodes, with dense matrix kernels.
+  * See SupernodalCholeskyBase for the details.
+  *
+  * In order to reduce the fill-in, a symmetric permutation P is applied prior to the factorization
+  * such that the factorized matrix is P A P^-1.
+  *
+  * \tparam _MatrixType the type of the sparse matrix A, it must be a SparseMatrix<>
+  * \tparam _UpLo the triangular part that will be used for the computations. It can be Lower
+  *               or Upper. Default is Lower.
+  * \tparam _Ordering The ordering method to use, either AMDOrdering<> or NaturalOrdering<>. Default is AMDOrdering<>
+  *
+  * \implsparsesolverconcept
+  *
+  * \sa class SupernodalLLT, class SimplicialLDLT, class AMDOrdering, class NaturalOrdering
+  */
+template<typename _MatrixType, int _UpLo, typename _Ordering>
+class SupernodalLDLT : public SupernodalCholeskyBase<SupernodalLDLT<_MatrixType,_UpLo,_Ordering> >
+{
+  public:
+    typedef _MatrixType MatrixType;
+    enum { UpLo = _UpLo };
+    typedef SupernodalCholeskyBase<SupernodalLDLT> Base;
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::RealScalar RealScalar;
+    typedef typename MatrixType::StorageIndex StorageIndex;
+    typedef typename Base::CholMatrixType CholMatrixType;
+    typedef typename Base::VectorType VectorType;
+
+    /** Default constructor */
+    SupernodalLDLT() : Base() {}
+
+    /** Constructs and performs the LDLT factorization of \a matrix */
+    explicit SupernodalLDLT(const MatrixType& matrix) : Base()
+    {
+      compute(matrix);
+    }
+
+    /** \returns a vector expression of the diagonal D */
+    inline const VectorType vectorD() const
+    {
+      eigen_assert(Base::m_factorizationIsOk && "Supernodal LDLT not factorized");
+      return Base::m_diag;
+    }
+
+    /** \returns the unit lower triangular factor L as a sparse matrix. It is built from the supernodes by this call. */
+    CholMatrixType matrixL() const
+    {
+      eigen_assert(Base::m_factorizationIsOk && "Supernodal LDLT not factorized");
+      return Base::factorL(true);
+    }
+
+    /** Computes the sparse Cholesky decomposition of \a matrix */
+    SupernodalLDLT& compute(const MatrixType& matrix)
+    {
+      Base::template compute<true>(matrix);
+      return *this;
+    }
+
+    /** Performs a numeric decomposition of \a a
+      *
+      * The given matrix must have the same sparsity as the matrix on which the symbolic decomposition has been performed.
+      *
+      * \sa analyzePattern()
+      */
+    void factorize(const MatrixType& a)
+    {
+      Base::template factorize<true>(a);
+    }
+
+    /** \returns the determinant of the underlying matrix from the current factorization */
+    Scalar determinant() const
+    {
+      return Base::m_diag.prod();
+    }
+};
+
+template<typename Derived>
+void SupernodalCholeskyBase<Derived>::analyzePattern(const MatrixType& a)
+{
+  eigen_assert(a.rows()==a.cols());
+  const Index size = a.cols();
+  m_size = size;
+
+  // fill-reducing ordering, note that ordering methods compute the inverse permutation
+  {
+    CholMatrixType C;
+    C = a.template selfadjointView<UpLo>();
+    OrderingType ordering;
+    ordering(C, m_Pinv);
+  }
+  if(m_Pinv.size()==0)
+    m_Pinv.setIdentity(size);
+  m_P = m_Pinv.inverse();
+
+  // postorder the elimination tree, so that the supernodes and the subtrees are made of consecutive columns
+  CholMatrixType ap(size, size);
+  ap.template selfadjointView<Upper>() = a.template selfadjointView<UpLo>().twistedBy(m_P);
+  VectorI parent, post;
+  internal::supernodal_etree(ap, parent);
+  internal::supernodal_postorder(parent, post);
+  {
+    VectorI postInv(size);
+    for(Index k = 0; k < size; ++k)
+      postInv(post(k)) = StorageIndex(k);
+    for(Index i = 0; i < size; ++i)
+      m_P.indices()(i) = postInv(m_P.indices()(i));
+    m_Pinv = m_P.inverse();
+  }
+  ap.template selfadjointView<Upper>() = a.template selfadjointView<UpLo>().twistedBy(m_P);
+  internal::supernodal_etree(ap, parent);
+
+  // number of nonzeros below the diagonal of each column of L: the row k of L is the subtree of the elimination tree
+  // spanned by the nonzeros of the column k of the upper part
+  VectorI colCounts = VectorI::Zero(size), mark(size), childCounts = VectorI::Zero(size);
+  for(Index k = 0; k < size; ++k)
+  {
+    mark(k) = StorageIndex(k);
+    for(typename CholMatrixType::InnerIterator it(ap,k); it; ++it)
+    {
+      for(Index i = it.index(); i < k && mark(i) != k; i = parent(i))
+      {
+        ++colCounts(i);
+        mark(i) = StorageIndex(k);
+      }
+    }
+    if(parent(k) != -1)
+      ++childCounts(parent(k));
+  }
+
+  // fundamental supernodes: the column j extends the supernode of j-1 if it is its only child and has the same pattern
+  std::vector<StorageIndex> starts;
+  for(Index j = 0; j < size; ++j)
+    if(j==0 || parent(j-1) != j || childCounts(j) != 1 || colCounts(j-1) != colCounts(j)+1)
+      starts.push_back(StorageIndex(j));
+  starts.push_back(StorageIndex(size));
+
+  // relaxed supernodes: a supernode is merged with its parent when it immediately precedes it and the merge only adds
+  // a small fraction of explicit zeros
+  std::vector<StorageIndex> relaxedStarts;
+  std::vector<double> zeros;
+  for(size_t s = 0; s+1 < starts.size(); ++s)
+  {
+    const Index first = starts[s], last = starts[s+1]-1;
+    relaxedStarts.push_back(StorageIndex(first));
+    zeros.push_back(0);
+    while(relaxedStarts.size()>1)
+    {
+      const size_t c = relaxedStarts.size()-2;
+      const Index childFirst = relaxedStarts[c], childLast = relaxedStarts[c+1]-1;
+      const Index parentFirst = relaxedStarts[c+1];
+      if(parent(childLast) < parentFirst || parent(childLast) > last)
+        break;
+      const double childCols = double(childLast-childFirst+1), parentCols = double(last-parentFirst+1);
+      const double childRows = colCounts(childLast), parentRows = colCounts(last);
+      const double width = childCols + parentCols;
+      const double newZeros = zeros[c] + zeros[c+1] + childCols * (parentCols + parentRows - childRows);
+      const double entries = width*(width+1)/2 + width*parentRows;
+      const double ratio = newZeros / entries;
+      if(!(width <= 4 || (width <= 16 && ratio < 0.8) || (width <= 48 && ratio < 0.1) || ratio < 0.05))
+        break;
+      relaxedStarts.pop_back();
+      zeros.pop_back();
+      zeros.back() = newZeros;
+    }
+  }
+  relaxedStarts.push_back(StorageIndex(size));
+
+  const Index nbSuper = Index(relaxedStarts.size())-1;
+  m_superStart = Map<const VectorI>(&relaxedStarts[0], nbSuper+1);
+  VectorI superOf(size);
+  for(Index s = 0; s < nbSuper; ++s)
+    superOf.segment(m_superStart(s), m_superStart(s+1)-m_superStart(s)).setConstant(StorageIndex(s));
+  m_superParent.resize(nbSuper);
+  m_firstChild.setConstant(nbSuper, -1);
+  m_nextSibling.resize(nbSuper);
+  for(Index s = nbSuper-1; s >= 0; --s)
+  {
+    const StorageIndex p = parent(m_superStart(s+1)-1);
+    m_superParent(s) = p == -1 ? StorageIndex(-1) : superOf(p);
+    if(p != -1)
+    {
+      m_nextSibling(s) = m_firstChild(superOf(p));
+      m_firstChild(superOf(p)) = StorageIndex(s);
+    }
+  }
+
+  // the rows of a supernode are its own columns, followed by the rows of its columns in the lower part of the matrix
+  // and of the updates of its children
+  CholMatrixType apLower(size, size);
+  apLower.template selfadjointView<Lower>() = a.template selfadjointView<UpLo>().twistedBy(m_P);
+  m_rowStart.resize(nbSuper+1);
+  m_valueStart.resize(nbSuper+1);
+  m_rowStart(0) = 0;
+  m_valueStart(0) = 0;
+  std::vector<StorageIndex> rowIndices;
+  mark.setConstant(-1);
+  for(Index s = 0; s < nbSuper; ++s)
+  {
+    const Index first = m_superStart(s), last = m_superStart(s+1)-1;
+    for(Index j = first; j <= last; ++j)
+      rowIndices.push_back(StorageIndex(j));
+    const size_t belowStart = rowIndices.size();
+    for(Index j = first; j <= last; ++j)
+    {
+      for(typename CholMatrixType::InnerIterator it(apLower,j); it; ++it)
+      {
+        const Index i = it.index();
+        if(i > last && mark(i) != s)
+        {
+          mark(i) = StorageIndex(s);
+          rowIndices.push_back(StorageIndex(i));
+        }
+      }
+    }
+    for(Index c = m_firstChild(s); c != -1; c = m_nextSibling(c))
+    {
+      for(Index k = m_rowStart(c) + m_superStart(c+1)-m_superStart(c); k < m_rowStart(c+1); ++k)
+      {
+        const Index i = rowIndices[k];
+        if(i > last && mark(i) != s)
+        {
+          mark(i) = StorageIndex(s);
+          rowIndices.push_back(StorageIndex(i));
+        }
+      }
+    }
+    std::sort(rowIndices.begin()+belowStart, rowIndices.end());
+    m_rowStart(s+1) = Index(rowIndices.size());
+    m_valueStart(s+1) = m_valueStart(s) + (m_rowStart(s+1)-m_rowStart(s)) * (last-first+1);
+  }
+  m_rowIndices = rowIndices.empty() ? VectorI() : VectorI(Map<const VectorI>(&rowIndices[0], Index(rowIndices.size())));
+
+  m_isInitialized     = true;
+  m_info              = Success;
+  m_analysisIsOk      = true;
+  m_factorizationIsOk = false;
+}
+
+template<typename Derived>
+template<bool DoLDLT>
+bool SupernodalCholeskyBase<Derived>::factorizeSupernode(Index s, const CholMatrixType& ap, std::vector<DenseMatrix>& updates, VectorI& map)
+{
+  const Index first = m_superStart(s);
+  const Index ncols = m_superStart(s+1) - first;
+  const Index nrows = m_rowStart(s+1) - m_rowStart(s);
+  const Index nbelow = nrows - ncols;
+  const StorageIndex* rows = m_rowIndices.data() + m_rowStart(s);
+  Map<DenseMatrix> panel(m_values.data() + m_valueStart(s), nrows, ncols);
+  DenseMatrix& update = updates[s];
+
+  for(Index k = 0; k < nrows; ++k)
+    map(rows[k]) = StorageIndex(k);
+
+  // assemble the columns of the matrix
+  panel.setZero();
+  for(Index j = 0; j < ncols; ++j)
+  {
+    for(typename CholMatrixType::InnerIterator it(ap,first+j); it; ++it)
+      panel(map(it.index()), j) += it.value();
+    panel(j,j) = numext::real(panel(j,j)) * m_shiftScale + m_shiftOffset;
+  }
+
+  // add the updates of the children (extend-add), the rows of a child are a subset of the rows of its parent
+  update.setZero(nbelow, nbelow);
+  for(Index c = m_firstChild(s); c != -1; c = m_nextSibling(c))
+  {
+    DenseMatrix& childUpdate = updates[c];
+    const StorageIndex* childRows = m_rowIndices.data() + m_rowStart(c) + (m_superStart(c+1) - m_superStart(c));
+    const Index n = childUpdate.rows();
+    for(Index cj = 0; cj < n; ++cj)
+    {
+      const Index j = map(childRows[cj]);
+      if(j < ncols)
+      {
+        for(Index ci = cj; ci < n; ++ci)
+          panel(map(childRows[ci]), j) += childUpdate(ci,cj);
+      }
+      else
+      {
+        for(Index ci = cj; ci < n; ++ci)
+          update(map(childRows[ci])-ncols, j-ncols) += childUpdate(ci,cj);
+      }
+    }
+    childUpdate.resize(0,0);
+  }
+
+  // factorize the panel and compute the update of the ancestors
+  Block<Map<DenseMatrix> > L11(panel, 0, 0, ncols, ncols);
+  Block<Map<DenseMatrix> > L21(panel, ncols, 0, nbelow, ncols);
+  if(DoLDLT)
+  {
+    typename VectorType::SegmentReturnType diag = m_diag.segment(first, ncols);
+    if(internal::supernodal_ldlt<Scalar>::blocked(L11, diag) >= 0)
+      return false;
+    if(nbelow>0)
+      internal::supernodal_ldlt<Scalar>::update(L11, L21, diag, update);
+  }
+  else
+  {
+    if(internal::llt_inplace<Scalar,Lower>::blocked(L11) >= 0)
+      return false;
+    if(nbelow>0)
+    {
+      L11.adjoint().template triangularView<Upper>().template solveInPlace<OnTheRight>(L21);
+      update.template selfadjointView<Lower>().rankUpdate(L21, RealScalar(-1));
+    }
+  }
+  return true;
+}
+
+template<typename Derived>
+template<bool DoLDLT>
+void SupernodalCholeskyBase<Derived>::factorize(const MatrixType& a)
+{
+  eigen_assert(m_analysisIsOk && "You must first call analyzePattern()");
+  eigen_assert(a.rows()==a.cols() && a.rows()==m_size);
+
+  CholMatrixType ap(m_size, m_size);
+  ap.template selfadjointView<Lower>() = a.template selfadjointView<UpLo>().twistedBy(m_P);
+
+  const Index nbSuper = m_superStart.size()-1;
+  m_values.resize(m_valueStart(nbSuper));
+  m_diag.resize(DoLDLT ? m_size : 0);
+  std::vector<DenseMatrix> updates(nbSuper);
+  VectorI map(m_size);
+  bool ok = true;
+
+  // flop estimates of the supernodes and of their subtrees
+  Matrix<double,Dynamic,1> work(nbSuper);
+  for(Index s = 0; s < nbSuper; ++s)
+  {
+    const double ncols = double(m_superStart(s+1)-m_superStart(s)), nrows = double(m_rowStart(s+1)-m_rowStart(s));
+    work(s) = ncols * nrows * nrows;
+  }
+  for(Index s = 0; s < nbSuper; ++s)
+    if(m_superParent(s) != -1)
+      work(m_superParent(s)) += work(s);
+  const double totalWork = work.size()>0 ? work.sum() : 0.;
+
+  Index threads = 1;
+#if defined(EIGEN_HAS_OPENMP) || defined(EIGEN_GEMM_THREADPOOL)
+  // Below this amount of work the threads cost more than they save.
+  if(totalWork > 1e7)
+  {
+    Eigen::initParallel();
+    threads = Eigen::nbThreads();
+  }
+#endif
+
+  // whether the supernode is factorized with a whole subtree by a thread
+  std::vector<unsigned char> inSubtree(nbSuper, 0);
+  if(threads>1)
+  {
+    // cut the tree into independent subtrees of at most 1/(4*threads) of the work,
+    // the subtree of s is made of the supernodes [firstDescendant(s),s]
+    VectorI firstDescendant(nbSuper);
+    for(Index s = 0; s < nbSuper; ++s)
+    {
+      firstDescendant(s) = StorageIndex(s);
+      if(m_firstChild(s) != -1)
+        firstDescendant(s) = firstDescendant(m_firstChild(s));
+    }
+    const double maxWork = totalWork / double(4*threads);
+    std::vector<std::pair<double,StorageIndex> > subtrees;
+    std::vector<StorageIndex> stack;
+    for(Index s = 0; s < nbSuper; ++s)
+      if(m_superParent(s) == -1)
+        stack.push_back(StorageIndex(s));
+    while(!stack.empty())
+    {
+      const StorageIndex s = stack.back();
+      stack.pop_back();
+      if(work(s) <= maxWork)
+        subtrees.push_back(std::make_pair(work(s), s));
+      else
+        for(Index c = m_firstChild(s); c != -1; c = m_nextSibling(c))
+          stack.push_back(StorageIndex(c));
+    }
+    // the largest subtrees first
+    std::sort(subtrees.begin(), subtrees.end());
+    std::reverse(subtrees.begin(), subtrees.end());
+    const Index nbSubtrees = Index(subtrees.size());
+    VectorI subtreeFirst(nbSubtrees), subtreeLast(nbSubtrees);
+    for(Index t = 0; t < nbSubtrees; ++t)
+    {
+      subtreeLast(t) = subtrees[t].second;
+      subtreeFirst(t) = firstDescendant(subtrees[t].second);
+      std::fill(inSubtree.begin()+subtreeFirst(t), inSubtree.begin()+subtreeLast(t)+1, 1);
+    }
+    std::vector<unsigned char> failed(nbSubtrees, 0);
+    internal::parallelize_ranges(nbSubtrees, Index(1), threads,
+        internal::supernodal_subtrees_task<SupernodalCholeskyBase,DoLDLT>(*this, ap, updates, subtreeFirst, subtreeLast, failed));
+    ok = std::find(failed.begin(), failed.end(), 1) == failed.end();
+  }
+
+  // the remaining supernodes, all their descendants are factorized
+  for(Index s = 0; s < nbSuper && ok; ++s)
+    if(!inSubtree[s])
+      ok = factorizeSupernode<DoLDLT>(s, ap, updates, map);
+
+  m_info = ok ? Success : NumericalIssue;
+  m_factorizationIsOk = true;
+}
+
+template<typename Derived>
+template<typename Rhs,typename Dest>
+void SupernodalCholeskyBase<Derived>::_solve_impl(const MatrixBase<Rhs> &b, MatrixBase<Dest> &dest) const
+{
+  eigen_assert(m_factorizationIsOk && "The decomposition is not in a valid state for solving, you must first call either compute() or analyzePattern()/factorize()");
+  eigen_assert(m_size==b.rows());
+
+  if(m_info!=Success)
+    return;
+
+  const bool unitDiagonal = m_diag.size()>0;
+  const Index nbSuper = m_superStart.size()-1;
+  DenseMatrix x = m_P * b;
+  DenseMatrix tmp;
+
+  // L y = P b
+  for(Index s = 0; s < nbSuper; ++s)
+  {
+    const Index first = m_superStart(s), ncols = m_superStart(s+1)-first;
+    const Index nbelow = m_rowStart(s+1) - m_rowStart(s) - ncols;
+    const StorageIndex* rows = m_rowIndices.data() + m_rowStart(s) + ncols;
+    Map<const DenseMatrix> panel(m_values.data() + m_valueStart(s), ncols+nbelow, ncols);
+    Block<DenseMatrix> xs(x, first, 0, ncols, x.cols());
+    if(unitDiagonal)
+      panel.topRows(ncols).template triangularView<UnitLower>().solveInPlace(xs);
+    else
+      panel.topRows(ncols).template triangularView<Lower>().solveInPlace(xs);
+    if(nbelow>0)
+    {
+      tmp.noalias() = panel.bottomRows(nbelow) * xs;
+      for(Index k = 0; k < nbelow; ++k)
+        x.row(rows[k]) -= tmp.row(k);
+    }
+  }
+
+  if(unitDiagonal)
+    x = m_diag.asDiagonal().inverse() * x;
+
+  // L^* z = y
+  for(Index s = nbSuper-1; s >= 0; --s)
+  {
+    const Index first = m_superStart(s), ncols = m_superStart(s+1)-first;
+    const Index nbelow = m_rowStart(s+1) - m_rowStart(s) - ncols;
+    const StorageIndex* rows = m_rowIndices.data() + m_rowStart(s) + ncols;
+    Map<const DenseMatrix> panel(m_values.data() + m_valueStart(s), ncols+nbelow, ncols);
+    Block<DenseMatrix> xs(x, first, 0, ncols, x.cols());
+    if(nbelow>0)
+    {
+      tmp.resize(nbelow, x.cols());
+      for(Index k = 0; k < nbelow; ++k)
+        tmp.row(k) = x.row(rows[k]);
+      xs.noalias() -= panel.bottomRows(nbelow).adjoint() * tmp;
+    }
+    if(unitDiagonal)
+      panel.topRows(ncols).template triangularView<UnitLower>().adjoint().solveInPlace(xs);
+    else
+      panel.topRows(ncols).template triangularView<Lower>().adjoint().solveInPlace(xs);
+  }
+
+  dest = m_Pinv * x;
+}
+
+template<typename Derived>
+typename SupernodalCholeskyBase<Derived>::CholMatrixType SupernodalCholeskyBase<Derived>::factorL(bool unitDiagonal) const
+{
+  const Index nbSuper = m_superStart.size()-1;
+  CholMatrixType L(m_size, m_size);
+  Matrix<Index,Dynamic,1> sizes(m_size);
+  for(Index s = 0; s < nbSuper; ++s)
+    for(Index j = m_superStart(s); j < m_superStart(s+1); ++j)
+      sizes(j) = m_rowStart(s+1) - m_rowStart(s) - (j - m_superStart(s));
+  L.reserve(sizes);
+  for(Index s = 0; s < nbSuper; ++s)
+  {
+    const Index first = m_superStart(s), ncols = m_superStart(s+1)-first;
+    const Index nrows = m_rowStart(s+1) - m_rowStart(s);
+    const StorageIndex* rows = m_rowIndices.data() + m_rowStart(s);
+    Map<const DenseMatrix> panel(m_values.data() + m_valueStart(s), nrows, ncols);
+    for(Index j = 0; j < ncols; ++j)
+    {
+      L.insert(first+j, first+j) = unitDiagonal ? Scalar(1) : panel(j,j);
+      for(Index k = j+1; k < nrows; ++k)
+        L.insert(rows[k], first+j) = panel(k,j);
+    }
+  }
+  L.makeCompressed();
+  return L;
+}
+
+template<typename Derived>
+typename SupernodalCholeskyBase<Derived>::Scalar SupernodalCholeskyBase<Derived>::diagonalProduct() const
+{
+  Scalar prod(1);
+  for(Index s = 0; s+1 < m_superStart.size(); ++s)
+  {
+    const Index ncols = m_superStart(s+1)-m_superStart(s);
+    Map<const DenseMatrix> panel(m_values.data() + m_valueStart(s), m_rowStart(s+1) - m_rowStart(s), ncols);
+    prod *= panel.topRows(ncols).diagonal().prod();
+  }
+  return prod;
+}
+
+} // end namespace Eigen
+
+#endif // EIGEN_SUPERNODAL_CHOLESKY_H
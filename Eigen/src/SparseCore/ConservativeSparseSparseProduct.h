@@ -14,6 +14,211 @@ namespace Eigen {
 
 namespace internal {
 
+// Two-phase products.
+//
+// The symbolic phase counts the nonzeros of every outer vector of the result, which gives the outer index, and the
+// numeric phase computes the inner indices and the values of every outer vector at its final position. The outer
+// vectors of both phases are independent, so they are distributed among the threads, each thread using its own
+// dense accumulator of the size of an outer vector. Like in conservative_sparse_sparse_product_impl, the products are
+// computed outer vector of rhs by outer vector of rhs, the storage order being faked by the caller.
+
+// Returns the number of threads to compute a product involving about work nonzeros.
+inline Index sparse_sparse_product_threads(Index work)
+{
+#if defined(EIGEN_HAS_OPENMP) || defined(EIGEN_GEMM_THREADPOOL)
+  // Below this size the threads cost more than they save.
+  if(work > 20000)
+  {
+    Eigen::initParallel();
+    return Eigen::nbThreads();
+  }
+#else
+  EIGEN_UNUSED_VARIABLE(work);
+#endif
+  return 1;
+}
+
+// Counts the nonzeros of the outer vectors [begin,end) of lhs*rhs into nnz.
+template<typename Lhs, typename Rhs, typename StorageIndex>
+struct sparse_sparse_product_count
+{
+  sparse_sparse_product_count(const evaluator<Lhs>& lhsEval, const evaluator<Rhs>& rhsEval, Index innerSize, StorageIndex* nnz)
+    : m_lhsEval(lhsEval), m_rhsEval(rhsEval), m_innerSize(innerSize), m_nnz(nnz)
+  {}
+
+  void operator()(Index begin, Index end) const
+  {
+    // mask(i)==j if the inner index i already appeared in the outer vector j
+    Matrix<Index,Dynamic,1> mask = Matrix<Index,Dynamic,1>::Constant(m_innerSize, -1);
+    for(Index j=begin; j<end; ++j)
+    {
+      StorageIndex nnz = 0;
+      for(typename evaluator<Rhs>::InnerIterator rhsIt(m_rhsEval, j); rhsIt; ++rhsIt)
+      {
+        for(typename evaluator<Lhs>::InnerIterator lhsIt(m_lhsEval, rhsIt.index()); lhsIt; ++lhsIt)
+        {
+          const Index i = lhsIt.index();
+          if(mask(i)!=j)
+          {
+            mask(i) = j;
+            ++nnz;
+          }
+        }
+      }
+      m_nnz[j] = nnz;
+    }
+  }
+
+  const evaluator<Lhs>& m_lhsEval;
+  const evaluator<Rhs>& m_rhsEval;
+  Index m_innerSize;
+  StorageIndex* m_nnz;
+};
+
+// Computes the outer vectors [begin,end) of lhs*rhs into res, whose outer index has been set by the symbolic phase.
+// The inner indices are sorted if sorted is true, otherwise they are in the order of their first appearance.
+template<typename Lhs, typename Rhs, typename ResultType>
+struct sparse_sparse_product_fill
+{
+  typedef typename ResultType::Scalar ResScalar;
+  typedef typename ResultType::StorageIndex StorageIndex;
+
+  sparse_sparse_product_fill(const evaluator<Lhs>& lhsEval, const evaluator<Rhs>& rhsEval, ResultType& res, bool sorted)
+    : m_lhsEval(lhsEval), m_rhsEval(rhsEval), m_res(res), m_sorted(sorted)
+  {}
+
+  void operator()(Index begin, Index end) const
+  {
+    const Index innerSize = m_res.innerSize();
+    Matrix<Index,Dynamic,1> mask = Matrix<Index,Dynamic,1>::Constant(innerSize, -1);
+    Matrix<ResScalar,Dynamic,1> values(innerSize);
+    const StorageIndex* outerIndex = m_res.outerIndexPtr();
+    StorageIndex* innerIndices = m_res.innerIndexPtr();
+    ResScalar* resValues = m_res.valuePtr();
+    for(Index j=begin; j<end; ++j)
+    {
+      const Index start = outerIndex[j];
+      Index p = start;
+      for(typename evaluator<Rhs>::InnerIterator rhsIt(m_rhsEval, j); rhsIt; ++rhsIt)
+      {
+        const typename remove_all<Rhs>::type::Scalar y = rhsIt.value();
+        for(typename evaluator<Lhs>::InnerIterator lhsIt(m_lhsEval, rhsIt.index()); lhsIt; ++lhsIt)
+        {
+          const Index i = lhsIt.index();
+          if(mask(i)!=j)
+          {
+            mask(i) = j;
+            values(i) = lhsIt.value() * y;
+            innerIndices[p++] = convert_index<StorageIndex>(i);
+          }
+          else
+            values(i) += lhsIt.value() * y;
+        }
+      }
+      eigen_internal_assert(p==outerIndex[j+1]);
+      if(m_sorted)
+        std::sort(innerIndices+start, innerIndices+p);
+      for(Index k=start; k<p; ++k)
+        resValues[k] = values(innerIndices[k]);
+    }
+  }
+
+  const evaluator<Lhs>& m_lhsEval;
+  const evaluator<Rhs>& m_rhsEval;
+  ResultType& m_res;
+  bool m_sorted;
+};
+
+// Recomputes the values of the outer vectors [begin,end) of lhs*rhs in res, which already has the pattern of the product.
+// The outer vectors j whose products have entries outside of this pattern are flagged in mismatches(j), these entries
+// are skipped.
+template<typename Lhs, typename Rhs, typename ResultType>
+struct sparse_sparse_product_refill
+{
+  typedef typename ResultType::Scalar ResScalar;
+  typedef typename ResultType::StorageIndex StorageIndex;
+
+  sparse_sparse_product_refill(const evaluator<Lhs>& lhsEval, const evaluator<Rhs>& rhsEval, ResultType& res,
+                               Matrix<bool,Dynamic,1>& mismatches)
+    : m_lhsEval(lhsEval), m_rhsEval(rhsEval), m_res(res), m_mismatches(mismatches)
+  {}
+
+  void operator()(Index begin, Index end) const
+  {
+    // positions(i) is the position of the inner index i in the current outer vector of res, or -1
+    Matrix<Index,Dynamic,1> positions = Matrix<Index,Dynamic,1>::Constant(m_res.innerSize(), -1);
+    const StorageIndex* outerIndex = m_res.outerIndexPtr();
+    const StorageIndex* innerIndices = m_res.innerIndexPtr();
+    ResScalar* values = m_res.valuePtr();
+    for(Index j=begin; j<end; ++j)
+    {
+      const Index start = outerIndex[j];
+      const Index stop = outerIndex[j+1];
+      for(Index k=start; k<stop; ++k)
+      {
+        positions(innerIndices[k]) = k;
+        values[k] = ResScalar(0);
+      }
+      bool mismatch = false;
+      for(typename evaluator<Rhs>::InnerIterator rhsIt(m_rhsEval, j); rhsIt; ++rhsIt)
+      {
+        const typename remove_all<Rhs>::type::Scalar y = rhsIt.value();
+        for(typename evaluator<Lhs>::InnerIterator lhsIt(m_lhsEval, rhsIt.index()); lhsIt; ++lhsIt)
+        {
+          const Index k = positions(lhsIt.index());
+          if(k<0)
+            mismatch = true;
+          else
+            values[k] += lhsIt.value() * y;
+        }
+      }
+      m_mismatches(j) = mismatch;
+      for(Index k=start; k<stop; ++k)
+        positions(innerIndices[k]) = -1;
+    }
+  }
+
+  const evaluator<Lhs>& m_lhsEval;
+  const evaluator<Rhs>& m_rhsEval;
+  ResultType& m_res;
+  Matrix<bool,Dynamic,1>& m_mismatches;
+};
+
+// Computes lhs*rhs into the compressed matrix res with the given number of threads.
+template<typename Lhs, typename Rhs, typename ResultType>
+void sparse_sparse_product_two_phases(const Lhs& lhs, const Rhs& rhs, ResultType& res, bool sortedInsertion, Index threads)
+{
+  typedef typename ResultType::StorageIndex StorageIndex;
+  const Index cols = rhs.outerSize();
+  eigen_assert(lhs.outerSize() == rhs.innerSize());
+
+  evaluator<Lhs> lhsEval(lhs);
+  evaluator<Rhs> rhsEval(rhs);
+
+  res.resize(res.rows(), res.cols());
+  StorageIndex* outerIndex = res.outerIndexPtr();
+  const Index chunk = numext::div_ceil(cols, 4*threads);
+  parallelize_ranges(cols, chunk, threads, sparse_sparse_product_count<Lhs,Rhs,StorageIndex>(lhsEval, rhsEval, lhs.innerSize(), outerIndex+1));
+  for(Index j=0; j<cols; ++j)
+    outerIndex[j+1] += outerIndex[j];
+  res.resizeNonZeros(outerIndex[cols]);
+  parallelize_ranges(cols, chunk, threads, sparse_sparse_product_fill<Lhs,Rhs,ResultType>(lhsEval, rhsEval, res, sortedInsertion));
+}
+
+template<typename Lhs, typename Rhs, typename Scalar, int Options, typename StorageIndex>
+bool sparse_sparse_product_in_parallel(const Lhs& lhs, const Rhs& rhs, SparseMatrix<Scalar,Options,StorageIndex>& res, bool sortedInsertion, Index threads)
+{
+  sparse_sparse_product_two_phases(lhs, rhs, res, sortedInsertion, threads);
+  return true;
+}
+
+// other destinations, e.g., sparse vectors, are filled by a single thread
+template<typename Lhs, typename Rhs, typename ResultType>
+bool sparse_sparse_product_in_parallel(const Lhs&, const Rhs&, ResultType&, bool, Index)
+{
+  return false;
+}
+
 template<typename Lhs, typename Rhs, typename ResultType>
 static void conservative_sparse_sparse_product_impl(const Lhs& lhs, const Rhs& rhs, ResultType& res, bool sortedInsertion = false)
 {
@@ -26,12 +231,6 @@ static void conservative_sparse_sparse_product_impl(const Lhs& lhs, const Rhs& r
   Index cols = rhs.outerSize();
   eigen_assert(lhs.outerSize() == rhs.innerSize());
   
-  ei_declare_aligned_stack_constructed_variable(bool,   mask,     rows, 0);
-  ei_declare_aligned_stack_constructed_variable(ResScalar, values,   rows, 0);
-  ei_declare_aligned_stack_constructed_variable(Index,  indices,  rows, 0);
-  
-  std::memset(mask,0,sizeof(bool)*rows);
-
   evaluator<Lhs> lhsEval(lhs);
   evaluator<Rhs> rhsEval(rhs);
   
@@ -43,6 +242,17 @@ static void conservative_sparse_sparse_product_impl(const Lhs& lhs, const Rhs& r
   // Therefore, we have nnz(lhs*rhs) = nnz(lhs) + nnz(rhs)
   Index estimated_nnz_prod = lhsEval.nonZerosEstimate() + rhsEval.nonZerosEstimate();
 
+  // large products are computed by several threads, in a symbolic and a numeric pass
+  const Index threads = sparse_sparse_product_threads(estimated_nnz_prod);
+  if(threads>1 && sparse_sparse_product_in_parallel(lhs, rhs, res, sortedInsertion, threads))
+    return;
+
+  ei_declare_aligned_stack_constructed_variable(bool,   mask,     rows, 0);
+  ei_declare_aligned_stack_constructed_variable(ResScalar, values,   rows, 0);
+  ei_declare_aligned_stack_constructed_variable(Index,  indices,  rows, 0);
+  
+  std::memset(mask,0,sizeof(bool)*rows);
+
   res.setZero();
   res.reserve(Index(estimated_nnz_prod));
   // we compute each column of the result, one after the other
@@ -17,6 +17,280 @@ namespace internal {
 template <> struct product_promote_storage_type<Sparse,Dense, OuterProduct> { typedef Sparse ret; };
 template <> struct product_promote_storage_type<Dense,Sparse, OuterProduct> { typedef Sparse ret; };
 
+// Products with several right-hand side columns.
+//
+// Rather than traversing the sparse matrix once per column of the rhs, every nonzero is multiplied by
+// contiguous packets of a row-major view of the rhs, which is copied only if the rhs is not already stored
+// this way or, for row-major operands, if its rows have to be padded to full packets.
+// Row-major operands accumulate tiles of TileSize columns of a row of the result in registers and are
+// split by rows among the threads; column-major ones scatter whole rows of the result and are split by
+// blocks of columns.
+
+template<typename Scalar>
+struct sparse_dense_tile_traits
+{
+  typedef typename packet_traits<Scalar>::type Packet;
+  enum {
+    PacketSize = unpacket_traits<Packet>::size,
+    TileSize = 4*PacketSize
+  };
+};
+
+// The number of columns of the rhs must be a multiple of PacketSize, the extra columns are ignored.
+template<typename LhsEval, typename Rhs, typename Res>
+struct sparse_rowmajor_time_dense_tiles_task
+{
+  typedef typename Res::Scalar Scalar;
+  typedef typename LhsEval::InnerIterator LhsInnerIterator;
+  typedef sparse_dense_tile_traits<Scalar> Tile;
+  typedef typename Tile::Packet Packet;
+  enum { PacketSize = Tile::PacketSize, TileSize = Tile::TileSize };
+
+  sparse_rowmajor_time_dense_tiles_task(const LhsEval& lhsEval, const Rhs& rhs, Res& res, const Scalar& alpha)
+    : m_lhsEval(lhsEval), m_rhs(rhs), m_res(res), m_alpha(alpha)
+  {}
+
+  void operator()(Index begin, Index end) const
+  {
+    const Index cols = m_res.cols();
+    const Index fullTiles = cols/TileSize;
+    const Index c = fullTiles*TileSize;
+    for(Index i=begin; i<end; ++i)
+    {
+      for(Index t=0; t<fullTiles; ++t)
+        processTile<4>(i, t*TileSize, TileSize);
+      // the remaining columns, narrower than a tile
+      switch(numext::div_ceil(cols-c, Index(PacketSize)))
+      {
+        case 0: break;
+        case 1: processTile<1>(i, c, cols-c); break;
+        case 2: processTile<2>(i, c, cols-c); break;
+        case 3: processTile<3>(i, c, cols-c); break;
+        default: processTile<4>(i, c, cols-c); break;
+      }
+    }
+  }
+
+  // res(i,c:c+width) += alpha * lhs.row(i) * rhs(:,c:c+width), with width <= N*PacketSize
+  template<int N>
+  void processTile(Index i, Index c, Index width) const
+  {
+    const Index stride = m_rhs.outerStride();
+    const Scalar* rhs = m_rhs.data() + c;
+    Packet acc[N];
+    for(int k=0; k<N; ++k)
+      acc[k] = pset1<Packet>(Scalar(0));
+    for(LhsInnerIterator it(m_lhsEval,i); it ;++it)
+    {
+      const Scalar* r = rhs + it.index()*stride;
+      const Packet v = pset1<Packet>(it.value());
+      for(int k=0; k<N; ++k)
+        acc[k] = pmadd(v, ploadu<Packet>(r+k*PacketSize), acc[k]);
+    }
+    EIGEN_ALIGN_MAX Scalar tile[N*PacketSize];
+    for(int k=0; k<N; ++k)
+      pstore(tile+k*PacketSize, acc[k]);
+    for(Index k=0; k<width; ++k)
+      m_res.coeffRef(i,c+k) += m_alpha * tile[k];
+  }
+
+  const LhsEval& m_lhsEval;
+  const Rhs& m_rhs;
+  Res& m_res;
+  Scalar m_alpha;
+};
+
+// Destination of the column-major kernel: the result itself if its rows are contiguous,
+// or a row-major buffer added to the result once complete.
+template<typename Res, bool Direct = (int(traits<Res>::Flags)&RowMajorBit) && (int(traits<Res>::Flags)&DirectAccessBit)
+                                     && int(Res::InnerStrideAtCompileTime)==1>
+struct sparse_dense_tiles_output
+{
+  typedef typename Res::Scalar Scalar;
+  sparse_dense_tiles_output(Res& res, Index begin, Index cols)
+    : m_res(res), m_begin(begin), m_buffer(Matrix<Scalar,Dynamic,Dynamic,RowMajor>::Zero(res.rows(), cols))
+  {}
+  // the buffer should stay in cache
+  static Index maxCols(Index rows) { return Index(l2CacheSize()/(rows*sizeof(Scalar))); }
+  Scalar* data() { return m_buffer.data(); }
+  Index stride() const { return m_buffer.cols(); }
+  void commit() { m_res.middleCols(m_begin, m_buffer.cols()) += m_buffer; }
+
+  Res& m_res;
+  Index m_begin;
+  Matrix<Scalar,Dynamic,Dynamic,RowMajor> m_buffer;
+};
+
+template<typename Res>
+struct sparse_dense_tiles_output<Res,true>
+{
+  typedef typename Res::Scalar Scalar;
+  sparse_dense_tiles_output(Res& res, Index begin, Index)
+    : m_data(&res.coeffRef(0,begin)), m_stride(res.outerStride())
+  {}
+  static Index maxCols(Index) { return NumTraits<Index>::highest(); }
+  Scalar* data() { return m_data; }
+  Index stride() const { return m_stride; }
+  void commit() {}
+
+  Scalar* m_data;
+  Index m_stride;
+};
+
+template<typename LhsEval, typename Rhs, typename Res>
+struct sparse_colmajor_time_dense_tiles_task
+{
+  typedef typename Res::Scalar Scalar;
+  typedef typename LhsEval::InnerIterator LhsInnerIterator;
+  typedef sparse_dense_tile_traits<Scalar> Tile;
+  typedef typename Tile::Packet Packet;
+  enum { PacketSize = Tile::PacketSize, TileSize = Tile::TileSize };
+
+  sparse_colmajor_time_dense_tiles_task(const LhsEval& lhsEval, Index outerSize, const Rhs& rhs, Res& res,
+                                        const Scalar& alpha)
+    : m_lhsEval(lhsEval), m_outerSize(outerSize), m_rhs(rhs), m_res(res), m_alpha(alpha)
+  {}
+
+  void operator()(Index begin, Index end) const
+  {
+    Index blockCols = sparse_dense_tiles_output<Res>::maxCols(m_res.rows());
+    blockCols -= blockCols%PacketSize;
+    while(begin<end)
+    {
+      const Index blockEnd = end-begin>blockCols ? begin+blockCols : end;
+      processBlock(begin, blockEnd);
+      begin = blockEnd;
+    }
+  }
+
+  // Every nonzero updates the columns [begin,end) of one row of the result,
+  // so the matrix is traversed once per block of columns.
+  void processBlock(Index begin, Index end) const
+  {
+    const Index width = end-begin;
+    const Index rhsStride = m_rhs.outerStride();
+    const Scalar* rhs = m_rhs.data() + begin;
+    sparse_dense_tiles_output<Res> output(m_res, begin, width);
+    Scalar* out = output.data();
+    const Index outStride = output.stride();
+    for(Index j=0; j<m_outerSize; ++j)
+    {
+      const Scalar* r = rhs + j*rhsStride;
+      for(LhsInnerIterator it(m_lhsEval,j); it ;++it)
+      {
+        const Scalar s = m_alpha * it.value();
+        const Packet v = pset1<Packet>(s);
+        Scalar* o = out + it.index()*outStride;
+        Index c = 0;
+        for(; c+TileSize<=width; c+=TileSize)
+        {
+          pstoreu(o+c, pmadd(v, ploadu<Packet>(r+c), ploadu<Packet>(o+c)));
+          pstoreu(o+c+PacketSize, pmadd(v, ploadu<Packet>(r+c+PacketSize), ploadu<Packet>(o+c+PacketSize)));
+          pstoreu(o+c+2*PacketSize, pmadd(v, ploadu<Packet>(r+c+2*PacketSize), ploadu<Packet>(o+c+2*PacketSize)));
+          pstoreu(o+c+3*PacketSize, pmadd(v, ploadu<Packet>(r+c+3*PacketSize), ploadu<Packet>(o+c+3*PacketSize)));
+        }
+        for(; c+PacketSize<=width; c+=PacketSize)
+          pstoreu(o+c, pmadd(v, ploadu<Packet>(r+c), ploadu<Packet>(o+c)));
+        for(; c<width; ++c)
+          o[c] += s * r[c];
+      }
+    }
+    output.commit();
+  }
+
+  const LhsEval& m_lhsEval;
+  Index m_outerSize;
+  const Rhs& m_rhs;
+  Res& m_res;
+  Scalar m_alpha;
+};
+
+template<typename SparseLhsType, typename DenseRhsType, typename DenseResType, typename AlphaType,
+         bool Enable = is_same<typename remove_all<SparseLhsType>::type::Scalar,
+                               typename remove_all<DenseResType>::type::Scalar>::value
+                    && is_same<typename remove_all<DenseRhsType>::type::Scalar,
+                               typename remove_all<DenseResType>::type::Scalar>::value
+                    && is_same<AlphaType, typename remove_all<DenseResType>::type::Scalar>::value
+                    && remove_all<DenseRhsType>::type::ColsAtCompileTime!=1>
+struct sparse_time_dense_tiled_product
+{
+  // Returns false if the product has to be evaluated by the generic kernels.
+  static bool run(const SparseLhsType&, const DenseRhsType&, DenseResType&, const AlphaType&) { return false; }
+};
+
+template<typename SparseLhsType, typename DenseRhsType, typename DenseResType, typename AlphaType>
+struct sparse_time_dense_tiled_product<SparseLhsType,DenseRhsType,DenseResType,AlphaType,true>
+{
+  typedef typename remove_all<SparseLhsType>::type Lhs;
+  typedef typename remove_all<DenseRhsType>::type Rhs;
+  typedef typename remove_all<DenseResType>::type Res;
+  typedef typename Res::Scalar Scalar;
+  typedef evaluator<Lhs> LhsEval;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowMajorMatrix;
+  // A column-major rhs is evaluated into a row-major temporary by this Ref: the kernels load packets
+  // along the rows of the rhs, which would be gathers otherwise. The copy costs one pass over the rhs,
+  // whereas the product reads every row of it once per nonzero of the matching column of the lhs.
+  typedef Ref<const RowMajorMatrix, 0, OuterStride<> > RhsRef;
+  enum {
+    PacketSize = sparse_dense_tile_traits<Scalar>::PacketSize,
+    TileSize = sparse_dense_tile_traits<Scalar>::TileSize,
+    RhsIsRowMajor = (int(traits<Rhs>::Flags)&RowMajorBit) && (int(traits<Rhs>::Flags)&DirectAccessBit)
+                 && int(Rhs::InnerStrideAtCompileTime)==1
+  };
+
+  static bool run(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const Scalar& alpha)
+  {
+    const Index cols = rhs.cols();
+    // a single column is better handled by the matrix-vector kernels, and so are the column-major
+    // products for which even a few columns of the result do not fit in cache
+    if(cols<2 || res.rows()==0)
+      return cols>=2;
+    if(!Lhs::IsRowMajor && sparse_dense_tiles_output<DenseResType>::maxCols(res.rows()) < (std::max)(int(PacketSize),4))
+      return false;
+
+    LhsEval lhsEval(lhs);
+    Index threads = 1;
+#if defined(EIGEN_HAS_OPENMP) || defined(EIGEN_GEMM_THREADPOOL)
+    // Same threshold as for the matrix-vector products.
+    if(lhsEval.nonZerosEstimate()*cols > 20000)
+    {
+      Eigen::initParallel();
+      threads = Eigen::nbThreads();
+    }
+#endif
+
+    const Index n = lhs.outerSize();
+    if(Lhs::IsRowMajor)
+    {
+      if(RhsIsRowMajor && cols%PacketSize==0)
+      {
+        RhsRef actualRhs(rhs);
+        sparse_rowmajor_time_dense_tiles_task<LhsEval,RhsRef,DenseResType> task(lhsEval, actualRhs, res, alpha);
+        parallelize_ranges(n, numext::div_ceil(n, 4*threads), threads, task);
+      }
+      else
+      {
+        // pad the rows of the rhs with zeros so that the kernel only deals with full packets
+        RowMajorMatrix paddedRhs(rhs.rows(), numext::div_ceil(cols, Index(PacketSize))*PacketSize);
+        paddedRhs.leftCols(cols) = rhs;
+        paddedRhs.rightCols(paddedRhs.cols()-cols).setZero();
+        RhsRef actualRhs(paddedRhs);
+        sparse_rowmajor_time_dense_tiles_task<LhsEval,RhsRef,DenseResType> task(lhsEval, actualRhs, res, alpha);
+        parallelize_ranges(n, numext::div_ceil(n, 4*threads), threads, task);
+      }
+    }
+    else
+    {
+      // each thread traverses the whole matrix, so it gets as many columns as possible
+      RhsRef actualRhs(rhs);
+      sparse_colmajor_time_dense_tiles_task<LhsEval,RhsRef,DenseResType> task(lhsEval, n, actualRhs, res, alpha);
+      const Index tiles = numext::div_ceil(cols, Index(TileSize));
+      parallelize_ranges(cols, Index(TileSize)*numext::div_ceil(tiles, threads), threads, task);
+    }
+    return true;
+  }
+};
+
 template<typename SparseLhsType, typename DenseRhsType, typename DenseResType,
          typename AlphaType,
          int LhsStorageOrder = ((SparseLhsType::Flags&RowMajorBit)==RowMajorBit) ? RowMajor : ColMajor,
@@ -33,6 +307,9 @@ struct sparse_time_dense_product_impl<SparseLhsType,DenseRhsType,DenseResType, t
   typedef evaluator<Lhs> LhsEval;
   static void run(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const typename Res::Scalar& alpha)
   {
+    if(sparse_time_dense_tiled_product<SparseLhsType,DenseRhsType,DenseResType,typename Res::Scalar>::run(lhs, rhs, res, alpha))
+      return;
+
     LhsEval lhsEval(lhs);
     
     Index n = lhs.outerSize();
@@ -91,6 +368,9 @@ struct sparse_time_dense_product_impl<SparseLhsType,DenseRhsType,DenseResType, A
   typedef typename evaluator<Lhs>::InnerIterator LhsInnerIterator;
   static void run(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const AlphaType& alpha)
   {
+    if(sparse_time_dense_tiled_product<SparseLhsType,DenseRhsType,DenseResType,AlphaType>::run(lhs, rhs, res, alpha))
+      return;
+
     evaluator<Lhs> lhsEval(lhs);
     for(Index c=0; c<rhs.cols(); ++c)
     {
@@ -114,6 +394,9 @@ struct sparse_time_dense_product_impl<SparseLhsType,DenseRhsType,DenseResType, t
   typedef typename evaluator<Lhs>::InnerIterator LhsInnerIterator;
   static void run(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const typename Res::Scalar& alpha)
   {
+    if(sparse_time_dense_tiled_product<SparseLhsType,DenseRhsType,DenseResType,typename Res::Scalar>::run(lhs, rhs, res, alpha))
+      return;
+
     evaluator<Lhs> lhsEval(lhs);
     for(Index j=0; j<lhs.outerSize(); ++j)
     {
@@ -133,6 +416,9 @@ struct sparse_time_dense_product_impl<SparseLhsType,DenseRhsType,DenseResType, t
   typedef typename evaluator<Lhs>::InnerIterator LhsInnerIterator;
   static void run(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const typename Res::Scalar& alpha)
   {
+    if(sparse_time_dense_tiled_product<SparseLhsType,DenseRhsType,DenseResType,typename Res::Scalar>::run(lhs, rhs, res, alpha))
+      return;
+
     evaluator<Lhs> lhsEval(lhs);
     for(Index j=0; j<lhs.outerSize(); ++j)
     {
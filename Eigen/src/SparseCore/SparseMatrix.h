@@ -445,6 +445,12 @@ class SparseMatrix
     template<typename InputIterators,typename DupFunctor>
     void setFromTriplets(const InputIterators& begin, const InputIterators& end, DupFunctor dup_func);
 
+    template<typename InputIterators>
+    void setFromTriplets(const InputIterators& begin, const InputIterators& end, TripletAssembly assembly);
+
+    template<typename InputIterators,typename DupFunctor>
+    void setFromTriplets(const InputIterators& begin, const InputIterators& end, DupFunctor dup_func, TripletAssembly assembly);
+
     void sumupDuplicates() { collapseDuplicates(internal::scalar_sum_op<Scalar,Scalar>()); }
 
     template<typename DupFunctor>
@@ -916,15 +922,288 @@ private:
 
 namespace internal {
 
+// Bucketed assembly from triplets.
+//
+// The list of triplets is split into one contiguous range per thread. Every thread counts its triplets
+// per outer vector of the destination, a prefix sum over the outer vectors and the threads gives the
+// position of every bucket, and the threads copy their triplets to their buckets. The buckets of an outer
+// vector are ordered like the ranges, so the triplets keep their input order and the duplicates are merged
+// in the same order as by the serial assembly.
+
+template<typename InputIterator, typename SparseMatrixType>
+struct triplets_bucketing
+{
+  typedef typename SparseMatrixType::StorageIndex StorageIndex;
+  typedef Matrix<StorageIndex,Dynamic,Dynamic> Counts;
+  enum { IsRowMajor = SparseMatrixType::IsRowMajor };
+
+  triplets_bucketing(const InputIterator& first, Index chunkSize, SparseMatrixType& mat, Counts& counts, bool scatter)
+    : m_first(first), m_chunkSize(chunkSize), m_mat(mat), m_counts(counts), m_scatter(scatter)
+  {}
+
+  void operator()(Index begin, Index end) const
+  {
+    InputIterator it(m_first);
+    std::advance(it, begin);
+    // the counts of a range are stored in its own column
+    for(Index chunk=begin/m_chunkSize; begin<end; ++chunk)
+    {
+      const Index chunkEnd = (std::min)(end, (chunk+1)*m_chunkSize);
+      StorageIndex* counts = &m_counts.coeffRef(0,chunk);
+      if(m_scatter)
+      {
+        const StorageIndex* outerIndex = m_mat.outerIndexPtr();
+        StorageIndex* innerIndices = m_mat.innerIndexPtr();
+        typename SparseMatrixType::Scalar* values = m_mat.valuePtr();
+        for(; begin<chunkEnd; ++begin, ++it)
+        {
+          const Index outer = IsRowMajor ? it->row() : it->col();
+          const Index p = outerIndex[outer] + counts[outer]++;
+          innerIndices[p] = convert_index<StorageIndex>(IsRowMajor ? it->col() : it->row());
+          values[p] = it->value();
+        }
+      }
+      else
+      {
+        for(; begin<chunkEnd; ++begin, ++it)
+        {
+          eigen_assert(it->row()>=0 && it->row()<m_mat.rows() && it->col()>=0 && it->col()<m_mat.cols());
+          ++counts[IsRowMajor ? it->row() : it->col()];
+        }
+      }
+    }
+  }
+
+  InputIterator m_first;
+  Index m_chunkSize;
+  SparseMatrixType& m_mat;
+  Counts& m_counts;
+  bool m_scatter;
+};
+
+// Turns the counts of every outer vector into the offsets of the buckets of the ranges within the vector.
+template<typename StorageIndex>
+struct triplets_bucket_offsets
+{
+  typedef Matrix<StorageIndex,Dynamic,Dynamic> Counts;
+  typedef Matrix<StorageIndex,Dynamic,1> IndexVector;
+
+  triplets_bucket_offsets(Counts& counts, IndexVector& totals) : m_counts(counts), m_totals(totals) {}
+
+  void operator()(Index begin, Index end) const
+  {
+    for(Index j=begin; j<end; ++j)
+    {
+      StorageIndex total = 0;
+      for(Index chunk=0; chunk<m_counts.cols(); ++chunk)
+      {
+        const StorageIndex count = m_counts(j,chunk);
+        m_counts(j,chunk) = total;
+        total += count;
+      }
+      m_totals(j) = total;
+    }
+  }
+
+  Counts& m_counts;
+  IndexVector& m_totals;
+};
+
+// Merges the duplicates of every inner vector, in place. This is collapseDuplicates() without the final compression.
+template<typename SparseMatrixType, typename DupFunctor>
+struct triplets_collapse_duplicates
+{
+  typedef typename SparseMatrixType::StorageIndex StorageIndex;
+  typedef Matrix<StorageIndex,Dynamic,1> IndexVector;
+
+  triplets_collapse_duplicates(SparseMatrixType& mat, const IndexVector& sizes, DupFunctor dup_func)
+    : m_mat(mat), m_sizes(sizes), m_dupFunc(dup_func)
+  {}
+
+  void operator()(Index begin, Index end) const
+  {
+    const StorageIndex* outerIndex = m_mat.outerIndexPtr();
+    StorageIndex* innerNonZeros = m_mat.innerNonZeroPtr();
+    StorageIndex* innerIndices = m_mat.innerIndexPtr();
+    typename SparseMatrixType::Scalar* values = m_mat.valuePtr();
+    // wi[inner_index] holds the position of the first entry with this index
+    IndexVector wi(m_mat.innerSize());
+    wi.fill(-1);
+    for(Index j=begin; j<end; ++j)
+    {
+      const StorageIndex start = outerIndex[j];
+      StorageIndex count = start;
+      for(Index k=start; k<start+m_sizes(j); ++k)
+      {
+        const Index i = innerIndices[k];
+        if(wi(i)>=start)
+        {
+          values[wi(i)] = m_dupFunc(values[wi(i)], values[k]);
+        }
+        else
+        {
+          values[count] = values[k];
+          innerIndices[count] = innerIndices[k];
+          wi(i) = count;
+          ++count;
+        }
+      }
+      innerNonZeros[j] = count - start;
+    }
+  }
+
+  SparseMatrixType& m_mat;
+  const IndexVector& m_sizes;
+  DupFunctor m_dupFunc;
+};
+
+// Sorts every inner vector by inner index, keeping the input order of the duplicates, and merges the duplicates.
+template<typename SparseMatrixType, typename DupFunctor>
+struct triplets_sort_inner_vectors
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef typename SparseMatrixType::StorageIndex StorageIndex;
+  typedef Matrix<StorageIndex,Dynamic,1> IndexVector;
+
+  triplets_sort_inner_vectors(SparseMatrixType& mat, const IndexVector& sizes, DupFunctor dup_func)
+    : m_mat(mat), m_sizes(sizes), m_dupFunc(dup_func)
+  {}
+
+  void operator()(Index begin, Index end) const
+  {
+    std::vector<std::pair<StorageIndex,Index> > order;
+    std::vector<Scalar> sortedValues;
+    for(Index j=begin; j<end; ++j)
+    {
+      const Index size = m_sizes(j);
+      StorageIndex* innerIndices = m_mat.innerIndexPtr() + m_mat.outerIndexPtr()[j];
+      Scalar* values = m_mat.valuePtr() + m_mat.outerIndexPtr()[j];
+
+      bool sorted = true;
+      for(Index k=1; k<size && sorted; ++k)
+        sorted = innerIndices[k-1] <= innerIndices[k];
+      if(!sorted)
+      {
+        // the position breaks the ties between duplicates
+        order.resize(size);
+        for(Index k=0; k<size; ++k)
+          order[k] = std::make_pair(innerIndices[k], k);
+        std::sort(order.begin(), order.end());
+        sortedValues.resize(size);
+        for(Index k=0; k<size; ++k)
+        {
+          innerIndices[k] = order[k].first;
+          sortedValues[k] = values[order[k].second];
+        }
+        std::copy(sortedValues.begin(), sortedValues.end(), values);
+      }
+
+      Index count = 0;
+      for(Index k=0; k<size; ++k)
+      {
+        if(count>0 && innerIndices[count-1]==innerIndices[k])
+        {
+          values[count-1] = m_dupFunc(values[count-1], values[k]);
+        }
+        else
+        {
+          innerIndices[count] = innerIndices[k];
+          values[count] = values[k];
+          ++count;
+        }
+      }
+      m_mat.innerNonZeroPtr()[j] = convert_index<StorageIndex>(count);
+    }
+  }
+
+  SparseMatrixType& m_mat;
+  const IndexVector& m_sizes;
+  DupFunctor m_dupFunc;
+};
+
+// Fills mat, which is left uncompressed, with the triplets using the given number of threads.
+// If sortInnerVectors is false, the entries of the inner vectors are in the order of the triplets.
 template<typename InputIterator, typename SparseMatrixType, typename DupFunctor>
-void set_from_triplets(const InputIterator& begin, const InputIterator& end, SparseMatrixType& mat, DupFunctor dup_func)
+void set_from_triplets_by_buckets(const InputIterator& begin, const InputIterator& end, SparseMatrixType& mat,
+                                  DupFunctor dup_func, bool sortInnerVectors, Index threads)
+{
+  typedef typename SparseMatrixType::StorageIndex StorageIndex;
+  typedef Matrix<StorageIndex,Dynamic,Dynamic> Counts;
+  typedef Matrix<StorageIndex,Dynamic,1> IndexVector;
+
+  mat.resize(mat.rows(), mat.cols());
+  const Index size = std::distance(begin, end);
+  if(size==0)
+    return;
+
+  // pass 1: count the triplets per range and outer vector
+  const Index outerSize = mat.outerSize();
+  const Index chunkSize = numext::div_ceil(size, threads);
+  Counts counts = Counts::Zero(outerSize, numext::div_ceil(size, chunkSize));
+  parallelize_ranges(size, chunkSize, threads, triplets_bucketing<InputIterator,SparseMatrixType>(begin, chunkSize, mat, counts, false));
+
+  // pass 2: prefix sums giving the position of the buckets
+  IndexVector sizes(outerSize);
+  parallelize_ranges(outerSize, numext::div_ceil(outerSize, 4*threads), threads, triplets_bucket_offsets<StorageIndex>(counts, sizes));
+  mat.reserve(sizes);
+
+  // pass 3: copy the triplets to their buckets
+  parallelize_ranges(size, chunkSize, threads, triplets_bucketing<InputIterator,SparseMatrixType>(begin, chunkSize, mat, counts, true));
+
+  // pass 4: merge the duplicates
+  if(sortInnerVectors)
+    parallelize_ranges(outerSize, numext::div_ceil(outerSize, 4*threads), threads,
+                       triplets_sort_inner_vectors<SparseMatrixType,DupFunctor>(mat, sizes, dup_func));
+  else
+    parallelize_ranges(outerSize, numext::div_ceil(outerSize, threads), threads,
+                       triplets_collapse_duplicates<SparseMatrixType,DupFunctor>(mat, sizes, dup_func));
+}
+
+template<typename InputIterator>
+Index triplets_parallel_size(const InputIterator& begin, const InputIterator& end, std::random_access_iterator_tag)
+{
+  return end-begin;
+}
+
+// the list of triplets can be split among threads only if its iterators have random access
+template<typename InputIterator, typename IteratorCategory>
+Index triplets_parallel_size(const InputIterator&, const InputIterator&, IteratorCategory)
+{
+  return 0;
+}
+
+template<typename InputIterator, typename SparseMatrixType, typename DupFunctor>
+void set_from_triplets(const InputIterator& begin, const InputIterator& end, SparseMatrixType& mat, DupFunctor dup_func,
+                       TripletAssembly assembly = TransposedAssembly)
 {
   enum { IsRowMajor = SparseMatrixType::IsRowMajor };
   typedef typename SparseMatrixType::Scalar Scalar;
   typedef typename SparseMatrixType::StorageIndex StorageIndex;
+
+  Index threads = 1;
+#if defined(EIGEN_HAS_OPENMP) || defined(EIGEN_GEMM_THREADPOOL)
+  // Below this number of triplets the threads cost more than they save.
+  if(triplets_parallel_size(begin, end, typename std::iterator_traits<InputIterator>::iterator_category()) > 100000)
+  {
+    Eigen::initParallel();
+    threads = Eigen::nbThreads();
+  }
+#endif
+
+  if(assembly==SortedAssembly)
+  {
+    set_from_triplets_by_buckets(begin, end, mat, dup_func, true, threads);
+    mat.makeCompressed();
+    return;
+  }
+
   SparseMatrix<Scalar,IsRowMajor?ColMajor:RowMajor,StorageIndex> trMat(mat.rows(),mat.cols());
 
-  if(begin!=end)
+  if(threads>1)
+  {
+    set_from_triplets_by_buckets(begin, end, trMat, dup_func, false, threads);
+  }
+  else if(begin!=end)
   {
     // pass 1: count the nnz per inner-vector
     typename SparseMatrixType::IndexVector wi(trMat.outerSize());
@@ -987,6 +1266,11 @@ void set_from_triplets(const InputIterator& begin, const InputIterator& end, Spa
   * \warning The list of triplets is read multiple times (at least twice). Therefore, it is not recommended to define
   * an abstract iterator over a complex data-structure that would be expensive to evaluate. The triplets should rather
   * be explicitely stored into a std::vector for instance.
+  *
+  * When Eigen is parallelized (see \ref TopicMultiThreading) and the iterators have random access, large lists of
+  * triplets are assembled by several threads.
+  *
+  * \sa setFromTriplets(const InputIterators&, const InputIterators&, TripletAssembly)
   */
 template<typename Scalar, int _Options, typename _StorageIndex>
 template<typename InputIterators>
@@ -995,6 +1279,19 @@ void SparseMatrix<Scalar,_Options,_StorageIndex>::setFromTriplets(const InputIte
   internal::set_from_triplets<InputIterators, SparseMatrix<Scalar,_Options,_StorageIndex> >(begin, end, *this, internal::scalar_sum_op<Scalar,Scalar>());
 }
 
+/** The same as setFromTriplets but the entries are sorted as specified by \a assembly.
+  * With \c SortedAssembly the triplets are directly bucketed into \c *this, which saves the memory
+  * and the time of an intermediate transposed copy, especially when the triplets are already almost sorted.
+  *
+  * \sa TripletAssembly
+  */
+template<typename Scalar, int _Options, typename _StorageIndex>
+template<typename InputIterators>
+void SparseMatrix<Scalar,_Options,_StorageIndex>::setFromTriplets(const InputIterators& begin, const InputIterators& end, TripletAssembly assembly)
+{
+  internal::set_from_triplets<InputIterators, SparseMatrix<Scalar,_Options,_StorageIndex> >(begin, end, *this, internal::scalar_sum_op<Scalar,Scalar>(), assembly);
+}
+
 /** The same as setFromTriplets but when duplicates are met the functor \a dup_func is applied:
   * \code
   * value = dup_func(OldValue, NewValue)
@@ -1011,6 +1308,15 @@ void SparseMatrix<Scalar,_Options,_StorageIndex>::setFromTriplets(const InputIte
   internal::set_from_triplets<InputIterators, SparseMatrix<Scalar,_Options,_StorageIndex>, DupFunctor>(begin, end, *this, dup_func);
 }
 
+/** The same as setFromTriplets but the duplicates are merged by \a dup_func and the entries are sorted as specified
+  * by \a assembly. */
+template<typename Scalar, int _Options, typename _StorageIndex>
+template<typename InputIterators,typename DupFunctor>
+void SparseMatrix<Scalar,_Options,_StorageIndex>::setFromTriplets(const InputIterators& begin, const InputIterators& end, DupFunctor dup_func, TripletAssembly assembly)
+{
+  internal::set_from_triplets<InputIterators, SparseMatrix<Scalar,_Options,_StorageIndex>, DupFunctor>(begin, end, *this, dup_func, assembly);
+}
+
 /** \internal */
 template<typename Scalar, int _Options, typename _StorageIndex>
 template<typename DupFunctor>
@@ -0,0 +1,136 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_SPARSE_MATRIX_PRODUCT_H
+#define EIGEN_SPARSE_MATRIX_PRODUCT_H
+
+namespace Eigen {
+
+/** \ingroup SparseCore_Module
+  * \class SparseMatrixProduct
+  *
+  * \brief The product of two sparse matrices whose values can be recomputed for the same patterns
+  *
+  * \tparam _MatrixType the type of the result, a SparseMatrix<>
+  *
+  * The product of two sparse matrices is computed in two phases. The symbolic phase determines the pattern of the
+  * result, and the numeric phase computes its values. When the same product is computed over and over again with
+  * operands whose values change but not their patterns, compute() can be called once and then computeValues() only
+  * runs the numeric phase, in place in the already allocated result. This is typically the case of the Galerkin
+  * products \f$ R A P \f$ of algebraic multigrid methods:
+  * \code
+  * SparseMatrix<double> R, A, P;
+  * SparseMatrixProduct<SparseMatrix<double> > RA(R, A), RAP(RA.result(), P);
+  * // ... then, for new values of A:
+  * RA.computeValues(R, A);
+  * RAP.computeValues(RA.result(), P);
+  * // use RAP.result()
+  * \endcode
+  *
+  * Both phases are multi-threaded for large products (see setNbThreads()). The inner indices of the result are
+  * sorted.
+  *
+  * The operands are fastest when they are compressed SparseMatrix objects with the storage order of the result,
+  * other expressions are first evaluated into temporaries.
+  *
+  * \sa SparseMatrixBase::operator*(const SparseMatrixBase<OtherDerived>&) const
+  */
+template<typename _MatrixType>
+class SparseMatrixProduct
+{
+  public:
+    typedef _MatrixType MatrixType;
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::StorageIndex StorageIndex;
+    enum {
+      IsRowMajor = MatrixType::IsRowMajor
+    };
+
+    SparseMatrixProduct() : m_info(Success), m_isInitialized(false) {}
+
+    /** Computes the product \a lhs * \a rhs, see compute() */
+    template<typename Lhs, typename Rhs>
+    SparseMatrixProduct(const SparseMatrixBase<Lhs>& lhs, const SparseMatrixBase<Rhs>& rhs)
+      : m_info(Success), m_isInitialized(false)
+    {
+      compute(lhs, rhs);
+    }
+
+    /** Computes the pattern and the values of the product \a lhs * \a rhs. */
+    template<typename Lhs, typename Rhs>
+    SparseMatrixProduct& compute(const SparseMatrixBase<Lhs>& lhs, const SparseMatrixBase<Rhs>& rhs)
+    {
+      eigen_assert(lhs.cols() == rhs.rows() && "invalid sparse matrix * sparse matrix product");
+      const OperandRef lhsRef(lhs.derived()), rhsRef(rhs.derived());
+      m_result.resize(lhs.rows(), rhs.cols());
+      const Index threads = internal::sparse_sparse_product_threads(lhsRef.nonZeros() + rhsRef.nonZeros());
+      // the outer vectors of the result are combinations of the outer vectors of the first operand
+      internal::sparse_sparse_product_two_phases(IsRowMajor ? rhsRef : lhsRef, IsRowMajor ? lhsRef : rhsRef,
+                                                 m_result, true, threads);
+      m_info = Success;
+      m_isInitialized = true;
+      return *this;
+    }
+
+    /** Recomputes the values of the product \a lhs * \a rhs, keeping the pattern of the result.
+      *
+      * The patterns of \a lhs and \a rhs must be the ones passed to the last call to compute(), or subsets of them.
+      * Otherwise the entries of the product that are not in the pattern of the result are dropped, and info() returns
+      * \c InvalidInput.
+      */
+    template<typename Lhs, typename Rhs>
+    SparseMatrixProduct& computeValues(const SparseMatrixBase<Lhs>& lhs, const SparseMatrixBase<Rhs>& rhs)
+    {
+      eigen_assert(m_isInitialized && "SparseMatrixProduct is not initialized.");
+      eigen_assert(lhs.rows() == rows() && rhs.cols() == cols() && lhs.cols() == rhs.rows()
+                   && "the sizes of the operands do not match the ones of the computed product");
+      const OperandRef lhsRef(lhs.derived()), rhsRef(rhs.derived());
+      const internal::evaluator<OperandRef> firstEval(IsRowMajor ? rhsRef : lhsRef);
+      const internal::evaluator<OperandRef> secondEval(IsRowMajor ? lhsRef : rhsRef);
+      const Index threads = internal::sparse_sparse_product_threads(lhsRef.nonZeros() + rhsRef.nonZeros());
+      const Index outerSize = m_result.outerSize();
+      Matrix<bool,Dynamic,1> mismatches(outerSize);
+      internal::parallelize_ranges(outerSize, numext::div_ceil(outerSize, 4*threads), threads,
+          internal::sparse_sparse_product_refill<OperandRef,OperandRef,MatrixType>(firstEval, secondEval, m_result,
+                                                                                   mismatches));
+      m_info = mismatches.any() ? InvalidInput : Success;
+      return *this;
+    }
+
+    /** \brief Reports whether the last computation was successful.
+      *
+      * \returns \c Success if it was successful, or \c InvalidInput if the last call to computeValues() was given
+      *          operands whose product has entries outside of the pattern computed by compute().
+      */
+    ComputationInfo info() const
+    {
+      eigen_assert(m_isInitialized && "SparseMatrixProduct is not initialized.");
+      return m_info;
+    }
+
+    /** \returns the product computed by the last call to compute() or computeValues() */
+    const MatrixType& result() const
+    {
+      eigen_assert(m_isInitialized && "SparseMatrixProduct is not initialized.");
+      return m_result;
+    }
+
+    inline Index rows() const { return m_result.rows(); }
+    inline Index cols() const { return m_result.cols(); }
+    inline Index nonZeros() const { return m_result.nonZeros(); }
+
+  protected:
+    typedef Ref<const SparseMatrix<Scalar,IsRowMajor?RowMajor:ColMajor,StorageIndex> > OperandRef;
+
+    MatrixType m_result;
+    ComputationInfo m_info;
+    bool m_isInitialized;
+};
+
+} // end namespace Eigen
+
+#endif // EIGEN_SPARSE_MATRIX_PRODUCT_H
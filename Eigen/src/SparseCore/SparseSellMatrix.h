@@ -0,0 +1,375 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_SPARSE_SELL_MATRIX_H
+#define EIGEN_SPARSE_SELL_MATRIX_H
+
+namespace Eigen {
+
+namespace internal {
+
+template<typename _Scalar, typename _StorageIndex>
+struct traits<SparseSellMatrix<_Scalar,_StorageIndex> > : traits<SparseMatrix<_Scalar,RowMajor,_StorageIndex> >
+{};
+
+} // end namespace internal
+
+/** \ingroup SparseCore_Module
+  * \class SparseSellMatrix
+  *
+  * \brief A read-only sparse matrix stored in the SELL-C-sigma format for fast sparse matrix times dense products
+  *
+  * \tparam _Scalar the scalar type, i.e. the type of the coefficients
+  * \tparam _StorageIndex the type of the indices. It has to be a \b signed type (e.g., short, int, std::ptrdiff_t). Default is \c int.
+  *
+  * The rows are grouped into slices of \c SliceHeight consecutive rows, where \c SliceHeight is a small multiple of
+  * the packet size of the scalar type. The nonzeros of a slice are stored column by column: the j-th nonzero of each
+  * row of the slice are contiguous in memory, and the shorter rows are padded with explicit zeros. The product with a
+  * dense vector then computes \c SliceHeight rows at once with full packets, instead of reducing each row separately
+  * as the compressed row storage does.
+  *
+  * To limit the amount of padding, the rows are first sorted by decreasing number of nonzeros within windows of
+  * \c sortingScope rows (the \em sigma of SELL-C-sigma). A larger scope reduces the padding, a smaller one preserves
+  * the locality of the accesses to the destination. A scope of 1 disables the sorting.
+  *
+  * A SparseSellMatrix is built from any sparse expression and can then be multiplied by dense vectors and matrices:
+  * \code
+  * SparseMatrix<double> A = ...;
+  * SparseSellMatrix<double> S(A);
+  * y = S * x;
+  * y.noalias() += 2 * (S * X).col(0);
+  * \endcode
+  * The products are multi-threaded like the SparseMatrix ones (see setNbThreads()). It can also be passed to the
+  * iterative solvers, e.g., <tt>ConjugateGradient<SparseSellMatrix<double>, Lower|Upper></tt>, as a matrix-free operator.
+  *
+  * \warning The padding entries multiply explicit zeros with coefficients of the right hand side. Therefore, infinite
+  * or NaN coefficients of the right hand side may propagate to rows that do not reference them.
+  *
+  * \sa SparseMatrix
+  */
+template<typename _Scalar, typename _StorageIndex>
+class SparseSellMatrix : public EigenBase<SparseSellMatrix<_Scalar,_StorageIndex> >
+{
+  public:
+    typedef _Scalar Scalar;
+    typedef typename NumTraits<Scalar>::Real RealScalar;
+    typedef _StorageIndex StorageIndex;
+    typedef Matrix<Scalar,Dynamic,1> ScalarVector;
+    typedef Matrix<StorageIndex,Dynamic,1> IndexVector;
+
+    enum {
+      ColsAtCompileTime = Dynamic,
+      MaxColsAtCompileTime = Dynamic,
+      IsRowMajor = 1,
+      PacketSize = internal::packet_traits<Scalar>::size,
+      Vectorizable = internal::packet_traits<Scalar>::Vectorizable && PacketSize>1,
+      /** The number of rows processed at once */
+      SliceHeight = Vectorizable ? 2*PacketSize : 4,
+      DefaultSortingScope = 32*SliceHeight
+    };
+
+    class InnerIterator;
+
+    SparseSellMatrix() : m_rows(0), m_cols(0), m_nonZeros(0), m_sortingScope(1)
+    {
+      m_sliceOffsets.setZero(1);
+    }
+
+    /** Builds the SELL storage of \a other, sorting the rows within windows of \a sortingScope rows */
+    template<typename OtherDerived>
+    explicit SparseSellMatrix(const SparseMatrixBase<OtherDerived>& other, Index sortingScope = DefaultSortingScope)
+    {
+      compute(other, sortingScope);
+    }
+
+    /** Rebuilds the SELL storage from \a other, sorting the rows within windows of \a sortingScope rows */
+    template<typename OtherDerived>
+    SparseSellMatrix& compute(const SparseMatrixBase<OtherDerived>& other, Index sortingScope = DefaultSortingScope);
+
+    inline Index rows() const { return m_rows; }
+    inline Index cols() const { return m_cols; }
+    inline Index outerSize() const { return m_rows; }
+    inline Index innerSize() const { return m_cols; }
+
+    /** \returns the number of nonzeros of the original matrix */
+    inline Index nonZeros() const { return m_nonZeros; }
+    /** \returns the number of stored coefficients, including the padding */
+    inline Index storageSize() const { return m_values.size(); }
+    /** \returns the size of the windows within which the rows were sorted */
+    inline Index sortingScope() const { return m_sortingScope; }
+    /** \returns the number of slices of \c SliceHeight rows */
+    inline Index slices() const { return m_sliceOffsets.size()-1; }
+
+    /** \returns the rows of the matrix in storage order: the i-th stored row is the row \c rowOrder()(i) */
+    inline const IndexVector& rowOrder() const { return m_rowOrder; }
+
+    template<typename Rhs>
+    inline const Product<SparseSellMatrix,Rhs,AliasFreeProduct> operator*(const MatrixBase<Rhs>& other) const
+    {
+      return Product<SparseSellMatrix,Rhs,AliasFreeProduct>(*this, other.derived());
+    }
+
+    /** \internal Performs \a dst += \a alpha * \c *this * \a rhs for the slices in [\a begin, \a end) */
+    template<typename Dest, typename Rhs>
+    void scaleAndAddTo(Dest& dst, const Rhs& rhs, const Scalar& alpha, Index begin, Index end) const;
+
+  protected:
+    struct LongerRow;
+
+    Index m_rows;
+    Index m_cols;
+    Index m_nonZeros;
+    Index m_sortingScope;
+    IndexVector m_rowOrder;     // stored position -> row
+    IndexVector m_positions;    // row -> stored position
+    IndexVector m_rowLengths;   // stored position -> number of nonzeros
+    IndexVector m_sliceOffsets; // slice -> offset of its first coefficient
+    ScalarVector m_values;
+    IndexVector m_indices;
+};
+
+/** \class SparseSellMatrix::InnerIterator
+  * \brief Iterates over the nonzeros of a row, skipping the padding */
+template<typename Scalar, typename StorageIndex>
+class SparseSellMatrix<Scalar,StorageIndex>::InnerIterator
+{
+  public:
+    InnerIterator(const SparseSellMatrix& mat, Index outer)
+      : m_outer(outer), m_id(0)
+    {
+      const Index pos = mat.m_positions(outer);
+      const Index offset = mat.m_sliceOffsets(pos / SliceHeight) + pos % SliceHeight;
+      m_values = mat.m_values.data() + offset;
+      m_indices = mat.m_indices.data() + offset;
+      m_end = mat.m_rowLengths(pos);
+    }
+
+    inline InnerIterator& operator++() { ++m_id; return *this; }
+
+    inline const Scalar& value() const { return m_values[m_id*SliceHeight]; }
+    inline StorageIndex index() const { return m_indices[m_id*SliceHeight]; }
+    inline Index outer() const { return m_outer; }
+    inline Index row() const { return m_outer; }
+    inline Index col() const { return index(); }
+
+    inline operator bool() const { return m_id < m_end; }
+
+  protected:
+    const Scalar* m_values;
+    const StorageIndex* m_indices;
+    const Index m_outer;
+    Index m_id;
+    Index m_end;
+};
+
+template<typename Scalar, typename StorageIndex>
+struct SparseSellMatrix<Scalar,StorageIndex>::LongerRow
+{
+  LongerRow(const IndexVector& lengths) : m_lengths(lengths) {}
+  bool operator()(StorageIndex a, StorageIndex b) const { return m_lengths(a) > m_lengths(b); }
+  const IndexVector& m_lengths;
+};
+
+template<typename Scalar, typename StorageIndex>
+template<typename OtherDerived>
+SparseSellMatrix<Scalar,StorageIndex>&
+SparseSellMatrix<Scalar,StorageIndex>::compute(const SparseMatrixBase<OtherDerived>& other, Index sortingScope)
+{
+  typedef Ref<const SparseMatrix<Scalar,RowMajor,StorageIndex> > RowMajorRef;
+  const RowMajorRef mat(other.derived());
+
+  m_rows = mat.rows();
+  m_cols = mat.cols();
+  // the windows are made of whole slices so that the first row of each slice is its longest one
+  m_sortingScope = numext::div_ceil((std::max)(sortingScope, Index(1)), Index(SliceHeight)) * SliceHeight;
+
+  IndexVector lengths(m_rows);
+  for(Index i=0; i<m_rows; ++i)
+  {
+    StorageIndex n = 0;
+    for(typename RowMajorRef::InnerIterator it(mat,i); it; ++it)
+      ++n;
+    lengths(i) = n;
+  }
+
+  m_rowOrder.resize(m_rows);
+  for(Index i=0; i<m_rows; ++i)
+    m_rowOrder(i) = StorageIndex(i);
+  if(m_sortingScope > SliceHeight)
+  {
+    for(Index start=0; start<m_rows; start+=m_sortingScope)
+      std::stable_sort(m_rowOrder.data()+start, m_rowOrder.data()+(std::min)(start+m_sortingScope, m_rows),
+                       LongerRow(lengths));
+  }
+
+  const Index numSlices = numext::div_ceil(m_rows, Index(SliceHeight));
+  m_positions.resize(m_rows);
+  m_rowLengths.resize(m_rows);
+  m_sliceOffsets.resize(numSlices+1);
+  m_sliceOffsets(0) = 0;
+  m_nonZeros = 0;
+  for(Index s=0; s<numSlices; ++s)
+  {
+    StorageIndex width = 0;
+    for(Index pos=s*SliceHeight; pos<(std::min)((s+1)*SliceHeight, m_rows); ++pos)
+    {
+      m_positions(m_rowOrder(pos)) = StorageIndex(pos);
+      m_rowLengths(pos) = lengths(m_rowOrder(pos));
+      width = (std::max)(width, m_rowLengths(pos));
+      m_nonZeros += m_rowLengths(pos);
+    }
+    m_sliceOffsets(s+1) = m_sliceOffsets(s) + width*StorageIndex(SliceHeight);
+  }
+
+  // The padding reads the last column of its row, which is already in cache, or the first column for the empty rows.
+  m_values.setZero(m_sliceOffsets(numSlices));
+  m_indices.setZero(m_sliceOffsets(numSlices));
+  for(Index pos=0; pos<m_rows; ++pos)
+  {
+    const Index s = pos / SliceHeight;
+    const Index width = (m_sliceOffsets(s+1) - m_sliceOffsets(s)) / SliceHeight;
+    Scalar* values = m_values.data() + m_sliceOffsets(s) + pos % SliceHeight;
+    StorageIndex* indices = m_indices.data() + m_sliceOffsets(s) + pos % SliceHeight;
+    Index j = 0;
+    for(typename RowMajorRef::InnerIterator it(mat,m_rowOrder(pos)); it; ++it, ++j)
+    {
+      values[j*SliceHeight] = it.value();
+      indices[j*SliceHeight] = it.index();
+    }
+    for(; j<width; ++j)
+      indices[j*SliceHeight] = j>0 ? indices[(j-1)*SliceHeight] : StorageIndex(0);
+  }
+  return *this;
+}
+
+namespace internal {
+
+/** \internal Computes \a res[r] = sum_j \a values[j*SliceHeight+r] * \a rhs[\a indices[j*SliceHeight+r]] for the
+  * \c SliceHeight rows of a slice of width \a width */
+template<typename Scalar, typename StorageIndex, int SliceHeight,
+         bool Vectorizable = SparseSellMatrix<Scalar,StorageIndex>::Vectorizable>
+struct sell_slice_product
+{
+  static EIGEN_STRONG_INLINE void run(const Scalar* values, const StorageIndex* indices, Index width,
+                                      const Scalar* rhs, Scalar* res)
+  {
+    Scalar acc[SliceHeight];
+    for(int r=0; r<SliceHeight; ++r)
+      acc[r] = Scalar(0);
+    for(Index j=0; j<width; ++j, values+=SliceHeight, indices+=SliceHeight)
+      for(int r=0; r<SliceHeight; ++r)
+        acc[r] += values[r] * rhs[indices[r]];
+    for(int r=0; r<SliceHeight; ++r)
+      res[r] = acc[r];
+  }
+};
+
+template<typename Scalar, typename StorageIndex, int SliceHeight>
+struct sell_slice_product<Scalar,StorageIndex,SliceHeight,true>
+{
+  typedef typename packet_traits<Scalar>::type Packet;
+  enum {
+    PacketSize = packet_traits<Scalar>::size,
+    NumPackets = SliceHeight / PacketSize
+  };
+
+  static EIGEN_STRONG_INLINE void run(const Scalar* values, const StorageIndex* indices, Index width,
+                                      const Scalar* rhs, Scalar* res)
+  {
+    Packet acc[NumPackets];
+    for(int k=0; k<NumPackets; ++k)
+      acc[k] = pset1<Packet>(Scalar(0));
+    for(Index j=0; j<width; ++j, values+=SliceHeight, indices+=SliceHeight)
+    {
+      // gather the coefficients of the rhs through an aligned buffer
+      EIGEN_ALIGN_MAX Scalar gathered[SliceHeight];
+      for(int r=0; r<SliceHeight; ++r)
+        gathered[r] = rhs[indices[r]];
+      for(int k=0; k<NumPackets; ++k)
+        acc[k] = pmadd(pload<Packet>(values+k*PacketSize), pload<Packet>(gathered+k*PacketSize), acc[k]);
+    }
+    for(int k=0; k<NumPackets; ++k)
+      pstoreu(res+k*PacketSize, acc[k]);
+  }
+};
+
+template<typename Lhs, typename Rhs, typename Dest>
+struct sell_time_dense_product_task
+{
+  typedef typename Lhs::Scalar Scalar;
+  sell_time_dense_product_task(const Lhs& lhs, const Rhs& rhs, Dest& dst, const Scalar& alpha)
+    : m_lhs(lhs), m_rhs(rhs), m_dst(dst), m_alpha(alpha)
+  {}
+  void operator()(Index begin, Index end) const
+  {
+    m_lhs.scaleAndAddTo(m_dst, m_rhs, m_alpha, begin, end);
+  }
+  const Lhs& m_lhs;
+  const Rhs& m_rhs;
+  Dest& m_dst;
+  Scalar m_alpha;
+};
+
+template<typename _Scalar, typename _StorageIndex, typename Rhs, int ProductType>
+struct generic_product_impl<SparseSellMatrix<_Scalar,_StorageIndex>, Rhs, SparseShape, DenseShape, ProductType>
+ : generic_product_impl_base<SparseSellMatrix<_Scalar,_StorageIndex>, Rhs,
+                             generic_product_impl<SparseSellMatrix<_Scalar,_StorageIndex>, Rhs, SparseShape, DenseShape, ProductType> >
+{
+  typedef SparseSellMatrix<_Scalar,_StorageIndex> Lhs;
+  typedef typename Product<Lhs,Rhs>::Scalar Scalar;
+  // the kernels read the columns of the rhs through raw pointers
+  typedef Ref<const Matrix<_Scalar,Dynamic,Dynamic>, 0, OuterStride<> > RhsRef;
+
+  template<typename Dest>
+  static void scaleAndAddTo(Dest& dst, const Lhs& lhs, const Rhs& rhs, const Scalar& alpha)
+  {
+    EIGEN_STATIC_ASSERT((internal::is_same<_Scalar,typename Rhs::Scalar>::value),
+                        YOU_MIXED_DIFFERENT_NUMERIC_TYPES__YOU_NEED_TO_USE_THE_CAST_METHOD_OF_MATRIXBASE_TO_CAST_NUMERIC_TYPES_EXPLICITLY)
+    const RhsRef actualRhs(rhs);
+    sell_time_dense_product_task<Lhs,RhsRef,Dest> task(lhs, actualRhs, dst, alpha);
+
+    Index threads = 1;
+#if defined(EIGEN_HAS_OPENMP) || defined(EIGEN_GEMM_THREADPOOL)
+    // Same threshold as for the products of a row-major SparseMatrix.
+    if(lhs.nonZeros()*rhs.cols() > 20000)
+    {
+      Eigen::initParallel();
+      threads = Eigen::nbThreads();
+    }
+#endif
+    parallelize_ranges(lhs.slices(), numext::div_ceil(lhs.slices(), 4*threads), threads, task);
+  }
+};
+
+} // end namespace internal
+
+template<typename Scalar, typename StorageIndex>
+template<typename Dest, typename Rhs>
+void SparseSellMatrix<Scalar,StorageIndex>::scaleAndAddTo(Dest& dst, const Rhs& rhs, const Scalar& alpha,
+                                                          Index begin, Index end) const
+{
+  typedef internal::sell_slice_product<Scalar,StorageIndex,SliceHeight> SliceProduct;
+  for(Index s=begin; s<end; ++s)
+  {
+    const Index offset = m_sliceOffsets(s);
+    const Index width = (m_sliceOffsets(s+1) - offset) / SliceHeight;
+    const Index actualRows = (std::min)(Index(SliceHeight), m_rows - s*SliceHeight);
+    const StorageIndex* order = m_rowOrder.data() + s*SliceHeight;
+    // all the columns of the rhs are processed while the slice is in cache
+    for(Index c=0; c<rhs.cols(); ++c)
+    {
+      Scalar res[SliceHeight];
+      SliceProduct::run(m_values.data()+offset, m_indices.data()+offset, width, rhs.data()+c*rhs.outerStride(), res);
+      for(Index r=0; r<actualRows; ++r)
+        dst.coeffRef(order[r],c) += alpha * res[r];
+    }
+  }
+}
+
+} // end namespace Eigen
+
+#endif // EIGEN_SPARSE_SELL_MATRIX_H
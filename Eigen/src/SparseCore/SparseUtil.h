@@ -49,10 +49,23 @@ const int InnerRandomAccessPattern  = 0x2 | CoherentAccessPattern;
 const int OuterRandomAccessPattern  = 0x4 | CoherentAccessPattern;
 const int RandomAccessPattern       = 0x8 | OuterRandomAccessPattern | InnerRandomAccessPattern;
 
+/** \ingroup SparseCore_Module
+  * How SparseMatrix::setFromTriplets() sorts the entries of the matrix.
+  */
+enum TripletAssembly {
+  /** The triplets are bucketed by inner index into a matrix of the opposite storage order,
+    * and the transposed copy of this matrix sorts the entries. This is the default. */
+  TransposedAssembly,
+  /** The triplets are bucketed by outer index directly into the matrix, and each inner vector is
+    * sorted in place. This saves the intermediate matrix, at the price of a sort per inner vector. */
+  SortedAssembly
+};
+
 template<typename _Scalar, int _Flags = 0, typename _StorageIndex = int>  class SparseMatrix;
 template<typename _Scalar, int _Flags = 0, typename _StorageIndex = int>  class DynamicSparseMatrix;
 template<typename _Scalar, int _Flags = 0, typename _StorageIndex = int>  class SparseVector;
 template<typename _Scalar, int _Flags = 0, typename _StorageIndex = int>  class MappedSparseMatrix;
+template<typename _Scalar, typename _StorageIndex = int>                class SparseSellMatrix;
 
 template<typename MatrixType, unsigned int UpLo>  class SparseSelfAdjointView;
 template<typename Lhs, typename Rhs>              class SparseDiagonalProduct;
@@ -377,6 +377,32 @@ cube() const
   return CubeReturnType(derived());
 }
 
+/** \returns an expression of the coefficients of \c *this (which must be integers)
+  * arithmetically shifted right by \a N bit positions.
+  *
+  * \sa shiftLeft()
+  */
+template<int N>
+EIGEN_DEVICE_FUNC
+inline const CwiseUnaryOp<internal::scalar_shift_right_op<Scalar, N>, const Derived>
+shiftRight() const
+{
+  return CwiseUnaryOp<internal::scalar_shift_right_op<Scalar, N>, const Derived>(derived());
+}
+
+/** \returns an expression of the coefficients of \c *this (which must be integers)
+  * shifted left by \a N bit positions.
+  *
+  * \sa shiftRight()
+  */
+template<int N>
+EIGEN_DEVICE_FUNC
+inline const CwiseUnaryOp<internal::scalar_shift_left_op<Scalar, N>, const Derived>
+shiftLeft() const
+{
+  return CwiseUnaryOp<internal::scalar_shift_left_op<Scalar, N>, const Derived>(derived());
+}
+
 /** \returns an expression of the coefficient-wise round of *this.
   *
   * Example: \include Cwise_round.cpp
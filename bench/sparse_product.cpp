@@ -158,6 +158,14 @@ int main(int argc, char *argv[])
       BENCH(sm3 = sm1 * sm2; )
       std::cout << "   a * b:\t" << timer.value() << endl;
 
+      // symbolic and numeric phases, then the numeric phase alone
+      SparseMatrixProduct<EigenSparseMatrix> prod;
+      BENCH(prod.compute(sm1, sm2); )
+      std::cout << "   a * b (pattern + values):\t" << timer.value() << endl;
+
+      BENCH(prod.computeValues(sm1, sm2); )
+      std::cout << "   a * b (values only):\t" << timer.value() << endl;
+
 //       BENCH(sm3 = sm1.transpose() * sm2; )
 //       std::cout << "   a' * b:\t" << timer.value() << endl;
 // //
@@ -0,0 +1,49 @@
+#define EIGEN_USE_THREADS
+
+#include <string>
+
+#include "tensor_benchmarks.h"
+
+// Compares the throughput of the same computations on a thread pool that
+// ignores the NUMA layout of the machine, on a pool that groups its threads
+// per node (local-first stealing), and on pools that also pin the threads to
+// the cpus of their node or to a single cpu.
+#define CREATE_NUMA_THREAD_POOL(threads, affinity)                       \
+Eigen::NonBlockingThreadPool pool(threads, topology, affinity);         \
+Eigen::ThreadPoolDevice device(&pool, threads);
+
+static const Eigen::ThreadTopology topology = Eigen::ThreadTopology::Detect();
+
+#define BM_FuncNumaCPU(FUNC, AFFINITY)                                        \
+  static void BM_##FUNC##_##AFFINITY(int iters, int Threads) {                \
+    StopBenchmarkTiming();                                                    \
+    CREATE_NUMA_THREAD_POOL(Threads, Eigen::AFFINITY);                        \
+    BenchmarkSuite<Eigen::ThreadPoolDevice, float> suite(device, 2048);       \
+    suite.FUNC(iters);                                                        \
+  }                                                                           \
+  BENCHMARK_RANGE(BM_##FUNC##_##AFFINITY, 1, 64);
+
+#define BM_FuncUniformCPU(FUNC)                                               \
+  static void BM_##FUNC##_Uniform(int iters, int Threads) {                   \
+    StopBenchmarkTiming();                                                    \
+    Eigen::NonBlockingThreadPool pool(Threads);                               \
+    Eigen::ThreadPoolDevice device(&pool, Threads);                           \
+    BenchmarkSuite<Eigen::ThreadPoolDevice, float> suite(device, 2048);       \
+    suite.FUNC(iters);                                                        \
+  }                                                                           \
+  BENCHMARK_RANGE(BM_##FUNC##_Uniform, 1, 64);
+
+BM_FuncUniformCPU(contraction);
+BM_FuncNumaCPU(contraction, kNoAffinity);
+BM_FuncNumaCPU(contraction, kNodeAffinity);
+BM_FuncNumaCPU(contraction, kCpuAffinity);
+
+BM_FuncUniformCPU(coeffWiseOp);
+BM_FuncNumaCPU(coeffWiseOp, kNoAffinity);
+BM_FuncNumaCPU(coeffWiseOp, kNodeAffinity);
+BM_FuncNumaCPU(coeffWiseOp, kCpuAffinity);
+
+BM_FuncUniformCPU(rowReduction);
+BM_FuncNumaCPU(rowReduction, kNoAffinity);
+BM_FuncNumaCPU(rowReduction, kNodeAffinity);
+BM_FuncNumaCPU(rowReduction, kCpuAffinity);
@@ -455,6 +455,84 @@ for (int iter = 0; iter < 10; ++iter) {
     finalizeBenchmark(static_cast<int64_t>(k_) * n_ * num_iters);
   }
 
+  // Row and column reductions with the other standard reducers, along a
+  // dimension that is only known at runtime.
+  void rowReductionMean(int num_iters) {
+    reduction(num_iters, 0, Eigen::internal::MeanReducer<T>());
+  }
+  void rowReductionMax(int num_iters) {
+    reduction(num_iters, 0, Eigen::internal::MaxReducer<T>());
+  }
+  void rowReductionMin(int num_iters) {
+    reduction(num_iters, 0, Eigen::internal::MinReducer<T>());
+  }
+  void rowReductionProd(int num_iters) {
+    reduction(num_iters, 0, Eigen::internal::ProdReducer<T>());
+  }
+  void colReductionMean(int num_iters) {
+    reduction(num_iters, 1, Eigen::internal::MeanReducer<T>());
+  }
+  void colReductionMax(int num_iters) {
+    reduction(num_iters, 1, Eigen::internal::MaxReducer<T>());
+  }
+  void colReductionMin(int num_iters) {
+    reduction(num_iters, 1, Eigen::internal::MinReducer<T>());
+  }
+  void colReductionProd(int num_iters) {
+    reduction(num_iters, 1, Eigen::internal::ProdReducer<T>());
+  }
+
+  // Cumulative sum along the first dimension: many short lines, with
+  // adjacent lines next to each other in memory.
+  void rowScan(int num_iters) {
+    Eigen::array<TensorIndex, 2> size;
+    size[0] = k_;
+    size[1] = n_;
+    const TensorMap<Tensor<T, 2, 0, TensorIndex>, Eigen::Aligned> B(b_, size);
+    TensorMap<Tensor<T, 2, 0, TensorIndex>, Eigen::Aligned> C(c_, size);
+
+    StartBenchmarkTiming();
+    for (int iter = 0; iter < num_iters; ++iter) {
+      C.device(device_) = B.cumsum(0);
+    }
+    // Record the number of FLOP executed per second (assuming one operation
+    // per value)
+    finalizeBenchmark(static_cast<int64_t>(k_) * n_ * num_iters);
+  }
+
+  // Cumulative sum along the last dimension: lines are strided.
+  void colScan(int num_iters) {
+    Eigen::array<TensorIndex, 2> size;
+    size[0] = k_;
+    size[1] = n_;
+    const TensorMap<Tensor<T, 2, 0, TensorIndex>, Eigen::Aligned> B(b_, size);
+    TensorMap<Tensor<T, 2, 0, TensorIndex>, Eigen::Aligned> C(c_, size);
+
+    StartBenchmarkTiming();
+    for (int iter = 0; iter < num_iters; ++iter) {
+      C.device(device_) = B.cumsum(1);
+    }
+    // Record the number of FLOP executed per second (assuming one operation
+    // per value)
+    finalizeBenchmark(static_cast<int64_t>(k_) * n_ * num_iters);
+  }
+
+  // Cumulative sum of a single long line.
+  void fullScan(int num_iters) {
+    Eigen::array<TensorIndex, 1> size;
+    size[0] = k_ * n_;
+    const TensorMap<Tensor<T, 1, 0, TensorIndex>, Eigen::Aligned> B(b_, size);
+    TensorMap<Tensor<T, 1, 0, TensorIndex>, Eigen::Aligned> C(c_, size);
+
+    StartBenchmarkTiming();
+    for (int iter = 0; iter < num_iters; ++iter) {
+      C.device(device_) = B.cumsum(0);
+    }
+    // Record the number of FLOP executed per second (assuming one operation
+    // per value)
+    finalizeBenchmark(static_cast<int64_t>(k_) * n_ * num_iters);
+  }
+
   // do a contraction which is equivalent to a matrix multiplication
   void contraction(int num_iters) {
     Eigen::array<TensorIndex, 2> sizeA;
@@ -520,6 +598,33 @@ for (int iter = 0; iter < 10; ++iter) {
   }
 
  private:
+  template <typename Reducer>
+  void reduction(int num_iters, int dim, const Reducer& reducer) {
+    Eigen::array<TensorIndex, 2> input_size;
+    input_size[0] = k_;
+    input_size[1] = n_;
+    const TensorMap<Tensor<T, 2, 0, TensorIndex>, Eigen::Aligned> B(
+        b_, input_size);
+    Eigen::array<TensorIndex, 1> output_size;
+    output_size[0] = input_size[1 - dim];
+    TensorMap<Tensor<T, 1, 0, TensorIndex>, Eigen::Aligned> C(
+        c_, output_size);
+    Eigen::array<TensorIndex, 1> reduce_along_dim;
+    reduce_along_dim[0] = dim;
+#ifdef EIGEN_USE_SYCL // warmup for sycl
+    for (int iter = 0; iter < 10; ++iter) {
+      C.device(device_) = B.reduce(reduce_along_dim, reducer);
+    }
+#endif
+    StartBenchmarkTiming();
+    for (int iter = 0; iter < num_iters; ++iter) {
+      C.device(device_) = B.reduce(reduce_along_dim, reducer);
+    }
+    // Record the number of FLOP executed per second (assuming one operation
+    // per value)
+    finalizeBenchmark(static_cast<int64_t>(k_) * n_ * num_iters);
+  }
+
   void initialize() {
     a_ = (T *) device_.allocate(m_ * k_ * sizeof(T));
     b_ = (T *) device_.allocate(k_ * n_ * sizeof(T));
@@ -78,6 +78,50 @@ BM_FuncCPU(colReduction, 4);
 BM_FuncCPU(colReduction, 8);
 BM_FuncCPU(colReduction, 12);
 
+BM_FuncCPU(rowReductionMean, 4);
+BM_FuncCPU(rowReductionMean, 8);
+BM_FuncCPU(rowReductionMean, 12);
+
+BM_FuncCPU(rowReductionMax, 4);
+BM_FuncCPU(rowReductionMax, 8);
+BM_FuncCPU(rowReductionMax, 12);
+
+BM_FuncCPU(rowReductionMin, 4);
+BM_FuncCPU(rowReductionMin, 8);
+BM_FuncCPU(rowReductionMin, 12);
+
+BM_FuncCPU(rowReductionProd, 4);
+BM_FuncCPU(rowReductionProd, 8);
+BM_FuncCPU(rowReductionProd, 12);
+
+BM_FuncCPU(colReductionMean, 4);
+BM_FuncCPU(colReductionMean, 8);
+BM_FuncCPU(colReductionMean, 12);
+
+BM_FuncCPU(colReductionMax, 4);
+BM_FuncCPU(colReductionMax, 8);
+BM_FuncCPU(colReductionMax, 12);
+
+BM_FuncCPU(colReductionMin, 4);
+BM_FuncCPU(colReductionMin, 8);
+BM_FuncCPU(colReductionMin, 12);
+
+BM_FuncCPU(colReductionProd, 4);
+BM_FuncCPU(colReductionProd, 8);
+BM_FuncCPU(colReductionProd, 12);
+
+BM_FuncCPU(rowScan, 4);
+BM_FuncCPU(rowScan, 8);
+BM_FuncCPU(rowScan, 12);
+
+BM_FuncCPU(colScan, 4);
+BM_FuncCPU(colScan, 8);
+BM_FuncCPU(colScan, 12);
+
+BM_FuncCPU(fullScan, 4);
+BM_FuncCPU(fullScan, 8);
+BM_FuncCPU(fullScan, 12);
+
 
 // Contractions
 #define BM_FuncWithInputDimsCPU(FUNC, D1, D2, D3, THREADS)                      \
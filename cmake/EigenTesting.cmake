@@ -425,6 +425,12 @@ macro(ei_testing_print_summary)
       message(STATUS "AVX:               Using architecture defaults")
     endif()
 
+    if(EIGEN_TEST_AVX2)
+      message(STATUS "AVX2:              ON")
+    else()
+      message(STATUS "AVX2:              Using architecture defaults")
+    endif()
+
     if(EIGEN_TEST_FMA)
       message(STATUS "FMA:               ON")
     else()
@@ -635,6 +641,8 @@ macro(ei_get_cxxflags VAR)
     set(${VAR} ALVEC)
   elseif(EIGEN_TEST_FMA)
     set(${VAR} FMA)
+  elseif(EIGEN_TEST_AVX2)
+    set(${VAR} AVX2)
   elseif(EIGEN_TEST_AVX)
     set(${VAR} AVX)
   elseif(EIGEN_TEST_SSE4_2)
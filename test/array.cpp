@@ -454,6 +454,55 @@ template<typename ArrayType> void min_max(const ArrayType& m)
 
 }
 
+template<typename ArrayType> void array_integer(const ArrayType& m)
+{
+  typedef typename ArrayType::Index Index;
+  typedef typename ArrayType::Scalar Scalar;
+
+  Index rows = m.rows();
+  Index cols = m.cols();
+
+  ArrayType m1 = ArrayType::Random(rows, cols),
+            m2(rows, cols);
+
+  m2 = m1.template shiftRight<2>();
+  for(Index j=0; j<cols; ++j)
+    for(Index i=0; i<rows; ++i)
+    {
+      VERIFY_IS_EQUAL(m2(i,j), Scalar(m1(i,j) >> 2));
+    }
+
+  m2 = m1.template shiftLeft<9>();
+  for(Index j=0; j<cols; ++j)
+    for(Index i=0; i<rows; ++i)
+    {
+      VERIFY_IS_EQUAL(m2(i,j), internal::plogical_shift_left<9>(m1(i,j)));
+      // the scalar path agrees with the vectorized one on negative values too
+      VERIFY_IS_EQUAL(m1.template shiftLeft<9>().coeff(i,j), internal::plogical_shift_left<9>(m1(i,j)));
+    }
+  VERIFY_IS_EQUAL(ArrayType::Constant(rows, cols, Scalar(-3)).template shiftLeft<4>().coeff(0,0), Scalar(-48));
+
+  // shifts combined with other coefficient-wise operations
+  m2 = m1.template shiftLeft<5>() + m1.template shiftRight<3>();
+  for(Index j=0; j<cols; ++j)
+    for(Index i=0; i<rows; ++i)
+    {
+      VERIFY_IS_EQUAL(m2(i,j), Scalar(internal::plogical_shift_left<5>(m1(i,j)) + (m1(i,j) >> 3)));
+    }
+
+  Scalar ref_sum = 0, ref_min = m1(0,0), ref_max = m1(0,0);
+  for(Index j=0; j<cols; ++j)
+    for(Index i=0; i<rows; ++i)
+    {
+      ref_sum += m1(i,j);
+      ref_min = (std::min)(ref_min, m1(i,j));
+      ref_max = (std::max)(ref_max, m1(i,j));
+    }
+  VERIFY_IS_EQUAL(m1.sum(), ref_sum);
+  VERIFY_IS_EQUAL(m1.minCoeff(), ref_min);
+  VERIFY_IS_EQUAL(m1.maxCoeff(), ref_max);
+}
+
 void test_array()
 {
   for(int i = 0; i < g_repeat; i++) {
@@ -484,6 +533,10 @@ void test_array()
     CALL_SUBTEST_3( array_real(Array44d()) );
     CALL_SUBTEST_5( array_real(ArrayXXf(internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE))) );
   }
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_6( array_integer(ArrayXXi(internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE))) );
+    CALL_SUBTEST_6( array_integer(Array<numext::int64_t,Dynamic,Dynamic>(internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE))) );
+  }
   for(int i = 0; i < g_repeat; i++) {
     CALL_SUBTEST_4( array_complex(ArrayXXcf(internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE))) );
   }
@@ -0,0 +1,202 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <sstream>
+
+#include "main.h"
+
+using Eigen::bfloat16;
+
+void test_conversion()
+{
+  using Eigen::bfloat16_impl::__bfloat16_raw;
+
+  // Conversion from float.
+  VERIFY_IS_EQUAL(bfloat16(1.0f).value, 0x3f80);
+  VERIFY_IS_EQUAL(bfloat16(0.5f).value, 0x3f00);
+  VERIFY_IS_EQUAL(bfloat16(0.33333f).value, 0x3eab);
+  VERIFY_IS_EQUAL(bfloat16(0.0f).value, 0x0000);
+  VERIFY_IS_EQUAL(bfloat16(-0.0f).value, 0x8000);
+  VERIFY_IS_EQUAL(bfloat16(3.38953139e38f).value, 0x7f7f);
+  VERIFY_IS_EQUAL(bfloat16(3.40282347e38f).value, 0x7f80);  // Becomes infinity.
+
+  // Denormals.
+  VERIFY_IS_EQUAL(bfloat16(-9.18354962e-41f).value, 0x8001);
+  VERIFY_IS_EQUAL(bfloat16(9.18354962e-41f).value, 0x0001);
+
+  // Verify round-to-nearest-even behavior.
+  float val1 = float(bfloat16(__bfloat16_raw(0x3f80)));
+  float val2 = float(bfloat16(__bfloat16_raw(0x3f81)));
+  float val3 = float(bfloat16(__bfloat16_raw(0x3f82)));
+  VERIFY_IS_EQUAL(bfloat16(0.5f * (val1 + val2)).value, 0x3f80);
+  VERIFY_IS_EQUAL(bfloat16(0.5f * (val2 + val3)).value, 0x3f82);
+
+  // Conversion from int.
+  VERIFY_IS_EQUAL(bfloat16(-1).value, 0xbf80);
+  VERIFY_IS_EQUAL(bfloat16(0).value, 0x0000);
+  VERIFY_IS_EQUAL(bfloat16(1).value, 0x3f80);
+  VERIFY_IS_EQUAL(bfloat16(2).value, 0x4000);
+  VERIFY_IS_EQUAL(bfloat16(3).value, 0x4040);
+
+  // Conversion from bool.
+  VERIFY_IS_EQUAL(bfloat16(false).value, 0x0000);
+  VERIFY_IS_EQUAL(bfloat16(true).value, 0x3f80);
+
+  // Conversion to float.
+  VERIFY_IS_EQUAL(float(bfloat16(__bfloat16_raw(0x0000))), 0.0f);
+  VERIFY_IS_EQUAL(float(bfloat16(__bfloat16_raw(0x3f80))), 1.0f);
+  VERIFY_IS_EQUAL(float(bfloat16(__bfloat16_raw(0xc040))), -3.0f);
+
+  // NaNs and infinities.
+  VERIFY(!(numext::isinf)(bfloat16(__bfloat16_raw(0x7f7f))));
+  VERIFY(!(numext::isnan)(bfloat16(__bfloat16_raw(0x0000))));
+  VERIFY((numext::isinf)(bfloat16(__bfloat16_raw(0xff80))));
+  VERIFY((numext::isnan)(bfloat16(__bfloat16_raw(0xff81))));
+  VERIFY((numext::isinf)(bfloat16(__bfloat16_raw(0x7f80))));
+  VERIFY((numext::isnan)(bfloat16(__bfloat16_raw(0x7f81))));
+  // NaNs must not be rounded into infinities.
+  VERIFY((numext::isnan)(bfloat16(float(bfloat16(__bfloat16_raw(0x7fff))))));
+  VERIFY((numext::isnan)(bfloat16(std::numeric_limits<float>::quiet_NaN())));
+}
+
+void test_numtraits()
+{
+  VERIFY(NumTraits<bfloat16>::IsSigned);
+
+  VERIFY_IS_EQUAL(float(NumTraits<bfloat16>::epsilon()), 0.0078125f);
+  VERIFY_IS_EQUAL(float(NumTraits<bfloat16>::highest()), 3.38953139e38f);
+  VERIFY_IS_EQUAL(float(NumTraits<bfloat16>::lowest()), -3.38953139e38f);
+  VERIFY_IS_EQUAL(float((std::numeric_limits<bfloat16>::min)()), (std::numeric_limits<float>::min)());
+
+  VERIFY_IS_EQUAL( std::numeric_limits<bfloat16>::infinity().value, bfloat16(std::numeric_limits<float>::infinity()).value );
+  VERIFY_IS_EQUAL( std::numeric_limits<bfloat16>::quiet_NaN().value, bfloat16(std::numeric_limits<float>::quiet_NaN()).value );
+  VERIFY( (std::numeric_limits<bfloat16>::denorm_min)() > bfloat16(0.f) );
+  VERIFY( (std::numeric_limits<bfloat16>::min)()/bfloat16(2) > bfloat16(0.f) );
+  VERIFY_IS_EQUAL( (std::numeric_limits<bfloat16>::denorm_min)()/bfloat16(2), bfloat16(0.f) );
+}
+
+void test_arithmetic()
+{
+  VERIFY_IS_EQUAL(float(bfloat16(2) + bfloat16(2)), 4);
+  VERIFY_IS_EQUAL(float(bfloat16(2) + bfloat16(-2)), 0);
+  VERIFY_IS_APPROX(bfloat16(0.33333f) + bfloat16(0.66667f), bfloat16(1.0f));
+  VERIFY_IS_EQUAL(float(bfloat16(2.0f) * bfloat16(-5.5f)), -11.0f);
+  VERIFY_IS_EQUAL((bfloat16(1.0f) / bfloat16(3.0f)).value, bfloat16(1.0f / 3.0f).value);
+  VERIFY_IS_EQUAL(float(-bfloat16(4096.0f)), -4096.0f);
+  VERIFY_IS_EQUAL(float(-bfloat16(-4096.0f)), 4096.0f);
+}
+
+void test_comparison()
+{
+  VERIFY(bfloat16(1.0f) > bfloat16(0.5f));
+  VERIFY(bfloat16(0.5f) < bfloat16(1.0f));
+  VERIFY(!(bfloat16(4.0f) > bfloat16(4.0f)));
+  VERIFY(!(bfloat16(0.0f) < bfloat16(-0.0f)));
+  VERIFY(bfloat16(-16.0f) < bfloat16(-15.0f));
+  VERIFY(bfloat16(1.0f) == bfloat16(1.0f));
+  VERIFY(bfloat16(1.0f) != bfloat16(2.0f));
+
+  const bfloat16 nan = std::numeric_limits<bfloat16>::quiet_NaN();
+  VERIFY(!(nan == nan));
+  VERIFY(nan != nan);
+  VERIFY(!(bfloat16(1.0f) < nan));
+  VERIFY(!(bfloat16(1.0f) > nan));
+  VERIFY(bfloat16(1.0f) < std::numeric_limits<bfloat16>::infinity());
+}
+
+void test_basic_functions()
+{
+  VERIFY_IS_EQUAL(float(numext::abs(bfloat16(-3.5f))), 3.5f);
+  VERIFY_IS_EQUAL(float(abs(bfloat16(-3.5f))), 3.5f);
+  VERIFY_IS_EQUAL(float(numext::floor(bfloat16(-3.5f))), -4.0f);
+  VERIFY_IS_EQUAL(float(numext::ceil(bfloat16(-3.5f))), -3.0f);
+  VERIFY_IS_EQUAL(float(numext::sqrt(bfloat16(4.0f))), 2.0f);
+  VERIFY_IS_EQUAL(float(numext::pow(bfloat16(2.0f), bfloat16(2.0f))), 4.0f);
+  VERIFY_IS_EQUAL(float(numext::exp(bfloat16(0.0f))), 1.0f);
+  VERIFY_IS_APPROX(numext::exp(bfloat16(EIGEN_PI)), bfloat16(20.f + float(EIGEN_PI)));
+  VERIFY_IS_EQUAL(float(numext::log(bfloat16(1.0f))), 0.0f);
+  VERIFY_IS_APPROX(numext::log(bfloat16(10.0f)), bfloat16(2.30258509f));
+}
+
+void test_array()
+{
+  typedef Array<bfloat16,1,Dynamic> ArrayXbf;
+  Index size = internal::random<Index>(1,10);
+  Index i = internal::random<Index>(0,size-1);
+  ArrayXbf a1 = ArrayXbf::Random(size), a2 = ArrayXbf::Random(size);
+  VERIFY_IS_APPROX( a1+a1, bfloat16(2)*a1 );
+  VERIFY( (a1.abs() >= bfloat16(0)).all() );
+  VERIFY_IS_APPROX( (a1*a1).sqrt(), a1.abs() );
+
+  VERIFY( ((a1.min)(a2) <= (a1.max)(a2)).all() );
+  a1(i) = bfloat16(-10.);
+  VERIFY_IS_EQUAL( a1.minCoeff(), bfloat16(-10.) );
+  a1(i) = bfloat16(10.);
+  VERIFY_IS_EQUAL( a1.maxCoeff(), bfloat16(10.) );
+
+  std::stringstream ss;
+  ss << a1;
+}
+
+void test_vectorized_array()
+{
+  // Large enough to go through the packet path; results must match the
+  // scalar fallback, which also rounds a float computation to bfloat16.
+  typedef Array<bfloat16,Dynamic,1> ArrayXbf;
+  Index size = internal::random<Index>(1,200);
+  ArrayXbf a = ArrayXbf::Random(size), b = ArrayXbf::Random(size);
+  b = (b.abs() < bfloat16(0.01f)).select(bfloat16(0.5f), b);
+  ArrayXf af = a.cast<float>(), bf = b.cast<float>();
+
+  ArrayXbf r_add = a + b, r_sub = a - b, r_mul = a * b, r_div = a / b;
+  ArrayXbf r_neg = -a, r_abs = a.abs(), r_min = (a.min)(b), r_max = (a.max)(b);
+  ArrayXbf r_sqrt = a.abs().sqrt();
+  for (Index i = 0; i < size; ++i) {
+    VERIFY_IS_EQUAL(r_add(i).value, bfloat16(af(i) + bf(i)).value);
+    VERIFY_IS_EQUAL(r_sub(i).value, bfloat16(af(i) - bf(i)).value);
+    VERIFY_IS_EQUAL(r_mul(i).value, bfloat16(af(i) * bf(i)).value);
+    VERIFY_IS_EQUAL(r_div(i).value, bfloat16(af(i) / bf(i)).value);
+    VERIFY_IS_EQUAL(r_neg(i).value, bfloat16(-af(i)).value);
+    VERIFY_IS_EQUAL(r_abs(i).value, bfloat16(std::abs(af(i))).value);
+    VERIFY_IS_EQUAL(r_min(i).value, bfloat16((std::min)(af(i), bf(i))).value);
+    VERIFY_IS_EQUAL(r_max(i).value, bfloat16((std::max)(af(i), bf(i))).value);
+    VERIFY_IS_APPROX(r_sqrt(i), bfloat16(std::sqrt(std::abs(af(i)))));
+  }
+
+  VERIFY(numext::abs(float(a.sum()) - af.sum()) <= 5e-2f * af.abs().sum());
+  VERIFY_IS_EQUAL(a.minCoeff(), bfloat16(af.minCoeff()));
+  VERIFY_IS_EQUAL(a.maxCoeff(), bfloat16(af.maxCoeff()));
+  VERIFY_IS_APPROX(a.exp(), af.exp().cast<bfloat16>());
+
+  ArrayXbf r_cast = af.cast<bfloat16>();
+  VERIFY((r_cast.cast<float>() == af).all());
+}
+
+void test_product()
+{
+  typedef Matrix<bfloat16,Dynamic,Dynamic> MatrixXbf;
+  Index rows = internal::random<Index>(1,64);
+  Index depth = internal::random<Index>(1,64);
+  Index cols = internal::random<Index>(1,64);
+  MatrixXbf a = MatrixXbf::Random(rows,depth), b = MatrixXbf::Random(depth,cols);
+  MatrixXf ref = a.cast<float>() * b.cast<float>();
+  MatrixXbf c = a * b;
+  // The accumulation happens in bfloat16, so only compare at that precision.
+  VERIFY((c.cast<float>() - ref).cwiseAbs().maxCoeff() <= 1e-1f * (depth + 1));
+}
+
+void test_bfloat16_float()
+{
+  CALL_SUBTEST(test_conversion());
+  CALL_SUBTEST(test_numtraits());
+  CALL_SUBTEST(test_arithmetic());
+  CALL_SUBTEST(test_comparison());
+  CALL_SUBTEST(test_basic_functions());
+  CALL_SUBTEST(test_array());
+  CALL_SUBTEST(test_vectorized_array());
+  CALL_SUBTEST(test_product());
+}
@@ -257,6 +257,50 @@ void test_array()
   ss << a1;
 }
 
+void test_vectorized_array()
+{
+  // Large enough to go through the packet path; results must match the
+  // scalar fallback, which also rounds a float computation to half.
+  typedef Array<half,Dynamic,1> ArrayXh;
+  Index size = internal::random<Index>(1,200);
+  ArrayXh a = ArrayXh::Random(size), b = ArrayXh::Random(size);
+  b = (b.abs() < half(0.01f)).select(half(0.5f), b);
+  ArrayXf af = a.cast<float>(), bf = b.cast<float>();
+
+  ArrayXh r_add = a + b, r_sub = a - b, r_mul = a * b, r_div = a / b;
+  ArrayXh r_neg = -a, r_abs = a.abs(), r_min = (a.min)(b), r_max = (a.max)(b);
+  ArrayXh r_sqrt = a.abs().sqrt();
+  for (Index i = 0; i < size; ++i) {
+    VERIFY_IS_EQUAL(r_add(i).x, half(af(i) + bf(i)).x);
+    VERIFY_IS_EQUAL(r_sub(i).x, half(af(i) - bf(i)).x);
+    VERIFY_IS_EQUAL(r_mul(i).x, half(af(i) * bf(i)).x);
+    VERIFY_IS_EQUAL(r_div(i).x, half(af(i) / bf(i)).x);
+    VERIFY_IS_EQUAL(r_neg(i).x, half(-af(i)).x);
+    VERIFY_IS_EQUAL(r_abs(i).x, half(std::abs(af(i))).x);
+    VERIFY_IS_EQUAL(r_min(i).x, half((std::min)(af(i), bf(i))).x);
+    VERIFY_IS_EQUAL(r_max(i).x, half((std::max)(af(i), bf(i))).x);
+    VERIFY_IS_APPROX(float(r_sqrt(i)), std::sqrt(std::abs(af(i))));
+  }
+
+  VERIFY(numext::abs(float(a.sum()) - af.sum()) <= 1e-2f * af.abs().sum());
+  VERIFY_IS_EQUAL(a.minCoeff(), half(af.minCoeff()));
+  VERIFY_IS_EQUAL(a.maxCoeff(), half(af.maxCoeff()));
+  VERIFY_IS_APPROX(a.exp().cast<float>(), af.exp());
+}
+
+void test_product()
+{
+  typedef Matrix<half,Dynamic,Dynamic> MatrixXh;
+  Index rows = internal::random<Index>(1,64);
+  Index depth = internal::random<Index>(1,64);
+  Index cols = internal::random<Index>(1,64);
+  MatrixXh a = MatrixXh::Random(rows,depth), b = MatrixXh::Random(depth,cols);
+  MatrixXf ref = a.cast<float>() * b.cast<float>();
+  MatrixXh c = a * b;
+  // The accumulation happens in half, so only compare at half precision.
+  VERIFY((c.cast<float>() - ref).cwiseAbs().maxCoeff() <= 1e-2f * (depth + 1));
+}
+
 void test_half_float()
 {
   CALL_SUBTEST(test_conversion());
@@ -266,4 +310,6 @@ void test_half_float()
   CALL_SUBTEST(test_basic_functions());
   CALL_SUBTEST(test_trigonometric_functions());
   CALL_SUBTEST(test_array());
+  CALL_SUBTEST(test_vectorized_array());
+  CALL_SUBTEST(test_product());
 }
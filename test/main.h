@@ -48,6 +48,11 @@
 #ifdef EIGEN_USE_THREADS
 #include <future>
 #endif
+#ifdef EIGEN_GEMM_THREADPOOL
+#include <atomic>
+#include <functional>
+#include <thread>
+#endif
 #endif
 
 // Same for cuda_fp16.h
@@ -397,6 +402,13 @@ inline bool test_isMuchSmallerThan(const half& a, const half& b)
 inline bool test_isApproxOrLessThan(const half& a, const half& b)
 { return internal::isApproxOrLessThan(a, b, test_precision<half>()); }
 
+inline bool test_isApprox(const bfloat16& a, const bfloat16& b)
+{ return internal::isApprox(a, b, test_precision<bfloat16>()); }
+inline bool test_isMuchSmallerThan(const bfloat16& a, const bfloat16& b)
+{ return internal::isMuchSmallerThan(a, b, test_precision<bfloat16>()); }
+inline bool test_isApproxOrLessThan(const bfloat16& a, const bfloat16& b)
+{ return internal::isApproxOrLessThan(a, b, test_precision<bfloat16>()); }
+
 // test_relative_error returns the relative difference between a and b as a real scalar as used in isApprox.
 template<typename T1,typename T2>
 typename NumTraits<typename T1::RealScalar>::NonInteger test_relative_error(const EigenBase<T1> &a, const EigenBase<T2> &b)
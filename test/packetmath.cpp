@@ -178,7 +178,7 @@ template<typename Scalar> void packetmath()
   VERIFY((!PacketTraits::Vectorizable) || PacketTraits::HasSub);
   VERIFY((!PacketTraits::Vectorizable) || PacketTraits::HasMul);
   VERIFY((!PacketTraits::Vectorizable) || PacketTraits::HasNegate);
-  VERIFY((internal::is_same<Scalar,int>::value) || (!PacketTraits::Vectorizable) || PacketTraits::HasDiv);
+  VERIFY(NumTraits<Scalar>::IsInteger || (!PacketTraits::Vectorizable) || PacketTraits::HasDiv);
 
   CHECK_CWISE2_IF(PacketTraits::HasAdd, REF_ADD,  internal::padd);
   CHECK_CWISE2_IF(PacketTraits::HasSub, REF_SUB,  internal::psub);
@@ -248,12 +248,14 @@ template<typename Scalar> void packetmath()
   VERIFY(isApproxAbs(ref[0], internal::predux(internal::pload<Packet>(data1)), refvalue) && "internal::predux");
 
   {
-    for (int i=0; i<4; ++i)
+    // packets of 8 or more elements are reduced to their half packet
+    const int HalfPacketSize = PacketSize>4 ? PacketSize/2 : PacketSize;
+    for (int i=0; i<HalfPacketSize; ++i)
       ref[i] = 0;
     for (int i=0; i<PacketSize; ++i)
-      ref[i%4] += data1[i];
+      ref[i%HalfPacketSize] += data1[i];
     internal::pstore(data2, internal::predux_downto4(internal::pload<Packet>(data1)));
-    VERIFY(areApprox(ref, data2, PacketSize>4?PacketSize/2:PacketSize) && "internal::predux_downto4");
+    VERIFY(areApprox(ref, data2, HalfPacketSize) && "internal::predux_downto4");
   }
 
   ref[0] = 1;
@@ -517,6 +519,44 @@ template<typename Scalar> void packetmath_notcomplex()
   VERIFY(areApprox(ref, data2, PacketSize) && "internal::plset");
 }
 
+template<typename Scalar> void packetmath_integer()
+{
+  typedef internal::packet_traits<Scalar> PacketTraits;
+  typedef typename PacketTraits::type Packet;
+  const int PacketSize = PacketTraits::size;
+
+  EIGEN_ALIGN_MAX Scalar data1[PacketTraits::size*4];
+  EIGEN_ALIGN_MAX Scalar data2[PacketTraits::size*4];
+  EIGEN_ALIGN_MAX Scalar ref[PacketTraits::size*4];
+
+  Array<Scalar,Dynamic,1>::Map(data1, PacketTraits::size*4).setRandom();
+  // make sure both signs are exercised
+  data1[0] = -numext::abs(data1[0]);
+  data1[1] =  numext::abs(data1[1]);
+
+  CHECK_CWISE1_IF(PacketTraits::HasShift, internal::parithmetic_shift_right<1>, internal::parithmetic_shift_right<1>);
+  CHECK_CWISE1_IF(PacketTraits::HasShift, internal::parithmetic_shift_right<13>, internal::parithmetic_shift_right<13>);
+  CHECK_CWISE1_IF(PacketTraits::HasShift, internal::plogical_shift_right<1>, internal::plogical_shift_right<1>);
+  CHECK_CWISE1_IF(PacketTraits::HasShift, internal::plogical_shift_right<13>, internal::plogical_shift_right<13>);
+  CHECK_CWISE1_IF(PacketTraits::HasShift, internal::plogical_shift_left<1>, internal::plogical_shift_left<1>);
+  CHECK_CWISE1_IF(PacketTraits::HasShift, internal::plogical_shift_left<13>, internal::plogical_shift_left<13>);
+
+  for (int i=0; i<PacketSize; ++i)
+    ref[i] = data1[i] & data1[i+PacketSize];
+  internal::pstore(data2, internal::pand(internal::pload<Packet>(data1), internal::pload<Packet>(data1+PacketSize)));
+  VERIFY(areApprox(ref, data2, PacketSize) && "internal::pand");
+
+  for (int i=0; i<PacketSize; ++i)
+    ref[i] = data1[i] | data1[i+PacketSize];
+  internal::pstore(data2, internal::por(internal::pload<Packet>(data1), internal::pload<Packet>(data1+PacketSize)));
+  VERIFY(areApprox(ref, data2, PacketSize) && "internal::por");
+
+  for (int i=0; i<PacketSize; ++i)
+    ref[i] = data1[i] ^ data1[i+PacketSize];
+  internal::pstore(data2, internal::pxor(internal::pload<Packet>(data1), internal::pload<Packet>(data1+PacketSize)));
+  VERIFY(areApprox(ref, data2, PacketSize) && "internal::pxor");
+}
+
 template<typename Scalar,bool ConjLhs,bool ConjRhs> void test_conj_helper(Scalar* data1, Scalar* data2, Scalar* ref, Scalar* pval)
 {
   typedef internal::packet_traits<Scalar> PacketTraits;
@@ -638,5 +678,11 @@ void test_packetmath()
     CALL_SUBTEST_3( packetmath_scatter_gather<int>() );
     CALL_SUBTEST_4( packetmath_scatter_gather<std::complex<float> >() );
     CALL_SUBTEST_5( packetmath_scatter_gather<std::complex<double> >() );
+
+    CALL_SUBTEST_3( packetmath_integer<int>() );
+    CALL_SUBTEST_6( packetmath<numext::int64_t>() );
+    CALL_SUBTEST_6( packetmath_notcomplex<numext::int64_t>() );
+    CALL_SUBTEST_6( packetmath_integer<numext::int64_t>() );
+    CALL_SUBTEST_6( packetmath_scatter_gather<numext::int64_t>() );
   }
 }
@@ -0,0 +1,55 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_TEST_PARALLEL_BACKEND_H
+#define EIGEN_TEST_PARALLEL_BACKEND_H
+
+// The tests are not compiled with OpenMP by default. The tests defining EIGEN_GEMM_THREADPOOL before including main.h
+// can run the multi-threaded code paths on the threads of a TestParallelBackend:
+// \code
+// TestParallelBackend backend(4);
+// ScopedGemmParallelBackend scope(&backend);
+// \endcode
+#ifdef EIGEN_GEMM_THREADPOOL
+
+// Runs each task on its own thread, and counts the calls to run()
+class TestParallelBackend : public Eigen::GemmParallelBackend
+{
+  public:
+    explicit TestParallelBackend(int threads) : calls(0), m_threads(threads) {}
+
+    int numThreads() const { return m_threads; }
+
+    bool isWorkerThread() const { return is_worker(); }
+
+    bool run(int n, const std::function<void(int)>& task)
+    {
+      ++calls;
+      std::vector<std::thread> workers;
+      for(int i = 1; i < n; ++i)
+        workers.push_back(std::thread([&task, i]() { is_worker() = true; task(i); }));
+      task(0);
+      for(size_t i = 0; i < workers.size(); ++i)
+        workers[i].join();
+      return true;
+    }
+
+    std::atomic<int> calls;
+
+  private:
+    static bool& is_worker()
+    {
+      static thread_local bool worker = false;
+      return worker;
+    }
+
+    int m_threads;
+};
+
+#endif // EIGEN_GEMM_THREADPOOL
+
+#endif // EIGEN_TEST_PARALLEL_BACKEND_H
@@ -30,6 +30,36 @@ void test_aliasing()
   x = z;
 }
 
+// The last rows of the lhs which do not fill a packet are computed by the "swapped" kernel of gebp, with the rows of
+// the rhs in the packets. This checks all the remainders up to 15 rows and odd depths for complex scalars.
+template<typename T>
+void test_swapped_gebp()
+{
+  typedef Matrix<T,Dynamic,Dynamic> MatrixType;
+  for(int r = 1; r < 16; ++r)
+  {
+    int rows = 16*internal::random<int>(0,2) + r;
+    int depth = internal::random<int>(1,60);
+    int cols = 4*internal::random<int>(1,6) + internal::random<int>(0,3);
+    MatrixType a = MatrixType::Random(rows,depth), b = MatrixType::Random(depth,cols);
+    MatrixType c = MatrixType::Random(rows,cols), c0 = c;
+    T alpha = internal::random<T>();
+
+    c.noalias() += alpha * a * b;
+    VERIFY_IS_APPROX(c, c0 + alpha * a.lazyProduct(b));
+    c = c0;
+    c.noalias() += a.conjugate() * b;
+    VERIFY_IS_APPROX(c, c0 + a.conjugate().lazyProduct(b));
+    c = c0;
+    c.noalias() -= a * b.conjugate();
+    VERIFY_IS_APPROX(c, c0 - a.lazyProduct(b.conjugate()));
+    MatrixType at = a.adjoint();
+    c = c0;
+    c.noalias() += at.adjoint() * b.conjugate();
+    VERIFY_IS_APPROX(c, c0 + a.lazyProduct(b.conjugate()));
+  }
+}
+
 void test_product_large()
 {
   for(int i = 0; i < g_repeat; i++) {
@@ -40,6 +70,9 @@ void test_product_large()
     CALL_SUBTEST_5( product(Matrix<float,Dynamic,Dynamic,RowMajor>(internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE))) );
 
     CALL_SUBTEST_1( test_aliasing<float>() );
+
+    CALL_SUBTEST_4( test_swapped_gebp<std::complex<float> >() );
+    CALL_SUBTEST_7( test_swapped_gebp<std::complex<double> >() );
   }
 
 #if defined EIGEN_TEST_PART_6
@@ -12,7 +12,12 @@
 static long g_realloc_count = 0;
 #define EIGEN_SPARSE_COMPRESSED_STORAGE_REALLOCATE_PLUGIN g_realloc_count++;
 
+#if __cplusplus >= 201103L
+// to assemble the triplets on a TestParallelBackend
+#define EIGEN_GEMM_THREADPOOL
+#endif
 #include "sparse.h"
+#include "parallel_backend.h"
 
 template<typename SparseMatrixType> void sparse_basic(const SparseMatrixType& ref)
 {
@@ -389,6 +394,25 @@ template<typename SparseMatrixType> void sparse_basic(const SparseMatrixType& re
     m.setFromTriplets(triplets.begin(), triplets.end(), [] (Scalar,Scalar b) { return b; });
     VERIFY_IS_APPROX(m, refMat_last);
 #endif
+
+    // the sorted assembly gives the same matrix, without intermediate copy
+    SparseMatrixType m2(rows,cols);
+    m.setFromTriplets(triplets.begin(), triplets.end());
+    m2.setFromTriplets(triplets.begin(), triplets.end(), SortedAssembly);
+    VERIFY(m2.isCompressed());
+    VERIFY_IS_EQUAL(m2.nonZeros(), m.nonZeros());
+    VERIFY_IS_EQUAL(m2.toDense(), m.toDense());
+    for(Index j=0; j<m2.outerSize(); ++j)
+      for(Index k=m2.outerIndexPtr()[j]+1; k<m2.outerIndexPtr()[j+1]; ++k)
+        VERIFY(m2.innerIndexPtr()[k-1] < m2.innerIndexPtr()[k]);
+    m2.setFromTriplets(triplets.begin(), triplets.end(), std::multiplies<Scalar>(), SortedAssembly);
+    VERIFY_IS_APPROX(m2, refMat_prod);
+    m2.setFromTriplets(triplets.begin(), triplets.begin(), SortedAssembly);
+    VERIFY_IS_EQUAL(m2.nonZeros(), 0);
+#if (defined(__cplusplus) && __cplusplus >= 201103L)
+    m2.setFromTriplets(triplets.rbegin(), triplets.rend(), [] (Scalar a,Scalar) { return a; }, SortedAssembly);
+    VERIFY_IS_APPROX(m2, refMat_last);
+#endif
   }
   
   // test Map
@@ -638,8 +662,60 @@ void big_sparse_triplet(Index rows, Index cols, double density) {
   m.setFromTriplets(triplets.begin(), triplets.end());
   VERIFY(m.nonZeros() <= ntriplets);
   VERIFY_IS_APPROX(sum, m.sum());
+
+  SparseMatrixType m2(rows,cols);
+  m2.setFromTriplets(triplets.begin(), triplets.end(), SortedAssembly);
+  VERIFY_IS_EQUAL(m2.nonZeros(), m.nonZeros());
+  VERIFY_IS_APPROX(m2, m);
 }
 
+// Enough triplets, with duplicates, to be assembled by several threads
+template<typename SparseMatrixType>
+void big_sparse_triplet_parallel(Index rows, Index cols)
+{
+#ifdef EIGEN_GEMM_THREADPOOL
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef Triplet<Scalar,Index> TripletType;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  std::vector<TripletType> triplets;
+  const Index ntriplets = 150000;
+  triplets.reserve(ntriplets + ntriplets/3);
+  for(Index i=0;i<ntriplets;++i)
+    triplets.push_back(TripletType(internal::random<Index>(0,rows-1), internal::random<Index>(0,cols-1),
+                                   internal::random<Scalar>()));
+  // the duplicates are at the end, in the range of another thread than the first occurrences
+  for(Index i=0;i<ntriplets/3;++i)
+  {
+    TripletType t = triplets[internal::random<Index>(0,ntriplets-1)];
+    triplets.push_back(TripletType(t.row(), t.col(), internal::random<Scalar>()));
+  }
+
+  SparseMatrixType ref(rows,cols), refSorted(rows,cols), refLast(rows,cols);
+  ref.setFromTriplets(triplets.begin(), triplets.end());
+  refSorted.setFromTriplets(triplets.begin(), triplets.end(), SortedAssembly);
+  refLast.setFromTriplets(triplets.begin(), triplets.end(), [] (Scalar,Scalar b) { return b; });
+  VERIFY(ref.nonZeros() < Index(triplets.size()));
+
+  TestParallelBackend backend(4);
+  ScopedGemmParallelBackend scope(&backend);
+  VERIFY_IS_EQUAL(nbThreads(), 4);
+  SparseMatrixType m(rows,cols), m2(rows,cols), m3(rows,cols);
+  m.setFromTriplets(triplets.begin(), triplets.end());
+  m2.setFromTriplets(triplets.begin(), triplets.end(), SortedAssembly);
+  // the duplicates are combined in the order of the triplets
+  m3.setFromTriplets(triplets.begin(), triplets.end(), [] (Scalar,Scalar b) { return b; }, SortedAssembly);
+  VERIFY(backend.calls > 0);
+  VERIFY_IS_EQUAL(m.nonZeros(), ref.nonZeros());
+  VERIFY_IS_EQUAL(m2.nonZeros(), ref.nonZeros());
+  VERIFY_IS_EQUAL(m3.nonZeros(), ref.nonZeros());
+  VERIFY_IS_APPROX(m, ref);
+  VERIFY_IS_APPROX(m2, refSorted);
+  VERIFY_IS_EQUAL(DenseMatrix(m3), DenseMatrix(refLast));
+#else
+  EIGEN_UNUSED_VARIABLE(rows);
+  EIGEN_UNUSED_VARIABLE(cols);
+#endif
+}
 
 void test_sparse_basic()
 {
@@ -670,6 +746,8 @@ void test_sparse_basic()
   // Regression test for bug 900: (manually insert higher values here, if you have enough RAM):
   CALL_SUBTEST_3((big_sparse_triplet<SparseMatrix<float, RowMajor, int> >(10000, 10000, 0.125)));
   CALL_SUBTEST_4((big_sparse_triplet<SparseMatrix<double, ColMajor, long int> >(10000, 10000, 0.125)));
+  CALL_SUBTEST_3((big_sparse_triplet_parallel<SparseMatrix<float, RowMajor, int> >(1000, 1500)));
+  CALL_SUBTEST_4((big_sparse_triplet_parallel<SparseMatrix<double, ColMajor, long int> >(1500, 1000)));
 
   // Regression test for bug 1105
 #ifdef EIGEN_TEST_PART_7
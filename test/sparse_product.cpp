@@ -16,7 +16,12 @@ inline void on_temporary_creation() {
 
 #define EIGEN_SPARSE_CREATE_TEMPORARY_PLUGIN { on_temporary_creation(); }
 
+#if __cplusplus >= 201103L
+// to run the multi-threaded products on a TestParallelBackend
+#define EIGEN_GEMM_THREADPOOL
+#endif
 #include "sparse.h"
+#include "parallel_backend.h"
 
 #define VERIFY_EVALUATION_COUNT(XPR,N) {\
     nb_temporaries = 0; \
@@ -326,6 +331,202 @@ template<typename SparseMatrixType> void sparse_product()
   }
 }
 
+// Products with many right-hand side columns, exercising the tiles and their remainders
+template<typename SparseMatrixType> void sparse_product_multi_rhs(Index rows, Index depth)
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowDenseMatrix;
+
+  double density = (std::max)(8./(rows*depth), internal::random<double>(0.01,0.2));
+  DenseMatrix refMat = DenseMatrix::Zero(rows, depth);
+  SparseMatrixType m(rows, depth);
+  initSparse<Scalar>(density, refMat, m);
+
+  const Index cols[] = { 2, 3, 16, 17, 33, internal::random<Index>(2,70) };
+  for(int k=0; k<6; ++k)
+  {
+    DenseMatrix X = DenseMatrix::Random(depth, cols[k]);
+    RowDenseMatrix Xr = X;
+    DenseMatrix Y = DenseMatrix::Random(rows, cols[k]);
+    RowDenseMatrix Yr = Y;
+    DenseMatrix refY = Y;
+    Scalar alpha = internal::random<Scalar>();
+
+    VERIFY_IS_APPROX(Y.noalias() = m * X, refY = refMat * X);
+    VERIFY_IS_APPROX(Yr.noalias() = m * X, refY);
+    VERIFY_IS_APPROX(Y.noalias() = m * Xr, refY);
+    VERIFY_IS_APPROX(Yr.noalias() = m * Xr, refY);
+    VERIFY_IS_APPROX(Y.noalias() += alpha * (m * Xr), refY += alpha * (refMat * X));
+    Yr = Y;
+    VERIFY_IS_APPROX(Yr.noalias() -= m * X, refY -= refMat * X);
+    VERIFY_IS_APPROX(Yr.rightCols(cols[k]-1).noalias() += m * X.leftCols(cols[k]-1) * alpha,
+                     refY.rightCols(cols[k]-1) += refMat * X.leftCols(cols[k]-1) * alpha);
+    // transposed sparse operands and dense * sparse products
+    DenseMatrix Z = DenseMatrix::Random(rows, cols[k]);
+    VERIFY_IS_APPROX(X.noalias() = m.transpose() * Z, refMat.transpose() * Z);
+    VERIFY_IS_APPROX(Xr.noalias() = m.transpose() * Z, refMat.transpose() * Z);
+    VERIFY_IS_APPROX(X.noalias() = (Z.transpose() * m).transpose(), (Z.transpose() * refMat).transpose());
+    VERIFY_IS_APPROX(Yr.noalias() = Xr.transpose() * m.transpose(), Xr.transpose() * refMat.transpose());
+  }
+}
+
+// The multi-threaded tiled products must match the single-threaded ones
+template<typename SparseMatrixType> void sparse_product_multi_rhs_parallel()
+{
+#ifdef EIGEN_GEMM_THREADPOOL
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowDenseMatrix;
+  const Index rows = 2000, depth = 1500;
+  DenseMatrix refMat = DenseMatrix::Zero(rows, depth);
+  SparseMatrixType m(rows, depth);
+  initSparse<Scalar>(0.01, refMat, m);
+
+  const Index cols[] = { 3, 17, 64 };
+  DenseMatrix X[3], Y[3];
+  RowDenseMatrix Xr[3], Yr[3];
+  for(int k=0; k<3; ++k)
+  {
+    X[k] = DenseMatrix::Random(depth, cols[k]);
+    Xr[k] = X[k];
+    Y[k] = m * X[k];
+    Yr[k] = m * Xr[k];
+  }
+
+  TestParallelBackend backend(4);
+  ScopedGemmParallelBackend scope(&backend);
+  VERIFY_IS_EQUAL(nbThreads(), 4);
+  for(int k=0; k<3; ++k)
+  {
+    VERIFY_IS_APPROX(DenseMatrix(m * X[k]), Y[k]);
+    VERIFY_IS_APPROX(RowDenseMatrix(m * Xr[k]), Yr[k]);
+    VERIFY_IS_APPROX(Y[k], refMat * X[k]);
+  }
+  VERIFY(backend.calls >= 6);
+#endif
+}
+
+// Products whose pattern is computed once and whose values are recomputed
+template<typename SparseMatrixType> void sparse_product_reuse(Index rows, Index depth, Index cols)
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef typename SparseMatrixType::StorageIndex StorageIndex;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef SparseMatrix<Scalar,SparseMatrixType::IsRowMajor?ColMajor:RowMajor,StorageIndex> OtherSparseMatrixType;
+
+  double density = (std::max)(8./(rows*depth), internal::random<double>(0.01,0.2));
+  DenseMatrix refLhs = DenseMatrix::Zero(rows, depth);
+  DenseMatrix refRhs = DenseMatrix::Zero(depth, cols);
+  SparseMatrixType lhs(rows, depth), rhs(depth, cols);
+  initSparse<Scalar>(density, refLhs, lhs);
+  initSparse<Scalar>(density, refRhs, rhs);
+  lhs.makeCompressed();
+  rhs.makeCompressed();
+
+  SparseMatrixProduct<SparseMatrixType> prod(lhs, rhs);
+  VERIFY_IS_EQUAL(prod.rows(), rows);
+  VERIFY_IS_EQUAL(prod.cols(), cols);
+  VERIFY_IS_APPROX(DenseMatrix(prod.result()), refLhs * refRhs);
+  SparseMatrixType res = lhs * rhs;
+  VERIFY_IS_EQUAL(prod.nonZeros(), res.nonZeros());
+  VERIFY(prod.result().isCompressed());
+  for(Index j=0; j<prod.result().outerSize(); ++j)
+  {
+    Index previous = -1;
+    for(typename SparseMatrixType::InnerIterator it(prod.result(), j); it; ++it)
+    {
+      VERIFY(it.index() > previous);
+      previous = it.index();
+    }
+  }
+
+  // new values with the same patterns, then a subset of the patterns
+  for(int k=0; k<2; ++k)
+  {
+    lhs.coeffs().setRandom();
+    rhs.coeffs().setRandom();
+    if(k==1 && lhs.nonZeros()>0)
+      lhs.coeffs()(internal::random<Index>(0,lhs.nonZeros()-1)) = Scalar(0);
+    lhs.prune(Scalar(0));
+    VERIFY_IS_APPROX(DenseMatrix(prod.computeValues(lhs, rhs).result()), DenseMatrix(lhs) * DenseMatrix(rhs));
+    VERIFY_IS_EQUAL(prod.info(), Success);
+    VERIFY_IS_EQUAL(prod.nonZeros(), res.nonZeros());
+  }
+
+  // operands with the other storage order and expressions
+  OtherSparseMatrixType otherRhs = rhs;
+  VERIFY_IS_APPROX(DenseMatrix(prod.computeValues(lhs, otherRhs).result()), DenseMatrix(lhs) * DenseMatrix(rhs));
+  VERIFY_IS_APPROX(DenseMatrix(prod.computeValues(lhs * Scalar(2), rhs).result()), Scalar(2) * DenseMatrix(lhs) * DenseMatrix(rhs));
+  SparseMatrixType lhst = lhs.transpose();
+  VERIFY_IS_APPROX(DenseMatrix(prod.compute(lhst.transpose(), otherRhs).result()), DenseMatrix(lhs) * DenseMatrix(rhs));
+
+  // the product chains of multigrid methods
+  SparseMatrixType rhst = rhs.transpose();
+  SparseMatrixProduct<SparseMatrixType> RA(rhst, lhst), RAP(RA.result(), lhs);
+  VERIFY_IS_APPROX(DenseMatrix(RAP.result()), DenseMatrix(rhst) * DenseMatrix(lhst) * DenseMatrix(lhs));
+  lhs.coeffs() *= Scalar(3);
+  lhst = lhs.transpose();
+  RA.computeValues(rhst, lhst);
+  RAP.computeValues(RA.result(), lhs);
+  VERIFY_IS_APPROX(DenseMatrix(RAP.result()), DenseMatrix(rhst) * DenseMatrix(lhst) * DenseMatrix(lhs));
+
+  // operands whose product is not included in the pattern of the result: the entries of the other outer vectors are
+  // preserved and the error is reported
+  SparseMatrixType I(2,2), full(2,2);
+  I.setIdentity();
+  full = DenseMatrix::Ones(2,2).sparseView();
+  SparseMatrixProduct<SparseMatrixType> diag(I, I);
+  VERIFY_IS_EQUAL(diag.info(), Success);
+  VERIFY_IS_EQUAL(diag.computeValues(full, I).info(), InvalidInput);
+  VERIFY_IS_EQUAL(diag.nonZeros(), 2);
+  VERIFY_IS_EQUAL(DenseMatrix(diag.result()), DenseMatrix(DenseMatrix::Identity(2,2)));
+  VERIFY_IS_EQUAL(diag.computeValues(I * Scalar(2), I).info(), Success);
+  VERIFY_IS_EQUAL(DenseMatrix(diag.result()), DenseMatrix(Scalar(2) * DenseMatrix::Identity(2,2)));
+}
+
+// Sparse products large enough to be computed by several threads, in a symbolic and a numeric pass
+template<typename SparseMatrixType> void sparse_product_reuse_parallel()
+{
+#ifdef EIGEN_GEMM_THREADPOOL
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  const Index n = 1000;
+  DenseMatrix refLhs = DenseMatrix::Zero(n, n), refRhs = DenseMatrix::Zero(n, n);
+  SparseMatrixType lhs(n, n), rhs(n, n);
+  initSparse<Scalar>(0.02, refLhs, lhs);
+  initSparse<Scalar>(0.02, refRhs, rhs);
+  lhs.makeCompressed();
+  rhs.makeCompressed();
+  VERIFY(lhs.nonZeros() + rhs.nonZeros() > 20000);
+  const SparseMatrixType res = lhs * rhs;
+
+  TestParallelBackend backend(4);
+  ScopedGemmParallelBackend scope(&backend);
+  VERIFY_IS_EQUAL(nbThreads(), 4);
+  SparseMatrixType res2 = lhs * rhs;
+  int calls = backend.calls;
+  VERIFY(calls > 0);
+  VERIFY_IS_EQUAL(res2.nonZeros(), res.nonZeros());
+  VERIFY_IS_APPROX(res2, res);
+  VERIFY_IS_APPROX(DenseMatrix(res2), refLhs * refRhs);
+
+  SparseMatrixProduct<SparseMatrixType> prod(lhs, rhs);
+  VERIFY(backend.calls > calls);
+  calls = backend.calls;
+  VERIFY_IS_EQUAL(prod.nonZeros(), res.nonZeros());
+  VERIFY_IS_APPROX(prod.result(), res);
+  // new values with the same patterns
+  lhs.coeffs().setRandom();
+  rhs.coeffs().setRandom();
+  prod.computeValues(lhs, rhs);
+  VERIFY_IS_EQUAL(int(backend.calls), calls+1);
+  VERIFY_IS_EQUAL(prod.info(), Success);
+  VERIFY_IS_EQUAL(prod.nonZeros(), res.nonZeros());
+  VERIFY_IS_APPROX(DenseMatrix(prod.result()), DenseMatrix(lhs) * DenseMatrix(rhs));
+#endif
+}
+
 // New test for Bug in SparseTimeDenseProduct
 template<typename SparseMatrixType, typename DenseMatrixType> void sparse_product_regression_test()
 {
@@ -465,5 +666,27 @@ void test_sparse_product()
     CALL_SUBTEST_4( (sparse_product_regression_test<SparseMatrix<double,RowMajor>, Matrix<double, Dynamic, Dynamic, RowMajor> >()) );
 
     CALL_SUBTEST_5( (test_mixing_types<float>()) );
+
+    Index r = internal::random<Index>(1,200), d = internal::random<Index>(1,200);
+    TEST_SET_BUT_UNUSED_VARIABLE(r)
+    TEST_SET_BUT_UNUSED_VARIABLE(d)
+    CALL_SUBTEST_6( (sparse_product_multi_rhs<SparseMatrix<double,ColMajor> >(r, d)) );
+    CALL_SUBTEST_6( (sparse_product_multi_rhs<SparseMatrix<double,RowMajor> >(r, d)) );
+    CALL_SUBTEST_7( (sparse_product_multi_rhs<SparseMatrix<std::complex<float>,RowMajor,long int> >(r, d)) );
+    CALL_SUBTEST_7( (sparse_product_multi_rhs<SparseMatrix<float,ColMajor> >(r, d)) );
+    Index c = internal::random<Index>(1,200);
+    TEST_SET_BUT_UNUSED_VARIABLE(c)
+    CALL_SUBTEST_9( (sparse_product_reuse<SparseMatrix<double,ColMajor> >(r, d, c)) );
+    CALL_SUBTEST_9( (sparse_product_reuse<SparseMatrix<std::complex<double>,RowMajor,long int> >(r, d, c)) );
   }
+  // large enough to run in parallel
+  CALL_SUBTEST_8( (sparse_product_multi_rhs<SparseMatrix<double,RowMajor> >(2000, 1500)) );
+  CALL_SUBTEST_8( (sparse_product_multi_rhs<SparseMatrix<double,ColMajor> >(2000, 1500)) );
+  CALL_SUBTEST_8( (sparse_product_multi_rhs_parallel<SparseMatrix<double,RowMajor> >()) );
+  CALL_SUBTEST_8( (sparse_product_multi_rhs_parallel<SparseMatrix<double,ColMajor> >()) );
+  CALL_SUBTEST_8( (sparse_product_multi_rhs_parallel<SparseMatrix<std::complex<float>,RowMajor> >()) );
+  CALL_SUBTEST_9( (sparse_product_reuse<SparseMatrix<double,ColMajor> >(300, 4000, 300)) );
+  CALL_SUBTEST_9( (sparse_product_reuse<SparseMatrix<double,RowMajor> >(300, 4000, 300)) );
+  CALL_SUBTEST_9( (sparse_product_reuse_parallel<SparseMatrix<double,ColMajor> >()) );
+  CALL_SUBTEST_9( (sparse_product_reuse_parallel<SparseMatrix<std::complex<double>,RowMajor,long int> >()) );
 }
@@ -0,0 +1,177 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#if __cplusplus >= 201103L
+// to run the multi-threaded products on a TestParallelBackend
+#define EIGEN_GEMM_THREADPOOL
+#endif
+#include "sparse.h"
+#include "parallel_backend.h"
+#include <Eigen/IterativeLinearSolvers>
+
+template<typename SparseMatrixType> void sparse_sell(Index rows, Index cols)
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef typename SparseMatrixType::StorageIndex StorageIndex;
+  typedef SparseSellMatrix<Scalar,StorageIndex> SellMatrix;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowDenseMatrix;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+
+  double density = (std::max)(8./(rows*cols), internal::random<double>(0.01,0.5));
+  DenseMatrix refMat = DenseMatrix::Zero(rows, cols);
+  SparseMatrixType m(rows, cols);
+  initSparse<Scalar>(density, refMat, m);
+  // a few long rows and empty rows to exercise the sorting and the padding
+  if(rows>2)
+  {
+    refMat.row(internal::random<Index>(0,rows-1)).setRandom();
+    refMat.row(internal::random<Index>(0,rows-1)).setZero();
+    m = refMat.sparseView();
+  }
+
+  const Index scopes[] = { 1, SellMatrix::SliceHeight, SellMatrix::DefaultSortingScope, rows };
+  for(int k=0; k<4; ++k)
+  {
+    SellMatrix s(m, scopes[k]);
+    VERIFY_IS_EQUAL(s.rows(), rows);
+    VERIFY_IS_EQUAL(s.cols(), cols);
+    VERIFY_IS_EQUAL(s.nonZeros(), m.nonZeros());
+    VERIFY(s.storageSize() >= s.nonZeros());
+    VERIFY(s.sortingScope() >= scopes[k]);
+    VERIFY_IS_EQUAL(s.slices(), (rows + SellMatrix::SliceHeight - 1) / SellMatrix::SliceHeight);
+
+    // the rows can be traversed in order, without the padding
+    DenseMatrix fromIterators = DenseMatrix::Zero(rows, cols);
+    for(Index i=0; i<s.outerSize(); ++i)
+    {
+      Index previous = -1;
+      for(typename SellMatrix::InnerIterator it(s,i); it; ++it)
+      {
+        VERIFY_IS_EQUAL(it.row(), i);
+        VERIFY(it.index() > previous);
+        previous = it.index();
+        fromIterators(it.row(), it.col()) = it.value();
+      }
+    }
+    VERIFY_IS_EQUAL(fromIterators, refMat);
+
+    DenseVector x = DenseVector::Random(cols);
+    DenseVector y = DenseVector::Random(rows);
+    DenseVector y2 = y;
+    Scalar alpha = internal::random<Scalar>();
+    VERIFY_IS_APPROX(y = s * x, refMat * x);
+    VERIFY_IS_APPROX(y.noalias() += s * x, y2 = y + refMat * x);
+    VERIFY_IS_APPROX(y.noalias() -= alpha * (s * x), y2 = y - alpha * (refMat * x));
+    VERIFY_IS_APPROX(y = s * (x * alpha), refMat * (x * alpha));
+
+    Index rhsCols = internal::random<Index>(1,9);
+    DenseMatrix X = DenseMatrix::Random(cols, rhsCols);
+    RowDenseMatrix Xr = X;
+    DenseMatrix Y(rows, rhsCols);
+    VERIFY_IS_APPROX(Y = s * X, refMat * X);
+    VERIFY_IS_APPROX(Y = s * Xr, refMat * X);
+    RowDenseMatrix Yr = RowDenseMatrix::Zero(rows, rhsCols);
+    VERIFY_IS_APPROX(Yr.noalias() += s * X.leftCols(rhsCols), refMat * X);
+    VERIFY_IS_APPROX(y = s * X.col(rhsCols-1), refMat * X.col(rhsCols-1));
+  }
+
+  // rebuilding from another matrix
+  SellMatrix s;
+  VERIFY_IS_EQUAL(s.rows(), 0);
+  s.compute(m.transpose());
+  DenseVector x = DenseVector::Random(rows);
+  VERIFY_IS_APPROX(DenseVector(s * x), refMat.transpose() * x);
+}
+
+template<typename Scalar> void sparse_sell_solver()
+{
+  typedef SparseMatrix<Scalar> SparseMatrixType;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+  const Index n = internal::random<Index>(10,300);
+  // a shifted 1D laplacian plus random symmetric couplings
+  std::vector<Triplet<Scalar> > triplets;
+  for(Index i=0; i<n; ++i)
+  {
+    triplets.push_back(Triplet<Scalar>(i, i, Scalar(4)));
+    if(i>0)
+    {
+      triplets.push_back(Triplet<Scalar>(i, i-1, Scalar(-1)));
+      triplets.push_back(Triplet<Scalar>(i-1, i, Scalar(-1)));
+    }
+    Index j = internal::random<Index>(0,n-1);
+    if(j!=i)
+    {
+      Scalar v = Scalar(internal::random<double>(-0.5,0.5));
+      triplets.push_back(Triplet<Scalar>(i, j, v));
+      triplets.push_back(Triplet<Scalar>(j, i, v));
+    }
+  }
+  SparseMatrixType A(n,n);
+  A.setFromTriplets(triplets.begin(), triplets.end());
+  SparseSellMatrix<Scalar> S(A);
+  DenseVector b = DenseVector::Random(n);
+
+  ConjugateGradient<SparseMatrixType, Lower|Upper> refSolver(A);
+  DenseVector ref = refSolver.solve(b);
+
+  ConjugateGradient<SparseSellMatrix<Scalar>, Lower|Upper> cg(S);
+  DenseVector x = cg.solve(b);
+  VERIFY_IS_EQUAL(cg.info(), Success);
+  VERIFY_IS_APPROX(x, ref);
+
+  ConjugateGradient<SparseSellMatrix<Scalar>, Lower|Upper, IdentityPreconditioner> cgI(S);
+  VERIFY_IS_APPROX(cgI.solve(b), ref);
+
+  BiCGSTAB<SparseSellMatrix<Scalar> > bicg(S);
+  VERIFY_IS_APPROX(bicg.solve(b), ref);
+}
+
+// The row slices are split between the threads, the results must be the ones of the sequential products.
+template<typename Scalar> void sparse_sell_parallel()
+{
+#ifdef EIGEN_GEMM_THREADPOOL
+  typedef SparseMatrix<Scalar,RowMajor> SparseMatrixType;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+  const Index rows = 3000, cols = 2000;
+  DenseMatrix refMat = DenseMatrix::Zero(rows, cols);
+  SparseMatrixType m(rows, cols);
+  initSparse<Scalar>(0.01, refMat, m);
+  SparseSellMatrix<Scalar> s(m);
+  DenseMatrix X = DenseMatrix::Random(cols, 5);
+  DenseVector x = DenseVector::Random(cols);
+  const DenseMatrix Y = s * X;
+  const DenseVector y = s * x;
+
+  TestParallelBackend backend(4);
+  ScopedGemmParallelBackend scope(&backend);
+  VERIFY_IS_EQUAL(nbThreads(), 4);
+  VERIFY_IS_EQUAL(DenseMatrix(s * X), Y);
+  VERIFY_IS_EQUAL(DenseVector(s * x), y);
+  VERIFY_IS_APPROX(y, refMat * x);
+  VERIFY_IS_EQUAL(int(backend.calls), 2);
+#endif
+}
+
+void test_sparse_sell()
+{
+  for(int i = 0; i < g_repeat; i++) {
+    Index r = internal::random<Index>(1,300), c = internal::random<Index>(1,300);
+    CALL_SUBTEST_1(( sparse_sell<SparseMatrix<double> >(r, c) ));
+    CALL_SUBTEST_1(( sparse_sell<SparseMatrix<double,RowMajor> >(r, c) ));
+    CALL_SUBTEST_1(( sparse_sell<SparseMatrix<double> >(1, c) ));
+    CALL_SUBTEST_2(( sparse_sell<SparseMatrix<float,RowMajor> >(r, c) ));
+    CALL_SUBTEST_3(( sparse_sell<SparseMatrix<std::complex<double>,ColMajor,long int> >(r, c) ));
+    CALL_SUBTEST_4(( sparse_sell_solver<double>() ));
+    CALL_SUBTEST_4(( sparse_sell_solver<float>() ));
+  }
+  // large enough to run in parallel
+  CALL_SUBTEST_5(( sparse_sell<SparseMatrix<double,RowMajor> >(3000, 2000) ));
+  CALL_SUBTEST_5(( sparse_sell_parallel<double>() ));
+  CALL_SUBTEST_5(( sparse_sell_parallel<std::complex<float> >() ));
+}
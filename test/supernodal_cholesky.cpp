@@ -0,0 +1,155 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#if __cplusplus >= 201103L
+// to factorize the subtrees on a TestParallelBackend
+#define EIGEN_GEMM_THREADPOOL
+#endif
+#include "sparse_solver.h"
+#include "parallel_backend.h"
+
+template<typename T, typename I> void test_supernodal_cholesky_T()
+{
+  typedef SparseMatrix<T,0,I> SparseMatrixType;
+  SupernodalLLT< SparseMatrixType, Lower> llt_colmajor_lower_amd;
+  SupernodalLLT< SparseMatrixType, Upper> llt_colmajor_upper_amd;
+  SupernodalLDLT<SparseMatrixType, Lower> ldlt_colmajor_lower_amd;
+  SupernodalLDLT<SparseMatrixType, Upper> ldlt_colmajor_upper_amd;
+  SupernodalLLT< SparseMatrixType, Lower, NaturalOrdering<I> > llt_colmajor_lower_nat;
+  SupernodalLDLT<SparseMatrixType, Upper, NaturalOrdering<I> > ldlt_colmajor_upper_nat;
+
+  check_sparse_spd_solving(llt_colmajor_lower_amd);
+  check_sparse_spd_solving(llt_colmajor_upper_amd);
+  check_sparse_spd_solving(ldlt_colmajor_lower_amd);
+  check_sparse_spd_solving(ldlt_colmajor_upper_amd);
+
+  check_sparse_spd_determinant(llt_colmajor_lower_amd);
+  check_sparse_spd_determinant(llt_colmajor_upper_amd);
+  check_sparse_spd_determinant(ldlt_colmajor_lower_amd);
+  check_sparse_spd_determinant(ldlt_colmajor_upper_amd);
+
+  check_sparse_spd_solving(llt_colmajor_lower_nat, 300, 1000);
+  check_sparse_spd_solving(ldlt_colmajor_upper_nat, 300, 1000);
+}
+
+// The shifted laplacian of a n x n x n grid
+template<typename T> SparseMatrix<T> grid_laplacian(Index n)
+{
+  const Index size = n*n*n;
+  std::vector<Triplet<T> > triplets;
+  for(Index i = 0; i < n; ++i)
+    for(Index j = 0; j < n; ++j)
+      for(Index k = 0; k < n; ++k)
+      {
+        const Index id = (i*n+j)*n+k;
+        triplets.push_back(Triplet<T>(id, id, T(6.1)));
+        const Index neighbors[3] = { i>0 ? id-n*n : -1, j>0 ? id-n : -1, k>0 ? id-1 : -1 };
+        for(int d = 0; d < 3; ++d)
+        {
+          if(neighbors[d] < 0) continue;
+          triplets.push_back(Triplet<T>(id, neighbors[d], T(-1)));
+          triplets.push_back(Triplet<T>(neighbors[d], id, T(-1)));
+        }
+      }
+  SparseMatrix<T> A(size, size);
+  A.setFromTriplets(triplets.begin(), triplets.end());
+  return A;
+}
+
+// The laplacian of a 3D grid has large supernodes, the factors are checked against the simplicial ones.
+template<typename T> void test_supernodal_cholesky_grid(Index n)
+{
+  typedef SparseMatrix<T> SparseMatrixType;
+  typedef Matrix<T,Dynamic,Dynamic> DenseMatrix;
+  const Index size = n*n*n;
+  const SparseMatrixType A = grid_laplacian<T>(n);
+  DenseMatrix B = DenseMatrix::Random(size, 3);
+
+  SimplicialLLT<SparseMatrixType> ref(A);
+  SupernodalLLT<SparseMatrixType> llt(A);
+  VERIFY_IS_EQUAL(llt.info(), Success);
+  VERIFY(llt.nbSupernodes() < size);
+  VERIFY_IS_APPROX(llt.solve(B), ref.solve(B));
+  // the determinant overflows on the larger grids, the log-determinants are compared
+  SparseMatrixType L = llt.matrixL(), refL = ref.matrixL();
+  VERIFY_IS_APPROX(L.diagonal().real().array().log().sum(), refL.diagonal().real().array().log().sum());
+
+  // L L^* is the permuted matrix
+  SparseMatrixType PAPinv = llt.permutationP() * A * llt.permutationPinv();
+  VERIFY_IS_APPROX(DenseMatrix(L * SparseMatrixType(L.adjoint())), DenseMatrix(PAPinv));
+
+  SupernodalLDLT<SparseMatrixType, Upper> ldlt;
+  ldlt.analyzePattern(A);
+  ldlt.factorize(A);
+  VERIFY_IS_EQUAL(ldlt.info(), Success);
+  VERIFY_IS_APPROX(ldlt.solve(B), ref.solve(B));
+  SparseMatrixType L1 = ldlt.matrixL();
+  VERIFY_IS_APPROX(DenseMatrix(L1 * ldlt.vectorD().asDiagonal() * SparseMatrixType(L1.adjoint())),
+                   DenseMatrix(ldlt.permutationP() * A * ldlt.permutationPinv()));
+
+  // a shift that makes the matrix indefinite is detected
+  llt.setShift(-10);
+  llt.factorize(A);
+  VERIFY_IS_EQUAL(llt.info(), NumericalIssue);
+  llt.setShift(1, 2);
+  llt.factorize(A);
+  VERIFY_IS_EQUAL(llt.info(), Success);
+  SparseMatrixType shifted = A;
+  shifted.diagonal() = shifted.diagonal() * T(2) + DenseMatrix::Ones(size,1);
+  VERIFY_IS_APPROX(shifted * llt.solve(B), B);
+}
+
+// Grids large enough for the subtrees of the elimination tree to be factorized by several threads
+template<typename T> void test_supernodal_cholesky_parallel(Index n)
+{
+#ifdef EIGEN_GEMM_THREADPOOL
+  typedef SparseMatrix<T> SparseMatrixType;
+  typedef Matrix<T,Dynamic,Dynamic> DenseMatrix;
+  const SparseMatrixType A = grid_laplacian<T>(n);
+  const DenseMatrix B = DenseMatrix::Random(A.rows(), 3);
+
+  SupernodalLLT<SparseMatrixType> llt(A);
+  SupernodalLDLT<SparseMatrixType> ldlt(A);
+  VERIFY_IS_EQUAL(llt.info(), Success);
+  VERIFY_IS_EQUAL(ldlt.info(), Success);
+  const SparseMatrixType L = llt.matrixL(), L1 = ldlt.matrixL();
+
+  TestParallelBackend backend(4);
+  ScopedGemmParallelBackend scope(&backend);
+  VERIFY_IS_EQUAL(nbThreads(), 4);
+  SupernodalLLT<SparseMatrixType> pllt(A);
+  VERIFY(backend.calls > 0);
+  SupernodalLDLT<SparseMatrixType> pldlt(A);
+  VERIFY_IS_EQUAL(pllt.info(), Success);
+  VERIFY_IS_EQUAL(pldlt.info(), Success);
+  SparseMatrixType pL = pllt.matrixL(), pL1 = pldlt.matrixL();
+  VERIFY_IS_EQUAL(pL.nonZeros(), L.nonZeros());
+  VERIFY_IS_APPROX(pL, L);
+  VERIFY_IS_APPROX(pL1, L1);
+  VERIFY_IS_APPROX(pldlt.vectorD(), ldlt.vectorD());
+  VERIFY_IS_APPROX(pllt.solve(B), llt.solve(B));
+  VERIFY_IS_APPROX(A * pldlt.solve(B), B);
+
+  // a failure in a subtree is reported
+  pllt.setShift(-10);
+  pllt.factorize(A);
+  VERIFY_IS_EQUAL(pllt.info(), NumericalIssue);
+#else
+  EIGEN_UNUSED_VARIABLE(n);
+#endif
+}
+
+void test_supernodal_cholesky()
+{
+  CALL_SUBTEST_1(( test_supernodal_cholesky_T<double,int>() ));
+  CALL_SUBTEST_2(( test_supernodal_cholesky_T<std::complex<double>, int>() ));
+  CALL_SUBTEST_3(( test_supernodal_cholesky_T<double,long int>() ));
+  CALL_SUBTEST_4(( test_supernodal_cholesky_grid<double>(internal::random<Index>(2,12)) ));
+  CALL_SUBTEST_4(( test_supernodal_cholesky_grid<std::complex<double> >(internal::random<Index>(2,8)) ));
+  CALL_SUBTEST_5(( test_supernodal_cholesky_parallel<double>(internal::random<Index>(18,22)) ));
+  CALL_SUBTEST_5(( test_supernodal_cholesky_parallel<std::complex<double> >(16) ));
+}
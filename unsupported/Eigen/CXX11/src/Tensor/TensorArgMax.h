@@ -87,6 +87,7 @@ struct TensorEvaluator<const TensorIndexTupleOp<ArgType>, Device>
     IsAligned = /*TensorEvaluator<ArgType, Device>::IsAligned*/ false,
     PacketAccess = /*TensorEvaluator<ArgType, Device>::PacketAccess*/ false,
     BlockAccess = false,
+    PreferBlockAccess = false,
     Layout = TensorEvaluator<ArgType, Device>::Layout,
     CoordAccess = false,  // to be implemented
     RawAccess = false
@@ -103,6 +104,15 @@ struct TensorEvaluator<const TensorIndexTupleOp<ArgType>, Device>
     m_impl.evalSubExprsIfNeeded(NULL);
     return true;
   }
+
+#ifdef EIGEN_USE_THREADS
+  template <typename EvalSubExprsCallback>
+  EIGEN_STRONG_INLINE void evalSubExprsIfNeededAsync(
+      Scalar*, EvalSubExprsCallback done) {
+    m_impl.evalSubExprsIfNeededAsync(NULL, [done](bool) { done(true); });
+  }
+#endif  // EIGEN_USE_THREADS
+
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void cleanup() {
     m_impl.cleanup();
   }
@@ -119,11 +129,9 @@ struct TensorEvaluator<const TensorIndexTupleOp<ArgType>, Device>
 
   EIGEN_DEVICE_FUNC Scalar* data() const { return NULL; }
 
-#ifdef EIGEN_USE_SYCL
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE const TensorEvaluator<ArgType, Device>& impl() const {
     return m_impl;
   }
-#endif
 
  protected:
   TensorEvaluator<ArgType, Device> m_impl;
@@ -202,6 +210,244 @@ class TensorTupleReducerOp : public TensorBase<TensorTupleReducerOp<ReduceOp, Di
     const Dims m_reduce_dims;
 };
 
+namespace internal {
+
+// Comparisons used to search for the coefficient selected by argmax and argmin
+// on the cpu, which works on the values of the input directly instead of
+// reducing (index, value) tuples.
+template <typename ReduceOp>
+struct ArgReducerOps {
+  static const bool Supported = false;
+};
+
+template <typename T>
+struct ArgReducerOps<ArgMaxTupleReducer<T> > {
+  typedef typename T::second_type Scalar;
+  static const bool Supported = true;
+  static const bool PacketAccess = packet_traits<Scalar>::HasMax;
+  static EIGEN_STRONG_INLINE Scalar initialize() { return NumTraits<Scalar>::lowest(); }
+  static EIGEN_STRONG_INLINE bool better(const Scalar& a, const Scalar& b) { return a > b; }
+  template <typename Packet>
+  static EIGEN_STRONG_INLINE Packet reducePacket(const Packet& a, const Packet& b) { return pmax<Packet>(a, b); }
+  template <typename Packet>
+  static EIGEN_STRONG_INLINE Scalar reduxPacket(const Packet& a) { return predux_max<Packet>(a); }
+};
+
+template <typename T>
+struct ArgReducerOps<ArgMinTupleReducer<T> > {
+  typedef typename T::second_type Scalar;
+  static const bool Supported = true;
+  static const bool PacketAccess = packet_traits<Scalar>::HasMin;
+  static EIGEN_STRONG_INLINE Scalar initialize() { return NumTraits<Scalar>::highest(); }
+  static EIGEN_STRONG_INLINE bool better(const Scalar& a, const Scalar& b) { return a < b; }
+  template <typename Packet>
+  static EIGEN_STRONG_INLINE Packet reducePacket(const Packet& a, const Packet& b) { return pmin<Packet>(a, b); }
+  template <typename Packet>
+  static EIGEN_STRONG_INLINE Scalar reduxPacket(const Packet& a) { return predux_min<Packet>(a); }
+};
+
+// Returns the index of the first coefficient in [first, last) that is not
+// beaten by any other coefficient of the range. Like the tuple reducers, the
+// search starts from Ops::initialize(), so NaNs are never selected, and first
+// is returned when no coefficient beats the initial value.
+template <typename Impl, typename Ops, bool Vectorizable>
+struct ArgReduceRange {
+  typedef typename Impl::Index Index;
+  typedef typename Ops::Scalar Scalar;
+
+  static Index run(const Impl& impl, Index first, Index last) {
+    Index best = first;
+    Scalar best_value = Ops::initialize();
+    for (Index i = first; i < last; ++i) {
+      const Scalar value = impl.coeff(i);
+      if (Ops::better(value, best_value)) {
+        best_value = value;
+        best = i;
+      }
+    }
+    return best;
+  }
+};
+
+// Vectorized version: the extremum of each block of coefficients is computed
+// with packets, without tracking any index. Only the block that contains the
+// extremum of the range is scanned again to locate it.
+template <typename Impl, typename Ops>
+struct ArgReduceRange<Impl, Ops, true> {
+  typedef typename Impl::Index Index;
+  typedef typename Ops::Scalar Scalar;
+  typedef typename Impl::PacketReturnType Packet;
+  static const Index PacketSize = unpacket_traits<Packet>::size;
+  static const Index kBlockSize = 1024;
+
+  static Index run(const Impl& impl, Index first, Index last) {
+    Index best_block = first;
+    Scalar best_value = Ops::initialize();
+    for (Index block = first; block < last; block += kBlockSize) {
+      const Scalar value = reduceBlock(impl, block, numext::mini(last, block + kBlockSize));
+      if (Ops::better(value, best_value)) {
+        best_value = value;
+        best_block = block;
+      }
+    }
+    return ArgReduceRange<Impl, Ops, false>::run(impl, best_block, numext::mini(last, best_block + kBlockSize));
+  }
+
+ private:
+  static Scalar reduceBlock(const Impl& impl, Index first, Index last) {
+    Scalar result = Ops::initialize();
+    Index i = first;
+    if (last - first >= 4 * PacketSize) {
+      // pmax and pmin only ignore a NaN in their second argument, so the
+      // accumulators must not be loaded from the input.
+      const Packet init = pset1<Packet>(Ops::initialize());
+      Packet p0 = init;
+      Packet p1 = init;
+      Packet p2 = init;
+      Packet p3 = init;
+      for (; i + 4 * PacketSize <= last; i += 4 * PacketSize) {
+        p0 = Ops::reducePacket(p0, impl.template packet<Unaligned>(i));
+        p1 = Ops::reducePacket(p1, impl.template packet<Unaligned>(i + PacketSize));
+        p2 = Ops::reducePacket(p2, impl.template packet<Unaligned>(i + 2 * PacketSize));
+        p3 = Ops::reducePacket(p3, impl.template packet<Unaligned>(i + 3 * PacketSize));
+      }
+      p0 = Ops::reducePacket(Ops::reducePacket(p0, p1), Ops::reducePacket(p2, p3));
+      for (; i + PacketSize <= last; i += PacketSize) {
+        p0 = Ops::reducePacket(p0, impl.template packet<Unaligned>(i));
+      }
+      result = Ops::reduxPacket(p0);
+    }
+    for (; i < last; ++i) {
+      const Scalar value = impl.coeff(i);
+      if (Ops::better(value, result)) {
+        result = value;
+      }
+    }
+    return result;
+  }
+};
+
+// Computes the result of every output coefficient.
+template <typename Self, typename Device>
+struct ArgReducerLauncher {
+  typedef typename Self::Index Index;
+
+  static void run(const Self& self, const Device&, Index* output) {
+    const Index num_values = self.m_numValuesToReduce;
+    for (Index i = 0; i < self.m_numOutputs; ++i) {
+      output[i] = self.returnIndex(self.argReduce(i * num_values, (i + 1) * num_values));
+    }
+  }
+
+#ifdef EIGEN_USE_THREADS
+  template <typename DoneCallback>
+  static void runAsync(const Self& self, const Device& device, Index* output,
+                       DoneCallback done) {
+    run(self, device, output);
+    done();
+  }
+#endif  // EIGEN_USE_THREADS
+};
+
+#ifdef EIGEN_USE_THREADS
+// Multithreaded version. The output coefficients are distributed over the
+// threads. When there are fewer outputs than threads, the values reduced into
+// each output are split into shards searched independently, and the results
+// of the shards are combined in order once they are all available.
+template <typename Self>
+struct ArgReducerLauncher<Self, ThreadPoolDevice> {
+  typedef typename Self::Index Index;
+  // Smallest number of coefficients searched by a shard. It is an enum since
+  // numext::maxi takes it by reference.
+  enum { kMinShardSize = 16384 };
+
+  static void run(const Self& self, const ThreadPoolDevice& device, Index* output) {
+    const Index shard_size = shardSize(self, device);
+    const Index num_shards = divup(self.m_numValuesToReduce, shard_size);
+    Index* partial = num_shards > 1
+        ? static_cast<Index*>(device.allocate(self.m_numOutputs * num_shards * sizeof(Index)))
+        : NULL;
+    device.parallelFor(self.m_numOutputs * num_shards, cost(self, shard_size),
+                       [&self, shard_size, num_shards, output, partial](Index first, Index last) {
+                         reduceShards(self, shard_size, num_shards, first, last, output, partial);
+                       });
+    if (partial) {
+      combineShards(self, num_shards, partial, output);
+      device.deallocate(partial);
+    }
+  }
+
+  template <typename DoneCallback>
+  static void runAsync(const Self& self, const ThreadPoolDevice& device,
+                       Index* output, DoneCallback done) {
+    const Index shard_size = shardSize(self, device);
+    const Index num_shards = divup(self.m_numValuesToReduce, shard_size);
+    Index* partial = num_shards > 1
+        ? static_cast<Index*>(device.allocate(self.m_numOutputs * num_shards * sizeof(Index)))
+        : NULL;
+    const Self* self_ptr = &self;
+    const ThreadPoolDevice* device_ptr = &device;
+    device.parallelForAsync(
+        self.m_numOutputs * num_shards, cost(self, shard_size),
+        [self_ptr, shard_size, num_shards, output, partial](Index first, Index last) {
+          reduceShards(*self_ptr, shard_size, num_shards, first, last, output, partial);
+        },
+        [self_ptr, device_ptr, num_shards, output, partial, done]() {
+          if (partial) {
+            combineShards(*self_ptr, num_shards, partial, output);
+            device_ptr->deallocate(partial);
+          }
+          done();
+        });
+  }
+
+ private:
+  static Index shardSize(const Self& self, const ThreadPoolDevice& device) {
+    const Index num_values = self.m_numValuesToReduce;
+    if (self.m_numOutputs >= device.numThreads() || num_values < 2 * kMinShardSize) {
+      return num_values;
+    }
+    const Index num_shards = divup<Index>(4 * device.numThreads(), self.m_numOutputs);
+    return numext::maxi<Index>(kMinShardSize, divup(num_values, num_shards));
+  }
+
+  static TensorOpCost cost(const Self& self, Index shard_size) {
+    return static_cast<double>(shard_size) * self.argReduceCost();
+  }
+
+  static void reduceShards(const Self& self, Index shard_size, Index num_shards,
+                           Index first, Index last, Index* output, Index* partial) {
+    const Index num_values = self.m_numValuesToReduce;
+    for (Index i = first; i < last; ++i) {
+      const Index output_index = i / num_shards;
+      const Index begin = output_index * num_values + (i - output_index * num_shards) * shard_size;
+      const Index end = numext::mini((output_index + 1) * num_values, begin + shard_size);
+      const Index best = self.argReduce(begin, end);
+      if (partial) {
+        partial[i] = best;
+      } else {
+        output[i] = self.returnIndex(best);
+      }
+    }
+  }
+
+  static void combineShards(const Self& self, Index num_shards, const Index* partial, Index* output) {
+    for (Index i = 0; i < self.m_numOutputs; ++i) {
+      Index best = partial[i * num_shards];
+      for (Index j = 1; j < num_shards; ++j) {
+        const Index candidate = partial[i * num_shards + j];
+        if (self.better(candidate, best)) {
+          best = candidate;
+        }
+      }
+      output[i] = self.returnIndex(best);
+    }
+  }
+};
+#endif  // EIGEN_USE_THREADS
+
+}  // end namespace internal
+
 // Eval as rvalue
 template<typename ReduceOp, typename Dims, typename ArgType, typename Device>
 struct TensorEvaluator<const TensorTupleReducerOp<ReduceOp, Dims, ArgType>, Device>
@@ -220,6 +466,7 @@ struct TensorEvaluator<const TensorTupleReducerOp<ReduceOp, Dims, ArgType>, Devi
     IsAligned = /*TensorEvaluator<ArgType, Device>::IsAligned*/ false,
     PacketAccess = /*TensorEvaluator<ArgType, Device>::PacketAccess*/ false,
     BlockAccess = false,
+    PreferBlockAccess = false,
     Layout = TensorEvaluator<const TensorReductionOp<ReduceOp, Dims, const TensorIndexTupleOp<ArgType> >, Device>::Layout,
     CoordAccess = false,  // to be implemented
     RawAccess = false
@@ -228,10 +475,9 @@ struct TensorEvaluator<const TensorTupleReducerOp<ReduceOp, Dims, ArgType>, Devi
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE TensorEvaluator(const XprType& op, const Device& device)
       : m_orig_impl(op.expression(), device),
         m_impl(op.expression().index_tuples().reduce(op.reduce_dims(), op.reduce_op()), device),
-        m_return_dim(op.return_dim())
-#ifdef EIGEN_USE_SYCL
-       ,m_device(device)
-#endif
+        m_return_dim(op.return_dim()),
+        m_result(NULL),
+        m_device(device)
   {
 
     gen_strides(m_orig_impl.dimensions(), m_strides);
@@ -243,27 +489,95 @@ struct TensorEvaluator<const TensorTupleReducerOp<ReduceOp, Dims, ArgType>, Devi
       m_stride_mod = (m_return_dim > 0) ? m_strides[m_return_dim - 1] : total_size;
     }
     m_stride_div = m_strides[m_return_dim];
+
+    // On the cpu, the values reduced into each output coefficient are
+    // searched directly when they are contiguous in the input, i.e. when the
+    // reduced dimensions are the inner most ones.
+    const InputDimensions& input_dims = m_orig_impl.dimensions();
+    array<bool, NumDims> reduced;
+    for (int i = 0; i < NumDims; ++i) {
+      reduced[i] = false;
+    }
+    for (int i = 0; i < internal::array_size<Dims>::value; ++i) {
+      reduced[op.reduce_dims()[i]] = true;
+    }
+    m_numValuesToReduce = 1;
+    bool contiguous = true;
+    bool inner = true;
+    for (int i = 0; i < NumDims; ++i) {
+      const int dim = (Layout == static_cast<int>(ColMajor)) ? i : NumDims - 1 - i;
+      if (reduced[dim]) {
+        contiguous = contiguous && inner;
+        m_numValuesToReduce *= input_dims[dim];
+      } else {
+        inner = false;
+      }
+    }
+    m_numOutputs = internal::array_prod(m_impl.dimensions());
+    m_useArgReducer = UseArgReducer && contiguous && m_numValuesToReduce > 0;
   }
 
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE const Dimensions& dimensions() const {
     return m_impl.dimensions();
   }
 
-  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE bool evalSubExprsIfNeeded(Scalar* /*data*/) {
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE bool evalSubExprsIfNeeded(Scalar* data) {
+    if (m_useArgReducer) {
+      m_orig_impl.evalSubExprsIfNeeded(NULL);
+      if (!data) {
+        m_result = static_cast<Index*>(m_device.allocate(m_numOutputs * sizeof(Index)));
+        data = m_result;
+      }
+      internal::ArgReducerLauncher<Self, Device>::run(*this, m_device, data);
+      return (m_result != NULL);
+    }
     m_impl.evalSubExprsIfNeeded(NULL);
     return true;
   }
+
+#ifdef EIGEN_USE_THREADS
+  template <typename EvalSubExprsCallback>
+  EIGEN_STRONG_INLINE void evalSubExprsIfNeededAsync(
+      Scalar* data, EvalSubExprsCallback done) {
+    if (m_useArgReducer) {
+      m_orig_impl.evalSubExprsIfNeededAsync(NULL, [this, data, done](bool) {
+        Index* output = data;
+        if (!output) {
+          m_result = static_cast<Index*>(m_device.allocate(m_numOutputs * sizeof(Index)));
+          output = m_result;
+        }
+        const bool need_assign = (m_result != NULL);
+        internal::ArgReducerLauncher<Self, Device>::runAsync(
+            *this, m_device, output, [done, need_assign]() { done(need_assign); });
+      });
+      return;
+    }
+    m_impl.evalSubExprsIfNeededAsync(NULL, [done](bool) { done(true); });
+  }
+#endif  // EIGEN_USE_THREADS
+
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void cleanup() {
-    m_impl.cleanup();
+    if (m_useArgReducer) {
+      m_orig_impl.cleanup();
+    } else {
+      m_impl.cleanup();
+    }
+    if (m_result) {
+      m_device.deallocate(m_result);
+      m_result = NULL;
+    }
   }
 
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE CoeffReturnType coeff(Index index) const {
+    if (m_result) {
+      return m_result[index];
+    }
     const TupleType v = m_impl.coeff(index);
     return (m_return_dim < 0) ? v.first : (v.first % m_stride_mod) / m_stride_div;
   }
 
   #ifndef EIGEN_USE_SYCL
-  EIGEN_DEVICE_FUNC Scalar* data() const { return NULL; }
+  EIGEN_DEVICE_FUNC Scalar* data() const { return m_result; }
   #else // following functions are required by sycl
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE TupleType* data() const { return m_impl.data(); }
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE Index return_dim() const {return m_return_dim;}
@@ -275,6 +589,9 @@ struct TensorEvaluator<const TensorTupleReducerOp<ReduceOp, Dims, ArgType>, Devi
 
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE TensorOpCost
   costPerCoeff(bool vectorized) const {
+    if (m_result) {
+      return TensorOpCost(sizeof(Index), 0, 0);
+    }
     const double compute_cost = 1.0 +
         (m_return_dim < 0 ? 0.0 : (TensorOpCost::ModCost<Index>() + TensorOpCost::DivCost<Index>()));
     return m_orig_impl.costPerCoeff(vectorized) +
@@ -282,6 +599,47 @@ struct TensorEvaluator<const TensorTupleReducerOp<ReduceOp, Dims, ArgType>, Devi
   }
 
  private:
+  typedef TensorEvaluator<const TensorTupleReducerOp<ReduceOp, Dims, ArgType>, Device> Self;
+  typedef TensorEvaluator<ArgType, Device> InputImpl;
+  typedef internal::ArgReducerOps<ReduceOp> ArgOps;
+  template <typename, typename> friend struct internal::ArgReducerLauncher;
+
+#if defined(EIGEN_USE_GPU) && defined(EIGEN_CUDACC)
+  static const bool RunningOnGPU = internal::is_same<Device, Eigen::GpuDevice>::value;
+#else
+  static const bool RunningOnGPU = false;
+#endif
+#if defined(EIGEN_USE_SYCL)
+  static const bool RunningOnSycl = internal::is_same<typename internal::remove_all<Device>::type, Eigen::SyclDevice>::value;
+#else
+  static const bool RunningOnSycl = false;
+#endif
+  static const bool UseArgReducer = ArgOps::Supported && !RunningOnGPU && !RunningOnSycl;
+
+  // Index of the selected coefficient among the input coefficients [first, last).
+  EIGEN_STRONG_INLINE Index argReduce(Index first, Index last) const {
+    return internal::ArgReduceRange<InputImpl, ArgOps,
+                                    InputImpl::PacketAccess && ArgOps::PacketAccess>::run(
+        m_orig_impl.impl(), first, last);
+  }
+
+  // Whether the input coefficient a is selected over the input coefficient b.
+  EIGEN_STRONG_INLINE bool better(Index a, Index b) const {
+    return ArgOps::better(m_orig_impl.impl().coeff(a), m_orig_impl.impl().coeff(b));
+  }
+
+  // Cost of searching one input coefficient.
+  EIGEN_STRONG_INLINE TensorOpCost argReduceCost() const {
+    const bool vectorized = InputImpl::PacketAccess && ArgOps::PacketAccess;
+    return m_orig_impl.impl().costPerCoeff(vectorized) +
+           TensorOpCost(0, 0, internal::functor_traits<internal::scalar_max_op<typename InputImpl::CoeffReturnType> >::Cost,
+                        vectorized, internal::unpacket_traits<typename InputImpl::PacketReturnType>::size);
+  }
+
+  EIGEN_STRONG_INLINE Index returnIndex(Index index) const {
+    return (m_return_dim < 0) ? index : (index % m_stride_mod) / m_stride_div;
+  }
+
   EIGEN_DEVICE_FUNC void gen_strides(const InputDimensions& dims, StrideDims& strides) {
     if (m_return_dim < 0) {
       return;  // Won't be using the strides.
@@ -311,9 +669,11 @@ struct TensorEvaluator<const TensorTupleReducerOp<ReduceOp, Dims, ArgType>, Devi
   StrideDims m_strides;
   Index m_stride_mod;
   Index m_stride_div;
-#ifdef EIGEN_USE_SYCL
+  Index m_numValuesToReduce;
+  Index m_numOutputs;
+  bool m_useArgReducer;
+  Index* m_result;
   const Device& m_device;
-#endif
 };
 
 } // end namespace Eigen
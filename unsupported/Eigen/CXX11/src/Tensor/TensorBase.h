@@ -490,6 +490,14 @@ class TensorBase<Derived, ReadOnlyAccessors>
       return TensorContractionOp<const Dimensions, const Derived, const OtherDerived>(derived(), other.derived(), dims);
     }
 
+    // Contraction followed by an output kernel that is applied to each block
+    // of the result while it is still in cache, see NoOpOutputKernel.
+    template<typename OtherDerived, typename Dimensions, typename OutputKernel> EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE
+    const TensorContractionOp<const Dimensions, const Derived, const OtherDerived, const OutputKernel>
+    contract(const OtherDerived& other, const Dimensions& dims, const OutputKernel& output_kernel) const {
+      return TensorContractionOp<const Dimensions, const Derived, const OtherDerived, const OutputKernel>(derived(), other.derived(), dims, output_kernel);
+    }
+
     // Convolutions.
     template<typename KernelDerived, typename Dimensions> EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE
     const TensorConvolutionOp<const Dimensions, const Derived, const KernelDerived>
@@ -665,6 +673,12 @@ class TensorBase<Derived, ReadOnlyAccessors>
         const Derived>(derived(), internal::ArgMinTupleReducer<Tuple<Index, CoeffReturnType> >(), return_dim, in_dims);
     }
 
+    EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE
+    const TensorTopKOp<const Derived>
+    topk(const Index k, const Index dim) const {
+      return TensorTopKOp<const Derived>(derived(), k, dim);
+    }
+
     template <typename Reducer, typename Dims> EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE
     const TensorReductionOp<Reducer, const Dims, const Derived>
     reduce(const Dims& dims, const Reducer& reducer) const {
@@ -1018,6 +1032,15 @@ class TensorBase : public TensorBase<Derived, ReadOnlyAccessors> {
       return TensorDevice<Derived, DeviceType>(device, derived());
     }
 
+#ifdef EIGEN_USE_THREADS
+    // Select the device on which to asynchronously evaluate the expression:
+    // 'done' is called once the evaluation completes.
+    template <typename DeviceType, typename DoneCallback>
+    TensorAsyncDevice<Derived, DeviceType, DoneCallback> device(const DeviceType& device, DoneCallback done) {
+      return TensorAsyncDevice<Derived, DeviceType, DoneCallback>(device, derived(), std::move(done));
+    }
+#endif  // EIGEN_USE_THREADS
+
  protected:
     EIGEN_DEVICE_FUNC
     EIGEN_STRONG_INLINE Derived& derived() { return *static_cast<Derived*>(this); }
@@ -0,0 +1,576 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2018 Eigen contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_CXX11_TENSOR_TENSOR_BLOCK_H
+#define EIGEN_CXX11_TENSOR_TENSOR_BLOCK_H
+
+namespace Eigen {
+namespace internal {
+
+/** \class TensorBlock
+  * \ingroup CXX11_Tensor_Module
+  *
+  * \brief Tensor block class.
+  *
+  * A block is a rectangular region of a tensor, stored in a buffer with
+  * arbitrary strides. Evaluators with BlockAccess can produce a block of
+  * their output in one go (block()) and lvalue evaluators can consume one
+  * (writeBlock()), which avoids the index computations of the coefficient
+  * based evaluation and keeps the accesses local.
+  *
+  * first_coeff_index is the linear index of the first coefficient of the
+  * block in the tensor, and tensor_strides are the strides of the tensor
+  * dimensions, i.e. its coordinates are recovered with the tensor layout.
+  * block_strides are the strides of the block dimensions in the data buffer.
+  */
+enum TensorBlockShapeType {
+  // Blocks with roughly the same size in every dimension, for operations
+  // that read or write across the inner dimension (e.g. shuffling).
+  kUniformAllDims,
+  // Blocks that span the inner dimensions first, for operations that
+  // perform better on long contiguous runs.
+  kSkewedInnerDims
+};
+
+struct TensorOpResourceRequirements {
+  TensorBlockShapeType block_shape;
+  Index block_total_size;
+
+  TensorOpResourceRequirements()
+      : block_shape(kSkewedInnerDims), block_total_size(0) {}
+
+  // Blocks are uniform as soon as one of the operations of the expression
+  // asks for it, and large enough for all of them.
+  void merge(TensorBlockShapeType shape, Index total_size) {
+    if (shape == kUniformAllDims) block_shape = kUniformAllDims;
+    block_total_size = numext::maxi(block_total_size, total_size);
+  }
+};
+
+template <typename Scalar_, typename StorageIndex_, int NumDims_, int Layout_>
+class TensorBlock {
+ public:
+  typedef Scalar_ Scalar;
+  typedef StorageIndex_ StorageIndex;
+  static const int NumDims = NumDims_;
+  static const int Layout = Layout_;
+  typedef DSizes<StorageIndex, NumDims> Dimensions;
+
+  TensorBlock(const StorageIndex first_coeff_index,
+              const Dimensions& block_sizes,
+              const Dimensions& block_strides,
+              const Dimensions& tensor_strides,
+              Scalar* data)
+      : m_first_coeff_index(first_coeff_index),
+        m_block_sizes(block_sizes),
+        m_block_strides(block_strides),
+        m_tensor_strides(tensor_strides),
+        m_data(data) {}
+
+  StorageIndex first_coeff_index() const { return m_first_coeff_index; }
+  const Dimensions& block_sizes() const { return m_block_sizes; }
+  const Dimensions& block_strides() const { return m_block_strides; }
+  const Dimensions& tensor_strides() const { return m_tensor_strides; }
+  Scalar* data() const { return m_data; }
+
+ private:
+  StorageIndex m_first_coeff_index;
+  Dimensions m_block_sizes;
+  Dimensions m_block_strides;
+  Dimensions m_tensor_strides;
+  Scalar* m_data;
+};
+
+// Strides of a densely packed buffer of the given sizes.
+template <int Layout, typename StorageIndex, int NumDims>
+EIGEN_STRONG_INLINE DSizes<StorageIndex, NumDims> strides(
+    const DSizes<StorageIndex, NumDims>& sizes) {
+  DSizes<StorageIndex, NumDims> result;
+  if (NumDims == 0) return result;
+  if (static_cast<int>(Layout) == static_cast<int>(ColMajor)) {
+    result[0] = 1;
+    for (int i = 1; i < NumDims; ++i) {
+      result[i] = result[i - 1] * sizes[i - 1];
+    }
+  } else {
+    result[NumDims - 1] = 1;
+    for (int i = NumDims - 2; i >= 0; --i) {
+      result[i] = result[i + 1] * sizes[i + 1];
+    }
+  }
+  return result;
+}
+
+// Loop over a strided block of an output buffer and of NumInputs input
+// buffers. The dimensions are visited by increasing output stride, and the
+// inner dimensions that are contiguous in all the buffers are merged so that
+// the inner loop is as long as possible.
+template <typename StorageIndex, int NumDims, int NumInputs>
+class TensorBlockLoop {
+ public:
+  typedef DSizes<StorageIndex, NumDims> Dimensions;
+
+  TensorBlockLoop(const Dimensions& sizes, const Dimensions& output_strides,
+                  const Dimensions* input_strides)
+      : m_inner_size(1), m_output_stride(1), m_outer_count(1),
+        m_num_outer(0), m_output_offset(0) {
+    for (int k = 0; k < NumInputs; ++k) {
+      m_input_stride[k] = 1;
+      m_input_offset[k] = 0;
+    }
+    // Only the first m_num_outer entries are used, the others are zeroed so
+    // that the compiler does not see next() read uninitialized values.
+    for (int d = 0; d < (NumDims > 0 ? NumDims : 1); ++d) {
+      m_outer_sizes[d] = 0;
+      m_outer_output_strides[d] = 0;
+      for (int k = 0; k < NumInputs; ++k) {
+        m_outer_input_strides[k][d] = 0;
+      }
+      m_counters[d] = 0;
+    }
+
+    int order[NumDims > 0 ? NumDims : 1];
+    int rank = 0;
+    for (int d = 0; d < NumDims; ++d) {
+      if (sizes[d] == 1) continue;
+      int i = rank++;
+      while (i > 0 && output_strides[order[i - 1]] > output_strides[d]) {
+        order[i] = order[i - 1];
+        --i;
+      }
+      order[i] = d;
+    }
+    if (rank == 0) return;
+
+    int r = 0;
+    const int inner = order[r++];
+    m_inner_size = sizes[inner];
+    m_output_stride = output_strides[inner];
+    for (int k = 0; k < NumInputs; ++k) {
+      m_input_stride[k] = input_strides[k][inner];
+    }
+    for (; r < rank; ++r) {
+      const int d = order[r];
+      bool contiguous = output_strides[d] == m_inner_size * m_output_stride;
+      for (int k = 0; k < NumInputs; ++k) {
+        contiguous = contiguous &&
+                     input_strides[k][d] == m_inner_size * m_input_stride[k];
+      }
+      if (!contiguous) break;
+      m_inner_size *= sizes[d];
+    }
+    for (; r < rank; ++r) {
+      const int d = order[r];
+      m_outer_sizes[m_num_outer] = sizes[d];
+      m_outer_output_strides[m_num_outer] = output_strides[d];
+      for (int k = 0; k < NumInputs; ++k) {
+        m_outer_input_strides[k][m_num_outer] = input_strides[k][d];
+      }
+      m_outer_count *= sizes[d];
+      ++m_num_outer;
+    }
+  }
+
+  StorageIndex inner_size() const { return m_inner_size; }
+  StorageIndex output_stride() const { return m_output_stride; }
+  StorageIndex input_stride(int k) const { return m_input_stride[k]; }
+  // Number of inner loops.
+  StorageIndex outer_count() const { return m_outer_count; }
+  StorageIndex output_offset() const { return m_output_offset; }
+  StorageIndex input_offset(int k) const { return m_input_offset[k]; }
+
+  // Moves the offsets to the next inner loop.
+  void next() {
+    for (int j = 0; j < m_num_outer; ++j) {
+      if (++m_counters[j] < m_outer_sizes[j]) {
+        m_output_offset += m_outer_output_strides[j];
+        for (int k = 0; k < NumInputs; ++k) {
+          m_input_offset[k] += m_outer_input_strides[k][j];
+        }
+        return;
+      }
+      m_counters[j] = 0;
+      m_output_offset -= (m_outer_sizes[j] - 1) * m_outer_output_strides[j];
+      for (int k = 0; k < NumInputs; ++k) {
+        m_input_offset[k] -= (m_outer_sizes[j] - 1) * m_outer_input_strides[k][j];
+      }
+    }
+  }
+
+ private:
+  StorageIndex m_inner_size;
+  StorageIndex m_output_stride;
+  StorageIndex m_input_stride[NumInputs];
+  StorageIndex m_outer_count;
+  int m_num_outer;
+  StorageIndex m_outer_sizes[NumDims > 0 ? NumDims : 1];
+  StorageIndex m_outer_output_strides[NumDims > 0 ? NumDims : 1];
+  StorageIndex m_outer_input_strides[NumInputs][NumDims > 0 ? NumDims : 1];
+  StorageIndex m_counters[NumDims > 0 ? NumDims : 1];
+  StorageIndex m_output_offset;
+  StorageIndex m_input_offset[NumInputs];
+};
+
+// Copies num_coeff_to_copy strided coefficients. A source stride of 0
+// broadcasts a single value.
+template <typename Scalar, typename StorageIndex>
+struct TensorBlockCopyOp {
+  static void Run(const StorageIndex num_coeff_to_copy, Scalar* dst_data,
+                  const StorageIndex dst_stride, const Scalar* src_data,
+                  const StorageIndex src_stride) {
+    typedef typename packet_traits<Scalar>::type Packet;
+    const StorageIndex PacketSize = unpacket_traits<Packet>::size;
+    const StorageIndex vectorized_size =
+        (num_coeff_to_copy / PacketSize) * PacketSize;
+    StorageIndex i = 0;
+    if (PacketSize > 1 && dst_stride == 1) {
+      if (src_stride == 1) {
+        for (; i < vectorized_size; i += PacketSize) {
+          pstoreu<Scalar, Packet>(dst_data + i, ploadu<Packet>(src_data + i));
+        }
+      } else if (src_stride == 0) {
+        const Packet p = pset1<Packet>(*src_data);
+        for (; i < vectorized_size; i += PacketSize) {
+          pstoreu<Scalar, Packet>(dst_data + i, p);
+        }
+      } else {
+        for (; i < vectorized_size; i += PacketSize) {
+          pstoreu<Scalar, Packet>(dst_data + i, pgather<Scalar, Packet>(src_data + i * src_stride, src_stride));
+        }
+      }
+    } else if (PacketSize > 1 && src_stride == 1) {
+      for (; i < vectorized_size; i += PacketSize) {
+        pscatter<Scalar, Packet>(dst_data + i * dst_stride, ploadu<Packet>(src_data + i), dst_stride);
+      }
+    }
+    for (; i < num_coeff_to_copy; ++i) {
+      dst_data[i * dst_stride] = src_data[i * src_stride];
+    }
+  }
+};
+
+// Copies a block of the given sizes between two strided buffers.
+template <typename Scalar, typename StorageIndex, int NumDims>
+struct TensorBlockIO {
+  typedef DSizes<StorageIndex, NumDims> Dimensions;
+
+  static void Copy(const Dimensions& sizes, const Dimensions& dst_strides,
+                   Scalar* dst_data, const Dimensions& src_strides,
+                   const Scalar* src_data) {
+    TensorBlockLoop<StorageIndex, NumDims, 1> loop(sizes, dst_strides, &src_strides);
+    for (StorageIndex i = 0; i < loop.outer_count(); ++i, loop.next()) {
+      TensorBlockCopyOp<Scalar, StorageIndex>::Run(
+          loop.inner_size(), dst_data + loop.output_offset(),
+          loop.output_stride(), src_data + loop.input_offset(0),
+          loop.input_stride(0));
+    }
+  }
+};
+
+// Reads a block from the memory of a tensor.
+struct TensorBlockReader {
+  template <typename Block>
+  static void Run(Block* block, const typename Block::Scalar* src_data) {
+    TensorBlockIO<typename Block::Scalar, typename Block::StorageIndex, Block::NumDims>::Copy(
+        block->block_sizes(), block->block_strides(), block->data(),
+        block->tensor_strides(), src_data + block->first_coeff_index());
+  }
+};
+
+// Writes a block to the memory of a tensor.
+struct TensorBlockWriter {
+  template <typename Block>
+  static void Run(const Block& block, typename Block::Scalar* dst_data) {
+    TensorBlockIO<typename Block::Scalar, typename Block::StorageIndex, Block::NumDims>::Copy(
+        block.block_sizes(), block.tensor_strides(),
+        dst_data + block.first_coeff_index(), block.block_strides(),
+        block.data());
+  }
+};
+
+// Applies a unary functor to num_coeff strided coefficients.
+template <typename UnaryFunctor, typename StorageIndex, typename OutputScalar,
+          bool Vectorizable>
+struct TensorBlockCwiseUnaryOp {
+  template <typename InputScalar>
+  static void Run(const UnaryFunctor& functor, const StorageIndex num_coeff,
+                  OutputScalar* output_data, const StorageIndex output_stride,
+                  const InputScalar* input_data, const StorageIndex input_stride) {
+    for (StorageIndex i = 0; i < num_coeff; ++i) {
+      output_data[i * output_stride] = functor(input_data[i * input_stride]);
+    }
+  }
+};
+
+template <typename UnaryFunctor, typename StorageIndex, typename OutputScalar>
+struct TensorBlockCwiseUnaryOp<UnaryFunctor, StorageIndex, OutputScalar, true> {
+  template <typename InputScalar>
+  static void Run(const UnaryFunctor& functor, const StorageIndex num_coeff,
+                  OutputScalar* output_data, const StorageIndex output_stride,
+                  const InputScalar* input_data, const StorageIndex input_stride) {
+    typedef typename packet_traits<InputScalar>::type InputPacket;
+    typedef typename packet_traits<OutputScalar>::type OutputPacket;
+    const StorageIndex PacketSize = unpacket_traits<OutputPacket>::size;
+    StorageIndex i = 0;
+    if (output_stride == 1 && input_stride == 1) {
+      const StorageIndex vectorized_size = (num_coeff / PacketSize) * PacketSize;
+      for (; i < vectorized_size; i += PacketSize) {
+        pstoreu<OutputScalar, OutputPacket>(
+            output_data + i, functor.packetOp(ploadu<InputPacket>(input_data + i)));
+      }
+    }
+    for (; i < num_coeff; ++i) {
+      output_data[i * output_stride] = functor(input_data[i * input_stride]);
+    }
+  }
+};
+
+template <typename UnaryFunctor, typename StorageIndex, typename OutputScalar,
+          int NumDims, bool Vectorizable>
+struct TensorBlockCwiseUnaryIO {
+  typedef DSizes<StorageIndex, NumDims> Dimensions;
+
+  template <typename InputScalar>
+  static void Run(const UnaryFunctor& functor, const Dimensions& sizes,
+                  const Dimensions& output_strides, OutputScalar* output_data,
+                  const Dimensions& input_strides, const InputScalar* input_data) {
+    TensorBlockLoop<StorageIndex, NumDims, 1> loop(sizes, output_strides, &input_strides);
+    for (StorageIndex i = 0; i < loop.outer_count(); ++i, loop.next()) {
+      TensorBlockCwiseUnaryOp<UnaryFunctor, StorageIndex, OutputScalar, Vectorizable>::Run(
+          functor, loop.inner_size(), output_data + loop.output_offset(),
+          loop.output_stride(), input_data + loop.input_offset(0),
+          loop.input_stride(0));
+    }
+  }
+};
+
+// Applies a binary functor to num_coeff strided coefficients.
+template <typename BinaryFunctor, typename StorageIndex, typename OutputScalar,
+          bool Vectorizable>
+struct TensorBlockCwiseBinaryOp {
+  template <typename LeftScalar, typename RightScalar>
+  static void Run(const BinaryFunctor& functor, const StorageIndex num_coeff,
+                  OutputScalar* output_data, const StorageIndex output_stride,
+                  const LeftScalar* left_data, const StorageIndex left_stride,
+                  const RightScalar* right_data, const StorageIndex right_stride) {
+    for (StorageIndex i = 0; i < num_coeff; ++i) {
+      output_data[i * output_stride] =
+          functor(left_data[i * left_stride], right_data[i * right_stride]);
+    }
+  }
+};
+
+template <typename BinaryFunctor, typename StorageIndex, typename OutputScalar>
+struct TensorBlockCwiseBinaryOp<BinaryFunctor, StorageIndex, OutputScalar, true> {
+  template <typename LeftScalar, typename RightScalar>
+  static void Run(const BinaryFunctor& functor, const StorageIndex num_coeff,
+                  OutputScalar* output_data, const StorageIndex output_stride,
+                  const LeftScalar* left_data, const StorageIndex left_stride,
+                  const RightScalar* right_data, const StorageIndex right_stride) {
+    typedef typename packet_traits<LeftScalar>::type LeftPacket;
+    typedef typename packet_traits<RightScalar>::type RightPacket;
+    typedef typename packet_traits<OutputScalar>::type OutputPacket;
+    const StorageIndex PacketSize = unpacket_traits<OutputPacket>::size;
+    StorageIndex i = 0;
+    if (output_stride == 1 && left_stride == 1 && right_stride == 1) {
+      const StorageIndex vectorized_size = (num_coeff / PacketSize) * PacketSize;
+      for (; i < vectorized_size; i += PacketSize) {
+        pstoreu<OutputScalar, OutputPacket>(
+            output_data + i,
+            functor.packetOp(ploadu<LeftPacket>(left_data + i),
+                             ploadu<RightPacket>(right_data + i)));
+      }
+    }
+    for (; i < num_coeff; ++i) {
+      output_data[i * output_stride] =
+          functor(left_data[i * left_stride], right_data[i * right_stride]);
+    }
+  }
+};
+
+template <typename BinaryFunctor, typename StorageIndex, typename OutputScalar,
+          int NumDims, bool Vectorizable>
+struct TensorBlockCwiseBinaryIO {
+  typedef DSizes<StorageIndex, NumDims> Dimensions;
+
+  template <typename LeftScalar, typename RightScalar>
+  static void Run(const BinaryFunctor& functor, const Dimensions& sizes,
+                  const Dimensions& output_strides, OutputScalar* output_data,
+                  const Dimensions& left_strides, const LeftScalar* left_data,
+                  const Dimensions& right_strides, const RightScalar* right_data) {
+    const Dimensions input_strides[2] = {left_strides, right_strides};
+    TensorBlockLoop<StorageIndex, NumDims, 2> loop(sizes, output_strides, input_strides);
+    for (StorageIndex i = 0; i < loop.outer_count(); ++i, loop.next()) {
+      TensorBlockCwiseBinaryOp<BinaryFunctor, StorageIndex, OutputScalar, Vectorizable>::Run(
+          functor, loop.inner_size(), output_data + loop.output_offset(),
+          loop.output_stride(), left_data + loop.input_offset(0),
+          loop.input_stride(0), right_data + loop.input_offset(1),
+          loop.input_stride(1));
+    }
+  }
+};
+
+/** \class TensorBlockView
+  * \ingroup CXX11_Tensor_Module
+  *
+  * \brief Read only view of a block of the argument of an evaluator.
+  *
+  * The coefficients are read directly from the memory of the argument when
+  * it provides raw access, and are otherwise evaluated in a scratch buffer
+  * allocated on the device.
+  */
+template <typename ArgType, typename Device, typename StorageIndex, int NumDims>
+class TensorBlockView {
+ public:
+  typedef TensorEvaluator<ArgType, Device> Impl;
+  typedef typename remove_const<typename traits<ArgType>::Scalar>::type Scalar;
+  typedef DSizes<StorageIndex, NumDims> Dimensions;
+  typedef TensorBlock<Scalar, StorageIndex, NumDims, Impl::Layout> Block;
+
+  template <typename OtherBlock>
+  TensorBlockView(const Device& device, const Impl& impl, const OtherBlock& block)
+      : m_device(device), m_data(NULL), m_allocated_data(NULL) {
+    if (impl.data() != NULL) {
+      m_data = impl.data() + block.first_coeff_index();
+      m_block_strides = block.tensor_strides();
+    } else {
+      Dimensions sizes;
+      for (int i = 0; i < NumDims; ++i) sizes[i] = block.block_sizes()[i];
+      m_block_strides = strides<Impl::Layout>(sizes);
+      m_allocated_data = static_cast<Scalar*>(
+          m_device.allocate(sizes.TotalSize() * sizeof(Scalar)));
+      Block input_block(block.first_coeff_index(), sizes, m_block_strides,
+                        block.tensor_strides(), m_allocated_data);
+      impl.block(&input_block);
+      m_data = m_allocated_data;
+    }
+  }
+
+  ~TensorBlockView() {
+    if (m_allocated_data) m_device.deallocate(m_allocated_data);
+  }
+
+  const Scalar* data() const { return m_data; }
+  const Dimensions& block_strides() const { return m_block_strides; }
+
+ private:
+  const Device& m_device;
+  const Scalar* m_data;
+  Scalar* m_allocated_data;
+  Dimensions m_block_strides;
+};
+
+/** \class TensorBlockMapper
+  * \ingroup CXX11_Tensor_Module
+  *
+  * \brief Tensor block mapper class.
+  *
+  * Splits a tensor into blocks of at most min_target_size coefficients (the
+  * blocks are larger when a single coefficient of each dimension already
+  * exceeds it) and enumerates them.
+  */
+template <typename Scalar, typename StorageIndex, int NumDims, int Layout>
+class TensorBlockMapper {
+ public:
+  typedef TensorBlock<Scalar, StorageIndex, NumDims, Layout> Block;
+  typedef DSizes<StorageIndex, NumDims> Dimensions;
+
+  template <typename TensorDimensions>
+  TensorBlockMapper(const TensorDimensions& dims,
+                    const TensorBlockShapeType block_shape,
+                    Index min_target_size) {
+    for (int i = 0; i < NumDims; ++i) m_dimensions[i] = dims[i];
+    m_block_dim_sizes = BlockDimensions(m_dimensions, block_shape,
+                                        numext::maxi<Index>(min_target_size, 1));
+
+    Dimensions block_count;
+    for (int i = 0; i < NumDims; ++i) {
+      block_count[i] = divup(m_dimensions[i], m_block_dim_sizes[i]);
+    }
+    m_total_block_count = array_prod(block_count);
+    m_tensor_strides = strides<Layout>(m_dimensions);
+    m_block_strides = strides<Layout>(block_count);
+  }
+
+  Block GetBlockForIndex(StorageIndex block_index, Scalar* data) const {
+    StorageIndex first_coeff_index = 0;
+    Dimensions sizes;
+    for (int i = NumDims - 1; i >= 0; --i) {
+      const int dim = static_cast<int>(Layout) == static_cast<int>(ColMajor) ? i : NumDims - i - 1;
+      const StorageIndex idx = block_index / m_block_strides[dim];
+      block_index -= idx * m_block_strides[dim];
+      const StorageIndex coord = idx * m_block_dim_sizes[dim];
+      sizes[dim] = numext::mini(m_block_dim_sizes[dim], m_dimensions[dim] - coord);
+      first_coeff_index += coord * m_tensor_strides[dim];
+    }
+    return Block(first_coeff_index, sizes, strides<Layout>(sizes),
+                 m_tensor_strides, data);
+  }
+
+  StorageIndex total_block_count() const { return m_total_block_count; }
+
+  StorageIndex block_dims_total_size() const {
+    return m_block_dim_sizes.TotalSize();
+  }
+
+ private:
+  static Dimensions BlockDimensions(const Dimensions& tensor_dims,
+                                    const TensorBlockShapeType block_shape,
+                                    Index min_target_size) {
+    Dimensions block_dim_sizes;
+    for (int i = 0; i < NumDims; ++i) {
+      block_dim_sizes[i] = numext::maxi<StorageIndex>(tensor_dims[i], 1);
+    }
+    if (block_dim_sizes.TotalSize() <= min_target_size) {
+      return block_dim_sizes;
+    }
+
+    if (block_shape == kUniformAllDims) {
+      // Start from a hypercube and give the remaining budget to the inner
+      // dimensions when some dimensions are smaller than the cube.
+      const StorageIndex dim_size_target = static_cast<StorageIndex>(
+          std::pow(static_cast<float>(min_target_size), 1.0f / NumDims));
+      for (int i = 0; i < NumDims; ++i) {
+        block_dim_sizes[i] = numext::mini(
+            numext::maxi<StorageIndex>(dim_size_target, 1), tensor_dims[i]);
+      }
+      StorageIndex total_size = block_dim_sizes.TotalSize();
+      for (int i = 0; i < NumDims; ++i) {
+        const int dim = static_cast<int>(Layout) == static_cast<int>(ColMajor) ? i : NumDims - i - 1;
+        if (block_dim_sizes[dim] < tensor_dims[dim]) {
+          const StorageIndex total_size_other_dims = total_size / block_dim_sizes[dim];
+          const StorageIndex alloc_avail = min_target_size / total_size_other_dims;
+          if (alloc_avail <= block_dim_sizes[dim]) break;
+          block_dim_sizes[dim] = numext::mini(tensor_dims[dim], alloc_avail);
+          total_size = total_size_other_dims * block_dim_sizes[dim];
+        }
+      }
+    } else {
+      StorageIndex coeff_to_allocate = static_cast<StorageIndex>(min_target_size);
+      for (int i = 0; i < NumDims; ++i) {
+        const int dim = static_cast<int>(Layout) == static_cast<int>(ColMajor) ? i : NumDims - i - 1;
+        block_dim_sizes[dim] = numext::mini(coeff_to_allocate, tensor_dims[dim]);
+        coeff_to_allocate = numext::maxi<StorageIndex>(
+            1, coeff_to_allocate / numext::maxi<StorageIndex>(1, block_dim_sizes[dim]));
+      }
+    }
+    return block_dim_sizes;
+  }
+
+  Dimensions m_dimensions;
+  Dimensions m_block_dim_sizes;
+  Dimensions m_tensor_strides;
+  Dimensions m_block_strides;
+  StorageIndex m_total_block_count;
+};
+
+}  // namespace internal
+}  // namespace Eigen
+
+#endif  // EIGEN_CXX11_TENSOR_TENSOR_BLOCK_H
@@ -109,12 +109,14 @@ struct TensorEvaluator<const TensorBroadcastingOp<Broadcast, ArgType>, Device>
   enum {
     IsAligned = true,
     PacketAccess = TensorEvaluator<ArgType, Device>::PacketAccess,
+    BlockAccess = TensorEvaluator<ArgType, Device>::BlockAccess,
+    PreferBlockAccess = true,
     Layout = TensorEvaluator<ArgType, Device>::Layout,
     RawAccess = false
   };
 
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE TensorEvaluator(const XprType& op, const Device& device)
-    : m_broadcast(op.broadcast()),m_impl(op.expression(), device)
+    : m_broadcast(op.broadcast()),m_impl(op.expression(), device), m_device(device)
   {
     // The broadcasting op doesn't change the rank of the tensor. One can't broadcast a scalar
     // and store the result in a scalar. Instead one should reshape the scalar into a a N-D
@@ -151,6 +153,14 @@ struct TensorEvaluator<const TensorBroadcastingOp<Broadcast, ArgType>, Device>
     return true;
   }
 
+#ifdef EIGEN_USE_THREADS
+  template <typename EvalSubExprsCallback>
+  EIGEN_STRONG_INLINE void evalSubExprsIfNeededAsync(
+      Scalar*, EvalSubExprsCallback done) {
+    m_impl.evalSubExprsIfNeededAsync(NULL, [done](bool) { done(true); });
+  }
+#endif  // EIGEN_USE_THREADS
+
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void cleanup() {
     m_impl.cleanup();
   }
@@ -373,6 +383,127 @@ struct TensorEvaluator<const TensorBroadcastingOp<Broadcast, ArgType>, Device>
            TensorOpCost(0, 0, compute_cost, vectorized, PacketSize);
   }
 
+  EIGEN_STRONG_INLINE void getResourceRequirements(internal::TensorOpResourceRequirements* resources) const {
+    m_impl.getResourceRequirements(resources);
+  }
+
+  // Along each dimension, the block is split in up to 3 segments that map to
+  // contiguous ranges of the input: the end of a copy of the input, whole
+  // copies of the input and the beginning of a copy. Each combination of
+  // segments is an input block that is copied with a stride of 0 along the
+  // repetitions, so no index is ever divided per coefficient.
+  template <typename OutputTensorBlock>
+  EIGEN_STRONG_INLINE void block(OutputTensorBlock* output_block) const {
+    typedef typename OutputTensorBlock::StorageIndex StorageIndex;
+    typedef typename OutputTensorBlock::Scalar BlockScalar;
+    typedef typename OutputTensorBlock::Dimensions BlockDimensions;
+    typedef DSizes<StorageIndex, 2 * NumDims> CopyDimensions;
+
+    const BlockDimensions& output_sizes = output_block->block_sizes();
+    const BlockDimensions& output_strides = output_block->block_strides();
+
+    StorageIndex seg_input_start[NumDims][3];
+    StorageIndex seg_size[NumDims][3];
+    StorageIndex seg_reps[NumDims][3];
+    StorageIndex seg_output_offset[NumDims][3];
+    int num_segs[NumDims];
+    StorageIndex index = output_block->first_coeff_index();
+    for (int k = 0; k < NumDims; ++k) {
+      const int i = static_cast<int>(Layout) == static_cast<int>(ColMajor) ? NumDims - 1 - k : k;
+      const StorageIndex coord = index / m_outputStrides[i];
+      index -= coord * m_outputStrides[i];
+
+      const StorageIndex input_dim = m_impl.dimensions()[i];
+      const StorageIndex size = output_sizes[i];
+      const StorageIndex start = coord % input_dim;
+      StorageIndex pos = 0;
+      int n = 0;
+      if (start != 0) {
+        seg_input_start[i][n] = start;
+        seg_size[i][n] = numext::mini(size, input_dim - start);
+        seg_reps[i][n] = 1;
+        seg_output_offset[i][n] = 0;
+        pos = seg_size[i][n++];
+      }
+      if ((size - pos) / input_dim > 0) {
+        seg_input_start[i][n] = 0;
+        seg_size[i][n] = input_dim;
+        seg_reps[i][n] = (size - pos) / input_dim;
+        seg_output_offset[i][n] = pos;
+        pos += seg_reps[i][n++] * input_dim;
+      }
+      if (pos < size) {
+        seg_input_start[i][n] = 0;
+        seg_size[i][n] = size - pos;
+        seg_reps[i][n] = 1;
+        seg_output_offset[i][n] = pos;
+        ++n;
+      }
+      num_segs[i] = n;
+    }
+
+    const BlockScalar* input_data = m_impl.data();
+    BlockScalar* scratch = NULL;
+    if (input_data == NULL) {
+      scratch = static_cast<BlockScalar*>(
+          m_device.allocate(output_sizes.TotalSize() * sizeof(BlockScalar)));
+    }
+    BlockDimensions input_tensor_strides;
+    for (int i = 0; i < NumDims; ++i) {
+      input_tensor_strides[i] = m_inputStrides[i];
+    }
+
+    int seg[NumDims];
+    for (int i = 0; i < NumDims; ++i) seg[i] = 0;
+    for (;;) {
+      StorageIndex input_index = 0;
+      StorageIndex output_offset = 0;
+      BlockDimensions input_sizes;
+      for (int i = 0; i < NumDims; ++i) {
+        input_index += seg_input_start[i][seg[i]] * m_inputStrides[i];
+        output_offset += seg_output_offset[i][seg[i]] * output_strides[i];
+        input_sizes[i] = seg_size[i][seg[i]];
+      }
+
+      const BlockScalar* src_data;
+      BlockDimensions src_strides;
+      if (input_data != NULL) {
+        src_data = input_data + input_index;
+        src_strides = input_tensor_strides;
+      } else {
+        src_strides = internal::strides<Layout>(input_sizes);
+        OutputTensorBlock input_block(input_index, input_sizes, src_strides,
+                                      input_tensor_strides, scratch);
+        m_impl.block(&input_block);
+        src_data = scratch;
+      }
+
+      CopyDimensions copy_sizes;
+      CopyDimensions copy_dst_strides;
+      CopyDimensions copy_src_strides;
+      for (int i = 0; i < NumDims; ++i) {
+        copy_sizes[2 * i] = input_sizes[i];
+        copy_dst_strides[2 * i] = output_strides[i];
+        copy_src_strides[2 * i] = src_strides[i];
+        copy_sizes[2 * i + 1] = seg_reps[i][seg[i]];
+        copy_dst_strides[2 * i + 1] = output_strides[i] * m_impl.dimensions()[i];
+        copy_src_strides[2 * i + 1] = 0;
+      }
+      internal::TensorBlockIO<BlockScalar, StorageIndex, 2 * NumDims>::Copy(
+          copy_sizes, copy_dst_strides, output_block->data() + output_offset,
+          copy_src_strides, src_data);
+
+      int i = 0;
+      for (; i < NumDims; ++i) {
+        if (++seg[i] < num_segs[i]) break;
+        seg[i] = 0;
+      }
+      if (i == NumDims) break;
+    }
+
+    if (scratch != NULL) m_device.deallocate(scratch);
+  }
+
   EIGEN_DEVICE_FUNC typename Eigen::internal::traits<XprType>::PointerType data() const { return NULL; }
 
   const TensorEvaluator<ArgType, Device>& impl() const { return m_impl; }
@@ -385,6 +516,7 @@ struct TensorEvaluator<const TensorBroadcastingOp<Broadcast, ArgType>, Device>
   array<Index, NumDims> m_outputStrides;
   array<Index, NumDims> m_inputStrides;
   TensorEvaluator<ArgType, Device> m_impl;
+  const Device& m_device;
 };
 
 
@@ -146,6 +146,8 @@ struct TensorEvaluator<const TensorChippingOp<DimId, ArgType>, Device>
     // slice offsets.
     IsAligned = false,
     PacketAccess = TensorEvaluator<ArgType, Device>::PacketAccess,
+    BlockAccess = TensorEvaluator<ArgType, Device>::BlockAccess & (NumDims > 0),
+    PreferBlockAccess = true,
     Layout = TensorEvaluator<ArgType, Device>::Layout,
     CoordAccess = false,  // to be implemented
     RawAccess = false
@@ -192,6 +194,14 @@ struct TensorEvaluator<const TensorChippingOp<DimId, ArgType>, Device>
     return true;
   }
 
+#ifdef EIGEN_USE_THREADS
+  template <typename EvalSubExprsCallback>
+  EIGEN_STRONG_INLINE void evalSubExprsIfNeededAsync(
+      Scalar*, EvalSubExprsCallback done) {
+    m_impl.evalSubExprsIfNeededAsync(NULL, [done](bool) { done(true); });
+  }
+#endif  // EIGEN_USE_THREADS
+
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void cleanup() {
     m_impl.cleanup();
   }
@@ -265,6 +275,16 @@ struct TensorEvaluator<const TensorChippingOp<DimId, ArgType>, Device>
            TensorOpCost(0, 0, cost, vectorized, PacketSize);
   }
 
+  EIGEN_STRONG_INLINE void getResourceRequirements(internal::TensorOpResourceRequirements* resources) const {
+    m_impl.getResourceRequirements(resources);
+  }
+
+  template <typename OutputTensorBlock>
+  EIGEN_STRONG_INLINE void block(OutputTensorBlock* output_block) const {
+    typename InputTensorBlock<OutputTensorBlock>::type input_block = inputBlock(*output_block);
+    m_impl.block(&input_block);
+  }
+
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE typename Eigen::internal::traits<XprType>::PointerType data() const {
     CoeffReturnType* result = const_cast<CoeffReturnType*>(m_impl.data());
     if (((static_cast<int>(Layout) == static_cast<int>(ColMajor) && m_dim.actualDim() == NumDims) ||
@@ -289,6 +309,41 @@ struct TensorEvaluator<const TensorChippingOp<DimId, ArgType>, Device>
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE const TensorEvaluator<ArgType, Device>& impl() const { return m_impl; }
 
  protected:
+  template <typename OutputTensorBlock>
+  struct InputTensorBlock {
+    typedef internal::TensorBlock<typename OutputTensorBlock::Scalar,
+                                  typename OutputTensorBlock::StorageIndex,
+                                  NumInputDims, Layout> type;
+  };
+
+  // The block of the input that holds a block of the chip: the chipped
+  // dimension is reinserted with a size of 1.
+  template <typename OutputTensorBlock>
+  EIGEN_STRONG_INLINE typename InputTensorBlock<OutputTensorBlock>::type
+  inputBlock(const OutputTensorBlock& output_block) const {
+    typedef typename InputTensorBlock<OutputTensorBlock>::type::Dimensions InputDimensions;
+    InputDimensions input_dims;
+    for (int i = 0; i < NumInputDims; ++i) {
+      input_dims[i] = m_impl.dimensions()[i];
+    }
+    InputDimensions input_block_sizes;
+    InputDimensions input_block_strides;
+    for (int i = 0, j = 0; i < NumInputDims; ++i) {
+      if (i == m_dim.actualDim()) {
+        input_block_sizes[i] = 1;
+        input_block_strides[i] = 0;
+      } else {
+        input_block_sizes[i] = output_block.block_sizes()[j];
+        input_block_strides[i] = output_block.block_strides()[j];
+        ++j;
+      }
+    }
+    return typename InputTensorBlock<OutputTensorBlock>::type(
+        srcCoeff(output_block.first_coeff_index()), input_block_sizes,
+        input_block_strides, internal::strides<Layout>(input_dims),
+        output_block.data());
+  }
+
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE Index srcCoeff(Index index) const
   {
     Index inputIndex;
@@ -343,6 +398,8 @@ struct TensorEvaluator<TensorChippingOp<DimId, ArgType>, Device>
   enum {
     IsAligned = false,
     PacketAccess = TensorEvaluator<ArgType, Device>::PacketAccess,
+    BlockAccess = TensorEvaluator<ArgType, Device>::BlockAccess & (NumDims > 0),
+    PreferBlockAccess = true,
     RawAccess = false
   };
 
@@ -393,6 +450,10 @@ struct TensorEvaluator<TensorChippingOp<DimId, ArgType>, Device>
       }
     }
   }
+  template <typename TensorBlock>
+  EIGEN_STRONG_INLINE void writeBlock(const TensorBlock& block) {
+    this->m_impl.writeBlock(this->inputBlock(block));
+  }
 };
 
 
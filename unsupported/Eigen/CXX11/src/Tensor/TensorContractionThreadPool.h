@@ -56,16 +56,70 @@ struct packRhsAndKernelArg {
 }  // end namespace internal
 #endif  // EIGEN_USE_SIMPLE_THREAD_POOL
 
-template<typename Indices, typename LeftArgType, typename RightArgType>
-struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgType>, ThreadPoolDevice> :
-    public TensorContractionEvaluatorBase<TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgType>, ThreadPoolDevice> > {
+namespace internal {
+
+// Exposes the coefficients of a tensor evaluator converted to TgtScalar. The
+// contraction mappers read their operands through it, so that bfloat16 inputs
+// are widened to float while they are packed instead of in a separate pass
+// over the whole tensors.
+template <typename ArgEvaluator, typename TgtScalar>
+struct TensorContractionCastingEvaluator {
+  typedef typename ArgEvaluator::Index Index;
+  typedef typename ArgEvaluator::Dimensions Dimensions;
+  typedef typename ArgEvaluator::Scalar SrcScalar;
+  typedef TgtScalar Scalar;
+  typedef TgtScalar CoeffReturnType;
+  typedef typename packet_traits<SrcScalar>::type SrcPacket;
+  typedef typename packet_traits<TgtScalar>::type PacketReturnType;
+  static const int PacketSize = unpacket_traits<PacketReturnType>::size;
+
+  enum {
+    RawAccess = false,
+    PacketAccess = ArgEvaluator::PacketAccess &&
+                   type_casting_traits<SrcScalar, TgtScalar>::VectorizedCast &&
+                   int(unpacket_traits<SrcPacket>::size) == int(PacketSize)
+  };
+
+  TensorContractionCastingEvaluator(const ArgEvaluator& impl) : m_impl(impl) {}
+
+  const Dimensions& dimensions() const { return m_impl.dimensions(); }
+
+  EIGEN_STRONG_INLINE CoeffReturnType coeff(Index index) const {
+    return static_cast<TgtScalar>(m_impl.coeff(index));
+  }
+
+  template <int LoadMode>
+  EIGEN_STRONG_INLINE PacketReturnType packet(Index index) const {
+    return packet(index, typename conditional<PacketAccess, true_type, false_type>::type());
+  }
+
+ private:
+  // The alignment of the source and target packets differ, so the source is
+  // always read unaligned.
+  EIGEN_STRONG_INLINE PacketReturnType packet(Index index, true_type) const {
+    return pcast<SrcPacket, PacketReturnType>(m_impl.template packet<Unaligned>(index));
+  }
+  EIGEN_STRONG_INLINE PacketReturnType packet(Index index, false_type) const {
+    EIGEN_ALIGN_MAX TgtScalar values[PacketSize];
+    for (int i = 0; i < PacketSize; ++i) values[i] = coeff(index + i);
+    return pload<PacketReturnType>(values);
+  }
+
+  const ArgEvaluator m_impl;
+};
+
+}  // end namespace internal
+
+template<typename Indices, typename LeftArgType, typename RightArgType, typename OutputKernelType>
+struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgType, OutputKernelType>, ThreadPoolDevice> :
+    public TensorContractionEvaluatorBase<TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgType, OutputKernelType>, ThreadPoolDevice> > {
 
   typedef ThreadPoolDevice Device;
 
-  typedef TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgType>, Device> Self;
+  typedef TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgType, OutputKernelType>, Device> Self;
   typedef TensorContractionEvaluatorBase<Self> Base;
 
-  typedef TensorContractionOp<Indices, LeftArgType, RightArgType> XprType;
+  typedef TensorContractionOp<Indices, LeftArgType, RightArgType, OutputKernelType> XprType;
   typedef typename internal::remove_const<typename XprType::Scalar>::type Scalar;
   typedef typename XprType::Index Index;
   typedef typename XprType::CoeffReturnType CoeffReturnType;
@@ -119,7 +173,11 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
     const Index m = this->m_i_size;
     const Index n = this->m_j_size;
     const Index k = this->m_k_size;
-    if (m == 0 || n == 0 || k == 0) return;
+    if (m == 0 || n == 0) return;
+    if (k == 0) {
+      this->evalEmptyContraction(buffer);
+      return;
+    }
 
 #if defined(EIGEN_VECTORIZE_AVX) && defined(EIGEN_USE_LIBXSMM)
     if (this->m_can_use_xsmm) {
@@ -134,19 +192,177 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
       } else {
         ContextXsmm<Alignment>(this, buffer, m, n, k, blocking).run();
       }
+      // The libxsmm kernels are opaque, so the output kernel is applied to
+      // the whole output at once.
+      typedef internal::blas_data_mapper<Scalar, Index, ColMajor> OutputMapper;
+      this->m_output_kernel(OutputMapper(buffer, m),
+                            this->m_tensor_contraction_params,
+                            static_cast<Index>(0), static_cast<Index>(0), m, n);
       return;
     }
 #endif
 
-    typedef
-        typename internal::remove_const<typename EvalLeftArgType::Scalar>::type
-            LhsScalar;
-    typedef
-        typename internal::remove_const<typename EvalRightArgType::Scalar>::type
-            RhsScalar;
+    evalProduct<lhs_inner_dim_contiguous, rhs_inner_dim_contiguous,
+                rhs_inner_dim_reordered, Alignment>(
+        buffer, typename internal::conditional<AccumulateInFloat,
+                                               internal::true_type,
+                                               internal::false_type>::type());
+  }
+
+  // bfloat16 only has 8 bits of mantissa, which is not enough to accumulate
+  // long dot products. Such contractions read their operands as float and
+  // accumulate into a temporary float buffer that is rounded once at the end.
+  enum {
+    AccumulateInFloat =
+        internal::is_same<LhsScalar, bfloat16>::value &&
+        internal::is_same<RhsScalar, bfloat16>::value &&
+        internal::is_same<Scalar, bfloat16>::value
+  };
+
+  template <bool lhs_inner_dim_contiguous, bool rhs_inner_dim_contiguous,
+            bool rhs_inner_dim_reordered, int Alignment>
+  void evalProduct(Scalar* buffer, internal::false_type) const {
+    evalProductSharded<lhs_inner_dim_contiguous, rhs_inner_dim_contiguous,
+                       rhs_inner_dim_reordered, Alignment>(
+        buffer, this->m_leftImpl, this->m_rightImpl, this->m_output_kernel);
+  }
+
+  template <bool lhs_inner_dim_contiguous, bool rhs_inner_dim_contiguous,
+            bool rhs_inner_dim_reordered, int Alignment>
+  void evalProduct(Scalar* buffer, internal::true_type) const {
+    typedef internal::TensorContractionCastingEvaluator<
+        TensorEvaluator<EvalLeftArgType, Device>, float> LeftEvaluator;
+    typedef internal::TensorContractionCastingEvaluator<
+        TensorEvaluator<EvalRightArgType, Device>, float> RightEvaluator;
+    const Index size = this->m_i_size * this->m_j_size;
+    float* acc =
+        static_cast<float*>(this->m_device.allocate(size * sizeof(float)));
+    evalProductSharded<lhs_inner_dim_contiguous, rhs_inner_dim_contiguous,
+                       rhs_inner_dim_reordered, Unaligned>(
+        acc, LeftEvaluator(this->m_leftImpl),
+        RightEvaluator(this->m_rightImpl), NoOpOutputKernel());
+    this->m_device.parallelFor(this->m_j_size, roundingCost(),
+                               [=](Index first, Index last) {
+                                 roundAccumulator(buffer, acc, first, last);
+                               });
+    this->m_device.deallocate(acc);
+  }
+
+  // Rounds the columns [first, last) of the float accumulator into buffer,
+  // and applies the output kernel to them while they are still in cache.
+  void roundAccumulator(Scalar* buffer, const float* acc, Index first,
+                        Index last) const {
+    const Index m = this->m_i_size;
+    for (Index i = first * m; i < last * m; ++i) buffer[i] = Scalar(acc[i]);
+    typedef internal::blas_data_mapper<Scalar, Index, ColMajor> OutputMapper;
+    this->m_output_kernel(OutputMapper(buffer, m).getSubMapper(0, first),
+                          this->m_tensor_contraction_params,
+                          static_cast<Index>(0), first, m, last - first);
+  }
+
+  TensorOpCost roundingCost() const {
+    const double m = static_cast<double>(this->m_i_size);
+    return TensorOpCost(m * sizeof(float), m * sizeof(Scalar), m);
+  }
+
+  // Asynchronous version of evalProduct: returns immediately and calls done
+  // from a worker thread once the product has been written to buffer.
+  template <bool lhs_inner_dim_contiguous, bool rhs_inner_dim_contiguous,
+            bool rhs_inner_dim_reordered, int Alignment>
+  void evalProductAsync(Scalar* buffer, std::function<void()> done) const {
+    const Index m = this->m_i_size;
+    const Index n = this->m_j_size;
+    const Index k = this->m_k_size;
+    if (m == 0 || n == 0) {
+      done();
+      return;
+    }
+    if (k == 0) {
+      this->evalEmptyContraction(buffer);
+      done();
+      return;
+    }
+
+#if defined(EIGEN_VECTORIZE_AVX) && defined(EIGEN_USE_LIBXSMM)
+    if (this->m_can_use_xsmm) {
+      // The libxsmm kernels are only available synchronously.
+      this->m_device.enqueueNoNotification([this, buffer, done]() {
+        this->template evalProduct<lhs_inner_dim_contiguous,
+                                   rhs_inner_dim_contiguous,
+                                   rhs_inner_dim_reordered, Alignment>(buffer);
+        done();
+      });
+      return;
+    }
+#endif
+
+    evalProductAsync<lhs_inner_dim_contiguous, rhs_inner_dim_contiguous,
+                     rhs_inner_dim_reordered, Alignment>(
+        buffer, std::move(done),
+        typename internal::conditional<AccumulateInFloat, internal::true_type,
+                                       internal::false_type>::type());
+  }
+
+  template <bool lhs_inner_dim_contiguous, bool rhs_inner_dim_contiguous,
+            bool rhs_inner_dim_reordered, int Alignment>
+  void evalProductAsync(Scalar* buffer, std::function<void()> done,
+                        internal::false_type) const {
+    evalProductSharded<lhs_inner_dim_contiguous, rhs_inner_dim_contiguous,
+                       rhs_inner_dim_reordered, Alignment>(
+        buffer, this->m_leftImpl, this->m_rightImpl, this->m_output_kernel,
+        std::move(done));
+  }
+
+  template <bool lhs_inner_dim_contiguous, bool rhs_inner_dim_contiguous,
+            bool rhs_inner_dim_reordered, int Alignment>
+  void evalProductAsync(Scalar* buffer, std::function<void()> done,
+                        internal::true_type) const {
+    typedef internal::TensorContractionCastingEvaluator<
+        TensorEvaluator<EvalLeftArgType, Device>, float> LeftEvaluator;
+    typedef internal::TensorContractionCastingEvaluator<
+        TensorEvaluator<EvalRightArgType, Device>, float> RightEvaluator;
+    const Index size = this->m_i_size * this->m_j_size;
+    float* acc =
+        static_cast<float*>(this->m_device.allocate(size * sizeof(float)));
+    const Device& device = this->m_device;
+    evalProductSharded<lhs_inner_dim_contiguous, rhs_inner_dim_contiguous,
+                       rhs_inner_dim_reordered, Unaligned>(
+        acc, LeftEvaluator(this->m_leftImpl),
+        RightEvaluator(this->m_rightImpl), NoOpOutputKernel(),
+        [this, &device, buffer, acc, done]() {
+          device.parallelForAsync(
+              this->m_j_size, roundingCost(),
+              [this, buffer, acc](Index first, Index last) {
+                roundAccumulator(buffer, acc, first, last);
+              },
+              [&device, acc, done]() {
+                device.deallocate(acc);
+                done();
+              });
+        });
+  }
+
+  // Parallel gemm over the given operand evaluators, writing into a column
+  // major buffer of AccScalar. output_kernel is applied to each block of the
+  // buffer once it is final. When done is set, the gemm is evaluated
+  // asynchronously and done is called from the worker that completes it.
+  template <bool lhs_inner_dim_contiguous, bool rhs_inner_dim_contiguous,
+            bool rhs_inner_dim_reordered, int Alignment, typename AccScalar,
+            typename LeftEvaluator, typename RightEvaluator,
+            typename OutputKernel>
+  void evalProductSharded(AccScalar* buffer, const LeftEvaluator& left,
+                          const RightEvaluator& right,
+                          const OutputKernel& output_kernel,
+                          std::function<void()> done = nullptr) const {
+    const Index m = this->m_i_size;
+    const Index n = this->m_j_size;
+    const Index k = this->m_k_size;
+
+    typedef typename internal::remove_const<
+        typename LeftEvaluator::Scalar>::type LhsScalar;
+    typedef typename internal::remove_const<
+        typename RightEvaluator::Scalar>::type RhsScalar;
     typedef typename internal::gebp_traits<LhsScalar, RhsScalar> Traits;
-    typedef TensorEvaluator<EvalLeftArgType, Device> LeftEvaluator;
-    typedef TensorEvaluator<EvalRightArgType, Device> RightEvaluator;
     typedef internal::TensorContractionInputMapper<
         LhsScalar, Index, internal::Lhs, LeftEvaluator, left_nocontract_t,
         contract_t, internal::packet_traits<LhsScalar>::size,
@@ -157,7 +373,7 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
         contract_t, internal::packet_traits<RhsScalar>::size,
         rhs_inner_dim_contiguous, rhs_inner_dim_reordered, Unaligned>
         RhsMapper;
-    typedef internal::blas_data_mapper<Scalar, Index, ColMajor> OutputMapper;
+    typedef internal::blas_data_mapper<AccScalar, Index, ColMajor> OutputMapper;
     typedef internal::gemm_pack_lhs<LhsScalar, Index,
                                     typename LhsMapper::SubMapper, Traits::mr,
                                     Traits::LhsProgress, ColMajor>
@@ -228,16 +444,23 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
     // model is not tuned. Remove this when the cost model is tuned.
     if (n == 1) num_threads = 1;
 
-    if (num_threads == 1) {
+    // The accumulation buffer of the single-threaded algorithm is the output,
+    // so it is only usable when there is no intermediate buffer.
+    if (num_threads == 1 && internal::is_same<AccScalar, Scalar>::value) {
       // The single-threaded algorithm should be faster in this case.
-      if (n == 1)
-        this->template evalGemv<lhs_inner_dim_contiguous,
-                                rhs_inner_dim_contiguous,
-                                rhs_inner_dim_reordered, Alignment>(buffer);
-      else
-        this->template evalGemm<lhs_inner_dim_contiguous,
-                                rhs_inner_dim_contiguous,
-                                rhs_inner_dim_reordered, Alignment>(buffer);
+      Scalar* output = reinterpret_cast<Scalar*>(buffer);
+      if (done) {
+        this->m_device.enqueueNoNotification([this, output, done]() {
+          this->template evalSingleThreaded<lhs_inner_dim_contiguous,
+                                            rhs_inner_dim_contiguous,
+                                            rhs_inner_dim_reordered,
+                                            Alignment>(output);
+          done();
+        });
+      } else {
+        evalSingleThreaded<lhs_inner_dim_contiguous, rhs_inner_dim_contiguous,
+                           rhs_inner_dim_reordered, Alignment>(output);
+      }
       return;
     }
 
@@ -299,32 +522,64 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
     // more important in this case.
     if ((shard_by_col ? nm : nn) == 1) parallel_pack = false;
 
-    LhsMapper lhs(this->m_leftImpl, this->m_left_nocontract_strides,
+    LhsMapper lhs(left, this->m_left_nocontract_strides,
                   this->m_i_strides, this->m_left_contracting_strides,
                   this->m_k_strides);
 
-    RhsMapper rhs(this->m_rightImpl, this->m_right_nocontract_strides,
+    RhsMapper rhs(right, this->m_right_nocontract_strides,
                   this->m_j_strides, this->m_right_contracting_strides,
                   this->m_k_strides);
 
-    Context<LhsPacker, RhsPacker, GebpKernel, LhsMapper, RhsMapper,
-            OutputMapper>(this->m_device, num_threads, lhs, rhs, buffer, m, n,
-                          k, bm, bn, bk, nm, nn, nk, gm, gn, nm0, nn0,
-                          shard_by_col, parallel_pack)
-        .run();
+    typedef Context<LhsPacker, RhsPacker, GebpKernel, LhsMapper, RhsMapper,
+                    OutputMapper, OutputKernel> ContextType;
+    if (done) {
+      // The context deletes itself once the last kernel has completed.
+      (new ContextType(this->m_device, num_threads, lhs, rhs, buffer, m, n, k,
+                       bm, bn, bk, nm, nn, nk, gm, gn, nm0, nn0, shard_by_col,
+                       parallel_pack, output_kernel,
+                       this->m_tensor_contraction_params, std::move(done)))
+          ->runAsync();
+    } else {
+      ContextType(this->m_device, num_threads, lhs, rhs, buffer, m, n, k, bm,
+                  bn, bk, nm, nn, nk, gm, gn, nm0, nn0, shard_by_col,
+                  parallel_pack, output_kernel,
+                  this->m_tensor_contraction_params)
+          .run();
+    }
+  }
+
+  template <bool lhs_inner_dim_contiguous, bool rhs_inner_dim_contiguous,
+            bool rhs_inner_dim_reordered, int Alignment>
+  void evalSingleThreaded(Scalar* output) const {
+    if (this->m_j_size == 1)
+      this->template evalGemv<lhs_inner_dim_contiguous,
+                              rhs_inner_dim_contiguous,
+                              rhs_inner_dim_reordered, Alignment>(output);
+    else
+      this->template evalGemm<lhs_inner_dim_contiguous,
+                              rhs_inner_dim_contiguous,
+                              rhs_inner_dim_reordered, Alignment>(output);
   }
 
   // Context coordinates a single parallel gemm operation.
   template <typename LhsPacker, typename RhsPacker, typename GebpKernel,
-            typename LhsMapper, typename RhsMapper, typename OutputMapper>
+            typename LhsMapper, typename RhsMapper, typename OutputMapper,
+            typename OutputKernel>
   class Context {
    public:
+    typedef typename LhsMapper::Scalar LhsScalar;
+    typedef typename RhsMapper::Scalar RhsScalar;
+    typedef typename GebpKernel::ResScalar Scalar;
+
     Context(const Device& device, int num_threads, LhsMapper& lhs,
             RhsMapper& rhs, Scalar* buffer, Index tm, Index tn, Index tk, Index bm,
             Index bn, Index bk, Index nm, Index nn, Index nk, Index gm,
             Index gn, Index nm0, Index nn0, bool shard_by_col,
-            bool parallel_pack)
-        : device_(device),
+            bool parallel_pack, const OutputKernel& output_kernel,
+            const TensorContractionParams& tensor_contraction_params,
+            std::function<void()> done = nullptr)
+        : done_callback_(std::move(done)),
+          device_(device),
           lhs_(lhs),
           rhs_(rhs),
           buffer_(buffer),
@@ -332,6 +587,8 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
           num_threads_(num_threads),
           shard_by_col_(shard_by_col),
           parallel_pack_(parallel_pack),
+          output_kernel_(output_kernel),
+          tensor_contraction_params_(tensor_contraction_params),
           m_(tm),
           n_(tn),
           k_(tk),
@@ -377,7 +634,7 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
           divup<size_t>(bm_ * bk_ * sizeof(LhsScalar), align) * align;
       size_t rhs_size =
           divup<size_t>(bn_ * bk_ * sizeof(RhsScalar), align) * align;
-      packed_mem_ = static_cast<char*>(internal::aligned_malloc(
+      packed_mem_ = static_cast<char*>(device_.allocate(
           (nm0_ * lhs_size + nn0_ * rhs_size) * std::min<size_t>(nk_, P - 1)));
       char* mem = static_cast<char*>(packed_mem_);
       for (Index x = 0; x < numext::mini<Index>(nk_, P - 1); x++) {
@@ -399,7 +656,7 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
         for (Index m = 0; m < nm_; m++) delete[] state_kernel_[x][m];
         delete[] state_kernel_[x];
       }
-      internal::aligned_free(packed_mem_);
+      device_.deallocate(packed_mem_);
     }
 
     void run() {
@@ -413,16 +670,29 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
       done_.Wait();
     }
 
+    // Kicks off the computation from a worker thread and returns. The
+    // context must be heap allocated: it deletes itself after calling the
+    // done callback.
+    void runAsync() {
+      eigen_assert(done_callback_ != nullptr);
+      device_.enqueueNoNotification([this]() { signal_switch(0, 1); });
+    }
+
    private:
     Notification done_;
+    std::function<void()> done_callback_;
     const Device& device_;
-    LhsMapper& lhs_;
-    RhsMapper& rhs_;
+    // The mappers are copied so that an asynchronous context does not
+    // depend on the stack of the thread that started it.
+    LhsMapper lhs_;
+    RhsMapper rhs_;
     Scalar* const buffer_;
     OutputMapper output_;
     const int num_threads_;
     const bool shard_by_col_;
     const bool parallel_pack_;
+    const OutputKernel output_kernel_;
+    const TensorContractionParams tensor_contraction_params_;
     // Matrix sizes.
     const Index m_;
     const Index n_;
@@ -536,11 +806,13 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
       const Index mend = m * gm_ + gm(m);
       if (shard_by_col_) {
         for (Index n1 = n * gn_; n1 < nend; n1++) {
-          for (Index m1 = m * gm_; m1 < mend; m1++)
+          for (Index m1 = m * gm_; m1 < mend; m1++) {
             GebpKernel()(output_.getSubMapper(m1 * bm_, n1 * bn_),
                          packed_lhs_[k % (P - 1)][m1],
                          packed_rhs_[k % (P - 1)][n1], bm(m1), bk(k), bn(n1),
                          Scalar(1), -1, -1, 0, 0);
+            if (k + 1 == nk_) apply_output_kernel(m1, n1);
+          }
         }
       } else {
         for (Index m1 = m * gm_; m1 < mend; m1++)
@@ -549,12 +821,21 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
                          packed_lhs_[k % (P - 1)][m1],
                          packed_rhs_[k % (P - 1)][n1], bm(m1), bk(k), bn(n1),
                          Scalar(1), -1, -1, 0, 0);
+            if (k + 1 == nk_) apply_output_kernel(m1, n1);
           }
       }
       signal_kernel(m, n, k + 1, false);
       signal_switch(k + 2);
     }
 
+    // Applies the output kernel to the output block (m1, n1), which has just
+    // received the contribution of the last slice of k.
+    void apply_output_kernel(Index m1, Index n1) {
+      output_kernel_(output_.getSubMapper(m1 * bm_, n1 * bn_),
+                     tensor_contraction_params_, m1 * bm_, n1 * bn_, bm(m1),
+                     bn(n1));
+    }
+
     void signal_packing(Index k) {
       eigen_assert(!parallel_pack_);
       Index s = state_packing_ready_[k % P].fetch_sub(1);
@@ -606,6 +887,13 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
       } else if (k == nk_) {
         signal_switch(k + 1,
                       parallel_pack_ ? nm_ + nn_ : (shard_by_col_ ? nn_ : nm_));
+      } else if (done_callback_) {
+        std::function<void()> done = std::move(done_callback_);
+        // Nobody waits on the notification, but it must be released before
+        // the context is destroyed.
+        done_.Notify();
+        delete this;
+        done();
       } else {
         done_.Notify();
       }
@@ -758,6 +1046,16 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
     evalGemm<lhs_inner_dim_contiguous, rhs_inner_dim_contiguous, rhs_inner_dim_reordered, Alignment>(buffer);
   }
 
+  // The simple thread pool algorithm waits on notifications, so it is run
+  // from a worker thread to keep the caller from blocking.
+  template <bool lhs_inner_dim_contiguous, bool rhs_inner_dim_contiguous, bool rhs_inner_dim_reordered, int Alignment>
+  void evalProductAsync(Scalar* buffer, std::function<void()> done) const {
+    this->m_device.enqueueNoNotification([this, buffer, done]() {
+      this->template evalProduct<lhs_inner_dim_contiguous, rhs_inner_dim_contiguous, rhs_inner_dim_reordered, Alignment>(buffer);
+      done();
+    });
+  }
+
   template <bool lhs_inner_dim_contiguous, bool rhs_inner_dim_contiguous, bool rhs_inner_dim_reordered, int Alignment>
   void evalGemm(Scalar* buffer) const {
     // columns in left side, rows in right side
@@ -966,6 +1264,11 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
       delete lhs_notifications[i];
     }
 
+    // The kernels of this algorithm don't know when their output block is
+    // final, so the output kernel is applied once all of them are done.
+    this->m_output_kernel(output, this->m_tensor_contraction_params,
+                          static_cast<Index>(0), static_cast<Index>(0), m, n);
+
     // deallocate all of the memory for both A and B's
     for (size_t i = 0; i < blockAs.size(); i++) {
       this->m_device.deallocate(blockAs[i]);
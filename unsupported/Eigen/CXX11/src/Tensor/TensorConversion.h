@@ -177,6 +177,23 @@ template <typename Eval, typename Scalar> struct ConversionSubExprEval<true, Eva
   }
 };
 
+#ifdef EIGEN_USE_THREADS
+template <bool SameType, typename Eval, typename Scalar,
+          typename EvalSubExprsCallback>
+struct ConversionSubExprEvalAsync {
+  static EIGEN_STRONG_INLINE void run(Eval& impl, Scalar*, EvalSubExprsCallback done) {
+    impl.evalSubExprsIfNeededAsync(NULL, [done](bool) { done(true); });
+  }
+};
+
+template <typename Eval, typename Scalar, typename EvalSubExprsCallback>
+struct ConversionSubExprEvalAsync<true, Eval, Scalar, EvalSubExprsCallback> {
+  static EIGEN_STRONG_INLINE void run(Eval& impl, Scalar* data, EvalSubExprsCallback done) {
+    impl.evalSubExprsIfNeededAsync(data, std::move(done));
+  }
+};
+#endif  // EIGEN_USE_THREADS
+
 
 // Eval as rvalue
 template<typename TargetType, typename ArgType, typename Device>
@@ -195,6 +212,8 @@ struct TensorEvaluator<const TensorConversionOp<TargetType, ArgType>, Device>
   enum {
     IsAligned = false,
     PacketAccess = true,
+    BlockAccess = false,
+    PreferBlockAccess = false,
     Layout = TensorEvaluator<ArgType, Device>::Layout,
     RawAccess = false
   };
@@ -211,6 +230,16 @@ struct TensorEvaluator<const TensorConversionOp<TargetType, ArgType>, Device>
     return ConversionSubExprEval<internal::is_same<TargetType, SrcType>::value, TensorEvaluator<ArgType, Device>, Scalar>::run(m_impl, data);
   }
 
+#ifdef EIGEN_USE_THREADS
+  template <typename EvalSubExprsCallback>
+  EIGEN_STRONG_INLINE void evalSubExprsIfNeededAsync(
+      Scalar* data, EvalSubExprsCallback done) {
+    ConversionSubExprEvalAsync<internal::is_same<TargetType, SrcType>::value,
+                               TensorEvaluator<ArgType, Device>, Scalar,
+                               EvalSubExprsCallback>::run(m_impl, data, std::move(done));
+  }
+#endif  // EIGEN_USE_THREADS
+
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void cleanup()
   {
     m_impl.cleanup();
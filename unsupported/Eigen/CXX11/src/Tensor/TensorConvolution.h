@@ -289,6 +289,179 @@ class TensorConvolutionOp : public TensorBase<TensorConvolutionOp<Indices, Input
 };
 
 
+namespace internal {
+
+// Convolves the output coefficients [first, last) on the cpu. The output is
+// traversed line by line along its inner most dimension: since the inner most
+// dimension of the input is contiguous, a segment of an output line reads a
+// contiguous segment of the input for every coefficient of the kernel, shifted
+// by the offset of that coefficient.
+template <typename Self, bool Vectorizable = Self::VectorizedConvolution>
+struct ConvolutionBlock {
+  typedef typename Self::Index Index;
+  typedef typename Self::Scalar Scalar;
+
+  static void run(const Self& self, Index first, Index last, Scalar* output) {
+    const Index line_size = self.m_lineSize;
+    const Index kernel_size = self.m_kernelSize;
+    const Index* offsets = self.m_kernelOffsets;
+    const Scalar* kernel = self.m_kernel;
+    while (first < last) {
+      const Index line_end = numext::mini(last, (first / line_size + 1) * line_size);
+      const Index input = self.firstInput(first) - first;
+      for (Index i = first; i < line_end; ++i) {
+        Scalar accum = Scalar(0);
+        for (Index k = 0; k < kernel_size; ++k) {
+          accum += self.m_inputImpl.coeff(input + i + offsets[k]) * kernel[k];
+        }
+        output[i] = accum;
+      }
+      first = line_end;
+    }
+  }
+};
+
+// Vectorized version: each line is convolved by tiles of 4 packets, which
+// provides independent accumulators to hide the latency of the multiply-adds.
+// The loop over the kernel is unrolled for the most common small kernels,
+// which keep their broadcast coefficients in registers for the whole block.
+template <typename Self>
+struct ConvolutionBlock<Self, true> {
+  typedef typename Self::Index Index;
+  typedef typename Self::Scalar Scalar;
+  typedef typename Self::PacketReturnType Packet;
+  static const Index PacketSize = Self::PacketSize;
+
+  static void run(const Self& self, Index first, Index last, Scalar* output) {
+    switch (self.m_kernelSize) {
+      case 3:
+        convolve<3>(self, first, last, output);
+        break;
+      case 5:
+        convolve<5>(self, first, last, output);
+        break;
+      case 7:
+        convolve<7>(self, first, last, output);
+        break;
+      case 9:
+        convolve<9>(self, first, last, output);
+        break;
+      default:
+        convolve<Dynamic>(self, first, last, output);
+        break;
+    }
+  }
+
+ private:
+  template <int KernelSize>
+  static void convolve(const Self& self, Index first, Index last, Scalar* output) {
+    const Index line_size = self.m_lineSize;
+    const Index kernel_size = KernelSize == Dynamic ? self.m_kernelSize : KernelSize;
+    const Index* kernel_offsets = self.m_kernelOffsets;
+    const Scalar* kernel = self.m_kernel;
+
+    static const int NumPreloaded = KernelSize == Dynamic ? 1 : KernelSize;
+    Packet weights[NumPreloaded];
+    Index offsets[NumPreloaded];
+    if (KernelSize != Dynamic) {
+      for (int k = 0; k < NumPreloaded; ++k) {
+        weights[k] = pset1<Packet>(kernel[k]);
+        offsets[k] = kernel_offsets[k];
+      }
+    }
+
+    while (first < last) {
+      const Index line_end = numext::mini(last, (first / line_size + 1) * line_size);
+      const Index input = self.firstInput(first) - first;
+      Index i = first;
+      for (; i + 4 * PacketSize <= line_end; i += 4 * PacketSize) {
+        Packet accum0 = pset1<Packet>(Scalar(0));
+        Packet accum1 = pset1<Packet>(Scalar(0));
+        Packet accum2 = pset1<Packet>(Scalar(0));
+        Packet accum3 = pset1<Packet>(Scalar(0));
+        for (Index k = 0; k < kernel_size; ++k) {
+          const Packet weight = KernelSize == Dynamic ? pset1<Packet>(kernel[k]) : weights[k];
+          const Index in = input + i + (KernelSize == Dynamic ? kernel_offsets[k] : offsets[k]);
+          accum0 = pmadd(self.m_inputImpl.template packet<Unaligned>(in), weight, accum0);
+          accum1 = pmadd(self.m_inputImpl.template packet<Unaligned>(in + PacketSize), weight, accum1);
+          accum2 = pmadd(self.m_inputImpl.template packet<Unaligned>(in + 2 * PacketSize), weight, accum2);
+          accum3 = pmadd(self.m_inputImpl.template packet<Unaligned>(in + 3 * PacketSize), weight, accum3);
+        }
+        pstoreu(output + i, accum0);
+        pstoreu(output + i + PacketSize, accum1);
+        pstoreu(output + i + 2 * PacketSize, accum2);
+        pstoreu(output + i + 3 * PacketSize, accum3);
+      }
+      for (; i + PacketSize <= line_end; i += PacketSize) {
+        Packet accum = pset1<Packet>(Scalar(0));
+        for (Index k = 0; k < kernel_size; ++k) {
+          const Packet weight = KernelSize == Dynamic ? pset1<Packet>(kernel[k]) : weights[k];
+          const Index in = input + i + (KernelSize == Dynamic ? kernel_offsets[k] : offsets[k]);
+          accum = pmadd(self.m_inputImpl.template packet<Unaligned>(in), weight, accum);
+        }
+        pstoreu(output + i, accum);
+      }
+      for (; i < line_end; ++i) {
+        Scalar accum = Scalar(0);
+        for (Index k = 0; k < kernel_size; ++k) {
+          accum += self.m_inputImpl.coeff(input + i + kernel_offsets[k]) * kernel[k];
+        }
+        output[i] = accum;
+      }
+      first = line_end;
+    }
+  }
+};
+
+// Evaluates the whole convolution into the output buffer.
+template <typename Self, typename Device>
+struct ConvolutionLauncher {
+  static void run(const Self& self, const Device&, typename Self::Scalar* output) {
+    ConvolutionBlock<Self>::run(self, 0, self.dimensions().TotalSize(), output);
+  }
+};
+
+#ifdef EIGEN_USE_THREADS
+// Multithreaded convolution: the output coefficients are split into blocks
+// made of whole register tiles, which are convolved independently. Splitting
+// the coefficients rather than the lines keeps all the threads busy when there
+// are only a few long lines, e.g. for 1d convolutions.
+template <typename Self>
+struct ConvolutionLauncher<Self, ThreadPoolDevice> {
+  typedef typename Self::Index Index;
+  typedef typename Self::Scalar Scalar;
+  static const Index kTileSize = Self::VectorizedConvolution ? 4 * Self::PacketSize : 1;
+
+  static void run(const Self& self, const ThreadPoolDevice& device, Scalar* output) {
+    device.parallelFor(self.dimensions().TotalSize(), self.convolutionCost(),
+                       alignBlock,
+                       [&self, output](Index first, Index last) {
+                         ConvolutionBlock<Self>::run(self, first, last, output);
+                       });
+  }
+
+  template <typename DoneCallback>
+  static void runAsync(const Self& self, const ThreadPoolDevice& device,
+                       Scalar* output, DoneCallback done) {
+    const Self* self_ptr = &self;
+    device.parallelForAsync(self.dimensions().TotalSize(), self.convolutionCost(),
+                            alignBlock,
+                            [self_ptr, output](Index first, Index last) {
+                              ConvolutionBlock<Self>::run(*self_ptr, first, last, output);
+                            },
+                            std::move(done));
+  }
+
+ private:
+  static Index alignBlock(Index block_size) {
+    return divup(block_size, kTileSize) * kTileSize;
+  }
+};
+#endif  // EIGEN_USE_THREADS
+
+}  // end namespace internal
+
+
 template<typename Indices, typename InputArgType, typename KernelArgType, typename Device>
 struct TensorEvaluator<const TensorConvolutionOp<Indices, InputArgType, KernelArgType>, Device>
 {
@@ -307,13 +480,18 @@ struct TensorEvaluator<const TensorConvolutionOp<Indices, InputArgType, KernelAr
   enum {
     IsAligned = TensorEvaluator<InputArgType, Device>::IsAligned & TensorEvaluator<KernelArgType, Device>::IsAligned,
     PacketAccess = TensorEvaluator<InputArgType, Device>::PacketAccess & TensorEvaluator<KernelArgType, Device>::PacketAccess,
+    BlockAccess = false,
+    PreferBlockAccess = false,
     Layout = TensorEvaluator<InputArgType, Device>::Layout,
     CoordAccess = false,  // to be implemented
     RawAccess = false
   };
 
+  // The cpu kernel is vectorized along the inner most dimension of the input.
+  static const bool VectorizedConvolution = TensorEvaluator<InputArgType, Device>::PacketAccess && (PacketSize > 1);
+
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE TensorEvaluator(const XprType& op, const Device& device)
-      : m_inputImpl(op.inputExpression(), device), m_kernelImpl(op.kernelExpression(), device), m_kernelArg(op.kernelExpression()), m_kernel(NULL), m_local_kernel(false), m_device(device)
+      : m_inputImpl(op.inputExpression(), device), m_kernelImpl(op.kernelExpression(), device), m_kernelArg(op.kernelExpression()), m_kernel(NULL), m_local_kernel(false), m_kernelOffsets(NULL), m_buf(NULL), m_device(device)
   {
     EIGEN_STATIC_ASSERT((static_cast<int>(TensorEvaluator<InputArgType, Device>::Layout) == static_cast<int>(TensorEvaluator<KernelArgType, Device>::Layout)), YOU_MADE_A_PROGRAMMING_MISTAKE);
 
@@ -372,15 +550,45 @@ struct TensorEvaluator<const TensorConvolutionOp<Indices, InputArgType, KernelAr
         m_outputStride[i] = m_outputStride[i + 1] * m_dimensions[i + 1];
       }
     }
+
+    m_lineSize = static_cast<int>(Layout) == static_cast<int>(ColMajor) ? m_dimensions[0] : m_dimensions[NumDims - 1];
+    m_kernelSize = kernel_dims.TotalSize();
   }
 
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE const Dimensions& dimensions() const { return m_dimensions; }
 
-  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE bool evalSubExprsIfNeeded(Scalar*) {
+  // The whole convolution is computed upfront, directly into the destination
+  // when there is one, and into a temporary buffer otherwise.
+  EIGEN_STRONG_INLINE bool evalSubExprsIfNeeded(Scalar* data) {
     m_inputImpl.evalSubExprsIfNeeded(NULL);
     preloadKernel();
+    if (data) {
+      internal::ConvolutionLauncher<Self, Device>::run(*this, m_device, data);
+      return false;
+    }
+    m_buf = static_cast<Scalar*>(m_device.allocate(dimensions().TotalSize() * sizeof(Scalar)));
+    internal::ConvolutionLauncher<Self, Device>::run(*this, m_device, m_buf);
     return true;
   }
+
+#ifdef EIGEN_USE_THREADS
+  template <typename EvalSubExprsCallback>
+  EIGEN_STRONG_INLINE void evalSubExprsIfNeededAsync(
+      Scalar* data, EvalSubExprsCallback done) {
+    m_inputImpl.evalSubExprsIfNeededAsync(NULL, [this, data, done](bool) {
+      preloadKernel();
+      if (data) {
+        internal::ConvolutionLauncher<Self, Device>::runAsync(
+            *this, m_device, data, [done]() { done(false); });
+      } else {
+        m_buf = static_cast<Scalar*>(m_device.allocate(dimensions().TotalSize() * sizeof(Scalar)));
+        internal::ConvolutionLauncher<Self, Device>::runAsync(
+            *this, m_device, m_buf, [done]() { done(true); });
+      }
+    });
+  }
+#endif  // EIGEN_USE_THREADS
+
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void cleanup() {
     m_inputImpl.cleanup();
     if (m_local_kernel) {
@@ -388,6 +596,14 @@ struct TensorEvaluator<const TensorConvolutionOp<Indices, InputArgType, KernelAr
       m_local_kernel = false;
     }
     m_kernel = NULL;
+    if (m_kernelOffsets) {
+      m_device.deallocate(m_kernelOffsets);
+      m_kernelOffsets = NULL;
+    }
+    if (m_buf) {
+      m_device.deallocate(m_buf);
+      m_buf = NULL;
+    }
   }
 
   void evalTo(typename XprType::Scalar* buffer) {
@@ -400,6 +616,9 @@ struct TensorEvaluator<const TensorConvolutionOp<Indices, InputArgType, KernelAr
 
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE CoeffReturnType coeff(Index index) const
   {
+    if (m_buf) {
+      return m_buf[index];
+    }
     CoeffReturnType result = CoeffReturnType(0);
     convolve(firstInput(index), 0, NumKernelDims-1, result);
     return result;
@@ -408,6 +627,9 @@ struct TensorEvaluator<const TensorConvolutionOp<Indices, InputArgType, KernelAr
   template<int LoadMode>
   EIGEN_DEVICE_FUNC PacketReturnType packet(const Index index) const
   {
+    if (m_buf) {
+      return internal::ploadt<PacketReturnType, LoadMode>(m_buf + index);
+    }
     Index indices[2] = {index, index+PacketSize-1};
     Index startInputs[2] = {0, 0};
     if (static_cast<int>(Layout) == static_cast<int>(ColMajor)) {
@@ -452,6 +674,9 @@ struct TensorEvaluator<const TensorConvolutionOp<Indices, InputArgType, KernelAr
 
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE TensorOpCost
   costPerCoeff(bool vectorized) const {
+    if (m_buf) {
+      return TensorOpCost(sizeof(CoeffReturnType), 0, 0, vectorized, PacketSize);
+    }
     const double kernel_size = m_kernelImpl.dimensions().TotalSize();
     // We ignore the use of fused multiply-add.
     const double convolve_compute_cost =
@@ -467,9 +692,21 @@ struct TensorEvaluator<const TensorConvolutionOp<Indices, InputArgType, KernelAr
                                        PacketSize));
   }
 
-  EIGEN_DEVICE_FUNC typename Eigen::internal::traits<XprType>::PointerType data() const { return NULL; }
+  // Cost of computing one output coefficient with the cpu kernel.
+  TensorOpCost convolutionCost() const {
+    const double kernel_size = static_cast<double>(m_kernelSize);
+    return kernel_size * (m_inputImpl.costPerCoeff(VectorizedConvolution) +
+                          TensorOpCost(0, 0, TensorOpCost::AddCost<Scalar>() + TensorOpCost::MulCost<Scalar>(),
+                                       VectorizedConvolution, PacketSize)) +
+           TensorOpCost(0, sizeof(Scalar), 0, VectorizedConvolution, PacketSize);
+  }
+
+  EIGEN_DEVICE_FUNC typename Eigen::internal::traits<XprType>::PointerType data() const { return m_buf; }
 
  private:
+  typedef TensorEvaluator<const TensorConvolutionOp<Indices, InputArgType, KernelArgType>, Device> Self;
+  template <typename, bool> friend struct internal::ConvolutionBlock;
+
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE Index firstInput(Index index) const {
     Index startInput = 0;
     if (static_cast<int>(Layout) == static_cast<int>(ColMajor)) {
@@ -532,6 +769,23 @@ struct TensorEvaluator<const TensorConvolutionOp<Indices, InputArgType, KernelAr
       m_kernel = local;
       m_local_kernel = true;
     }
+
+    // Offsets of the input coefficients multiplied by each coefficient of the
+    // kernel, relative to the first input coefficient of the output.
+    m_kernelOffsets = static_cast<Index*>(m_device.allocate(m_kernelSize * sizeof(Index)));
+    computeKernelOffsets(0, 0, NumKernelDims - 1);
+  }
+
+  void computeKernelOffsets(Index firstIndex, Index firstKernel, int DimIndex) {
+    for (int j = 0; j < m_kernelImpl.dimensions()[DimIndex]; ++j) {
+      const Index input = firstIndex + j * m_indexStride[DimIndex];
+      const Index kernel = firstKernel + j * m_kernelStride[DimIndex];
+      if (DimIndex > 0) {
+        computeKernelOffsets(input, kernel, DimIndex-1);
+      } else {
+        m_kernelOffsets[kernel] = input;
+      }
+    }
   }
 
   array<Index, NumDims> m_inputStride;
@@ -546,6 +800,10 @@ struct TensorEvaluator<const TensorConvolutionOp<Indices, InputArgType, KernelAr
   KernelArgType m_kernelArg;
   const Scalar* m_kernel;
   bool m_local_kernel;
+  Index m_lineSize;
+  Index m_kernelSize;
+  Index* m_kernelOffsets;
+  Scalar* m_buf;
   const Device& m_device;
 };
 
@@ -766,6 +1024,8 @@ struct TensorEvaluator<const TensorConvolutionOp<Indices, InputArgType, KernelAr
   enum {
     IsAligned = TensorEvaluator<InputArgType, GpuDevice>::IsAligned & TensorEvaluator<KernelArgType, GpuDevice>::IsAligned,
     PacketAccess = false,
+    BlockAccess = false,
+    PreferBlockAccess = false,
     Layout = TensorEvaluator<InputArgType, GpuDevice>::Layout,
     CoordAccess = false,  // to be implemented
     RawAccess = false
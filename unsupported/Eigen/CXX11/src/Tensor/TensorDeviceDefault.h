@@ -13,12 +13,38 @@
 
 namespace Eigen {
 
+// An abstract interface to a memory allocator for the temporary buffers of
+// the cpu devices. The returned memory must be aligned like the memory
+// returned by internal::aligned_malloc. Implementations must be thread safe
+// when used with a ThreadPoolDevice.
+class Allocator {
+ public:
+  virtual ~Allocator() {}
+  virtual void* allocate(size_t num_bytes) const = 0;
+  virtual void deallocate(void* buffer) const = 0;
+};
+
 // Default device for the machine (typically a single cpu core)
 struct DefaultDevice {
+  EIGEN_DEVICE_FUNC DefaultDevice() : allocator_(NULL) { }
+  // The ownership of the allocator remains with the caller.
+  explicit DefaultDevice(Allocator* allocator) : allocator_(allocator) { }
+
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void* allocate(size_t num_bytes) const {
+#ifndef EIGEN_CUDA_ARCH
+    if (allocator_) {
+      return allocator_->allocate(num_bytes);
+    }
+#endif
     return internal::aligned_malloc(num_bytes);
   }
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void deallocate(void* buffer) const {
+#ifndef EIGEN_CUDA_ARCH
+    if (allocator_) {
+      allocator_->deallocate(buffer);
+      return;
+    }
+#endif
     internal::aligned_free(buffer);
   }
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void memcpy(void* dst, const void* src, size_t n) const {
@@ -74,6 +100,13 @@ struct DefaultDevice {
     return EIGEN_CUDA_ARCH / 100;
 #endif
   }
+
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE Allocator* allocator() const {
+    return allocator_;
+  }
+
+ private:
+  Allocator* allocator_;
 };
 
 }  // namespace Eigen
@@ -23,7 +23,7 @@ namespace Eigen {
 namespace internal {
 
 // Default strategy: the expression is evaluated with a single cpu thread.
-template<typename Expression, typename Device, bool Vectorizable>
+template<typename Expression, typename Device, bool Vectorizable, bool Tileable>
 class TensorExecutor
 {
  public:
@@ -46,7 +46,7 @@ class TensorExecutor
 
 
 template<typename Expression>
-class TensorExecutor<Expression, DefaultDevice, true>
+class TensorExecutor<Expression, DefaultDevice, true, false>
 {
  public:
   typedef typename Expression::Index Index;
@@ -81,6 +81,55 @@ class TensorExecutor<Expression, DefaultDevice, true>
 };
 
 
+// Block based strategy: the expression is evaluated one block at a time, with
+// blocks small enough to stay in the first level cache. This is used when the
+// expression contains operations like shuffling or broadcasting that are
+// much cheaper to evaluate on blocks than coefficient by coefficient.
+template <typename Expression, bool Vectorizable>
+class TensorExecutor<Expression, DefaultDevice, Vectorizable, true> {
+ public:
+  typedef typename traits<Expression>::Scalar Scalar;
+  typedef typename remove_const<Scalar>::type ScalarNoConst;
+  typedef typename traits<Expression>::Index Index;
+  typedef TensorEvaluator<Expression, DefaultDevice> Evaluator;
+  static const int NumDims = traits<Expression>::NumDimensions;
+
+  static inline void run(const Expression& expr,
+                         const DefaultDevice& device = DefaultDevice()) {
+    typedef TensorBlock<ScalarNoConst, Index, NumDims, Evaluator::Layout> TensorBlock;
+    typedef TensorBlockMapper<ScalarNoConst, Index, NumDims, Evaluator::Layout> TensorBlockMapper;
+
+    Evaluator evaluator(expr, device);
+    const Index total_size = array_prod(evaluator.dimensions());
+    const Index cache_size = device.firstLevelCacheSize() / sizeof(Scalar);
+    if (total_size < cache_size) {
+      // The tensor fits in a single block: the regular evaluation is faster.
+      evaluator.cleanup();
+      TensorExecutor<Expression, DefaultDevice, Vectorizable, false>::run(expr, device);
+      return;
+    }
+
+    const bool needs_assign = evaluator.evalSubExprsIfNeeded(NULL);
+    if (needs_assign) {
+      TensorOpResourceRequirements resources;
+      evaluator.getResourceRequirements(&resources);
+      TensorBlockMapper block_mapper(
+          evaluator.dimensions(), resources.block_shape,
+          numext::maxi(resources.block_total_size, cache_size));
+
+      ScalarNoConst* data = static_cast<ScalarNoConst*>(
+          device.allocate(block_mapper.block_dims_total_size() * sizeof(Scalar)));
+      const Index total_block_count = block_mapper.total_block_count();
+      for (Index i = 0; i < total_block_count; ++i) {
+        TensorBlock block = block_mapper.GetBlockForIndex(i, data);
+        evaluator.evalBlock(&block);
+      }
+      device.deallocate(data);
+    }
+    evaluator.cleanup();
+  }
+};
+
 
 // Multicore strategy: the index space is partitioned and each partition is executed on a single core
 #ifdef EIGEN_USE_THREADS
@@ -139,7 +188,7 @@ struct EvalRange<Evaluator, Index, true> {
 };
 
 template <typename Expression, bool Vectorizable>
-class TensorExecutor<Expression, ThreadPoolDevice, Vectorizable> {
+class TensorExecutor<Expression, ThreadPoolDevice, Vectorizable, false> {
  public:
   typedef typename Expression::Index Index;
   static inline void run(const Expression& expr, const ThreadPoolDevice& device)
@@ -187,14 +236,204 @@ class TensorExecutor<Expression, ThreadPoolDevice, Vectorizable> {
     evaluator.cleanup();
   }
 };
+
+template <typename Expression, bool Vectorizable>
+class TensorExecutor<Expression, ThreadPoolDevice, Vectorizable, true> {
+ public:
+  typedef typename traits<Expression>::Scalar Scalar;
+  typedef typename remove_const<Scalar>::type ScalarNoConst;
+  typedef typename traits<Expression>::Index Index;
+  typedef TensorEvaluator<Expression, ThreadPoolDevice> Evaluator;
+  static const int NumDims = traits<Expression>::NumDimensions;
+
+  static inline void run(const Expression& expr, const ThreadPoolDevice& device) {
+    typedef TensorBlock<ScalarNoConst, Index, NumDims, Evaluator::Layout> TensorBlock;
+    typedef TensorBlockMapper<ScalarNoConst, Index, NumDims, Evaluator::Layout> TensorBlockMapper;
+
+    Evaluator evaluator(expr, device);
+    const Index total_size = array_prod(evaluator.dimensions());
+    const Index cache_size = device.firstLevelCacheSize() / sizeof(Scalar);
+    if (total_size < cache_size) {
+      // The tensor fits in a single block: the regular evaluation is faster.
+      evaluator.cleanup();
+      TensorExecutor<Expression, ThreadPoolDevice, Vectorizable, false>::run(expr, device);
+      return;
+    }
+
+    const bool needs_assign = evaluator.evalSubExprsIfNeeded(NULL);
+    if (needs_assign) {
+      TensorOpResourceRequirements resources;
+      evaluator.getResourceRequirements(&resources);
+      const TensorBlockMapper block_mapper(
+          evaluator.dimensions(), resources.block_shape,
+          numext::maxi(resources.block_total_size, cache_size));
+      const Index block_size = block_mapper.block_dims_total_size();
+
+      device.parallelFor(
+          block_mapper.total_block_count(),
+          evaluator.costPerCoeff(Vectorizable) * block_size,
+          [&device, &evaluator, &block_mapper, block_size](Index first, Index last) {
+            // Each range of blocks gets its own scratch buffer.
+            ScalarNoConst* data = static_cast<ScalarNoConst*>(
+                device.allocate(block_size * sizeof(Scalar)));
+            for (Index i = first; i < last; ++i) {
+              TensorBlock block = block_mapper.GetBlockForIndex(i, data);
+              evaluator.evalBlock(&block);
+            }
+            device.deallocate(data);
+          });
+    }
+    evaluator.cleanup();
+  }
+};
+
+// Asynchronous strategy: the sub-expressions and the expression are
+// evaluated with the async variants of the evaluators and of parallelFor,
+// so that runAsync returns without waiting for the computation. The
+// evaluator lives in a heap allocated context that is destroyed, and the
+// done callback invoked, by the thread that finishes the last task.
+template <typename Expression, typename DoneCallback, bool Vectorizable>
+class TensorAsyncExecutor<Expression, ThreadPoolDevice, DoneCallback, Vectorizable, false> {
+ public:
+  typedef typename Expression::Index Index;
+  typedef TensorEvaluator<Expression, ThreadPoolDevice> Evaluator;
+
+  static inline void runAsync(const Expression& expr,
+                              const ThreadPoolDevice& device,
+                              DoneCallback done) {
+    TensorAsyncExecutorContext* const ctx =
+        new TensorAsyncExecutorContext(expr, device, std::move(done));
+
+    const auto on_eval_subexprs = [ctx, &device](bool needs_assign) -> void {
+      if (!needs_assign) {
+        delete ctx;
+        return;
+      }
+
+      typedef EvalRange<Evaluator, Index, Vectorizable> EvalRange;
+      const Index size = array_prod(ctx->evaluator.dimensions());
+      device.parallelForAsync(
+          size, ctx->evaluator.costPerCoeff(Vectorizable),
+          EvalRange::alignBlockSize,
+          [ctx](Index first, Index last) {
+            EvalRange::run(&ctx->evaluator, first, last);
+          },
+          [ctx]() { delete ctx; });
+    };
+
+    ctx->evaluator.evalSubExprsIfNeededAsync(NULL, on_eval_subexprs);
+  }
+
+ private:
+  struct TensorAsyncExecutorContext {
+    TensorAsyncExecutorContext(const Expression& expr,
+                               const ThreadPoolDevice& thread_pool,
+                               DoneCallback done)
+        : evaluator(expr, thread_pool), on_done(std::move(done)) {}
+
+    ~TensorAsyncExecutorContext() {
+      evaluator.cleanup();
+      on_done();
+    }
+
+    Evaluator evaluator;
+
+   private:
+    DoneCallback on_done;
+  };
+};
+
+template <typename Expression, typename DoneCallback, bool Vectorizable>
+class TensorAsyncExecutor<Expression, ThreadPoolDevice, DoneCallback, Vectorizable, true> {
+ public:
+  typedef typename traits<Expression>::Scalar Scalar;
+  typedef typename remove_const<Scalar>::type ScalarNoConst;
+  typedef typename traits<Expression>::Index Index;
+  typedef TensorEvaluator<Expression, ThreadPoolDevice> Evaluator;
+  static const int NumDims = traits<Expression>::NumDimensions;
+
+  static inline void runAsync(const Expression& expr,
+                              const ThreadPoolDevice& device,
+                              DoneCallback done) {
+    typedef TensorBlock<ScalarNoConst, Index, NumDims, Evaluator::Layout> TensorBlock;
+    typedef TensorBlockMapper<ScalarNoConst, Index, NumDims, Evaluator::Layout> TensorBlockMapper;
+
+    const Index cache_size = device.firstLevelCacheSize() / sizeof(Scalar);
+    {
+      Evaluator evaluator(expr, device);
+      const Index total_size = array_prod(evaluator.dimensions());
+      evaluator.cleanup();
+      if (total_size < cache_size) {
+        // The tensor fits in a single block: the regular evaluation is faster.
+        TensorAsyncExecutor<Expression, ThreadPoolDevice, DoneCallback,
+                            Vectorizable, false>::runAsync(expr, device,
+                                                           std::move(done));
+        return;
+      }
+    }
+
+    TensorAsyncExecutorContext* const ctx =
+        new TensorAsyncExecutorContext(expr, device, std::move(done));
+
+    const auto on_eval_subexprs = [ctx, &device, cache_size](bool needs_assign) -> void {
+      if (!needs_assign) {
+        delete ctx;
+        return;
+      }
+
+      TensorOpResourceRequirements resources;
+      ctx->evaluator.getResourceRequirements(&resources);
+      const TensorBlockMapper block_mapper(
+          ctx->evaluator.dimensions(), resources.block_shape,
+          numext::maxi(resources.block_total_size, cache_size));
+      const Index block_size = block_mapper.block_dims_total_size();
+
+      device.parallelForAsync(
+          block_mapper.total_block_count(),
+          ctx->evaluator.costPerCoeff(Vectorizable) * block_size,
+          [ctx, &device, block_mapper, block_size](Index first, Index last) {
+            // Each range of blocks gets its own scratch buffer.
+            ScalarNoConst* data = static_cast<ScalarNoConst*>(
+                device.allocate(block_size * sizeof(Scalar)));
+            for (Index i = first; i < last; ++i) {
+              TensorBlock block = block_mapper.GetBlockForIndex(i, data);
+              ctx->evaluator.evalBlock(&block);
+            }
+            device.deallocate(data);
+          },
+          [ctx]() { delete ctx; });
+    };
+
+    ctx->evaluator.evalSubExprsIfNeededAsync(NULL, on_eval_subexprs);
+  }
+
+ private:
+  struct TensorAsyncExecutorContext {
+    TensorAsyncExecutorContext(const Expression& expr,
+                               const ThreadPoolDevice& thread_pool,
+                               DoneCallback done)
+        : evaluator(expr, thread_pool), on_done(std::move(done)) {}
+
+    ~TensorAsyncExecutorContext() {
+      evaluator.cleanup();
+      on_done();
+    }
+
+    Evaluator evaluator;
+
+   private:
+    DoneCallback on_done;
+  };
+};
+
 #endif  // EIGEN_USE_THREADS
 
 
 // GPU: the evaluation of the expression is offloaded to a GPU.
 #if defined(EIGEN_USE_GPU)
 
-template <typename Expression, bool Vectorizable>
-class TensorExecutor<Expression, GpuDevice, Vectorizable> {
+template <typename Expression, bool Vectorizable, bool Tileable>
+class TensorExecutor<Expression, GpuDevice, Vectorizable, Tileable> {
  public:
   typedef typename Expression::Index Index;
   static void run(const Expression& expr, const GpuDevice& device);
@@ -244,8 +483,8 @@ EigenMetaKernel(Evaluator eval, Index size) {
 }
 
 /*static*/
-template <typename Expression, bool Vectorizable>
-inline void TensorExecutor<Expression, GpuDevice, Vectorizable>::run(
+template <typename Expression, bool Vectorizable, bool Tileable>
+inline void TensorExecutor<Expression, GpuDevice, Vectorizable, Tileable>::run(
     const Expression& expr, const GpuDevice& device) {
   TensorEvaluator<Expression, GpuDevice> evaluator(expr, device);
   const bool needs_assign = evaluator.evalSubExprsIfNeeded(NULL);
@@ -270,8 +509,8 @@ inline void TensorExecutor<Expression, GpuDevice, Vectorizable>::run(
 // SYCL Executor policy
 #ifdef EIGEN_USE_SYCL
 
-template <typename Expression, bool Vectorizable>
-class TensorExecutor<Expression, SyclDevice, Vectorizable> {
+template <typename Expression, bool Vectorizable, bool Tileable>
+class TensorExecutor<Expression, SyclDevice, Vectorizable, Tileable> {
 public:
   static inline void run(const Expression &expr, const SyclDevice &device) {
     // call TensorSYCL module
@@ -92,6 +92,25 @@ struct reducer_traits {
   };
 };
 
+// How reductions along the inner most dimension accumulate long runs of
+// values. LinearAccumulation reduces them one after the other.
+// TreeAccumulation reduces blocks of values and combines the partial results
+// pairwise, which bounds the rounding error of floating point sums to
+// O(log(n)) instead of O(n) at the same throughput. KahanAccumulation also
+// compensates the rounding errors within each block, and is only valid for
+// reducers that add the values (e.g. KahanSumReducer).
+enum ReductionAccumulation {
+  LinearAccumulation,
+  TreeAccumulation,
+  KahanAccumulation
+};
+
+// Reducers select their accumulation by specializing this trait.
+template <typename Reducer>
+struct reducer_accumulation {
+  static const int value = LinearAccumulation;
+};
+
 // Standard reduction functors
 template <typename T> struct SumReducer
 {
@@ -137,6 +156,23 @@ struct reducer_traits<SumReducer<T>, Device> {
   };
 };
 
+template <typename T>
+struct reducer_accumulation<SumReducer<T> > {
+  static const int value = NumTraits<T>::IsInteger ? LinearAccumulation : TreeAccumulation;
+};
+
+// Sum computed with Kahan compensated summation. It is slower than the
+// SumReducer, but its rounding error doesn't grow with the number of values.
+template <typename T> struct KahanSumReducer : SumReducer<T> {};
+
+template <typename T, typename Device>
+struct reducer_traits<KahanSumReducer<T>, Device> : reducer_traits<SumReducer<T>, Device> {};
+
+template <typename T>
+struct reducer_accumulation<KahanSumReducer<T> > {
+  static const int value = NumTraits<T>::IsInteger ? LinearAccumulation : KahanAccumulation;
+};
+
 
 template <typename T> struct MeanReducer
 {
@@ -195,6 +231,11 @@ struct reducer_traits<MeanReducer<T>, Device> {
   };
 };
 
+template <typename T>
+struct reducer_accumulation<MeanReducer<T> > {
+  static const int value = NumTraits<T>::IsInteger ? LinearAccumulation : TreeAccumulation;
+};
+
 
 template <typename T, bool IsMax = true, bool IsInteger = true>
 struct MinMaxBottomValue {
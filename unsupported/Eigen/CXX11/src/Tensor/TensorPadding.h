@@ -96,6 +96,8 @@ struct TensorEvaluator<const TensorPaddingOp<PaddingDimensions, ArgType>, Device
   enum {
     IsAligned = true,
     PacketAccess = TensorEvaluator<ArgType, Device>::PacketAccess,
+    BlockAccess = TensorEvaluator<ArgType, Device>::BlockAccess,
+    PreferBlockAccess = true,
     Layout = TensorEvaluator<ArgType, Device>::Layout,
     CoordAccess = true,
     RawAccess = false
@@ -140,6 +142,15 @@ struct TensorEvaluator<const TensorPaddingOp<PaddingDimensions, ArgType>, Device
     m_impl.evalSubExprsIfNeeded(NULL);
     return true;
   }
+
+#ifdef EIGEN_USE_THREADS
+  template <typename EvalSubExprsCallback>
+  EIGEN_STRONG_INLINE void evalSubExprsIfNeededAsync(
+      Scalar*, EvalSubExprsCallback done) {
+    m_impl.evalSubExprsIfNeededAsync(NULL, [done](bool) { done(true); });
+  }
+#endif  // EIGEN_USE_THREADS
+
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void cleanup() {
     m_impl.cleanup();
   }
@@ -199,6 +210,92 @@ struct TensorEvaluator<const TensorPaddingOp<PaddingDimensions, ArgType>, Device
     return cost;
   }
 
+  EIGEN_STRONG_INLINE void getResourceRequirements(internal::TensorOpResourceRequirements* resources) const {
+    m_impl.getResourceRequirements(resources);
+  }
+
+  // Along each dimension, the block is split in the padding before the input,
+  // the input and the padding after it. Combinations that touch the padding
+  // are filled with the padding value, the remaining one is evaluated by the
+  // input directly into the output block.
+  template <typename OutputTensorBlock>
+  EIGEN_STRONG_INLINE void block(OutputTensorBlock* output_block) const {
+    typedef typename OutputTensorBlock::StorageIndex StorageIndex;
+    typedef typename OutputTensorBlock::Scalar BlockScalar;
+    typedef typename OutputTensorBlock::Dimensions BlockDimensions;
+
+    const BlockDimensions& output_sizes = output_block->block_sizes();
+    const BlockDimensions& output_strides = output_block->block_strides();
+    const BlockDimensions& tensor_strides = output_block->tensor_strides();
+
+    StorageIndex seg_start[NumDims][3];
+    StorageIndex seg_size[NumDims][3];
+    bool seg_padding[NumDims][3];
+    int num_segs[NumDims];
+    StorageIndex input_first[NumDims];
+    StorageIndex index = output_block->first_coeff_index();
+    for (int k = 0; k < NumDims; ++k) {
+      const int i = static_cast<int>(Layout) == static_cast<int>(ColMajor) ? NumDims - 1 - k : k;
+      const StorageIndex coord = index / tensor_strides[i];
+      index -= coord * tensor_strides[i];
+
+      const StorageIndex end = coord + output_sizes[i];
+      const StorageIndex bounds[4] = {
+          coord, numext::maxi(coord, numext::mini(end, StorageIndex(m_padding[i].first))),
+          numext::maxi(coord, numext::mini(end, StorageIndex(m_dimensions[i] - m_padding[i].second))), end};
+      int n = 0;
+      for (int s = 0; s < 3; ++s) {
+        if (bounds[s + 1] > bounds[s]) {
+          seg_start[i][n] = bounds[s] - coord;
+          seg_size[i][n] = bounds[s + 1] - bounds[s];
+          seg_padding[i][n] = s != 1;
+          ++n;
+        }
+      }
+      num_segs[i] = n;
+      input_first[i] = numext::maxi(coord, StorageIndex(m_padding[i].first)) - m_padding[i].first;
+    }
+
+    BlockDimensions input_tensor_strides;
+    BlockDimensions zero_strides;
+    for (int i = 0; i < NumDims; ++i) {
+      input_tensor_strides[i] = m_inputStrides[i];
+      zero_strides[i] = 0;
+    }
+
+    int seg[NumDims];
+    for (int i = 0; i < NumDims; ++i) seg[i] = 0;
+    for (;;) {
+      bool padding = false;
+      StorageIndex input_index = 0;
+      StorageIndex output_offset = 0;
+      BlockDimensions sizes;
+      for (int i = 0; i < NumDims; ++i) {
+        padding |= seg_padding[i][seg[i]];
+        input_index += input_first[i] * m_inputStrides[i];
+        output_offset += seg_start[i][seg[i]] * output_strides[i];
+        sizes[i] = seg_size[i][seg[i]];
+      }
+
+      if (padding) {
+        internal::TensorBlockIO<BlockScalar, StorageIndex, NumDims>::Copy(
+            sizes, output_strides, output_block->data() + output_offset,
+            zero_strides, &m_paddingValue);
+      } else {
+        OutputTensorBlock input_block(input_index, sizes, output_strides, input_tensor_strides,
+                                      output_block->data() + output_offset);
+        m_impl.block(&input_block);
+      }
+
+      int i = 0;
+      for (; i < NumDims; ++i) {
+        if (++seg[i] < num_segs[i]) break;
+        seg[i] = 0;
+      }
+      if (i == NumDims) break;
+    }
+  }
+
   EIGEN_DEVICE_FUNC EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE typename Eigen::internal::traits<XprType>::PointerType data() const { return NULL; }
 
   /// used by sycl
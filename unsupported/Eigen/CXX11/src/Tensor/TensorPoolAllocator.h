@@ -0,0 +1,222 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#if defined(EIGEN_USE_THREADS) && !defined(EIGEN_CXX11_TENSOR_TENSOR_POOL_ALLOCATOR_H)
+#define EIGEN_CXX11_TENSOR_TENSOR_POOL_ALLOCATOR_H
+
+namespace Eigen {
+
+/** \class PoolAllocator
+  * \ingroup CXX11_Tensor_Module
+  *
+  * \brief An Allocator that recycles the temporary buffers of the evaluators.
+  *
+  * Requests are rounded up to a power of two size class. Released blocks are
+  * kept in a cache and handed back by the next request of the same class
+  * instead of going back to the system, so that expressions evaluated over and
+  * over again stop paying for malloc/free and for page faults on fresh memory.
+  *
+  * There are several caches protected by their own mutex; each thread sticks
+  * to one of them, which keeps the threads of a ThreadPoolDevice from
+  * contending on a single lock. Every cache holds at most
+  * max_cached_bytes / num_caches bytes, the excess goes back to the system.
+  * Requests larger than kMaxPooledBytes are never cached.
+  *
+  * All the buffers must be deallocated before the allocator is destroyed.
+  */
+class PoolAllocator : public Allocator {
+ public:
+  struct Stats {
+    size_t num_allocations;         // Calls to allocate().
+    size_t num_deallocations;       // Calls to deallocate().
+    size_t num_cache_hits;          // Allocations served from a cache.
+    size_t num_system_allocations;  // Blocks obtained from aligned_malloc.
+    size_t bytes_in_use;            // Bytes handed out and not deallocated.
+    size_t peak_bytes_in_use;
+    size_t bytes_cached;            // Bytes held by the caches.
+  };
+
+  static const size_t kMinPooledBytes = size_t(1) << 6;
+  static const size_t kMaxPooledBytes = size_t(1) << 26;
+
+  explicit PoolAllocator(int num_caches = 16,
+                         size_t max_cached_bytes = size_t(1) << 28)
+      : num_caches_(numext::maxi(num_caches, 1)),
+        max_cached_bytes_per_cache_(max_cached_bytes / num_caches_),
+        caches_(new Cache[num_caches_]),
+        num_allocations_(0),
+        num_deallocations_(0),
+        num_cache_hits_(0),
+        num_system_allocations_(0),
+        bytes_in_use_(0),
+        peak_bytes_in_use_(0),
+        bytes_cached_(0) {}
+
+  ~PoolAllocator() {
+    release();
+    delete[] caches_;
+  }
+
+  void* allocate(size_t num_bytes) const {
+    num_allocations_.fetch_add(1, std::memory_order_relaxed);
+    const int size_class = sizeClass(num_bytes);
+    char* block = NULL;
+    size_t block_bytes = num_bytes;
+    if (size_class >= 0) {
+      block_bytes = classBytes(size_class);
+      Cache& cache = threadCache();
+      std::lock_guard<std::mutex> lock(cache.mu);
+      std::vector<char*>& blocks = cache.blocks[size_class];
+      if (!blocks.empty()) {
+        block = blocks.back();
+        blocks.pop_back();
+        cache.num_bytes -= block_bytes;
+      }
+    }
+    if (block) {
+      num_cache_hits_.fetch_add(1, std::memory_order_relaxed);
+      bytes_cached_.fetch_sub(block_bytes, std::memory_order_relaxed);
+    } else {
+      num_system_allocations_.fetch_add(1, std::memory_order_relaxed);
+      block = static_cast<char*>(
+          internal::aligned_malloc(block_bytes + kHeaderBytes));
+    }
+    Header* header = reinterpret_cast<Header*>(block);
+    header->num_bytes = block_bytes;
+    header->size_class = size_class;
+    addBytesInUse(block_bytes);
+    return block + kHeaderBytes;
+  }
+
+  void deallocate(void* buffer) const {
+    if (buffer == NULL) return;
+    num_deallocations_.fetch_add(1, std::memory_order_relaxed);
+    char* block = static_cast<char*>(buffer) - kHeaderBytes;
+    const Header* header = reinterpret_cast<const Header*>(block);
+    const size_t block_bytes = header->num_bytes;
+    const int size_class = header->size_class;
+    bytes_in_use_.fetch_sub(block_bytes, std::memory_order_relaxed);
+    if (size_class >= 0) {
+      Cache& cache = threadCache();
+      std::lock_guard<std::mutex> lock(cache.mu);
+      if (cache.num_bytes + block_bytes <= max_cached_bytes_per_cache_) {
+        cache.blocks[size_class].push_back(block);
+        cache.num_bytes += block_bytes;
+        bytes_cached_.fetch_add(block_bytes, std::memory_order_relaxed);
+        return;
+      }
+    }
+    internal::aligned_free(block);
+  }
+
+  // Returns all the cached blocks to the system. The buffers in use are not
+  // affected.
+  void release() {
+    for (int i = 0; i < num_caches_; ++i) {
+      Cache& cache = caches_[i];
+      std::lock_guard<std::mutex> lock(cache.mu);
+      for (int c = 0; c < kNumClasses; ++c) {
+        for (size_t j = 0; j < cache.blocks[c].size(); ++j) {
+          internal::aligned_free(cache.blocks[c][j]);
+        }
+        cache.blocks[c].clear();
+      }
+      bytes_cached_.fetch_sub(cache.num_bytes, std::memory_order_relaxed);
+      cache.num_bytes = 0;
+    }
+  }
+
+  // A snapshot of the counters. The counters are updated without
+  // synchronization, so the values are only consistent when no allocation is
+  // in flight.
+  Stats stats() const {
+    Stats s;
+    s.num_allocations = num_allocations_.load(std::memory_order_relaxed);
+    s.num_deallocations = num_deallocations_.load(std::memory_order_relaxed);
+    s.num_cache_hits = num_cache_hits_.load(std::memory_order_relaxed);
+    s.num_system_allocations =
+        num_system_allocations_.load(std::memory_order_relaxed);
+    s.bytes_in_use = bytes_in_use_.load(std::memory_order_relaxed);
+    s.peak_bytes_in_use = peak_bytes_in_use_.load(std::memory_order_relaxed);
+    s.bytes_cached = bytes_cached_.load(std::memory_order_relaxed);
+    return s;
+  }
+
+ private:
+  static const int kNumClasses = 21;  // 2^6 ... 2^26 bytes.
+
+  // Stored in front of every block. The size keeps the returned pointers
+  // aligned like the ones returned by aligned_malloc.
+  struct Header {
+    size_t num_bytes;
+    int size_class;
+  };
+  static const size_t kHeaderBytes =
+      EIGEN_MAX_ALIGN_BYTES > 16 ? EIGEN_MAX_ALIGN_BYTES : 16;
+
+  struct Cache {
+    Cache() : num_bytes(0) {}
+    std::mutex mu;
+    std::vector<char*> blocks[kNumClasses];
+    size_t num_bytes;
+  };
+
+  // Returns -1 for the requests that are too large to be pooled.
+  static int sizeClass(size_t num_bytes) {
+    if (num_bytes > kMaxPooledBytes) return -1;
+    int size_class = 0;
+    size_t bytes = kMinPooledBytes;
+    while (bytes < num_bytes) {
+      bytes <<= 1;
+      ++size_class;
+    }
+    return size_class;
+  }
+
+  static size_t classBytes(int size_class) {
+    return kMinPooledBytes << size_class;
+  }
+
+  Cache& threadCache() const {
+    EIGEN_THREAD_LOCAL int thread_index = -1;
+    if (thread_index < 0) {
+      static std::atomic<int> next_thread_index(0);
+      thread_index = next_thread_index.fetch_add(1, std::memory_order_relaxed) &
+                     0x7fffffff;
+    }
+    return caches_[thread_index % num_caches_];
+  }
+
+  void addBytesInUse(size_t num_bytes) const {
+    const size_t in_use =
+        bytes_in_use_.fetch_add(num_bytes, std::memory_order_relaxed) +
+        num_bytes;
+    size_t peak = peak_bytes_in_use_.load(std::memory_order_relaxed);
+    while (in_use > peak &&
+           !peak_bytes_in_use_.compare_exchange_weak(
+               peak, in_use, std::memory_order_relaxed)) {
+    }
+  }
+
+  PoolAllocator(const PoolAllocator&) = delete;
+  void operator=(const PoolAllocator&) = delete;
+
+  const int num_caches_;
+  const size_t max_cached_bytes_per_cache_;
+  Cache* caches_;
+  mutable std::atomic<size_t> num_allocations_;
+  mutable std::atomic<size_t> num_deallocations_;
+  mutable std::atomic<size_t> num_cache_hits_;
+  mutable std::atomic<size_t> num_system_allocations_;
+  mutable std::atomic<size_t> bytes_in_use_;
+  mutable std::atomic<size_t> peak_bytes_in_use_;
+  mutable std::atomic<size_t> bytes_cached_;
+};
+
+}  // end namespace Eigen
+
+#endif  // EIGEN_CXX11_TENSOR_TENSOR_POOL_ALLOCATOR_H
@@ -165,7 +165,8 @@ struct GenericDimReducer<-1, Self, Op> {
   }
 };
 
-template <typename Self, typename Op, bool Vectorizable = (Self::InputPacketAccess & Op::PacketAccess)>
+template <typename Self, typename Op, bool Vectorizable = (Self::InputPacketAccess & Op::PacketAccess),
+          bool UseTreeReduction = (reducer_accumulation<Op>::value != LinearAccumulation)>
 struct InnerMostDimReducer {
   static EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE typename Self::CoeffReturnType reduce(const Self& self, typename Self::Index firstIndex, typename Self::Index numValuesToReduce, Op& reducer) {
     typename Self::CoeffReturnType accum = reducer.initialize();
@@ -177,7 +178,7 @@ struct InnerMostDimReducer {
 };
 
 template <typename Self, typename Op>
-struct InnerMostDimReducer<Self, Op, true> {
+struct InnerMostDimReducer<Self, Op, true, false> {
   static EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE typename Self::CoeffReturnType reduce(const Self& self, typename Self::Index firstIndex, typename Self::Index numValuesToReduce, Op& reducer) {
     const int packetSize = internal::unpacket_traits<typename Self::PacketReturnType>::size;
     const typename Self::Index VectorizedSize = (numValuesToReduce / packetSize) * packetSize;
@@ -193,6 +194,110 @@ struct InnerMostDimReducer<Self, Op, true> {
   }
 };
 
+// Tree reductions split the values in halves until they fit in a leaf, and
+// combine the partial results of the two halves. The partial results are
+// combined with a copy of the reducer, so that stateful reducers only count
+// the input values (e.g. the mean reducer).
+template <typename Self, typename Op>
+struct InnerMostDimReducer<Self, Op, false, true> {
+  typedef typename Self::Index Index;
+  typedef typename Self::CoeffReturnType CoeffReturnType;
+  static const Index kLeafSize = 1024;
+
+  static EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE CoeffReturnType reduce(const Self& self, Index firstIndex, Index numValuesToReduce, Op& reducer) {
+    return reducer.finalize(reduceTree(self, firstIndex, numValuesToReduce, reducer));
+  }
+
+  static EIGEN_DEVICE_FUNC CoeffReturnType reduceTree(const Self& self, Index firstIndex, Index numValuesToReduce, Op& reducer) {
+    if (numValuesToReduce > kLeafSize) {
+      const Index half = numValuesToReduce / 2;
+      CoeffReturnType accum = reduceTree(self, firstIndex, half, reducer);
+      const CoeffReturnType right = reduceTree(self, firstIndex + half, numValuesToReduce - half, reducer);
+      Op combiner(reducer);
+      combiner.reduce(right, &accum);
+      return accum;
+    }
+    CoeffReturnType accum = reducer.initialize();
+    if (reducer_accumulation<Op>::value == KahanAccumulation) {
+      CoeffReturnType compensation = reducer.initialize();
+      for (Index j = 0; j < numValuesToReduce; ++j) {
+        const CoeffReturnType y = self.m_impl.coeff(firstIndex + j) - compensation;
+        const CoeffReturnType t = accum + y;
+        compensation = (t - accum) - y;
+        accum = t;
+      }
+    } else {
+      for (Index j = 0; j < numValuesToReduce; ++j) {
+        reducer.reduce(self.m_impl.coeff(firstIndex + j), &accum);
+      }
+    }
+    return accum;
+  }
+};
+
+template <typename Self, typename Op>
+struct InnerMostDimReducer<Self, Op, true, true> {
+  typedef typename Self::Index Index;
+  typedef typename Self::CoeffReturnType CoeffReturnType;
+  typedef typename Self::PacketReturnType Packet;
+  static const int PacketSize = internal::unpacket_traits<Packet>::size;
+  // Number of packets in a leaf.
+  static const Index kLeafSize = 1024;
+
+  static EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE CoeffReturnType reduce(const Self& self, Index firstIndex, Index numValuesToReduce, Op& reducer) {
+    const Index numPackets = numValuesToReduce / PacketSize;
+    const Packet p = reduceTree(self, firstIndex, numPackets, reducer);
+    CoeffReturnType accum = reducer.initialize();
+    for (Index j = numPackets * PacketSize; j < numValuesToReduce; ++j) {
+      reducer.reduce(self.m_impl.coeff(firstIndex + j), &accum);
+    }
+    return reducer.finalizeBoth(accum, p);
+  }
+
+  static EIGEN_DEVICE_FUNC Packet reduceTree(const Self& self, Index firstIndex, Index numPackets, Op& reducer) {
+    if (numPackets > kLeafSize) {
+      const Index half = numPackets / 2;
+      Packet accum = reduceTree(self, firstIndex, half, reducer);
+      const Packet right = reduceTree(self, firstIndex + half * PacketSize, numPackets - half, reducer);
+      Op combiner(reducer);
+      combiner.reducePacket(right, &accum);
+      return accum;
+    }
+    if (reducer_accumulation<Op>::value == KahanAccumulation) {
+      Packet accum = reducer.template initializePacket<Packet>();
+      Packet compensation = reducer.template initializePacket<Packet>();
+      for (Index j = 0; j < numPackets; ++j) {
+        const Packet y = psub(self.m_impl.template packet<Unaligned>(firstIndex + j * PacketSize), compensation);
+        const Packet t = padd(accum, y);
+        compensation = psub(psub(t, accum), y);
+        accum = t;
+      }
+      return accum;
+    }
+    // Independent accumulators hide the latency of the reduction.
+    Packet accum0 = reducer.template initializePacket<Packet>();
+    Packet accum1 = accum0;
+    Packet accum2 = accum0;
+    Packet accum3 = accum0;
+    Index j = 0;
+    for (; j + 4 <= numPackets; j += 4) {
+      const Index index = firstIndex + j * PacketSize;
+      reducer.reducePacket(self.m_impl.template packet<Unaligned>(index), &accum0);
+      reducer.reducePacket(self.m_impl.template packet<Unaligned>(index + PacketSize), &accum1);
+      reducer.reducePacket(self.m_impl.template packet<Unaligned>(index + 2 * PacketSize), &accum2);
+      reducer.reducePacket(self.m_impl.template packet<Unaligned>(index + 3 * PacketSize), &accum3);
+    }
+    for (; j < numPackets; ++j) {
+      reducer.reducePacket(self.m_impl.template packet<Unaligned>(firstIndex + j * PacketSize), &accum0);
+    }
+    Op combiner(reducer);
+    combiner.reducePacket(accum1, &accum0);
+    combiner.reducePacket(accum3, &accum2);
+    combiner.reducePacket(accum2, &accum0);
+    return accum0;
+  }
+};
+
 template <int DimIndex, typename Self, typename Op, bool vectorizable = (Self::InputPacketAccess & Op::PacketAccess)>
 struct InnerMostDimPreserver {
   static EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void reduce(const Self&, typename Self::Index, Op&, typename Self::PacketReturnType*) {
@@ -236,6 +341,15 @@ struct FullReducer {
     const typename Self::Index num_coeffs = array_prod(self.m_impl.dimensions());
     *output = InnerMostDimReducer<Self, Op, Vectorizable>::reduce(self, 0, num_coeffs, reducer);
   }
+
+#ifdef EIGEN_USE_THREADS
+  template <typename DoneCallback>
+  static void runAsync(const Self& self, Op& reducer, const Device& device,
+                       typename Self::CoeffReturnType* output, DoneCallback done) {
+    run(self, reducer, device, output);
+    done();
+  }
+#endif  // EIGEN_USE_THREADS
 };
 
 
@@ -306,6 +420,57 @@ struct FullReducer<Self, Op, ThreadPoolDevice, Vectorizable> {
     }
     *output = reducer.finalize(finalShard);
   }
+
+  // Same as run, but returns immediately: the shards are reduced by the
+  // thread pool and done is called by the worker that finalizes the output.
+  template <typename DoneCallback>
+  static void runAsync(const Self& self, Op& reducer,
+                       const ThreadPoolDevice& device,
+                       typename Self::CoeffReturnType* output,
+                       DoneCallback done) {
+    typedef typename Self::Index Index;
+    typedef typename Self::CoeffReturnType CoeffReturnType;
+    const Index num_coeffs = array_prod(self.m_impl.dimensions());
+    if (num_coeffs == 0) {
+      *output = reducer.finalize(reducer.initialize());
+      done();
+      return;
+    }
+    const TensorOpCost cost =
+        self.m_impl.costPerCoeff(Vectorizable) +
+        TensorOpCost(0, 0, internal::functor_traits<Op>::Cost, Vectorizable,
+                     PacketSize);
+    const int num_threads = TensorCostModel<ThreadPoolDevice>::numThreads(
+        num_coeffs, cost, device.numThreads());
+    const Index blocksize = numext::maxi<Index>(
+        1, std::floor<Index>(static_cast<float>(num_coeffs) / num_threads));
+    const Index numblocks = divup(num_coeffs, blocksize);
+
+    MaxSizeVector<CoeffReturnType>* shards =
+        new MaxSizeVector<CoeffReturnType>(numblocks, reducer.initialize());
+    const Self* self_ptr = &self;
+    device.parallelForAsync(
+        numblocks, cost * static_cast<double>(blocksize),
+        [self_ptr, reducer, num_coeffs, blocksize, shards](Index first, Index last) {
+          for (Index i = first; i < last; ++i) {
+            Op shard_reducer(reducer);
+            const Index begin = i * blocksize;
+            (*shards)[i] = InnerMostDimReducer<Self, Op, Vectorizable>::reduce(
+                *self_ptr, begin, numext::mini(blocksize, num_coeffs - begin),
+                shard_reducer);
+          }
+        },
+        [reducer, numblocks, shards, output, done]() {
+          Op final_reducer(reducer);
+          CoeffReturnType accum = final_reducer.initialize();
+          for (Index i = 0; i < numblocks; ++i) {
+            final_reducer.reduce((*shards)[i], &accum);
+          }
+          *output = final_reducer.finalize(accum);
+          delete shards;
+          done();
+        });
+  }
 };
 
 #endif
@@ -334,6 +499,421 @@ struct OuterReducer {
 };
 
 
+// Stateless reducers can be shared by several accumulators, and the partial
+// results they produce can be combined with reduce() since finalize() doesn't
+// alter them. User defined reducers are conservatively assumed to be stateful.
+template <typename Op> struct is_stateless_reducer { static const bool value = false; };
+template <typename T> struct is_stateless_reducer<SumReducer<T> > { static const bool value = true; };
+template <typename T> struct is_stateless_reducer<MaxReducer<T> > { static const bool value = true; };
+template <typename T> struct is_stateless_reducer<MinReducer<T> > { static const bool value = true; };
+template <typename T> struct is_stateless_reducer<ProdReducer<T> > { static const bool value = true; };
+template <> struct is_stateless_reducer<AndReducer> { static const bool value = true; };
+template <> struct is_stateless_reducer<OrReducer> { static const bool value = true; };
+
+// Reduces the rows [firstRow, firstRow + numRows) of the input, viewed as a
+// column major matrix with numPreserved rows of contiguous coefficients, for
+// the columns [firstCol, lastCol). The reduced value of column j is written
+// to output[j], which also holds the accumulators: the columns are processed
+// in blocks small enough for the accumulators to stay in cache while the
+// rows of the input are streamed. Stateful reducers (e.g. the mean reducer
+// counts the values it has seen) need one copy per accumulator.
+template <typename Self, typename Op, bool Vectorizable = (Self::InputPacketAccess & Op::PacketAccess)>
+struct OuterMostDimReducer {
+  static const int BlockSize = 1024;
+
+  static void reduce(const Self& self, const Op& reducer,
+                     typename Self::Index firstRow, typename Self::Index numRows,
+                     typename Self::Index numPreserved,
+                     typename Self::Index firstCol, typename Self::Index lastCol,
+                     typename Self::CoeffReturnType* output) {
+    typedef typename Self::Index Index;
+    const bool stateless = is_stateless_reducer<Op>::value;
+    for (Index first = firstCol; first < lastCol; first += BlockSize) {
+      const Index last = numext::mini<Index>(lastCol, first + BlockSize);
+      Op shared_reducer(reducer);
+      MaxSizeVector<Op> reducers(stateless ? 0 : last - first, reducer);
+      for (Index j = first; j < last; ++j) {
+        Op& r = stateless ? shared_reducer : reducers[j - first];
+        output[j] = r.initialize();
+      }
+      for (Index i = firstRow; i < firstRow + numRows; ++i) {
+        const Index base = i * numPreserved;
+        for (Index j = first; j < last; ++j) {
+          Op& r = stateless ? shared_reducer : reducers[j - first];
+          r.reduce(self.m_impl.coeff(base + j), &output[j]);
+        }
+      }
+      for (Index j = first; j < last; ++j) {
+        Op& r = stateless ? shared_reducer : reducers[j - first];
+        output[j] = r.finalize(output[j]);
+      }
+    }
+  }
+};
+
+template <typename Self, typename Op>
+struct OuterMostDimReducer<Self, Op, true> {
+  static const int PacketSize = unpacket_traits<typename Self::PacketReturnType>::size;
+  static const int BlockSize = 256 * PacketSize;
+
+  static void reduce(const Self& self, const Op& reducer,
+                     typename Self::Index firstRow, typename Self::Index numRows,
+                     typename Self::Index numPreserved,
+                     typename Self::Index firstCol, typename Self::Index lastCol,
+                     typename Self::CoeffReturnType* output) {
+    typedef typename Self::Index Index;
+    typedef typename Self::PacketReturnType Packet;
+    const bool stateless = is_stateless_reducer<Op>::value;
+    const Index vectorized_end =
+        firstCol + ((lastCol - firstCol) / PacketSize) * PacketSize;
+    for (Index first = firstCol; first < vectorized_end; first += BlockSize) {
+      const Index last = numext::mini<Index>(vectorized_end, first + BlockSize);
+      Op shared_reducer(reducer);
+      MaxSizeVector<Op> reducers(stateless ? 0 : (last - first) / PacketSize, reducer);
+      for (Index j = first; j < last; j += PacketSize) {
+        Op& r = stateless ? shared_reducer : reducers[(j - first) / PacketSize];
+        pstoreu(output + j, r.template initializePacket<Packet>());
+      }
+      for (Index i = firstRow; i < firstRow + numRows; ++i) {
+        const Index base = i * numPreserved;
+        for (Index j = first; j < last; j += PacketSize) {
+          Op& r = stateless ? shared_reducer : reducers[(j - first) / PacketSize];
+          Packet accum = ploadu<Packet>(output + j);
+          r.reducePacket(self.m_impl.template packet<Unaligned>(base + j), &accum);
+          pstoreu(output + j, accum);
+        }
+      }
+      for (Index j = first; j < last; j += PacketSize) {
+        Op& r = stateless ? shared_reducer : reducers[(j - first) / PacketSize];
+        pstoreu(output + j, r.finalizePacket(ploadu<Packet>(output + j)));
+      }
+    }
+    OuterMostDimReducer<Self, Op, false>::reduce(self, reducer, firstRow, numRows, numPreserved,
+                                                 vectorized_end, lastCol, output);
+  }
+};
+
+// Vectorized reduction of the inner most dimensions on the default device.
+template <typename Self, typename Op>
+struct InnerReducer<Self, Op, DefaultDevice> {
+  static const bool HasOptimizedImplementation = true;
+
+  static bool run(const Self& self, Op& reducer, const DefaultDevice&,
+                  typename Self::CoeffReturnType* output,
+                  typename Self::Index num_values_to_reduce,
+                  typename Self::Index num_coeffs_to_preserve) {
+    for (typename Self::Index i = 0; i < num_coeffs_to_preserve; ++i) {
+      Op row_reducer(reducer);
+      output[i] = InnerMostDimReducer<Self, Op>::reduce(
+          self, i * num_values_to_reduce, num_values_to_reduce, row_reducer);
+    }
+    return false;
+  }
+};
+
+// Vectorized reduction of the outer most dimensions on the default device.
+template <typename Self, typename Op>
+struct OuterReducer<Self, Op, DefaultDevice> {
+  static const bool HasOptimizedImplementation = true;
+
+  static bool run(const Self& self, Op& reducer, const DefaultDevice&,
+                  typename Self::CoeffReturnType* output,
+                  typename Self::Index num_values_to_reduce,
+                  typename Self::Index num_coeffs_to_preserve) {
+    OuterMostDimReducer<Self, Op>::reduce(self, reducer, 0, num_values_to_reduce,
+                                          num_coeffs_to_preserve, 0,
+                                          num_coeffs_to_preserve, output);
+    return false;
+  }
+};
+
+#ifdef EIGEN_USE_THREADS
+// Multithreaded inner reducer. Rows are reduced in parallel. When there are
+// fewer rows than threads, each row is also split into shards that are
+// reduced independently and combined at the end, which requires a stateless
+// reducer.
+template <typename Self, typename Op>
+struct InnerReducer<Self, Op, ThreadPoolDevice> {
+  static const bool HasOptimizedImplementation = true;
+  static const bool Vectorizable = Self::InputPacketAccess & Op::PacketAccess;
+  static const int PacketSize = unpacket_traits<typename Self::PacketReturnType>::size;
+
+  typedef typename Self::Index Index;
+  typedef typename Self::CoeffReturnType CoeffReturnType;
+
+  static bool run(const Self& self, Op& reducer, const ThreadPoolDevice& device,
+                  CoeffReturnType* output, Index num_values_to_reduce,
+                  Index num_coeffs_to_preserve) {
+    const Index num_shards = numShards(self, device, num_values_to_reduce,
+                                       num_coeffs_to_preserve);
+    if (num_shards == 1) {
+      device.parallelFor(num_coeffs_to_preserve, rowCost(self, num_values_to_reduce),
+                         [&](Index first, Index last) {
+                           reduceRows(self, reducer, num_values_to_reduce, first, last, output);
+                         });
+      return false;
+    }
+    const Index shard_size = shardSize(num_values_to_reduce, num_shards);
+    CoeffReturnType* shards = static_cast<CoeffReturnType*>(device.allocate(
+        num_coeffs_to_preserve * num_shards * sizeof(CoeffReturnType)));
+    device.parallelFor(num_coeffs_to_preserve * num_shards, rowCost(self, shard_size),
+                       [&](Index first, Index last) {
+                         reduceShards(self, reducer, num_values_to_reduce, num_shards,
+                                      shard_size, first, last, shards);
+                       });
+    combineShards(reducer, num_coeffs_to_preserve, num_shards, shards, output);
+    device.deallocate(shards);
+    return false;
+  }
+
+  template <typename DoneCallback>
+  static void runAsync(const Self& self, Op& reducer, const ThreadPoolDevice& device,
+                       CoeffReturnType* output, Index num_values_to_reduce,
+                       Index num_coeffs_to_preserve, DoneCallback done) {
+    const Self* self_ptr = &self;
+    const Index num_shards = numShards(self, device, num_values_to_reduce,
+                                       num_coeffs_to_preserve);
+    if (num_shards == 1) {
+      device.parallelForAsync(
+          num_coeffs_to_preserve, rowCost(self, num_values_to_reduce),
+          [self_ptr, reducer, num_values_to_reduce, output](Index first, Index last) {
+            reduceRows(*self_ptr, reducer, num_values_to_reduce, first, last, output);
+          },
+          std::move(done));
+      return;
+    }
+    const Index shard_size = shardSize(num_values_to_reduce, num_shards);
+    CoeffReturnType* shards = static_cast<CoeffReturnType*>(device.allocate(
+        num_coeffs_to_preserve * num_shards * sizeof(CoeffReturnType)));
+    const ThreadPoolDevice* device_ptr = &device;
+    device.parallelForAsync(
+        num_coeffs_to_preserve * num_shards, rowCost(self, shard_size),
+        [self_ptr, reducer, num_values_to_reduce, num_shards, shard_size,
+         shards](Index first, Index last) {
+          reduceShards(*self_ptr, reducer, num_values_to_reduce, num_shards,
+                       shard_size, first, last, shards);
+        },
+        [device_ptr, reducer, num_coeffs_to_preserve, num_shards, shards, output,
+         done]() {
+          combineShards(reducer, num_coeffs_to_preserve, num_shards, shards, output);
+          device_ptr->deallocate(shards);
+          done();
+        });
+  }
+
+ private:
+  static TensorOpCost rowCost(const Self& self, Index num_values) {
+    return (self.m_impl.costPerCoeff(Vectorizable) +
+            TensorOpCost(0, 0, functor_traits<Op>::Cost, Vectorizable, PacketSize)) *
+           static_cast<double>(num_values);
+  }
+
+  static Index numShards(const Self& self, const ThreadPoolDevice& device,
+                         Index num_values_to_reduce, Index num_coeffs_to_preserve) {
+    if (!is_stateless_reducer<Op>::value || num_coeffs_to_preserve == 0 ||
+        num_coeffs_to_preserve >= device.numThreads()) {
+      return 1;
+    }
+    const int num_threads = TensorCostModel<ThreadPoolDevice>::numThreads(
+        static_cast<double>(num_coeffs_to_preserve),
+        rowCost(self, num_values_to_reduce), device.numThreads());
+    if (num_threads <= num_coeffs_to_preserve) return 1;
+    // Don't create shards smaller than a few packets.
+    return numext::maxi<Index>(1, numext::mini<Index>(
+        divup<Index>(num_threads, num_coeffs_to_preserve),
+        divup<Index>(num_values_to_reduce, 4 * PacketSize)));
+  }
+
+  static Index shardSize(Index num_values_to_reduce, Index num_shards) {
+    return divup<Index>(divup(num_values_to_reduce, num_shards), PacketSize) * PacketSize;
+  }
+
+  static void reduceRows(const Self& self, const Op& reducer, Index num_values_to_reduce,
+                         Index first, Index last, CoeffReturnType* output) {
+    for (Index i = first; i < last; ++i) {
+      Op row_reducer(reducer);
+      output[i] = InnerMostDimReducer<Self, Op>::reduce(
+          self, i * num_values_to_reduce, num_values_to_reduce, row_reducer);
+    }
+  }
+
+  static void reduceShards(const Self& self, const Op& reducer, Index num_values_to_reduce,
+                           Index num_shards, Index shard_size, Index first, Index last,
+                           CoeffReturnType* shards) {
+    for (Index i = first; i < last; ++i) {
+      const Index row = i / num_shards;
+      const Index begin = (i - row * num_shards) * shard_size;
+      const Index size = numext::maxi<Index>(
+          0, numext::mini<Index>(shard_size, num_values_to_reduce - begin));
+      Op shard_reducer(reducer);
+      shards[i] = InnerMostDimReducer<Self, Op>::reduce(
+          self, row * num_values_to_reduce + begin, size, shard_reducer);
+    }
+  }
+
+  static void combineShards(const Op& reducer, Index num_coeffs_to_preserve, Index num_shards,
+                            const CoeffReturnType* shards, CoeffReturnType* output) {
+    for (Index i = 0; i < num_coeffs_to_preserve; ++i) {
+      Op row_reducer(reducer);
+      CoeffReturnType accum = row_reducer.initialize();
+      for (Index s = 0; s < num_shards; ++s) {
+        row_reducer.reduce(shards[i * num_shards + s], &accum);
+      }
+      output[i] = row_reducer.finalize(accum);
+    }
+  }
+};
+
+// Multithreaded outer reducer. The preserved coefficients are split between
+// the threads. When there are too few of them to keep the threads busy, the
+// reduced rows are split into shards that are reduced independently and
+// combined at the end, which requires a stateless reducer.
+template <typename Self, typename Op>
+struct OuterReducer<Self, Op, ThreadPoolDevice> {
+  static const bool HasOptimizedImplementation = true;
+  static const bool Vectorizable = Self::InputPacketAccess & Op::PacketAccess;
+  static const int PacketSize = unpacket_traits<typename Self::PacketReturnType>::size;
+
+  typedef typename Self::Index Index;
+  typedef typename Self::CoeffReturnType CoeffReturnType;
+
+  static bool run(const Self& self, Op& reducer, const ThreadPoolDevice& device,
+                  CoeffReturnType* output, Index num_values_to_reduce,
+                  Index num_coeffs_to_preserve) {
+    const Index num_shards = numShards(self, device, num_values_to_reduce,
+                                       num_coeffs_to_preserve);
+    if (num_shards == 1) {
+      const Index column_block = columnBlock(device, num_coeffs_to_preserve);
+      device.parallelFor(num_coeffs_to_preserve, columnCost(self, num_values_to_reduce),
+                         [column_block](Index size) { return alignColumns(column_block, size); },
+                         [&](Index first, Index last) {
+                           OuterMostDimReducer<Self, Op>::reduce(
+                               self, reducer, 0, num_values_to_reduce,
+                               num_coeffs_to_preserve, first, last, output);
+                         });
+      return false;
+    }
+    const Index rows_per_shard = divup(num_values_to_reduce, num_shards);
+    CoeffReturnType* shards = static_cast<CoeffReturnType*>(device.allocate(
+        num_coeffs_to_preserve * num_shards * sizeof(CoeffReturnType)));
+    device.parallelFor(num_shards, columnCost(self, rows_per_shard) *
+                                       static_cast<double>(num_coeffs_to_preserve),
+                       [&](Index first, Index last) {
+                         reduceShards(self, reducer, num_values_to_reduce,
+                                      num_coeffs_to_preserve, rows_per_shard, first,
+                                      last, shards);
+                       });
+    combineShards(reducer, num_coeffs_to_preserve, num_shards, shards, output);
+    device.deallocate(shards);
+    return false;
+  }
+
+  template <typename DoneCallback>
+  static void runAsync(const Self& self, Op& reducer, const ThreadPoolDevice& device,
+                       CoeffReturnType* output, Index num_values_to_reduce,
+                       Index num_coeffs_to_preserve, DoneCallback done) {
+    const Self* self_ptr = &self;
+    const Index num_shards = numShards(self, device, num_values_to_reduce,
+                                       num_coeffs_to_preserve);
+    if (num_shards == 1) {
+      const Index column_block = columnBlock(device, num_coeffs_to_preserve);
+      device.parallelForAsync(
+          num_coeffs_to_preserve, columnCost(self, num_values_to_reduce),
+          [column_block](Index size) { return alignColumns(column_block, size); },
+          [self_ptr, reducer, num_values_to_reduce, num_coeffs_to_preserve,
+           output](Index first, Index last) {
+            OuterMostDimReducer<Self, Op>::reduce(*self_ptr, reducer, 0,
+                                                  num_values_to_reduce,
+                                                  num_coeffs_to_preserve, first,
+                                                  last, output);
+          },
+          std::move(done));
+      return;
+    }
+    const Index rows_per_shard = divup(num_values_to_reduce, num_shards);
+    CoeffReturnType* shards = static_cast<CoeffReturnType*>(device.allocate(
+        num_coeffs_to_preserve * num_shards * sizeof(CoeffReturnType)));
+    const ThreadPoolDevice* device_ptr = &device;
+    device.parallelForAsync(
+        num_shards,
+        columnCost(self, rows_per_shard) * static_cast<double>(num_coeffs_to_preserve),
+        [self_ptr, reducer, num_values_to_reduce, num_coeffs_to_preserve,
+         rows_per_shard, shards](Index first, Index last) {
+          reduceShards(*self_ptr, reducer, num_values_to_reduce,
+                       num_coeffs_to_preserve, rows_per_shard, first, last, shards);
+        },
+        [device_ptr, reducer, num_coeffs_to_preserve, num_shards, shards, output,
+         done]() {
+          combineShards(reducer, num_coeffs_to_preserve, num_shards, shards, output);
+          device_ptr->deallocate(shards);
+          done();
+        });
+  }
+
+ private:
+  static TensorOpCost columnCost(const Self& self, Index num_values) {
+    return (self.m_impl.costPerCoeff(Vectorizable) +
+            TensorOpCost(0, 0, functor_traits<Op>::Cost, Vectorizable, PacketSize)) *
+           static_cast<double>(num_values);
+  }
+
+  // Minimum number of columns processed by a task. Wide blocks let the rows
+  // of the input be read in long contiguous runs, but stateful reducers
+  // can't split the rows between threads instead, so they get narrower
+  // blocks when there are few columns.
+  static Index columnBlock(const ThreadPoolDevice& device, Index num_coeffs_to_preserve) {
+    const Index block_size = OuterMostDimReducer<Self, Op>::BlockSize;
+    if (is_stateless_reducer<Op>::value) return block_size;
+    return numext::mini<Index>(
+        block_size, alignColumns(1, divup<Index>(num_coeffs_to_preserve, device.numThreads())));
+  }
+
+  // Blocks of columns are made of whole packets.
+  static Index alignColumns(Index column_block, Index size) {
+    return numext::maxi<Index>(column_block, divup<Index>(size, PacketSize) * PacketSize);
+  }
+
+  static Index numShards(const Self& self, const ThreadPoolDevice& device,
+                         Index num_values_to_reduce, Index num_coeffs_to_preserve) {
+    if (!is_stateless_reducer<Op>::value || num_coeffs_to_preserve == 0) return 1;
+    const int num_threads = TensorCostModel<ThreadPoolDevice>::numThreads(
+        static_cast<double>(num_coeffs_to_preserve),
+        columnCost(self, num_values_to_reduce), device.numThreads());
+    const Index num_column_blocks =
+        divup<Index>(num_coeffs_to_preserve, columnBlock(device, num_coeffs_to_preserve));
+    if (num_threads <= num_column_blocks) return 1;
+    return numext::maxi<Index>(1, numext::mini<Index>(
+        divup<Index>(num_threads, num_column_blocks), num_values_to_reduce));
+  }
+
+  static void reduceShards(const Self& self, const Op& reducer, Index num_values_to_reduce,
+                           Index num_coeffs_to_preserve, Index rows_per_shard,
+                           Index first, Index last, CoeffReturnType* shards) {
+    for (Index s = first; s < last; ++s) {
+      const Index begin = s * rows_per_shard;
+      const Index num_rows = numext::maxi<Index>(
+          0, numext::mini<Index>(rows_per_shard, num_values_to_reduce - begin));
+      OuterMostDimReducer<Self, Op>::reduce(
+          self, reducer, begin, num_rows, num_coeffs_to_preserve, 0,
+          num_coeffs_to_preserve, shards + s * num_coeffs_to_preserve);
+    }
+  }
+
+  static void combineShards(const Op& reducer, Index num_coeffs_to_preserve, Index num_shards,
+                            const CoeffReturnType* shards, CoeffReturnType* output) {
+    for (Index j = 0; j < num_coeffs_to_preserve; ++j) {
+      Op column_reducer(reducer);
+      CoeffReturnType accum = column_reducer.initialize();
+      for (Index s = 0; s < num_shards; ++s) {
+        column_reducer.reduce(shards[s * num_coeffs_to_preserve + j], &accum);
+      }
+      output[j] = column_reducer.finalize(accum);
+    }
+  }
+};
+#endif  // EIGEN_USE_THREADS
+
+
 #if defined(EIGEN_USE_GPU) && defined(EIGEN_CUDACC)
 template <int B, int N, typename S, typename R, typename I>
 __global__ void FullReductionKernel(R, const S, I, typename S::CoeffReturnType*, unsigned int*);
@@ -412,6 +992,8 @@ struct TensorEvaluator<const TensorReductionOp<Op, Dims, ArgType, MakePointer_>,
   enum {
     IsAligned = false,
     PacketAccess = Self::InputPacketAccess && Op::PacketAccess,
+    BlockAccess = false,
+    PreferBlockAccess = false,
     Layout = TensorEvaluator<ArgType, Device>::Layout,
     CoordAccess = false,  // to be implemented
     RawAccess = false
@@ -527,16 +1109,8 @@ struct TensorEvaluator<const TensorReductionOp<Op, Dims, ArgType, MakePointer_>,
 
     // Attempt to use an optimized reduction.
     else if (RunningOnGPU && (m_device.majorDeviceVersion() >= 3)) {
-      bool reducing_inner_dims = true;
-      for (int i = 0; i < NumReducedDims; ++i) {
-        if (static_cast<int>(Layout) == static_cast<int>(ColMajor)) {
-          reducing_inner_dims &= m_reduced[i];
-        } else {
-          reducing_inner_dims &= m_reduced[NumInputDims - 1 - i];
-        }
-      }
       if (internal::InnerReducer<Self, Op, Device>::HasOptimizedImplementation &&
-          (reducing_inner_dims || ReducingInnerMostDims)) {
+          (reducingInnerDims() || ReducingInnerMostDims)) {
         const Index num_values_to_reduce = internal::array_prod(m_reducedDims);
         const Index num_coeffs_to_preserve = internal::array_prod(m_dimensions);
         if (!data) {
@@ -560,16 +1134,8 @@ struct TensorEvaluator<const TensorReductionOp<Op, Dims, ArgType, MakePointer_>,
         }
       }
 
-      bool preserving_inner_dims = true;
-      for (int i = 0; i < NumReducedDims; ++i) {
-        if (static_cast<int>(Layout) == static_cast<int>(ColMajor)) {
-          preserving_inner_dims &= m_reduced[NumInputDims - 1 - i];
-        } else {
-          preserving_inner_dims &= m_reduced[i];
-        }
-      }
       if (internal::OuterReducer<Self, Op, Device>::HasOptimizedImplementation &&
-          preserving_inner_dims) {
+          preservingInnerDims()) {
         const Index num_values_to_reduce = internal::array_prod(m_reducedDims);
         const Index num_coeffs_to_preserve = internal::array_prod(m_dimensions);
         if (!data) {
@@ -593,9 +1159,91 @@ struct TensorEvaluator<const TensorReductionOp<Op, Dims, ArgType, MakePointer_>,
         }
       }
     }
+
+    // On the cpu, reductions of the inner most or of the outer most
+    // dimensions are evaluated in one pass over the input.
+    else if (!RunningOnGPU && !RunningOnSycl) {
+      const Index num_values_to_reduce = internal::array_prod(m_reducedDims);
+      const Index num_coeffs_to_preserve = internal::array_prod(m_dimensions);
+      const bool inner = useInnerReducer();
+      if (!inner && !useOuterReducer()) {
+        return true;
+      }
+      if (!data) {
+        // Buffering the result is only worth it if each output coefficient
+        // is computed from enough input coefficients.
+        if (num_values_to_reduce < kMinValuesToBuffer) {
+          return true;
+        }
+        data = static_cast<CoeffReturnType*>(m_device.allocate(sizeof(CoeffReturnType) * num_coeffs_to_preserve));
+        m_result = data;
+      }
+      Op reducer(m_reducer);
+      if (inner) {
+        internal::InnerReducer<Self, Op, Device>::run(*this, reducer, m_device, data, num_values_to_reduce, num_coeffs_to_preserve);
+      } else {
+        internal::OuterReducer<Self, Op, Device>::run(*this, reducer, m_device, data, num_values_to_reduce, num_coeffs_to_preserve);
+      }
+      return (m_result != NULL);
+    }
     return true;
   }
 
+#ifdef EIGEN_USE_THREADS
+  // Full reductions and reductions of the inner most or outer most dimensions
+  // are evaluated asynchronously, the other reductions are computed
+  // coefficient by coefficient by the executor.
+  template <typename EvalSubExprsCallback>
+  EIGEN_STRONG_INLINE void evalSubExprsIfNeededAsync(
+      typename MakePointer_<CoeffReturnType>::Type data,
+      EvalSubExprsCallback done) {
+    m_impl.evalSubExprsIfNeededAsync(NULL, [this, data, done](bool) {
+      if (RunningFullReduction &&
+          internal::FullReducer<Self, Op, Device>::HasOptimizedImplementation) {
+        bool need_assign = false;
+        typename MakePointer_<CoeffReturnType>::Type output = data;
+        if (!output) {
+          m_result = static_cast<CoeffReturnType*>(
+              m_device.allocate(sizeof(CoeffReturnType)));
+          output = m_result;
+          need_assign = true;
+        }
+        Op reducer(m_reducer);
+        internal::FullReducer<Self, Op, Device>::runAsync(
+            *this, reducer, m_device, output,
+            [done, need_assign]() { done(need_assign); });
+        return;
+      }
+      const Index num_values_to_reduce = internal::array_prod(m_reducedDims);
+      const Index num_coeffs_to_preserve = internal::array_prod(m_dimensions);
+      const bool inner = useInnerReducer();
+      if ((!inner && !useOuterReducer()) ||
+          (!data && num_values_to_reduce < kMinValuesToBuffer)) {
+        done(true);
+        return;
+      }
+      bool need_assign = false;
+      typename MakePointer_<CoeffReturnType>::Type output = data;
+      if (!output) {
+        m_result = static_cast<CoeffReturnType*>(
+            m_device.allocate(sizeof(CoeffReturnType) * num_coeffs_to_preserve));
+        output = m_result;
+        need_assign = true;
+      }
+      Op reducer(m_reducer);
+      if (inner) {
+        internal::InnerReducer<Self, Op, Device>::runAsync(
+            *this, reducer, m_device, output, num_values_to_reduce,
+            num_coeffs_to_preserve, [done, need_assign]() { done(need_assign); });
+      } else {
+        internal::OuterReducer<Self, Op, Device>::runAsync(
+            *this, reducer, m_device, output, num_values_to_reduce,
+            num_coeffs_to_preserve, [done, need_assign]() { done(need_assign); });
+      }
+    });
+  }
+#endif  // EIGEN_USE_THREADS
+
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void cleanup() {
     m_impl.cleanup();
     if (m_result) {
@@ -606,7 +1254,7 @@ struct TensorEvaluator<const TensorReductionOp<Op, Dims, ArgType, MakePointer_>,
 
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE CoeffReturnType coeff(Index index) const
   {
-    if ((RunningOnSycl || RunningFullReduction || RunningOnGPU) && m_result) {
+    if (m_result) {
       return *(m_result + index);
     }
     Op reducer(m_reducer);
@@ -629,8 +1277,8 @@ struct TensorEvaluator<const TensorReductionOp<Op, Dims, ArgType, MakePointer_>,
     EIGEN_STATIC_ASSERT((PacketSize > 1), YOU_MADE_A_PROGRAMMING_MISTAKE)
     eigen_assert(index + PacketSize - 1 < Index(internal::array_prod(dimensions())));
 
-    if (RunningOnGPU && m_result) {
-      return internal::pload<PacketReturnType>(m_result + index);
+    if (m_result) {
+      return internal::ploadt<PacketReturnType, LoadMode>(m_result + index);
     }
 
     EIGEN_ALIGN_MAX typename internal::remove_const<CoeffReturnType>::type values[PacketSize];
@@ -668,7 +1316,7 @@ struct TensorEvaluator<const TensorReductionOp<Op, Dims, ArgType, MakePointer_>,
 
   // Must be called after evalSubExprsIfNeeded().
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE TensorOpCost costPerCoeff(bool vectorized) const {
-    if (RunningFullReduction && m_result) {
+    if (m_result) {
       return TensorOpCost(sizeof(CoeffReturnType), 0, 0, vectorized, PacketSize);
     } else {
       const Index num_values_to_reduce = internal::array_prod(m_reducedDims);
@@ -688,7 +1336,7 @@ struct TensorEvaluator<const TensorReductionOp<Op, Dims, ArgType, MakePointer_>,
 
   private:
   template <int, typename, typename> friend struct internal::GenericDimReducer;
-  template <typename, typename, bool> friend struct internal::InnerMostDimReducer;
+  template <typename, typename, bool, bool> friend struct internal::InnerMostDimReducer;
   template <int, typename, typename, bool> friend struct internal::InnerMostDimPreserver;
   template <typename S, typename O, typename D, bool V> friend struct internal::FullReducer;
 #ifdef EIGEN_USE_THREADS
@@ -713,6 +1361,46 @@ struct TensorEvaluator<const TensorReductionOp<Op, Dims, ArgType, MakePointer_>,
 
 
   template <typename S, typename O, typename D> friend struct internal::InnerReducer;
+  template <typename S, typename O, typename D> friend struct internal::OuterReducer;
+  template <typename S, typename O, bool V> friend struct internal::OuterMostDimReducer;
+
+  // Minimum number of values reduced per output coefficient for which the
+  // cpu reducers evaluate the reduction into a temporary buffer.
+  static const Index kMinValuesToBuffer = 16;
+
+  // Checks whether the reduced dimensions are the inner most (resp. outer
+  // most) dimensions of the input. This is only known at runtime when the
+  // reduction dimensions aren't specified as compile time constants.
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE bool reducingInnerDims() const {
+    bool reducing_inner_dims = true;
+    for (int i = 0; i < NumReducedDims; ++i) {
+      if (static_cast<int>(Layout) == static_cast<int>(ColMajor)) {
+        reducing_inner_dims &= m_reduced[i];
+      } else {
+        reducing_inner_dims &= m_reduced[NumInputDims - 1 - i];
+      }
+    }
+    return reducing_inner_dims;
+  }
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE bool preservingInnerDims() const {
+    bool preserving_inner_dims = true;
+    for (int i = 0; i < NumReducedDims; ++i) {
+      if (static_cast<int>(Layout) == static_cast<int>(ColMajor)) {
+        preserving_inner_dims &= m_reduced[NumInputDims - 1 - i];
+      } else {
+        preserving_inner_dims &= m_reduced[i];
+      }
+    }
+    return preserving_inner_dims;
+  }
+  EIGEN_STRONG_INLINE bool useInnerReducer() const {
+    return internal::InnerReducer<Self, Op, Device>::HasOptimizedImplementation &&
+           (ReducingInnerMostDims || reducingInnerDims());
+  }
+  EIGEN_STRONG_INLINE bool useOuterReducer() const {
+    return internal::OuterReducer<Self, Op, Device>::HasOptimizedImplementation &&
+           preservingInnerDims();
+  }
 
   // Returns the Index in the input tensor of the first value that needs to be
   // used to compute the reduction at output index "index".
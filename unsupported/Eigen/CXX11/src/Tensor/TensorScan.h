@@ -92,11 +92,16 @@ struct TensorEvaluator<const TensorScanOp<Op, ArgType>, Device> {
   typedef typename XprType::CoeffReturnType CoeffReturnType;
   typedef typename PacketType<CoeffReturnType, Device>::type PacketReturnType;
   typedef TensorEvaluator<const TensorScanOp<Op, ArgType>, Device> Self;
+  typedef Op Accumulator;
+  // Whether the scans of adjacent lines can be computed together with packets.
+  static const bool VectorizedScan = TensorEvaluator<ArgType, Device>::PacketAccess &&
+                                     internal::reducer_traits<Op, Device>::PacketAccess;
 
   enum {
     IsAligned = false,
     PacketAccess = (internal::unpacket_traits<PacketReturnType>::size > 1),
     BlockAccess = false,
+    PreferBlockAccess = false,
     Layout = TensorEvaluator<ArgType, Device>::Layout,
     CoordAccess = false,
     RawAccess = true
@@ -171,6 +176,15 @@ struct TensorEvaluator<const TensorScanOp<Op, ArgType>, Device> {
     return true;
   }
 
+#ifdef EIGEN_USE_THREADS
+  // The scan is evaluated synchronously.
+  template <typename EvalSubExprsCallback>
+  EIGEN_STRONG_INLINE void evalSubExprsIfNeededAsync(
+      Scalar* data, EvalSubExprsCallback done) {
+    done(evalSubExprsIfNeeded(data));
+  }
+#endif  // EIGEN_USE_THREADS
+
   template<int LoadMode>
   EIGEN_DEVICE_FUNC PacketReturnType packet(Index index) const {
     return internal::ploadt<PacketReturnType, LoadMode>(m_output + index);
@@ -208,39 +222,239 @@ protected:
   CoeffReturnType* m_output;
 };
 
+namespace internal {
+
+// Scans the line of self starting at offset.
+template <typename Self>
+EIGEN_STRONG_INLINE void ReduceScalar(Self& self, Index offset,
+                                      typename Self::CoeffReturnType* data) {
+  // Compute the scan along the axis, starting at offset
+  typename Self::Accumulator reducer = self.accumulator();
+  typename Self::CoeffReturnType accum = reducer.initialize();
+  for (Index idx3 = 0; idx3 < self.size(); idx3++) {
+    Index curr = offset + idx3 * self.stride();
+
+    if (self.exclusive()) {
+      data[curr] = reducer.finalize(accum);
+      reducer.reduce(self.inner().coeff(curr), &accum);
+    } else {
+      reducer.reduce(self.inner().coeff(curr), &accum);
+      data[curr] = reducer.finalize(accum);
+    }
+  }
+}
+
+// Scans the PacketSize adjacent lines of self starting at offset at once.
+template <typename Self>
+EIGEN_STRONG_INLINE void ReducePacket(Self& self, Index offset,
+                                      typename Self::CoeffReturnType* data) {
+  typedef typename Self::PacketReturnType Packet;
+  typename Self::Accumulator reducer = self.accumulator();
+  Packet accum = reducer.template initializePacket<Packet>();
+  for (Index idx3 = 0; idx3 < self.size(); idx3++) {
+    Index curr = offset + idx3 * self.stride();
+
+    if (self.exclusive()) {
+      internal::pstoreu<typename Self::CoeffReturnType, Packet>(data + curr, reducer.finalizePacket(accum));
+      reducer.reducePacket(self.inner().template packet<Unaligned>(curr), &accum);
+    } else {
+      reducer.reducePacket(self.inner().template packet<Unaligned>(curr), &accum);
+      internal::pstoreu<typename Self::CoeffReturnType, Packet>(data + curr, reducer.finalizePacket(accum));
+    }
+  }
+}
+
+// Scans the lines [first, last) of self, where line i starts at offset
+// (i / stride) * stride * size + i % stride. Adjacent lines are scanned
+// PacketSize at a time when the reducer and the input can be vectorized.
+template <typename Self, bool Vectorize = Self::VectorizedScan>
+struct ScanLines {
+  static void run(Self& self, Index first, Index last,
+                  typename Self::CoeffReturnType* data) {
+    const Index PacketSize = unpacket_traits<typename Self::PacketReturnType>::size;
+    const Index stride = self.stride();
+    for (Index line = first; line < last;) {
+      const Index block = line / stride;
+      const Index idx1 = block * stride * self.size();
+      Index idx2 = line - block * stride;
+      const Index end = numext::mini(stride, idx2 + (last - line));
+      for (; idx2 + PacketSize <= end; idx2 += PacketSize) {
+        ReducePacket(self, idx1 + idx2, data);
+      }
+      for (; idx2 < end; ++idx2) {
+        ReduceScalar(self, idx1 + idx2, data);
+      }
+      line = block * stride + end;
+    }
+  }
+};
+
+template <typename Self>
+struct ScanLines<Self, false> {
+  static void run(Self& self, Index first, Index last,
+                  typename Self::CoeffReturnType* data) {
+    const Index stride = self.stride();
+    for (Index line = first; line < last; ++line) {
+      const Index block = line / stride;
+      ReduceScalar(self, block * stride * self.size() + line - block * stride, data);
+    }
+  }
+};
+
+// Reduces the coefficients [first, last) of the line of self starting at
+// offset.
+template <typename Self, bool Vectorize = Self::VectorizedScan>
+struct ReduceLineBlock {
+  static typename Self::CoeffReturnType run(Self& self, Index offset, Index first, Index last) {
+    typedef typename Self::PacketReturnType Packet;
+    const Index PacketSize = unpacket_traits<Packet>::size;
+    typename Self::Accumulator reducer = self.accumulator();
+    typename Self::CoeffReturnType accum = reducer.initialize();
+    Index i = first;
+    if (self.stride() == 1) {
+      Packet paccum = reducer.template initializePacket<Packet>();
+      for (; i + PacketSize <= last; i += PacketSize) {
+        reducer.reducePacket(self.inner().template packet<Unaligned>(offset + i), &paccum);
+      }
+      accum = reducer.finalizeBoth(accum, paccum);
+    }
+    for (; i < last; ++i) {
+      reducer.reduce(self.inner().coeff(offset + i * self.stride()), &accum);
+    }
+    return accum;
+  }
+};
+
+template <typename Self>
+struct ReduceLineBlock<Self, false> {
+  static typename Self::CoeffReturnType run(Self& self, Index offset, Index first, Index last) {
+    typename Self::Accumulator reducer = self.accumulator();
+    typename Self::CoeffReturnType accum = reducer.initialize();
+    for (Index i = first; i < last; ++i) {
+      reducer.reduce(self.inner().coeff(offset + i * self.stride()), &accum);
+    }
+    return accum;
+  }
+};
+
+}  // end namespace internal
+
 // CPU implementation of scan
-// TODO(ibab) This single-threaded implementation should be parallelized,
-// at least by running multiple scans at the same time.
 template <typename Self, typename Reducer, typename Device>
 struct ScanLauncher {
   void operator()(Self& self, typename Self::CoeffReturnType *data) {
     Index total_size = internal::array_prod(self.dimensions());
+    if (total_size == 0) {
+      return;
+    }
+    internal::ScanLines<Self>::run(self, 0, total_size / self.size(), data);
+  }
+};
 
-    // We fix the index along the scan axis to 0 and perform a
-    // scan per remaining entry. The iteration is split into two nested
-    // loops to avoid an integer division by keeping track of each idx1 and idx2.
-    for (Index idx1 = 0; idx1 < total_size; idx1 += self.stride() * self.size()) {
-      for (Index idx2 = 0; idx2 < self.stride(); idx2++) {
-        // Calculate the starting offset for the scan
-        Index offset = idx1 + idx2;
+#ifdef EIGEN_USE_THREADS
+// Multithreaded implementation of scan. Independent lines are distributed
+// over the threads. When there are fewer lines than threads, each line is cut
+// into blocks scanned in two passes: the first one reduces every block, and
+// once the partial results are accumulated the second one scans every block
+// starting from the accumulation of the blocks before it. The second approach
+// only applies to reducers without state, for which reducing the partial
+// results of the blocks is equivalent to reducing the whole line.
+template <typename Self, typename Reducer>
+struct ScanLauncher<Self, Reducer, ThreadPoolDevice> {
+  typedef typename Self::CoeffReturnType CoeffReturnType;
+  typedef typename Self::PacketReturnType Packet;
+  static const Index PacketSize = internal::unpacket_traits<Packet>::size;
+  // Smallest number of coefficients scanned by a block in two passes. It is an
+  // enum since numext::maxi takes it by reference.
+  enum { kMinBlockSize = 16384 };
+
+  void operator()(Self& self, CoeffReturnType* data) {
+    const ThreadPoolDevice& device = self.device();
+    const Index total_size = internal::array_prod(self.dimensions());
+    if (total_size == 0) {
+      return;
+    }
+    const Index num_lines = total_size / self.size();
+    const int num_threads = device.numThreads();
+
+    if (!Reducer::IsStateful && num_lines < num_threads &&
+        self.size() >= 2 * kMinBlockSize) {
+      for (Index line = 0; line < num_lines; ++line) {
+        const Index block = line / self.stride();
+        scanLongLine(self, block * self.stride() * self.size() + line - block * self.stride(), data);
+      }
+      return;
+    }
 
-        // Compute the scan along the axis, starting at the calculated offset
-        typename Self::CoeffReturnType accum = self.accumulator().initialize();
-        for (Index idx3 = 0; idx3 < self.size(); idx3++) {
-          Index curr = offset + idx3 * self.stride();
+    const double cost_per_line = static_cast<double>(self.size());
+    const TensorOpCost cost(cost_per_line * sizeof(CoeffReturnType),
+                            cost_per_line * sizeof(CoeffReturnType),
+                            cost_per_line * internal::reducer_traits<Reducer, ThreadPoolDevice>::Cost);
+    device.parallelFor(num_lines, cost,
+                       [](Index block_size) -> Index {
+                         return Self::VectorizedScan ? divup(block_size, PacketSize) * PacketSize : block_size;
+                       },
+                       [&self, data](Index first, Index last) {
+                         internal::ScanLines<Self>::run(self, first, last, data);
+                       });
+  }
 
+ private:
+  void scanLongLine(Self& self, Index offset, CoeffReturnType* data) {
+    const ThreadPoolDevice& device = self.device();
+    const Index size = self.size();
+    const Index stride = self.stride();
+    const Index block_size = numext::maxi<Index>(
+        kMinBlockSize, divup<Index>(size, 4 * device.numThreads()));
+    const Index num_blocks = divup(size, block_size);
+
+    // First pass: reduce each block.
+    CoeffReturnType* partial = static_cast<CoeffReturnType*>(
+        device.allocate(num_blocks * sizeof(CoeffReturnType)));
+    Barrier barrier(static_cast<unsigned int>(num_blocks));
+    for (Index b = 0; b < num_blocks; ++b) {
+      device.enqueue_with_barrier(&barrier, [&self, offset, size, block_size, partial, b]() {
+        const Index first = b * block_size;
+        const Index last = numext::mini(size, first + block_size);
+        partial[b] = internal::ReduceLineBlock<Self>::run(self, offset, first, last);
+      });
+    }
+    barrier.Wait();
+
+    // Accumulate the partial results into the prefix of each block.
+    Reducer reducer = self.accumulator();
+    CoeffReturnType accum = reducer.initialize();
+    for (Index b = 0; b < num_blocks; ++b) {
+      const CoeffReturnType block_accum = partial[b];
+      partial[b] = accum;
+      reducer.reduce(block_accum, &accum);
+    }
+
+    // Second pass: scan each block starting from its prefix.
+    Barrier barrier2(static_cast<unsigned int>(num_blocks));
+    for (Index b = 0; b < num_blocks; ++b) {
+      device.enqueue_with_barrier(&barrier2, [&self, offset, stride, size, block_size, partial, b, data]() {
+        const Index first = b * block_size;
+        const Index last = numext::mini(size, first + block_size);
+        Reducer reducer = self.accumulator();
+        CoeffReturnType accum = partial[b];
+        for (Index i = first; i < last; ++i) {
+          const Index curr = offset + i * stride;
           if (self.exclusive()) {
-            data[curr] = self.accumulator().finalize(accum);
-            self.accumulator().reduce(self.inner().coeff(curr), &accum);
+            data[curr] = reducer.finalize(accum);
+            reducer.reduce(self.inner().coeff(curr), &accum);
           } else {
-            self.accumulator().reduce(self.inner().coeff(curr), &accum);
-            data[curr] = self.accumulator().finalize(accum);
+            reducer.reduce(self.inner().coeff(curr), &accum);
+            data[curr] = reducer.finalize(accum);
           }
         }
-      }
+      });
     }
+    barrier2.Wait();
+    device.deallocate(partial);
   }
 };
+#endif  // EIGEN_USE_THREADS
 
 #if defined(EIGEN_USE_GPU) && defined(EIGEN_CUDACC)
 
@@ -112,6 +112,8 @@ struct TensorEvaluator<const TensorShufflingOp<Shuffle, ArgType>, Device>
   enum {
     IsAligned = false,
     PacketAccess = (internal::packet_traits<Scalar>::size > 1),
+    BlockAccess = TensorEvaluator<ArgType, Device>::BlockAccess,
+    PreferBlockAccess = true,
     Layout = TensorEvaluator<ArgType, Device>::Layout,
     CoordAccess = false,  // to be implemented
     RawAccess = false
@@ -146,6 +148,7 @@ struct TensorEvaluator<const TensorShufflingOp<Shuffle, ArgType>, Device>
 
     for (int i = 0; i < NumDims; ++i) {
       m_inputStrides[i] = inputStrides[shuffle[i]];
+      m_unshuffledInputStrides[i] = inputStrides[i];
     }
   }
 
@@ -155,6 +158,15 @@ struct TensorEvaluator<const TensorShufflingOp<Shuffle, ArgType>, Device>
     m_impl.evalSubExprsIfNeeded(NULL);
     return true;
   }
+
+#ifdef EIGEN_USE_THREADS
+  template <typename EvalSubExprsCallback>
+  EIGEN_STRONG_INLINE void evalSubExprsIfNeededAsync(
+      Scalar*, EvalSubExprsCallback done) {
+    m_impl.evalSubExprsIfNeededAsync(NULL, [done](bool) { done(true); });
+  }
+#endif  // EIGEN_USE_THREADS
+
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void cleanup() {
     m_impl.cleanup();
   }
@@ -186,6 +198,31 @@ struct TensorEvaluator<const TensorShufflingOp<Shuffle, ArgType>, Device>
            TensorOpCost(0, 0, compute_cost, false /* vectorized */, PacketSize);
   }
 
+  EIGEN_STRONG_INLINE void getResourceRequirements(internal::TensorOpResourceRequirements* resources) const {
+    // Tiles that are square-ish in every dimension keep both the reads and
+    // the writes of the transposition in cache.
+    resources->merge(internal::kUniformAllDims, 0);
+    m_impl.getResourceRequirements(resources);
+  }
+
+  // The argument block is evaluated directly in the output buffer, with the
+  // strides of the output block permuted.
+  template <typename OutputTensorBlock>
+  EIGEN_STRONG_INLINE void block(OutputTensorBlock* output_block) const {
+    typename OutputTensorBlock::Dimensions input_block_sizes;
+    typename OutputTensorBlock::Dimensions input_block_strides;
+    typename OutputTensorBlock::Dimensions input_tensor_strides;
+    for (int i = 0; i < NumDims; ++i) {
+      input_block_sizes[m_shuffle[i]] = output_block->block_sizes()[i];
+      input_block_strides[m_shuffle[i]] = output_block->block_strides()[i];
+      input_tensor_strides[i] = m_unshuffledInputStrides[i];
+    }
+    OutputTensorBlock input_block(srcCoeff(output_block->first_coeff_index()),
+                                  input_block_sizes, input_block_strides,
+                                  input_tensor_strides, output_block->data());
+    m_impl.block(&input_block);
+  }
+
   EIGEN_DEVICE_FUNC typename Eigen::internal::traits<XprType>::PointerType data() const { return NULL; }
 
   // required by sycl
@@ -215,6 +252,7 @@ struct TensorEvaluator<const TensorShufflingOp<Shuffle, ArgType>, Device>
   Dimensions m_dimensions;
   array<Index, NumDims> m_outputStrides;
   array<Index, NumDims> m_inputStrides;
+  array<Index, NumDims> m_unshuffledInputStrides;
   TensorEvaluator<ArgType, Device> m_impl;
   /// required by sycl
   Shuffle m_shuffle;
@@ -240,6 +278,8 @@ struct TensorEvaluator<TensorShufflingOp<Shuffle, ArgType>, Device>
   enum {
     IsAligned = false,
     PacketAccess = (internal::packet_traits<Scalar>::size > 1),
+    BlockAccess = false,
+    PreferBlockAccess = false,
     RawAccess = false
   };
 
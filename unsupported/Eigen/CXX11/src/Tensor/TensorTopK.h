@@ -0,0 +1,380 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_CXX11_TENSOR_TENSOR_TOP_K_H
+#define EIGEN_CXX11_TENSOR_TENSOR_TOP_K_H
+
+namespace Eigen {
+
+/** \class TensorTopK
+  * \ingroup CXX11_Tensor_Module
+  *
+  * \brief Tensor top-k class.
+  *
+  * Selects the k largest coefficients along a dimension. The result has the
+  * dimensions of the input, except for the selected dimension which has k
+  * coefficients: tuples made of the index of the coefficient along the
+  * dimension and of its value, sorted by decreasing value. Coefficients with
+  * the same value are ordered by increasing index.
+  */
+namespace internal {
+template<typename XprType>
+struct traits<TensorTopKOp<XprType> > : public traits<XprType>
+{
+  typedef traits<XprType> XprTraits;
+  typedef typename XprTraits::StorageKind StorageKind;
+  typedef typename XprTraits::Index Index;
+  typedef Tuple<Index, typename XprTraits::Scalar> Scalar;
+  typedef typename XprType::Nested Nested;
+  typedef typename remove_reference<Nested>::type _Nested;
+  static const int NumDimensions = XprTraits::NumDimensions;
+  static const int Layout = XprTraits::Layout;
+};
+
+template<typename XprType>
+struct eval<TensorTopKOp<XprType>, Eigen::Dense>
+{
+  typedef const TensorTopKOp<XprType>& type;
+};
+
+template<typename XprType>
+struct nested<TensorTopKOp<XprType>, 1, typename eval<TensorTopKOp<XprType> >::type>
+{
+  typedef TensorTopKOp<XprType> type;
+};
+
+}  // end namespace internal
+
+
+template<typename XprType>
+class TensorTopKOp : public TensorBase<TensorTopKOp<XprType>, ReadOnlyAccessors>
+{
+  public:
+  typedef typename Eigen::internal::traits<TensorTopKOp>::Scalar Scalar;
+  typedef typename Eigen::NumTraits<Scalar>::Real RealScalar;
+  typedef typename Eigen::internal::nested<TensorTopKOp>::type Nested;
+  typedef typename Eigen::internal::traits<TensorTopKOp>::StorageKind StorageKind;
+  typedef typename Eigen::internal::traits<TensorTopKOp>::Index Index;
+  typedef Tuple<Index, typename XprType::CoeffReturnType> CoeffReturnType;
+
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE TensorTopKOp(const XprType& expr, const Index k, const Index dim)
+      : m_xpr(expr), m_k(k), m_dim(dim) {}
+
+  EIGEN_DEVICE_FUNC
+  const typename internal::remove_all<typename XprType::Nested>::type&
+  expression() const { return m_xpr; }
+
+  EIGEN_DEVICE_FUNC
+  Index k() const { return m_k; }
+
+  EIGEN_DEVICE_FUNC
+  Index dim() const { return m_dim; }
+
+  protected:
+    typename XprType::Nested m_xpr;
+    const Index m_k;
+    const Index m_dim;
+};
+
+
+namespace internal {
+
+// Selects the k largest coefficients of the lines [firstLine, lastLine) along
+// the top-k dimension. A heap holds the k best coefficients seen so far, its
+// top being the worst of them: a new coefficient is only inserted if it beats
+// the top of the heap.
+template <typename Self, bool Vectorizable = Self::VectorizedSelection>
+struct TopKLines {
+  typedef typename Self::Index Index;
+  typedef typename Self::CoeffReturnType TupleType;
+  typedef typename Self::InputScalar Scalar;
+
+  static void run(const Self& self, Index firstLine, Index lastLine, TupleType* output) {
+    MaxSizeVector<TupleType> heap(self.m_k);
+    for (Index line = firstLine; line < lastLine; ++line) {
+      Index input;
+      Index out;
+      self.lineOffsets(line, &input, &out);
+      initHeap(self, input, heap);
+      for (Index j = self.m_k; j < self.m_size; ++j) {
+        insert(self, heap, j, self.m_impl.coeff(input + j * self.m_stride));
+      }
+      writeLine(self, heap, output + out);
+    }
+  }
+
+  // Whether a is ranked before b in the result.
+  static EIGEN_STRONG_INLINE bool better(const TupleType& a, const TupleType& b) {
+    return a.second > b.second || (a.second == b.second && a.first < b.first);
+  }
+
+  static void initHeap(const Self& self, Index input, MaxSizeVector<TupleType>& heap) {
+    heap.resize(0);
+    for (Index j = 0; j < self.m_k; ++j) {
+      heap.push_back(TupleType(j, self.m_impl.coeff(input + j * self.m_stride)));
+    }
+    std::make_heap(heap.begin(), heap.end(), better);
+  }
+
+  // Coefficients are visited by increasing index, so a coefficient equal to
+  // the top of the heap is never inserted.
+  static EIGEN_STRONG_INLINE void insert(const Self&, MaxSizeVector<TupleType>& heap,
+                                         Index j, const Scalar& value) {
+    if (value > heap[0].second) {
+      std::pop_heap(heap.begin(), heap.end(), better);
+      heap.back() = TupleType(j, value);
+      std::push_heap(heap.begin(), heap.end(), better);
+    }
+  }
+
+  static void writeLine(const Self& self, MaxSizeVector<TupleType>& heap, TupleType* output) {
+    std::sort_heap(heap.begin(), heap.end(), better);
+    for (Index j = 0; j < self.m_k; ++j) {
+      output[j * self.m_stride] = heap[j];
+    }
+  }
+};
+
+// Vectorized version, used when the top-k dimension is the inner most one.
+// Since most coefficients don't make it into the heap once it is filled with
+// good candidates, whole packets are skipped when none of their coefficients
+// beats the top of the heap.
+template <typename Self>
+struct TopKLines<Self, true> {
+  typedef typename Self::Index Index;
+  typedef typename Self::CoeffReturnType TupleType;
+  typedef typename Self::InputScalar Scalar;
+  typedef typename Self::InputPacket Packet;
+  typedef TopKLines<Self, false> ScalarLines;
+  static const Index PacketSize = unpacket_traits<Packet>::size;
+
+  static void run(const Self& self, Index firstLine, Index lastLine, TupleType* output) {
+    if (self.m_stride != 1) {
+      ScalarLines::run(self, firstLine, lastLine, output);
+      return;
+    }
+    MaxSizeVector<TupleType> heap(self.m_k);
+    for (Index line = firstLine; line < lastLine; ++line) {
+      Index input;
+      Index out;
+      self.lineOffsets(line, &input, &out);
+      ScalarLines::initHeap(self, input, heap);
+      Index j = self.m_k;
+      for (; j + 4 * PacketSize <= self.m_size; j += 4 * PacketSize) {
+        const Packet p0 = self.m_impl.template packet<Unaligned>(input + j);
+        const Packet p1 = self.m_impl.template packet<Unaligned>(input + j + PacketSize);
+        const Packet p2 = self.m_impl.template packet<Unaligned>(input + j + 2 * PacketSize);
+        const Packet p3 = self.m_impl.template packet<Unaligned>(input + j + 3 * PacketSize);
+        const Packet best = pmax<Packet>(pmax<Packet>(p0, p1), pmax<Packet>(p2, p3));
+        if (!(predux_max<Packet>(best) > heap[0].second)) {
+          continue;
+        }
+        for (Index i = j; i < j + 4 * PacketSize; ++i) {
+          ScalarLines::insert(self, heap, i, self.m_impl.coeff(input + i));
+        }
+      }
+      for (; j < self.m_size; ++j) {
+        ScalarLines::insert(self, heap, j, self.m_impl.coeff(input + j));
+      }
+      ScalarLines::writeLine(self, heap, output + out);
+    }
+  }
+};
+
+template <typename Self, typename Device>
+struct TopKLauncher {
+  typedef typename Self::Index Index;
+  typedef typename Self::CoeffReturnType TupleType;
+
+  static void run(const Self& self, const Device&, TupleType* output) {
+    TopKLines<Self>::run(self, 0, self.m_numLines, output);
+  }
+
+#ifdef EIGEN_USE_THREADS
+  template <typename DoneCallback>
+  static void runAsync(const Self& self, const Device& device, TupleType* output,
+                       DoneCallback done) {
+    run(self, device, output);
+    done();
+  }
+#endif  // EIGEN_USE_THREADS
+};
+
+#ifdef EIGEN_USE_THREADS
+// Multithreaded version: the lines are distributed over the threads.
+template <typename Self>
+struct TopKLauncher<Self, ThreadPoolDevice> {
+  typedef typename Self::Index Index;
+  typedef typename Self::CoeffReturnType TupleType;
+
+  static void run(const Self& self, const ThreadPoolDevice& device, TupleType* output) {
+    device.parallelFor(self.m_numLines, self.lineCost(),
+                       [&self, output](Index first, Index last) {
+                         TopKLines<Self>::run(self, first, last, output);
+                       });
+  }
+
+  template <typename DoneCallback>
+  static void runAsync(const Self& self, const ThreadPoolDevice& device,
+                       TupleType* output, DoneCallback done) {
+    const Self* self_ptr = &self;
+    device.parallelForAsync(self.m_numLines, self.lineCost(),
+                            [self_ptr, output](Index first, Index last) {
+                              TopKLines<Self>::run(*self_ptr, first, last, output);
+                            },
+                            std::move(done));
+  }
+};
+#endif  // EIGEN_USE_THREADS
+
+}  // end namespace internal
+
+
+// Eval as rvalue
+template<typename ArgType, typename Device>
+struct TensorEvaluator<const TensorTopKOp<ArgType>, Device>
+{
+  typedef TensorTopKOp<ArgType> XprType;
+  typedef typename XprType::Index Index;
+  typedef typename XprType::Scalar Scalar;
+  typedef typename XprType::CoeffReturnType CoeffReturnType;
+  typedef typename TensorEvaluator<ArgType, Device>::Dimensions InputDimensions;
+  static const int NumDims = internal::array_size<InputDimensions>::value;
+  typedef DSizes<Index, NumDims> Dimensions;
+  typedef typename TensorEvaluator<ArgType, Device>::CoeffReturnType InputScalar;
+  typedef typename TensorEvaluator<ArgType, Device>::PacketReturnType InputPacket;
+
+  enum {
+    IsAligned = false,
+    PacketAccess = false,
+    BlockAccess = false,
+    PreferBlockAccess = false,
+    Layout = TensorEvaluator<ArgType, Device>::Layout,
+    CoordAccess = false,  // to be implemented
+    RawAccess = false
+  };
+
+  // Packets are only used to skip coefficients that can't make it into the
+  // result, which requires a vectorized max.
+  static const bool VectorizedSelection = TensorEvaluator<ArgType, Device>::PacketAccess &&
+                                          internal::packet_traits<InputScalar>::HasMax;
+
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE TensorEvaluator(const XprType& op, const Device& device)
+      : m_impl(op.expression(), device), m_k(op.k()), m_result(NULL), m_device(device)
+  {
+    const Index dim = op.dim();
+    eigen_assert(dim >= 0 && dim < NumDims && "Selecting along a dimension outside of the rank");
+    const InputDimensions& input_dims = m_impl.dimensions();
+    m_size = input_dims[dim];
+    eigen_assert(m_k >= 0 && m_k <= m_size && "Selecting more coefficients than the dimension holds");
+
+    m_stride = 1;
+    if (static_cast<int>(Layout) == static_cast<int>(ColMajor)) {
+      for (int i = 0; i < dim; ++i) {
+        m_stride *= input_dims[i];
+      }
+    } else {
+      for (int i = NumDims - 1; i > dim; --i) {
+        m_stride *= input_dims[i];
+      }
+    }
+
+    for (int i = 0; i < NumDims; ++i) {
+      m_dimensions[i] = input_dims[i];
+    }
+    m_dimensions[dim] = m_k;
+    m_numLines = m_size > 0 ? internal::array_prod(input_dims) / m_size : 0;
+  }
+
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE const Dimensions& dimensions() const { return m_dimensions; }
+
+  EIGEN_STRONG_INLINE bool evalSubExprsIfNeeded(CoeffReturnType* data) {
+    m_impl.evalSubExprsIfNeeded(NULL);
+    if (m_k == 0) {
+      return false;
+    }
+    if (!data) {
+      m_result = static_cast<CoeffReturnType*>(m_device.allocate(m_dimensions.TotalSize() * sizeof(CoeffReturnType)));
+      data = m_result;
+    }
+    internal::TopKLauncher<Self, Device>::run(*this, m_device, data);
+    return (m_result != NULL);
+  }
+
+#ifdef EIGEN_USE_THREADS
+  template <typename EvalSubExprsCallback>
+  EIGEN_STRONG_INLINE void evalSubExprsIfNeededAsync(
+      CoeffReturnType* data, EvalSubExprsCallback done) {
+    m_impl.evalSubExprsIfNeededAsync(NULL, [this, data, done](bool) {
+      if (m_k == 0) {
+        done(false);
+        return;
+      }
+      CoeffReturnType* output = data;
+      if (!output) {
+        m_result = static_cast<CoeffReturnType*>(m_device.allocate(m_dimensions.TotalSize() * sizeof(CoeffReturnType)));
+        output = m_result;
+      }
+      const bool need_assign = (m_result != NULL);
+      internal::TopKLauncher<Self, Device>::runAsync(
+          *this, m_device, output, [done, need_assign]() { done(need_assign); });
+    });
+  }
+#endif  // EIGEN_USE_THREADS
+
+  EIGEN_STRONG_INLINE void cleanup() {
+    m_impl.cleanup();
+    if (m_result) {
+      m_device.deallocate(m_result);
+      m_result = NULL;
+    }
+  }
+
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE CoeffReturnType coeff(Index index) const {
+    return m_result[index];
+  }
+
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE TensorOpCost costPerCoeff(bool vectorized) const {
+    return TensorOpCost(sizeof(CoeffReturnType), 0, 0, vectorized, 1);
+  }
+
+  EIGEN_DEVICE_FUNC CoeffReturnType* data() const { return m_result; }
+
+ private:
+  typedef TensorEvaluator<const TensorTopKOp<ArgType>, Device> Self;
+  template <typename, bool> friend struct internal::TopKLines;
+  template <typename, typename> friend struct internal::TopKLauncher;
+
+  // Offsets of the first coefficient of a line in the input and in the output.
+  EIGEN_STRONG_INLINE void lineOffsets(Index line, Index* input, Index* output) const {
+    const Index outer = line / m_stride;
+    const Index inner = line - outer * m_stride;
+    *input = outer * m_stride * m_size + inner;
+    *output = outer * m_stride * m_k + inner;
+  }
+
+  // Cost of selecting the top k coefficients of one line.
+  TensorOpCost lineCost() const {
+    const double size = static_cast<double>(m_size);
+    const double k = static_cast<double>(m_k);
+    return size * (m_impl.costPerCoeff(false) + TensorOpCost(0, 0, TensorOpCost::AddCost<InputScalar>())) +
+           TensorOpCost(0, k * sizeof(CoeffReturnType), k * numext::log(k + 1) * TensorOpCost::AddCost<InputScalar>());
+  }
+
+  TensorEvaluator<ArgType, Device> m_impl;
+  Dimensions m_dimensions;
+  Index m_k;
+  Index m_size;
+  Index m_stride;
+  Index m_numLines;
+  CoeffReturnType* m_result;
+  const Device& m_device;
+};
+
+} // end namespace Eigen
+
+#endif // EIGEN_CXX11_TENSOR_TENSOR_TOP_K_H
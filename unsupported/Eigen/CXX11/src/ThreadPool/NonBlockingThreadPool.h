@@ -24,12 +24,23 @@ class NonBlockingThreadPoolTempl : public Eigen::ThreadPoolInterface {
 
   NonBlockingThreadPoolTempl(int num_threads, bool allow_spinning,
                              Environment env = Environment())
+      : NonBlockingThreadPoolTempl(num_threads, ThreadTopology(), kNoAffinity,
+                                   allow_spinning, env) {}
+
+  // Builds a pool whose threads are split into one group per NUMA node of the
+  // topology, proportionally to the number of cpus of each node. Idle threads
+  // first try to steal work from the threads of their own node, and only then
+  // from the other nodes. The affinity controls whether the threads are
+  // pinned to the cpus of their node.
+  NonBlockingThreadPoolTempl(int num_threads, const ThreadTopology& topology,
+                             ThreadAffinity affinity,
+                             bool allow_spinning = true,
+                             Environment env = Environment())
       : env_(env),
         num_threads_(num_threads),
         allow_spinning_(allow_spinning),
         threads_(num_threads),
         queues_(num_threads),
-        coprimes_(num_threads),
         waiters_(num_threads),
         blocked_(0),
         spinning_(0),
@@ -38,25 +49,17 @@ class NonBlockingThreadPoolTempl : public Eigen::ThreadPoolInterface {
         ec_(waiters_) {
     waiters_.resize(num_threads_);
 
-    // Calculate coprimes of num_threads_.
-    // Coprimes are used for a random walk over all threads in Steal
-    // and NonEmptyQueueIndex. Iteration is based on the fact that if we take
-    // a walk starting thread index t and calculate num_threads - 1 subsequent
-    // indices as (t + coprime) % num_threads, we will cover all threads without
+    AssignNodes(topology, affinity);
+    // Calculate the coprimes of the sizes of the pool and of its nodes.
+    // Coprimes are used for a random walk over the threads of a partition in
+    // Steal and NonEmptyQueueIndex. Iteration is based on the fact that if we
+    // take a walk starting thread index t and calculate size - 1 subsequent
+    // indices as (t + coprime) % size, we will cover all threads without
     // repetitions (effectively getting a presudo-random permutation of thread
     // indices).
-    for (int i = 1; i <= num_threads_; i++) {
-      unsigned a = i;
-      unsigned b = num_threads_;
-      // If GCD(a, b) == 1, then a and b are coprimes.
-      while (b != 0) {
-        unsigned tmp = a;
-        a = b;
-        b = tmp % b;
-      }
-      if (a == 1) {
-        coprimes_.push_back(i);
-      }
+    ComputeCoprimes(num_threads_);
+    for (size_t node = 0; node < nodes_.size(); node++) {
+      ComputeCoprimes(nodes_[node].limit - nodes_[node].start);
     }
     for (int i = 0; i < num_threads_; i++) {
       queues_.push_back(new Queue());
@@ -88,16 +91,21 @@ class NonBlockingThreadPoolTempl : public Eigen::ThreadPoolInterface {
   }
 
   void Schedule(std::function<void()> fn) {
+    ScheduleWithHint(std::move(fn), 0, num_threads_);
+  }
+
+  void ScheduleWithHint(std::function<void()> fn, int start, int limit) {
+    eigen_assert(0 <= start && start < limit && limit <= num_threads_);
     Task t = env_.CreateTask(std::move(fn));
     PerThread* pt = GetPerThread();
-    if (pt->pool == this) {
+    if (pt->pool == this && start <= pt->thread_id && pt->thread_id < limit) {
       // Worker thread of this pool, push onto the thread's queue.
       Queue* q = queues_[pt->thread_id];
       t = q->PushFront(std::move(t));
     } else {
-      // A free-standing thread (or worker of another pool), push onto a random
-      // queue.
-      Queue* q = queues_[Rand(&pt->rand) % queues_.size()];
+      // A free-standing thread (or worker of another pool, or of another
+      // node), push onto a random queue of the requested range.
+      Queue* q = queues_[start + Rand(&pt->rand) % (limit - start)];
       t = q->PushBack(std::move(t));
     }
     // Note: below we touch this after making w available to worker threads.
@@ -130,10 +138,34 @@ class NonBlockingThreadPoolTempl : public Eigen::ThreadPoolInterface {
     ec_.Notify(true);
   }
 
+  // Submits a closure to be run preferably by the threads of a NUMA node.
+  void ScheduleOnNode(std::function<void()> fn, int node) {
+    eigen_assert(0 <= node && node < NumNodes());
+    const Partition& p = nodes_[node];
+    if (p.start < p.limit) {
+      ScheduleWithHint(std::move(fn), p.start, p.limit);
+    } else {
+      // No thread was assigned to this node.
+      Schedule(std::move(fn));
+    }
+  }
+
   int NumThreads() const final {
     return num_threads_;
   }
 
+  int NumNodes() const {
+    return static_cast<int>(nodes_.size());
+  }
+
+  // Returns the range of threads [*start, *limit) of a NUMA node. The range is
+  // empty if the pool has fewer threads than nodes.
+  void NodeThreads(int node, int* start, int* limit) const {
+    eigen_assert(0 <= node && node < NumNodes());
+    *start = nodes_[node].start;
+    *limit = nodes_[node].limit;
+  }
+
   int CurrentThreadId() const final {
     const PerThread* pt =
         const_cast<NonBlockingThreadPoolTempl*>(this)->GetPerThread();
@@ -147,6 +179,14 @@ class NonBlockingThreadPoolTempl : public Eigen::ThreadPoolInterface {
  private:
   typedef typename Environment::EnvThread Thread;
 
+  // A range of threads [start, limit).
+  struct Partition {
+    Partition() : start(0), limit(0) {}
+    Partition(int s, int l) : start(s), limit(l) {}
+    int start;
+    int limit;
+  };
+
   struct PerThread {
     constexpr PerThread() : pool(NULL), rand(0), thread_id(-1) { }
     NonBlockingThreadPoolTempl* pool;  // Parent pool, or null for normal threads.
@@ -159,7 +199,10 @@ class NonBlockingThreadPoolTempl : public Eigen::ThreadPoolInterface {
   const bool allow_spinning_;
   MaxSizeVector<Thread*> threads_;
   MaxSizeVector<Queue*> queues_;
-  MaxSizeVector<unsigned> coprimes_;
+  std::map<unsigned, std::vector<unsigned> > coprimes_;  // Keyed by partition size.
+  std::vector<Partition> nodes_;  // Threads of each NUMA node.
+  std::vector<Partition> partitions_;  // Threads of the node of each thread.
+  std::vector<std::vector<int> > thread_cpus_;  // Cpus each thread is pinned to.
   MaxSizeVector<EventCount::Waiter> waiters_;
   std::atomic<unsigned> blocked_;
   std::atomic<bool> spinning_;
@@ -167,8 +210,63 @@ class NonBlockingThreadPoolTempl : public Eigen::ThreadPoolInterface {
   std::atomic<bool> cancelled_;
   EventCount ec_;
 
+  void ComputeCoprimes(unsigned size) {
+    std::vector<unsigned>& coprimes = coprimes_[size];
+    if (size == 0 || !coprimes.empty()) {
+      return;
+    }
+    for (unsigned i = 1; i <= size; i++) {
+      unsigned a = i;
+      unsigned b = size;
+      // If GCD(a, b) == 1, then a and b are coprimes.
+      while (b != 0) {
+        unsigned tmp = a;
+        a = b;
+        b = tmp % b;
+      }
+      if (a == 1) {
+        coprimes.push_back(i);
+      }
+    }
+  }
+
+  // Splits the threads into contiguous groups, one per node, proportionally
+  // to the number of cpus of the nodes.
+  void AssignNodes(const ThreadTopology& topology, ThreadAffinity affinity) {
+    partitions_.assign(num_threads_, Partition(0, num_threads_));
+    thread_cpus_.resize(num_threads_);
+    const int num_cpus = topology.NumCpus();
+    if (num_cpus == 0) {
+      nodes_.push_back(Partition(0, num_threads_));
+      return;
+    }
+    int cpus_before = 0;
+    for (int node = 0; node < topology.NumNodes(); node++) {
+      const std::vector<int>& cpus = topology.nodes[node];
+      const int start =
+          static_cast<int>(int64_t(num_threads_) * cpus_before / num_cpus);
+      cpus_before += static_cast<int>(cpus.size());
+      const int limit =
+          static_cast<int>(int64_t(num_threads_) * cpus_before / num_cpus);
+      nodes_.push_back(Partition(start, limit));
+      for (int i = start; i < limit; i++) {
+        partitions_[i] = Partition(start, limit);
+        if (affinity == kNodeAffinity) {
+          thread_cpus_[i] = cpus;
+        } else if (affinity == kCpuAffinity && !cpus.empty()) {
+          thread_cpus_[i].push_back(cpus[(i - start) % cpus.size()]);
+        }
+      }
+    }
+  }
+
   // Main worker thread loop.
   void WorkerLoop(int thread_id) {
+    if (!thread_cpus_[thread_id].empty()) {
+      // Pinning is best effort, keep running wherever the OS put us if it
+      // failed.
+      SetCurrentThreadAffinity(thread_cpus_[thread_id]);
+    }
     PerThread* pt = GetPerThread();
     pt->pool = this;
     pt->rand = std::hash<std::thread::id>()(std::this_thread::get_id());
@@ -236,14 +334,28 @@ class NonBlockingThreadPoolTempl : public Eigen::ThreadPoolInterface {
   }
 
   // Steal tries to steal work from other worker threads in best-effort manner.
+  // The threads of the same node are tried first.
   Task Steal() {
     PerThread* pt = GetPerThread();
-    const size_t size = queues_.size();
+    const Partition& local = partitions_[pt->thread_id];
+    if (local.limit - local.start < num_threads_) {
+      Task t = Steal(local.start, local.limit);
+      if (t.f) {
+        return t;
+      }
+    }
+    return Steal(0, num_threads_);
+  }
+
+  Task Steal(unsigned start, unsigned limit) {
+    PerThread* pt = GetPerThread();
+    const unsigned size = limit - start;
+    const std::vector<unsigned>& coprimes = coprimes_.find(size)->second;
     unsigned r = Rand(&pt->rand);
-    unsigned inc = coprimes_[r % coprimes_.size()];
+    unsigned inc = coprimes[r % coprimes.size()];
     unsigned victim = r % size;
     for (unsigned i = 0; i < size; i++) {
-      Task t = queues_[victim]->PopBack();
+      Task t = queues_[start + victim]->PopBack();
       if (t.f) {
         return t;
       }
@@ -307,8 +419,9 @@ class NonBlockingThreadPoolTempl : public Eigen::ThreadPoolInterface {
   int NonEmptyQueueIndex() {
     PerThread* pt = GetPerThread();
     const size_t size = queues_.size();
+    const std::vector<unsigned>& coprimes = coprimes_.find(size)->second;
     unsigned r = Rand(&pt->rand);
-    unsigned inc = coprimes_[r % coprimes_.size()];
+    unsigned inc = coprimes[r % coprimes.size()];
     unsigned victim = r % size;
     for (unsigned i = 0; i < size; i++) {
       if (!queues_[victim]->Empty()) {
@@ -0,0 +1,73 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2018 Eigen contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_CXX11_THREADPOOL_THREAD_POOL_GEMM_BACKEND_H
+#define EIGEN_CXX11_THREADPOOL_THREAD_POOL_GEMM_BACKEND_H
+
+#ifdef EIGEN_GEMM_THREADPOOL
+
+namespace Eigen {
+
+// Runs the large dense matrix products of Eigen/Core on the threads of a
+// ThreadPoolInterface instead of OpenMP:
+//
+//   Eigen::ThreadPool pool(8);
+//   Eigen::ThreadPoolGemmBackend backend(&pool);
+//   Eigen::setGemmParallelBackend(&backend);             // for all threads
+//   Eigen::ScopedGemmParallelBackend scope(&backend);    // or for this scope
+//
+// The threads of a product busy-wait on each other to share the packed lhs
+// panels, so the backend only runs one product at a time: a product started
+// while the pool is already busy with another one is computed sequentially by
+// the calling thread. Products started from one of the threads of the pool are
+// also computed sequentially.
+class ThreadPoolGemmBackend : public GemmParallelBackend {
+ public:
+  explicit ThreadPoolGemmBackend(ThreadPoolInterface* pool)
+      : pool_(pool), busy_(false) {}
+
+  int numThreads() const { return pool_->NumThreads(); }
+
+  bool isWorkerThread() const { return pool_->CurrentThreadId() != -1; }
+
+  bool run(int n, const std::function<void(int)>& task) {
+    eigen_assert(n <= numThreads());
+    bool expected = false;
+    if (!busy_.compare_exchange_strong(expected, true)) return false;
+
+    std::mutex mu;
+    std::condition_variable done;
+    int pending = n - 1;
+    for (int i = 1; i < n; ++i) {
+      pool_->Schedule([&, i]() {
+        task(i);
+        std::unique_lock<std::mutex> l(mu);
+        if (--pending == 0) done.notify_all();
+      });
+    }
+    task(0);
+    {
+      std::unique_lock<std::mutex> l(mu);
+      while (pending != 0) done.wait(l);
+    }
+
+    busy_ = false;
+    return true;
+  }
+
+ private:
+  ThreadPoolInterface* pool_;
+  std::atomic<bool> busy_;
+};
+
+}  // namespace Eigen
+
+#endif  // EIGEN_GEMM_THREADPOOL
+
+#endif  // EIGEN_CXX11_THREADPOOL_THREAD_POOL_GEMM_BACKEND_H
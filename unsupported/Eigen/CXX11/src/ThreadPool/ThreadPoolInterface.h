@@ -19,6 +19,15 @@ class ThreadPoolInterface {
   // Submits a closure to be run by a thread in the pool.
   virtual void Schedule(std::function<void()> fn) = 0;
 
+  // Submits a closure to be run preferably by one of the threads in
+  // [start, limit). This is only a hint: pools that don't support it just
+  // call Schedule, and the closure may still be stolen by another thread.
+  virtual void ScheduleWithHint(std::function<void()> fn, int start, int limit) {
+    EIGEN_UNUSED_VARIABLE(start);
+    EIGEN_UNUSED_VARIABLE(limit);
+    Schedule(std::move(fn));
+  }
+
   // If implemented, stop processing the closures that have been enqueued.
   // Currently running closures may still be processed.
   // If not implemented, does nothing.
@@ -0,0 +1,116 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_CXX11_THREADPOOL_THREAD_TOPOLOGY_H
+#define EIGEN_CXX11_THREADPOOL_THREAD_TOPOLOGY_H
+
+namespace Eigen {
+
+// How the worker threads of a pool are bound to the cpus of the machine.
+enum ThreadAffinity {
+  kNoAffinity,    // Let the OS schedule the threads anywhere.
+  kNodeAffinity,  // Bind each thread to the cpus of its NUMA node.
+  kCpuAffinity    // Bind each thread to a single cpu of its NUMA node.
+};
+
+// The NUMA layout of the machine, as the list of logical cpus of each node.
+struct ThreadTopology {
+  std::vector<std::vector<int> > nodes;
+
+  int NumNodes() const { return static_cast<int>(nodes.size()); }
+
+  int NumCpus() const {
+    int num_cpus = 0;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      num_cpus += static_cast<int>(nodes[i].size());
+    }
+    return num_cpus;
+  }
+
+  // Reads the NUMA nodes from /sys on Linux. Returns a single node with all the
+  // cpus when the information is not available.
+  static ThreadTopology Detect() {
+    ThreadTopology topology;
+#if EIGEN_OS_LINUX
+    for (int node = 0;; ++node) {
+      char path[64];
+      snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist",
+               node);
+      FILE* file = fopen(path, "r");
+      if (file == NULL) break;
+      char cpulist[4096];
+      const bool ok = fgets(cpulist, sizeof(cpulist), file) != NULL;
+      fclose(file);
+      if (!ok) break;
+      std::vector<int> cpus = ParseCpuList(cpulist);
+      // Memory only nodes have no cpu.
+      if (!cpus.empty()) topology.nodes.push_back(cpus);
+    }
+#endif
+    if (topology.nodes.empty()) {
+      const int num_cpus =
+          numext::maxi<int>(1, std::thread::hardware_concurrency());
+      return Uniform(1, num_cpus);
+    }
+    return topology;
+  }
+
+  // Splits the cpus 0 ... num_cpus - 1 into num_nodes nodes of consecutive
+  // cpus. Useful to emulate a NUMA layout.
+  static ThreadTopology Uniform(int num_nodes, int num_cpus) {
+    eigen_assert(num_nodes > 0 && num_cpus >= num_nodes);
+    ThreadTopology topology;
+    topology.nodes.resize(num_nodes);
+    for (int cpu = 0; cpu < num_cpus; ++cpu) {
+      topology.nodes[static_cast<size_t>(cpu) * num_nodes / num_cpus]
+          .push_back(cpu);
+    }
+    return topology;
+  }
+
+  // Parses a cpu list in the Linux format, e.g. "0-3,8,10-11".
+  static std::vector<int> ParseCpuList(const char* cpulist) {
+    std::vector<int> cpus;
+    const char* p = cpulist;
+    while (*p != '\0') {
+      if (*p < '0' || *p > '9') {
+        ++p;
+        continue;
+      }
+      char* end;
+      const int first = static_cast<int>(strtol(p, &end, 10));
+      int last = first;
+      p = end;
+      if (*p == '-') {
+        last = static_cast<int>(strtol(p + 1, &end, 10));
+        p = end;
+      }
+      for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+    }
+    return cpus;
+  }
+};
+
+// Restricts the calling thread to the given cpus. Returns false if this is not
+// supported on the platform or if the OS refused the request.
+inline bool SetCurrentThreadAffinity(const std::vector<int>& cpus) {
+#if EIGEN_OS_LINUX && defined(CPU_SET)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (size_t i = 0; i < cpus.size(); ++i) {
+    if (cpus[i] >= 0 && cpus[i] < CPU_SETSIZE) CPU_SET(cpus[i], &set);
+  }
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+  EIGEN_UNUSED_VARIABLE(cpus);
+  return false;
+#endif
+}
+
+}  // namespace Eigen
+
+#endif  // EIGEN_CXX11_THREADPOOL_THREAD_TOPOLOGY_H
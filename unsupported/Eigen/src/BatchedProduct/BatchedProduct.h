@@ -0,0 +1,362 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2018 Eigen contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_BATCHED_PRODUCT_H
+#define EIGEN_BATCHED_PRODUCT_H
+
+namespace Eigen {
+
+namespace internal {
+
+/** \internal
+  * Computes the products of a group of PacketSize matrices stored in the interleaved layout, i.e., the coefficient
+  * (i,j) of the k-th matrix of the group is the k-th lane of the packet stored at position i+j*rows (column-major).
+  * Each lane of the packets therefore belongs to a different matrix, and the products of the whole group are
+  * computed with the same packet multiply-adds as a single scalar product.
+  *
+  * The destination is processed by register blocks of 4 rows and 3 columns, such that each loaded coefficient of
+  * the lhs (resp. rhs) is reused 3 (resp. 4) times from registers. Sizes known at compile time let the compiler
+  * unroll everything.
+  */
+template<typename Scalar, int Rows, int Depth, int Cols>
+struct batched_product_kernel
+{
+  typedef typename packet_traits<Scalar>::type Packet;
+  enum {
+    PacketSize = packet_traits<Scalar>::size, RowBlock = 4, ColBlock = 3,
+    // whether the sizes may not be multiples of the register blocks: for fixed sizes that are, the remainder loops
+    // are removed at compile time, the compiler would otherwise warn about their out of range iterations
+    RowRemainder = Rows==Dynamic || Rows%RowBlock!=0,
+    ColRemainder = Cols==Dynamic || Cols%ColBlock!=0
+  };
+
+  template<int BlockRows, int BlockCols>
+  static EIGEN_STRONG_INLINE void run_block(Index i, Index j, Index rows, Index depth,
+                                            const Scalar* lhs, const Scalar* rhs, Scalar* res)
+  {
+    Packet acc[BlockRows*BlockCols];
+    for(int c=0; c<BlockRows*BlockCols; ++c)
+      acc[c] = pset1<Packet>(Scalar(0));
+
+    for(Index k=0; k<depth; ++k)
+    {
+      Packet a[BlockRows];
+      for(int r=0; r<BlockRows; ++r)
+        a[r] = pload<Packet>(lhs + (i + r + k*rows)*PacketSize);
+      for(int c=0; c<BlockCols; ++c)
+      {
+        Packet b = pload<Packet>(rhs + (k + (j+c)*depth)*PacketSize);
+        for(int r=0; r<BlockRows; ++r)
+          acc[r+c*BlockRows] = pmadd(a[r], b, acc[r+c*BlockRows]);
+      }
+    }
+
+    for(int c=0; c<BlockCols; ++c)
+      for(int r=0; r<BlockRows; ++r)
+        pstore(res + (i + r + (j+c)*rows)*PacketSize, acc[r+c*BlockRows]);
+  }
+
+  template<int BlockCols>
+  static EIGEN_STRONG_INLINE void run_cols(Index j, Index rows, Index depth,
+                                           const Scalar* lhs, const Scalar* rhs, Scalar* res)
+  {
+    Index i=0;
+    for(; i+RowBlock<=rows; i+=RowBlock)
+      run_block<RowBlock,BlockCols>(i, j, rows, depth, lhs, rhs, res);
+    if(RowRemainder)
+      for(; i<rows; ++i)
+        run_block<1,BlockCols>(i, j, rows, depth, lhs, rhs, res);
+  }
+
+  static EIGEN_STRONG_INLINE void run(Index _rows, Index _depth, Index _cols,
+                                      const Scalar* lhs, const Scalar* rhs, Scalar* res)
+  {
+    const internal::variable_if_dynamic<Index,Rows> rows(_rows);
+    const internal::variable_if_dynamic<Index,Depth> depth(_depth);
+    const internal::variable_if_dynamic<Index,Cols> cols(_cols);
+
+    Index j=0;
+    for(; j+ColBlock<=cols.value(); j+=ColBlock)
+      run_cols<ColBlock>(j, rows.value(), depth.value(), lhs, rhs, res);
+    if(ColRemainder)
+      for(; j<cols.value(); ++j)
+        run_cols<1>(j, rows.value(), depth.value(), lhs, rhs, res);
+  }
+};
+
+} // end namespace internal
+
+/** \ingroup BatchedProduct_Module
+  *
+  * \class InterleavedMatrixBatch
+  *
+  * \brief A batch of matrices of the same size stored in the SIMD-interleaved layout
+  *
+  * \tparam _Scalar the type of the coefficients
+  * \tparam _Rows the number of rows of each matrix, or Dynamic
+  * \tparam _Cols the number of columns of each matrix, or Dynamic
+  *
+  * The matrices are stored by groups of \c PacketSize matrices, where \c PacketSize is the number of scalars held
+  * by a SIMD packet. Within a group the coefficients are stored in column-major order, and each coefficient is a
+  * packet whose k-th lane belongs to the k-th matrix of the group. This is the layout expected by the vectorized
+  * batchedProduct() kernel, which can then fill all the SIMD lanes even for tiny matrices.
+  *
+  * The last group is padded with zero matrices.
+  *
+  * \sa batchedProduct()
+  */
+template<typename _Scalar, int _Rows = Dynamic, int _Cols = Dynamic>
+class InterleavedMatrixBatch
+{
+  public:
+    typedef _Scalar Scalar;
+    enum {
+      RowsAtCompileTime = _Rows,
+      ColsAtCompileTime = _Cols,
+      PacketSize = internal::packet_traits<Scalar>::size
+    };
+    typedef Matrix<Scalar,RowsAtCompileTime,ColsAtCompileTime> MatrixType;
+
+    /** Constructs a batch of \a batchSize zero matrices of size \a rows x \a cols */
+    InterleavedMatrixBatch(Index batchSize, Index rows = RowsAtCompileTime, Index cols = ColsAtCompileTime)
+      : m_batchSize(batchSize), m_rows(rows), m_cols(cols),
+        m_data(groups() * groupSize())
+    {
+      eigen_assert(rows>=0 && cols>=0 && batchSize>=0);
+      m_data.setZero();
+    }
+
+    /** \returns the number of matrices in the batch */
+    inline Index size() const { return m_batchSize; }
+    inline Index rows() const { return m_rows.value(); }
+    inline Index cols() const { return m_cols.value(); }
+
+    /** \returns the number of groups of \c PacketSize interleaved matrices */
+    inline Index groups() const { return (m_batchSize + PacketSize - 1) / PacketSize; }
+    /** \returns the number of scalars used to store a group */
+    inline Index groupSize() const { return rows() * cols() * PacketSize; }
+
+    inline Scalar* groupData(Index g) { return m_data.data() + g * groupSize(); }
+    inline const Scalar* groupData(Index g) const { return m_data.data() + g * groupSize(); }
+
+    /** \returns a reference to the coefficient (\a i, \a j) of the matrix \a k */
+    inline Scalar& coeffRef(Index k, Index i, Index j)
+    {
+      eigen_assert(k>=0 && k<size() && i>=0 && i<rows() && j>=0 && j<cols());
+      return groupData(k / PacketSize)[(i + j*rows()) * PacketSize + k % PacketSize];
+    }
+    inline const Scalar& coeff(Index k, Index i, Index j) const
+    {
+      eigen_assert(k>=0 && k<size() && i>=0 && i<rows() && j>=0 && j<cols());
+      return groupData(k / PacketSize)[(i + j*rows()) * PacketSize + k % PacketSize];
+    }
+
+    /** Copies \a m into the matrix \a k of the batch */
+    template<typename Derived>
+    void set(Index k, const MatrixBase<Derived>& m)
+    {
+      eigen_assert(m.rows()==rows() && m.cols()==cols());
+      for(Index j=0; j<cols(); ++j)
+        for(Index i=0; i<rows(); ++i)
+          coeffRef(k,i,j) = m.coeff(i,j);
+    }
+
+    /** \returns a copy of the matrix \a k of the batch */
+    MatrixType get(Index k) const
+    {
+      MatrixType res(rows(), cols());
+      for(Index j=0; j<cols(); ++j)
+        for(Index i=0; i<rows(); ++i)
+          res.coeffRef(i,j) = coeff(k,i,j);
+      return res;
+    }
+
+  protected:
+    Index m_batchSize;
+    internal::variable_if_dynamic<Index,RowsAtCompileTime> m_rows;
+    internal::variable_if_dynamic<Index,ColsAtCompileTime> m_cols;
+    Matrix<Scalar,Dynamic,1> m_data;
+};
+
+/** \ingroup BatchedProduct_Module
+  *
+  * Computes \c dst.get(k) = \c lhs.get(k) * \c rhs.get(k) for every matrix of the batches.
+  *
+  * This is the fastest variant: the batches are already in the interleaved layout, so each group of
+  * \c PacketSize products is computed at once with full SIMD packets.
+  */
+template<typename Scalar, int LhsRows, int Depth, int DstCols>
+void batchedProduct(const InterleavedMatrixBatch<Scalar,LhsRows,Depth>& lhs,
+                    const InterleavedMatrixBatch<Scalar,Depth,DstCols>& rhs,
+                    InterleavedMatrixBatch<Scalar,LhsRows,DstCols>& dst)
+{
+  eigen_assert(lhs.size()==rhs.size() && lhs.size()==dst.size());
+  eigen_assert(lhs.cols()==rhs.rows() && dst.rows()==lhs.rows() && dst.cols()==rhs.cols());
+
+  typedef internal::batched_product_kernel<Scalar,LhsRows,Depth,DstCols> Kernel;
+  for(Index g=0; g<lhs.groups(); ++g)
+    Kernel::run(lhs.rows(), lhs.cols(), rhs.cols(), lhs.groupData(g), rhs.groupData(g), dst.groupData(g));
+}
+
+/** \ingroup BatchedProduct_Module
+  *
+  * Computes \c dst[k] = \c lhs[k] * \c rhs[k] for \c k in [0, \c lhs.size()[.
+  *
+  * \param lhs, rhs random access containers (e.g., \c std::vector) of matrices of the same sizes
+  * \param dst a random access container of at least \c lhs.size() matrices, which are resized if needed
+  *
+  * The matrices are copied by groups of \c PacketSize into the interleaved layout of InterleavedMatrixBatch,
+  * multiplied with SIMD packets spanning the matrices of a group, and copied back. This avoids the per-product
+  * dispatch overhead of the general product and fills the SIMD lanes even for tiny (e.g., 3x3) matrices.
+  * Fixed-size matrices whose number of rows is a multiple of the (half) packet size are directly multiplied with
+  * the coefficient-based product instead. For the best performance, keep the data in an InterleavedMatrixBatch.
+  */
+template<typename LhsArray, typename RhsArray, typename DstArray>
+void batchedProduct(const LhsArray& lhs, const RhsArray& rhs, DstArray& dst)
+{
+  typedef typename internal::remove_all<typename LhsArray::value_type>::type LhsType;
+  typedef typename internal::remove_all<typename RhsArray::value_type>::type RhsType;
+  typedef typename LhsType::Scalar Scalar;
+  EIGEN_STATIC_ASSERT((internal::is_same<Scalar, typename RhsType::Scalar>::value),
+                      YOU_MIXED_DIFFERENT_NUMERIC_TYPES__YOU_NEED_TO_USE_THE_CAST_METHOD_OF_MATRIXBASE_TO_CAST_NUMERIC_TYPES_EXPLICITLY)
+  enum {
+    PacketSize = internal::packet_traits<Scalar>::size,
+    HalfPacketSize = internal::unpacket_traits<typename internal::packet_traits<Scalar>::half>::size,
+    Rows = LhsType::RowsAtCompileTime,
+    Depth = LhsType::ColsAtCompileTime,
+    Cols = RhsType::ColsAtCompileTime
+  };
+
+  const Index batchSize = Index(lhs.size());
+  eigen_assert(Index(rhs.size())==batchSize && Index(dst.size())>=batchSize);
+  if(batchSize==0)
+    return;
+
+  // When the columns of the fixed-size matrices are made of full (half-)packets, the coefficient-based product
+  // already fills the SIMD lanes and the conversions to the interleaved layout would not pay off.
+  if(Rows!=Dynamic && Depth!=Dynamic && Cols!=Dynamic && HalfPacketSize>1 && Rows%HalfPacketSize==0)
+  {
+    for(Index k=0; k<batchSize; ++k)
+      dst[k].noalias() = lhs[k].lazyProduct(rhs[k]);
+    return;
+  }
+
+  const Index rows = lhs[0].rows(), depth = lhs[0].cols(), cols = rhs[0].cols();
+  const Index lhsSize = rows*depth*PacketSize, rhsSize = depth*cols*PacketSize, dstSize = rows*cols*PacketSize;
+  ei_declare_aligned_stack_constructed_variable(Scalar, buffer, (lhsSize+rhsSize+dstSize), 0);
+  Scalar* lhsGroup = buffer;
+  Scalar* rhsGroup = lhsGroup + lhsSize;
+  Scalar* dstGroup = rhsGroup + rhsSize;
+
+  for(Index k0=0; k0<batchSize; k0+=PacketSize)
+  {
+    const Index actualPacketSize = (std::min)(Index(PacketSize), batchSize-k0);
+    if(actualPacketSize<PacketSize)
+    {
+      std::fill(lhsGroup, lhsGroup+lhsSize, Scalar(0));
+      std::fill(rhsGroup, rhsGroup+rhsSize, Scalar(0));
+    }
+
+    for(Index l=0; l<actualPacketSize; ++l)
+    {
+      const LhsType& a = lhs[k0+l];
+      const RhsType& b = rhs[k0+l];
+      eigen_assert(a.rows()==rows && a.cols()==depth && b.rows()==depth && b.cols()==cols);
+      for(Index j=0; j<depth; ++j)
+        for(Index i=0; i<rows; ++i)
+          lhsGroup[(i+j*rows)*PacketSize+l] = a.coeff(i,j);
+      for(Index j=0; j<cols; ++j)
+        for(Index i=0; i<depth; ++i)
+          rhsGroup[(i+j*depth)*PacketSize+l] = b.coeff(i,j);
+    }
+
+    internal::batched_product_kernel<Scalar,Rows,Depth,Cols>::run(rows, depth, cols, lhsGroup, rhsGroup, dstGroup);
+
+    for(Index l=0; l<actualPacketSize; ++l)
+    {
+      typename DstArray::value_type& c = dst[k0+l];
+      c.resize(rows, cols);
+      for(Index j=0; j<cols; ++j)
+        for(Index i=0; i<rows; ++i)
+          c.coeffRef(i,j) = dstGroup[(i+j*rows)*PacketSize+l];
+    }
+  }
+}
+
+/** \ingroup BatchedProduct_Module
+  *
+  * Computes the \a batchSize products of column-major matrices stored contiguously with constant strides:
+  * the k-th lhs (resp. rhs, dst) matrix starts at \a lhs + k * \a lhsStride (resp. \a rhs + k * \a rhsStride,
+  * \a dst + k * \a dstStride), and its leading dimension is its number of rows.
+  *
+  * \tparam Rows, Depth, Cols the sizes of the products if known at compile time, Dynamic otherwise
+  *
+  * Groups of \c PacketSize matrices are gathered into the interleaved layout with strided packet loads, multiplied
+  * with full SIMD packets, and scattered back to \a dst.
+  *
+  * \code
+  * // 1000 products of 8x8 matrices stored one after the other
+  * stridedBatchedProduct<8,8,8>(1000, 8, 8, 8, A.data(), 64, B.data(), 64, C.data(), 64);
+  * \endcode
+  */
+template<int Rows, int Depth, int Cols, typename Scalar>
+void stridedBatchedProduct(Index batchSize, Index rows, Index depth, Index cols,
+                           const Scalar* lhs, Index lhsStride,
+                           const Scalar* rhs, Index rhsStride,
+                           Scalar* dst, Index dstStride)
+{
+  typedef typename internal::packet_traits<Scalar>::type Packet;
+  enum { PacketSize = internal::packet_traits<Scalar>::size };
+  eigen_assert((Rows==Dynamic || Rows==rows) && (Depth==Dynamic || Depth==depth) && (Cols==Dynamic || Cols==cols));
+
+  const Index lhsSize = rows*depth, rhsSize = depth*cols, dstSize = rows*cols;
+  ei_declare_aligned_stack_constructed_variable(Scalar, buffer, (lhsSize+rhsSize+dstSize)*PacketSize, 0);
+  Scalar* lhsGroup = buffer;
+  Scalar* rhsGroup = lhsGroup + lhsSize*PacketSize;
+  Scalar* dstGroup = rhsGroup + rhsSize*PacketSize;
+
+  Index k0 = 0;
+  for(; k0+PacketSize<=batchSize; k0+=PacketSize)
+  {
+    for(Index c=0; c<lhsSize; ++c)
+      internal::pstore(lhsGroup + c*PacketSize, internal::pgather<Scalar,Packet>(lhs + k0*lhsStride + c, lhsStride));
+    for(Index c=0; c<rhsSize; ++c)
+      internal::pstore(rhsGroup + c*PacketSize, internal::pgather<Scalar,Packet>(rhs + k0*rhsStride + c, rhsStride));
+
+    internal::batched_product_kernel<Scalar,Rows,Depth,Cols>::run(rows, depth, cols, lhsGroup, rhsGroup, dstGroup);
+
+    for(Index c=0; c<dstSize; ++c)
+      internal::pscatter<Scalar,Packet>(dst + k0*dstStride + c, internal::pload<Packet>(dstGroup + c*PacketSize), dstStride);
+  }
+
+  // remaining products
+  for(; k0<batchSize; ++k0)
+  {
+    typedef Matrix<Scalar,Rows,Depth> LhsType;
+    typedef Matrix<Scalar,Depth,Cols> RhsType;
+    typedef Matrix<Scalar,Rows,Cols> DstType;
+    Map<DstType>(dst + k0*dstStride, rows, cols).noalias()
+      = Map<const LhsType>(lhs + k0*lhsStride, rows, depth).lazyProduct(Map<const RhsType>(rhs + k0*rhsStride, depth, cols));
+  }
+}
+
+/** \ingroup BatchedProduct_Module
+  * Overload of stridedBatchedProduct() for sizes only known at runtime. */
+template<typename Scalar>
+void stridedBatchedProduct(Index batchSize, Index rows, Index depth, Index cols,
+                           const Scalar* lhs, Index lhsStride,
+                           const Scalar* rhs, Index rhsStride,
+                           Scalar* dst, Index dstStride)
+{
+  stridedBatchedProduct<Dynamic,Dynamic,Dynamic>(batchSize, rows, depth, cols, lhs, lhsStride, rhs, rhsStride, dst, dstStride);
+}
+
+} // end namespace Eigen
+
+#endif // EIGEN_BATCHED_PRODUCT_H
@@ -0,0 +1,136 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2018 Eigen contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+namespace Eigen {
+
+namespace internal {
+
+// Executors run f(first, last) over blocks covering [0, n). The backends use
+// them to dispatch the signals of a batched transform.
+struct fft_serial_executor
+{
+  template <typename Function>
+  void operator()(Index n, const Function& f) const
+  {
+    if (n > 0) f(0, n);
+  }
+};
+
+#if EIGEN_HAS_CXX11
+// Runs the blocks on the threads of a device of the Tensor module such as
+// ThreadPoolDevice, i.e. anything with numThreads() and
+// enqueueNoNotification(). The calling thread takes the first block and then
+// waits for the others.
+template <typename Device>
+struct fft_device_executor
+{
+  explicit fft_device_executor(const Device& device) : m_device(device) {}
+
+  template <typename Function>
+  void operator()(Index n, const Function& f) const
+  {
+    // A few blocks per thread to balance the load.
+    const Index numBlocks = (std::min)(n, Index(4 * m_device.numThreads()));
+    if (numBlocks <= 1) {
+      if (n > 0) f(0, n);
+      return;
+    }
+    const Index blockSize = (n + numBlocks - 1) / numBlocks;
+    std::mutex mu;
+    std::condition_variable done;
+    Index pending = (n - 1) / blockSize;
+    for (Index first = blockSize; first < n; first += blockSize) {
+      const Index last = (std::min)(first + blockSize, n);
+      m_device.enqueueNoNotification([&, first, last]() {
+        f(first, last);
+        std::unique_lock<std::mutex> l(mu);
+        if (--pending == 0) done.notify_all();
+      });
+    }
+    f(0, blockSize);
+    std::unique_lock<std::mutex> l(mu);
+    while (pending != 0) done.wait(l);
+  }
+
+  const Device& m_device;
+};
+#endif
+
+template <typename Impl, typename Dst, typename Src>
+void fft_single(Impl& impl, Dst* dst, const Src* src, int nfft, false_type) { impl.fwd(dst, src, nfft); }
+
+template <typename Impl, typename Dst, typename Src>
+void fft_single(Impl& impl, Dst* dst, const Src* src, int nfft, true_type) { impl.inv(dst, src, nfft); }
+
+// Batched transforms for the backends that only provide single transforms:
+// each signal is copied to a contiguous buffer, transformed and copied back.
+// nin and nout are the number of values of an input and output signal.
+template <bool Inverse, typename Impl, typename Dst, typename Src>
+void fft_generic_batch(Impl& impl, Dst* dst, const Src* src, int nfft, Index nin, Index nout,
+                       Index howmany, Index istride, Index idist, Index ostride, Index odist)
+{
+  std::vector<Src> in(nin);
+  std::vector<Dst> out(nfft);
+  for (Index b = 0; b < howmany; ++b) {
+    for (Index i = 0; i < nin; ++i) in[i] = src[b * idist + i * istride];
+    fft_single(impl, &out[0], &in[0], nfft, typename conditional<Inverse, true_type, false_type>::type());
+    for (Index k = 0; k < nout; ++k) dst[b * odist + k * ostride] = out[k];
+  }
+}
+
+// Row major n0 x n1 two dimensional transform built on batched transforms.
+template <typename Impl, typename Complex, typename Executor>
+void fft_batch2(Impl& impl, bool inverse, Complex* dst, const Complex* src, int n0, int n1, const Executor& exec)
+{
+  if (inverse) {
+    impl.inv_batch(dst, src, n1, n0, 1, n1, 1, n1, exec);
+    impl.inv_batch(dst, dst, n0, n1, n1, 1, n1, 1, exec);
+  } else {
+    impl.fwd_batch(dst, src, n1, n0, 1, n1, 1, n1, exec);
+    impl.fwd_batch(dst, dst, n0, n1, n1, 1, n1, 1, exec);
+  }
+}
+
+// Post-processing of the batched transforms of the FFT class.
+template <typename Complex>
+struct fft_batch_reflect
+{
+  Complex* m_data;
+  Index m_nfft, m_stride, m_dist;
+
+  void operator()(Index first, Index last) const
+  {
+    for (Index b = first; b < last; ++b) {
+      Complex* freq = m_data + b * m_dist;
+      for (Index k = (m_nfft >> 1) + 1; k < m_nfft; ++k)
+        freq[k * m_stride] = numext::conj(freq[(m_nfft - k) * m_stride]);
+    }
+  }
+};
+
+template <typename T, typename Scalar>
+struct fft_batch_scale
+{
+  T* m_data;
+  Scalar m_scale;
+  Index m_size, m_stride, m_dist;
+
+  void operator()(Index first, Index last) const
+  {
+    for (Index b = first; b < last; ++b)
+      for (Index k = 0; k < m_size; ++k)
+        m_data[b * m_dist + k * m_stride] *= m_scale;
+  }
+};
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+/* vim: set filetype=cpp et sw=2 ts=2 ai: */
@@ -227,6 +227,39 @@ namespace internal {
         get_plan(n0,n1,true,dst,src).inv2(fftw_cast(dst), fftw_cast(src) ,n0,n1);
       }
 
+      // Batched transforms, computed one signal at a time on the calling thread.
+      template <typename Executor>
+      inline
+      void fwd_batch( Complex * dst,const Complex *src,int nfft,Index howmany,
+                      Index istride,Index idist,Index ostride,Index odist,const Executor &)
+      {
+        fft_generic_batch<false>(*this, dst, src, nfft, nfft, nfft, howmany, istride, idist, ostride, odist);
+      }
+
+      template <typename Executor>
+      inline
+      void fwd_batch( Complex * dst,const Scalar *src,int nfft,Index howmany,
+                      Index istride,Index idist,Index ostride,Index odist,const Executor &)
+      {
+        fft_generic_batch<false>(*this, dst, src, nfft, nfft, (nfft>>1)+1, howmany, istride, idist, ostride, odist);
+      }
+
+      template <typename Executor>
+      inline
+      void inv_batch( Complex * dst,const Complex *src,int nfft,Index howmany,
+                      Index istride,Index idist,Index ostride,Index odist,const Executor &)
+      {
+        fft_generic_batch<true>(*this, dst, src, nfft, nfft, nfft, howmany, istride, idist, ostride, odist);
+      }
+
+      template <typename Executor>
+      inline
+      void inv_batch( Scalar * dst,const Complex *src,int nfft,Index howmany,
+                      Index istride,Index idist,Index ostride,Index odist,const Executor &)
+      {
+        fft_generic_batch<true>(*this, dst, src, nfft, (nfft>>1)+1, nfft, howmany, istride, idist, ostride, odist);
+      }
+
 
   protected:
       typedef fftw_plan<Scalar> PlanData;
@@ -282,19 +282,46 @@ struct kissfft_impl
   inline
     void fwd2( Complex * dst,const Complex *src,int n0,int n1)
     {
-        EIGEN_UNUSED_VARIABLE(dst);
-        EIGEN_UNUSED_VARIABLE(src);
-        EIGEN_UNUSED_VARIABLE(n0);
-        EIGEN_UNUSED_VARIABLE(n1);
+      fft_batch2(*this, false, dst, src, n0, n1, fft_serial_executor());
     }
 
   inline
     void inv2( Complex * dst,const Complex *src,int n0,int n1)
     {
-        EIGEN_UNUSED_VARIABLE(dst);
-        EIGEN_UNUSED_VARIABLE(src);
-        EIGEN_UNUSED_VARIABLE(n0);
-        EIGEN_UNUSED_VARIABLE(n1);
+      fft_batch2(*this, true, dst, src, n0, n1, fft_serial_executor());
+    }
+
+  // Batched transforms, computed one signal at a time on the calling thread.
+  template <typename Executor>
+  inline
+    void fwd_batch( Complex * dst,const Complex *src,int nfft,Index howmany,
+                    Index istride,Index idist,Index ostride,Index odist,const Executor &)
+    {
+      fft_generic_batch<false>(*this, dst, src, nfft, nfft, nfft, howmany, istride, idist, ostride, odist);
+    }
+
+  template <typename Executor>
+  inline
+    void fwd_batch( Complex * dst,const Scalar *src,int nfft,Index howmany,
+                    Index istride,Index idist,Index ostride,Index odist,const Executor &)
+    {
+      fft_generic_batch<false>(*this, dst, src, nfft, nfft, (nfft>>1)+1, howmany, istride, idist, ostride, odist);
+    }
+
+  template <typename Executor>
+  inline
+    void inv_batch( Complex * dst,const Complex *src,int nfft,Index howmany,
+                    Index istride,Index idist,Index ostride,Index odist,const Executor &)
+    {
+      fft_generic_batch<true>(*this, dst, src, nfft, nfft, nfft, howmany, istride, idist, ostride, odist);
+    }
+
+  template <typename Executor>
+  inline
+    void inv_batch( Scalar * dst,const Complex *src,int nfft,Index howmany,
+                    Index istride,Index idist,Index ostride,Index odist,const Executor &)
+    {
+      fft_generic_batch<true>(*this, dst, src, nfft, (nfft>>1)+1, nfft, howmany, istride, idist, ostride, odist);
     }
 
   // real-to-complex forward FFT
@@ -0,0 +1,795 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2018 Eigen contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+namespace Eigen {
+
+namespace internal {
+
+// Out-of-place mixed radix FFT using the Stockham autosort formulation.
+//
+// Every pass reads the whole sequence and writes it back in a second buffer
+// in an order that makes the final output come out sorted, so there is no
+// bit reversal and all the loads and stores of a pass are unit stride over
+// one of the two loop indices. The butterflies are written in terms of the
+// complex packets of Eigen and vectorize over whichever index is contiguous:
+// the column index for the late passes and the butterfly index for the first
+// ones.
+//
+// Sequences that do not fit in the L2 cache are decomposed with the six-step
+// algorithm into n1 x n2 = n smaller transforms that do, separated by blocked
+// transpositions and a twiddle multiplication.
+
+// Multiplies a complex packet by -i for a forward transform, or by i for an
+// inverse one.
+template<typename Packet>
+EIGEN_STRONG_INLINE Packet fft_rotate(const Packet& a, bool inverse)
+{
+  return inverse ? pcplxflip(pconj(a)) : pconj(pcplxflip(a));
+}
+
+// Multiplies a complex packet by a real factor.
+template<typename Packet, typename Real>
+EIGEN_STRONG_INLINE Packet fft_scale(const Packet& a, const Real& s)
+{
+  return Packet(pmul(a.v, pset1<typename packet_traits<Real>::type>(s)));
+}
+
+template<typename Real>
+EIGEN_STRONG_INLINE std::complex<Real> fft_scale(const std::complex<Real>& a, const Real& s)
+{
+  return a * s;
+}
+
+// Complex product, without the inf/nan recovery of std::complex.
+template<typename Packet>
+EIGEN_STRONG_INLINE Packet fft_mul(const Packet& a, const Packet& b)
+{
+  return pmul(a, b);
+}
+
+template<typename Real>
+EIGEN_STRONG_INLINE std::complex<Real> fft_mul(const std::complex<Real>& a, const std::complex<Real>& b)
+{
+  return std::complex<Real>(a.real() * b.real() - a.imag() * b.imag(),
+                            a.real() * b.imag() + a.imag() * b.real());
+}
+
+// In-place DFT of the Radix packets in a. The roots are the Radix-th roots of
+// unity in the direction of the transform; they are only used by the generic
+// radix, which also uses a[radix, 2*radix) as temporary storage.
+template<int Radix> struct fft_butterfly;
+
+template<> struct fft_butterfly<2>
+{
+  template<typename Packet, typename Complex>
+  static EIGEN_STRONG_INLINE void run(Packet* a, int, bool, const Complex*)
+  {
+    Packet t = a[1];
+    a[1] = psub(a[0], t);
+    a[0] = padd(a[0], t);
+  }
+};
+
+template<> struct fft_butterfly<3>
+{
+  template<typename Packet, typename Complex>
+  static EIGEN_STRONG_INLINE void run(Packet* a, int, bool inverse, const Complex*)
+  {
+    typedef typename Complex::value_type Real;
+    const Real s = Real(0.86602540378443864676372317075294L);
+    Packet t = padd(a[1], a[2]);
+    Packet d = fft_rotate(fft_scale(psub(a[1], a[2]), s), inverse);
+    Packet m = psub(a[0], fft_scale(t, Real(0.5)));
+    a[0] = padd(a[0], t);
+    a[1] = padd(m, d);
+    a[2] = psub(m, d);
+  }
+};
+
+template<> struct fft_butterfly<4>
+{
+  template<typename Packet, typename Complex>
+  static EIGEN_STRONG_INLINE void run(Packet* a, int, bool inverse, const Complex*)
+  {
+    Packet t0 = padd(a[0], a[2]);
+    Packet t1 = psub(a[0], a[2]);
+    Packet t2 = padd(a[1], a[3]);
+    Packet t3 = fft_rotate(psub(a[1], a[3]), inverse);
+    a[0] = padd(t0, t2);
+    a[1] = padd(t1, t3);
+    a[2] = psub(t0, t2);
+    a[3] = psub(t1, t3);
+  }
+};
+
+template<> struct fft_butterfly<5>
+{
+  template<typename Packet, typename Complex>
+  static EIGEN_STRONG_INLINE void run(Packet* a, int, bool inverse, const Complex*)
+  {
+    typedef typename Complex::value_type Real;
+    const Real c1 = Real( 0.30901699437494742410229341718282L);
+    const Real c2 = Real(-0.80901699437494742410229341718282L);
+    const Real s1 = Real( 0.95105651629515357211643933337938L);
+    const Real s2 = Real( 0.58778525229247312916870595463907L);
+    Packet p14 = padd(a[1], a[4]);
+    Packet m14 = psub(a[1], a[4]);
+    Packet p23 = padd(a[2], a[3]);
+    Packet m23 = psub(a[2], a[3]);
+    Packet r1 = padd(a[0], padd(fft_scale(p14, c1), fft_scale(p23, c2)));
+    Packet r2 = padd(a[0], padd(fft_scale(p14, c2), fft_scale(p23, c1)));
+    Packet i1 = fft_rotate(padd(fft_scale(m14, s1), fft_scale(m23, s2)), inverse);
+    Packet i2 = fft_rotate(psub(fft_scale(m14, s2), fft_scale(m23, s1)), inverse);
+    a[0] = padd(a[0], padd(p14, p23));
+    a[1] = padd(r1, i1);
+    a[4] = psub(r1, i1);
+    a[2] = padd(r2, i2);
+    a[3] = psub(r2, i2);
+  }
+};
+
+template<> struct fft_butterfly<8>
+{
+  template<typename Packet, typename Complex>
+  static EIGEN_STRONG_INLINE void run(Packet* a, int, bool inverse, const Complex* roots)
+  {
+    typedef typename Complex::value_type Real;
+    const Real h = Real(0.70710678118654752440084436210485L);
+    Packet e[4] = { a[0], a[2], a[4], a[6] };
+    Packet o[4] = { a[1], a[3], a[5], a[7] };
+    fft_butterfly<4>::run(e, 4, inverse, roots);
+    fft_butterfly<4>::run(o, 4, inverse, roots);
+    // Multiply the odd outputs by the 8th roots of unity.
+    Packet r1 = fft_rotate(o[1], inverse);
+    Packet r3 = fft_rotate(o[3], inverse);
+    o[1] = fft_scale(padd(o[1], r1), h);
+    o[2] = fft_rotate(o[2], inverse);
+    o[3] = fft_scale(psub(r3, o[3]), h);
+    for (int k = 0; k < 4; ++k) {
+      a[k] = padd(e[k], o[k]);
+      a[k + 4] = psub(e[k], o[k]);
+    }
+  }
+};
+
+template<> struct fft_butterfly<Dynamic>
+{
+  template<typename Packet, typename Complex>
+  static EIGEN_STRONG_INLINE void run(Packet* a, int radix, bool, const Complex* roots)
+  {
+    Packet* b = a + radix;
+    for (int k = 0; k < radix; ++k) {
+      Packet acc = a[0];
+      int idx = 0;
+      for (int r = 1; r < radix; ++r) {
+        idx += k;
+        if (idx >= radix) idx -= radix;
+        acc = padd(acc, fft_mul(a[r], pset1<Packet>(roots[idx])));
+      }
+      b[k] = acc;
+    }
+    for (int k = 0; k < radix; ++k) a[k] = b[k];
+  }
+};
+
+template <typename _Scalar>
+struct stockham_plan
+{
+  typedef _Scalar Scalar;
+  typedef std::complex<Scalar> Complex;
+  typedef typename packet_traits<Complex>::type Packet;
+  enum {
+    Vectorizable = packet_traits<Complex>::Vectorizable,
+    PacketSize = unpacket_traits<Packet>::size
+  };
+
+  int m_nfft;
+  bool m_inverse;
+  // Stockham passes.
+  std::vector<int> m_stageRadix;
+  std::vector<Index> m_stageTwiddles;
+  std::vector<Index> m_stageRoots;
+  std::vector<Complex> m_twiddles;
+  // Six-step decomposition, used when m_n1 > 0.
+  int m_n1, m_n2;
+  std::vector<Complex> m_sixStepTwiddles;
+  const stockham_plan* m_plan1;
+  const stockham_plan* m_plan2;
+
+  // Number of interleaved transforms computed at once by the six-step
+  // algorithm.
+  enum { SixStepBatch = 16 };
+
+  stockham_plan() : m_nfft(0), m_inverse(false), m_n1(0), m_n2(0), m_plan1(0), m_plan2(0) {}
+
+  Complex root(Index k, Index n) const
+  {
+    using std::acos;
+    const Scalar phinc = (m_inverse ? 2 : -2) * acos(Scalar(-1)) / Scalar(n);
+    return std::exp(Complex(0, phinc * Scalar(k)));
+  }
+
+  void init(int nfft, bool inverse)
+  {
+    m_nfft = nfft;
+    m_inverse = inverse;
+    // Factor out 8's first to minimize the number of passes over the data,
+    // then 4, 2, 3, 5 and whatever prime factors remain.
+    int n = nfft;
+    int p = 8;
+    while (n > 1) {
+      while (n % p) {
+        switch (p) {
+          case 8: p = 4; break;
+          case 4: p = 2; break;
+          case 2: p = 3; break;
+          default: p += 2; break;
+        }
+        if (p * p > n) p = n;
+      }
+      n /= p;
+      m_stageRadix.push_back(p);
+    }
+
+    // For a pass of radix P over subsequences of length len, twiddle k of
+    // butterfly j is w^(j*k) with w the len-th root of unity. They are stored
+    // as P-1 rows of len/P contiguous values.
+    Index len = nfft;
+    for (size_t s = 0; s < m_stageRadix.size(); ++s) {
+      const int radix = m_stageRadix[s];
+      const Index m = len / radix;
+      m_stageTwiddles.push_back(static_cast<Index>(m_twiddles.size()));
+      for (int k = 1; k < radix; ++k)
+        for (Index j = 0; j < m; ++j)
+          m_twiddles.push_back(root(j * k, len));
+      m_stageRoots.push_back(static_cast<Index>(m_twiddles.size()));
+      if (radix != 2 && radix != 3 && radix != 4 && radix != 5 && radix != 8)
+        for (int k = 0; k < radix; ++k)
+          m_twiddles.push_back(root(k, radix));
+      len = m;
+    }
+  }
+
+  // Switches this plan to the six-step algorithm, built on transforms of
+  // length n1 and n2 = nfft/n1.
+  void initSixStep(int n1, const stockham_plan* plan1, const stockham_plan* plan2)
+  {
+    m_n1 = n1;
+    m_n2 = m_nfft / n1;
+    m_plan1 = plan1;
+    m_plan2 = plan2;
+    m_sixStepTwiddles.resize(m_nfft);
+    for (Index k1 = 0; k1 < m_n1; ++k1)
+      for (Index j2 = 0; j2 < m_n2; ++j2)
+        m_sixStepTwiddles[k1 * m_n2 + j2] = root(j2 * k1, m_nfft);
+  }
+
+  // Size of the scratch buffer that work() needs.
+  Index scratchSize() const
+  {
+    if (m_n1 == 0) return m_nfft;
+    return Index(m_nfft) + 3 * SixStepBatch * Index((std::max)(m_n1, m_n2));
+  }
+
+  // Computes batch interleaved transforms: element i of transform b is at
+  // src[i*batch + b]. dst and src must not overlap, and scratch must hold
+  // batch*scratchSize() values.
+  void work(Complex* dst, const Complex* src, Complex* scratch, Index batch = 1) const
+  {
+    if (m_n1 > 0) {
+      eigen_internal_assert(batch == 1);
+      sixStep(dst, src, scratch);
+      return;
+    }
+    const int nstages = static_cast<int>(m_stageRadix.size());
+    if (nstages == 0) {
+      std::copy(src, src + batch, dst);
+      return;
+    }
+    Index len = m_nfft;
+    Index stride = batch;
+    const Complex* in = src;
+    for (int s = 0; s < nstages; ++s) {
+      Complex* out = ((nstages - 1 - s) % 2 == 0) ? dst : scratch;
+      const int radix = m_stageRadix[s];
+      switch (radix) {
+        case 2: pass<2>(out, in, radix, len, stride, s); break;
+        case 3: pass<3>(out, in, radix, len, stride, s); break;
+        case 4: pass<4>(out, in, radix, len, stride, s); break;
+        case 5: pass<5>(out, in, radix, len, stride, s); break;
+        case 8: pass<8>(out, in, radix, len, stride, s); break;
+        default: pass<Dynamic>(out, in, radix, len, stride, s); break;
+      }
+      len /= radix;
+      stride *= radix;
+      in = out;
+    }
+  }
+
+  // One Stockham pass of the given radix over nfft/(len*stride) interleaved
+  // sequences of length len: for each butterfly j < m = len/radix and column
+  // q < stride,
+  //   y[q + stride*(radix*j + k)] = w^(j*k) * sum_r x[q + stride*(j + r*m)] * W^(r*k)
+  template<int Radix>
+  void pass(Complex* y, const Complex* x, int radix, Index len, Index stride, int stage) const
+  {
+    const Index m = len / radix;
+    const Complex* tw = &m_twiddles[m_stageTwiddles[stage]];
+    const Complex* roots = m_twiddles.empty() ? 0 : &m_twiddles[0] + m_stageRoots[stage];
+    const int R = Radix == Dynamic ? radix : Radix;
+    // Fixed size radices keep their operands in registers.
+    Packet afixed[Radix == Dynamic ? 1 : Radix];
+    Complex cfixed[Radix == Dynamic ? 1 : Radix];
+    const Index dynamicSize = Radix == Dynamic ? 2 * R : 0;
+    ei_declare_aligned_stack_constructed_variable(Packet, adynamic, dynamicSize, 0);
+    ei_declare_aligned_stack_constructed_variable(Complex, cdynamic, dynamicSize, 0);
+    Packet* a = Radix == Dynamic ? adynamic : afixed;
+    Complex* c = Radix == Dynamic ? cdynamic : cfixed;
+
+    if (Vectorizable && stride >= PacketSize) {
+      // Late passes: vectorize over the columns, all of which share the same
+      // twiddles.
+      const Index vend = stride - stride % PacketSize;
+      for (Index j = 0; j < m; ++j) {
+        for (Index q = 0; q < vend; q += PacketSize) {
+          for (int r = 0; r < R; ++r) a[r] = ploadu<Packet>(x + q + stride * (j + r * m));
+          fft_butterfly<Radix>::run(a, R, m_inverse, roots);
+          pstoreu(y + q + stride * radix * j, a[0]);
+          for (int k = 1; k < R; ++k)
+            pstoreu(y + q + stride * (radix * j + k), fft_mul(a[k], pset1<Packet>(tw[(k - 1) * m + j])));
+        }
+        for (Index q = vend; q < stride; ++q) scalarButterfly<Radix>(y, x, c, R, m, stride, j, q, tw, roots);
+      }
+    } else if (Vectorizable && m >= PacketSize) {
+      // First passes: vectorize over the butterflies, each of which has its
+      // own twiddles.
+      const Index vend = m - m % PacketSize;
+      for (Index q = 0; q < stride; ++q) {
+        for (Index j = 0; j < vend; j += PacketSize) {
+          if (stride == 1) {
+            for (int r = 0; r < R; ++r) a[r] = ploadu<Packet>(x + j + r * m);
+          } else {
+            for (int r = 0; r < R; ++r) a[r] = pgather<Complex, Packet>(x + q + stride * (j + r * m), stride);
+          }
+          fft_butterfly<Radix>::run(a, R, m_inverse, roots);
+          pscatter<Complex, Packet>(y + q + stride * radix * j, a[0], stride * radix);
+          for (int k = 1; k < R; ++k)
+            pscatter<Complex, Packet>(y + q + stride * (radix * j + k),
+                                      fft_mul(a[k], ploadu<Packet>(tw + (k - 1) * m + j)), stride * radix);
+        }
+        for (Index j = vend; j < m; ++j) scalarButterfly<Radix>(y, x, c, R, m, stride, j, q, tw, roots);
+      }
+    } else {
+      for (Index j = 0; j < m; ++j)
+        for (Index q = 0; q < stride; ++q) scalarButterfly<Radix>(y, x, c, R, m, stride, j, q, tw, roots);
+    }
+  }
+
+  template<int Radix>
+  EIGEN_STRONG_INLINE void scalarButterfly(Complex* y, const Complex* x, Complex* c, int R, Index m, Index stride,
+                                           Index j, Index q, const Complex* tw, const Complex* roots) const
+  {
+    for (int r = 0; r < R; ++r) c[r] = x[q + stride * (j + r * m)];
+    fft_butterfly<Radix>::run(c, R, m_inverse, roots);
+    y[q + stride * R * j] = c[0];
+    for (int k = 1; k < R; ++k) y[q + stride * (R * j + k)] = fft_mul(c[k], tw[(k - 1) * m + j]);
+  }
+
+  // Seeing x as an n1 x n2 row major matrix, with j = j1*n2 + j2 and
+  // k = k1 + n1*k2:
+  //   X[k] = sum_j2 W_n2^(j2*k2) * W_n^(j2*k1) * sum_j1 x[j] * W_n1^(j1*k1)
+  // The transforms along the columns, and then along the rows, are computed
+  // SixStepBatch at a time so that both the working set and the
+  // transpositions stay in cache, and the butterflies vectorize over the
+  // batch.
+  void sixStep(Complex* dst, const Complex* src, Complex* scratch) const
+  {
+    const Index n1 = m_n1, n2 = m_n2;
+    const Index blockSize = SixStepBatch * Index((std::max)(n1, n2));
+    Complex* t = scratch;
+    Complex* in = t + m_nfft;
+    Complex* out = in + blockSize;
+    Complex* sub = out + blockSize;
+
+    for (Index c0 = 0; c0 < n2; c0 += SixStepBatch) {
+      const Index bs = (std::min)(Index(SixStepBatch), n2 - c0);
+      for (Index j1 = 0; j1 < n1; ++j1)
+        std::copy(src + j1 * n2 + c0, src + j1 * n2 + c0 + bs, in + j1 * bs);
+      m_plan1->work(out, in, sub, bs);
+      for (Index k1 = 0; k1 < n1; ++k1)
+        twiddle(t + k1 * n2 + c0, out + k1 * bs, &m_sixStepTwiddles[k1 * n2 + c0], bs);
+    }
+
+    for (Index r0 = 0; r0 < n1; r0 += SixStepBatch) {
+      const Index bs = (std::min)(Index(SixStepBatch), n1 - r0);
+      for (Index b = 0; b < bs; ++b)
+        for (Index j2 = 0; j2 < n2; ++j2)
+          in[j2 * bs + b] = t[(r0 + b) * n2 + j2];
+      m_plan2->work(out, in, sub, bs);
+      for (Index k2 = 0; k2 < n2; ++k2)
+        std::copy(out + k2 * bs, out + (k2 + 1) * bs, dst + k2 * n1 + r0);
+    }
+  }
+
+  // dst[i] = src[i] * tw[i] for i < size.
+  static void twiddle(Complex* dst, const Complex* src, const Complex* tw, Index size)
+  {
+    const Index vend = Vectorizable ? size - size % PacketSize : 0;
+    for (Index i = 0; i < vend; i += PacketSize)
+      pstoreu(dst + i, fft_mul(ploadu<Packet>(src + i), ploadu<Packet>(tw + i)));
+    for (Index i = vend; i < size; ++i) dst[i] = fft_mul(src[i], tw[i]);
+  }
+};
+
+template <typename _Scalar>
+struct stockham_impl
+{
+  typedef _Scalar Scalar;
+  typedef std::complex<Scalar> Complex;
+
+  void clear()
+  {
+    m_plans.clear();
+    m_subPlans.clear();
+    m_realTwiddles.clear();
+  }
+
+  inline
+    void fwd( Complex * dst,const Complex *src,int nfft)
+    {
+      work(get_plan(nfft,false), dst, src);
+    }
+
+  inline
+    void fwd2( Complex * dst,const Complex *src,int n0,int n1)
+    {
+      fft_batch2(*this, false, dst, src, n0, n1, fft_serial_executor());
+    }
+
+  inline
+    void inv2( Complex * dst,const Complex *src,int n0,int n1)
+    {
+      fft_batch2(*this, true, dst, src, n0, n1, fft_serial_executor());
+    }
+
+  // real-to-complex forward FFT
+  inline
+    void fwd( Complex * dst,const Scalar * src,int nfft)
+    {
+      const RealPlan rp = get_real_plan(nfft,false);
+      reserve(rp);
+      realFwd(rp, dst, src, &m_tmpBuf1[0], &m_scratch[0]);
+    }
+
+  // inverse complex-to-complex
+  inline
+    void inv(Complex * dst,const Complex  *src,int nfft)
+    {
+      work(get_plan(nfft,true), dst, src);
+    }
+
+  // half-complex to scalar
+  inline
+    void inv( Scalar * dst,const Complex * src,int nfft)
+    {
+      const RealPlan rp = get_real_plan(nfft,true);
+      reserve(rp);
+      realInv(rp, dst, src, &m_tmpBuf1[0], &m_scratch[0]);
+    }
+
+  // Batched transforms of howmany signals: value i of signal b is at
+  // src[b*idist + i*istride] and bin k of its transform at
+  // dst[b*odist + k*ostride]. The plans are created on the calling thread,
+  // after what the signals are dispatched to exec with their own buffers.
+  template <typename Executor>
+  inline
+    void fwd_batch( Complex * dst,const Complex *src,int nfft,Index howmany,
+                    Index istride,Index idist,Index ostride,Index odist,const Executor & exec)
+    {
+      complex_batch(get_plan(nfft,false), dst, src, howmany, istride, idist, ostride, odist, exec);
+    }
+
+  template <typename Executor>
+  inline
+    void fwd_batch( Complex * dst,const Scalar *src,int nfft,Index howmany,
+                    Index istride,Index idist,Index ostride,Index odist,const Executor & exec)
+    {
+      real_batch_task<Complex,Scalar> task = { get_real_plan(nfft,false), dst, src, nfft, (nfft>>1)+1,
+                                               istride, idist, ostride, odist };
+      exec(howmany, task);
+    }
+
+  template <typename Executor>
+  inline
+    void inv_batch( Complex * dst,const Complex *src,int nfft,Index howmany,
+                    Index istride,Index idist,Index ostride,Index odist,const Executor & exec)
+    {
+      complex_batch(get_plan(nfft,true), dst, src, howmany, istride, idist, ostride, odist, exec);
+    }
+
+  template <typename Executor>
+  inline
+    void inv_batch( Scalar * dst,const Complex *src,int nfft,Index howmany,
+                    Index istride,Index idist,Index ostride,Index odist,const Executor & exec)
+    {
+      real_batch_task<Scalar,Complex> task = { get_real_plan(nfft,true), dst, src, (nfft>>1)+1, nfft,
+                                               istride, idist, ostride, odist };
+      exec(howmany, task);
+    }
+
+  protected:
+  typedef stockham_plan<Scalar> PlanData;
+  typedef std::map<int,PlanData> PlanMap;
+
+  // Real transforms of even size run a complex transform of half the size,
+  // the others a complex transform of the full size.
+  struct RealPlan
+  {
+    const PlanData * plan;
+    const Complex * twiddles;
+    int nfft;
+
+    // Size of the tmp buffer of realFwd() and realInv().
+    Index tmpSize() const { return 2 * Index(nfft); }
+  };
+
+  PlanMap m_plans;
+  PlanMap m_subPlans;
+  std::map<int, std::vector<Complex> > m_realTwiddles;
+  std::vector<Complex> m_tmpBuf1;
+  std::vector<Complex> m_tmpBuf2;
+  std::vector<Complex> m_scratch;
+
+  inline
+    int PlanKey(int nfft, bool isinverse) const { return (nfft<<1) | int(isinverse); }
+
+  inline
+    PlanData & get_plan(int nfft, bool inverse)
+    {
+      PlanData & pd = m_plans[ PlanKey(nfft,inverse) ];
+      if ( pd.m_nfft == 0 ) {
+        pd.init(nfft,inverse);
+        // Split the transforms that are well beyond the L2 cache in two
+        // dimensions as close to sqrt(nfft) as possible. Just above the cache
+        // size, the plain passes are still faster.
+        if ( Index(nfft) * Index(sizeof(Complex)) > 4 * l2CacheSize() ) {
+          int n1 = 1;
+          for (int d = 2; d * d <= nfft; ++d)
+            if (nfft % d == 0) n1 = d;
+          if (n1 > 1)
+            pd.initSixStep(n1, &get_subplan(n1,inverse), &get_subplan(nfft/n1,inverse));
+        }
+      }
+      return pd;
+    }
+
+  // Plain Stockham plans used by the six-step algorithm.
+  inline
+    PlanData & get_subplan(int nfft, bool inverse)
+    {
+      PlanData & pd = m_subPlans[ PlanKey(nfft,inverse) ];
+      if ( pd.m_nfft == 0 )
+        pd.init(nfft,inverse);
+      return pd;
+    }
+
+  inline
+    RealPlan get_real_plan(int nfft, bool inverse)
+    {
+      RealPlan rp;
+      rp.nfft = nfft;
+      if ( nfft&1 ) {
+        rp.plan = &get_plan(nfft,inverse);
+        rp.twiddles = 0;
+      }else{
+        rp.plan = &get_plan(nfft>>1,inverse);
+        rp.twiddles = real_twiddles(nfft>>1);
+      }
+      return rp;
+    }
+
+  inline
+    void reserve(const RealPlan & rp)
+    {
+      if (Index(m_tmpBuf1.size()) < rp.tmpSize())
+        m_tmpBuf1.resize(rp.tmpSize());
+      if (Index(m_scratch.size()) < rp.plan->scratchSize())
+        m_scratch.resize(rp.plan->scratchSize());
+    }
+
+  inline
+    void work(const PlanData & pd, Complex * dst, const Complex * src)
+    {
+      if (dst == src) {
+        work(pd, &m_tmpBuf2, src, pd.m_nfft);
+        std::copy(m_tmpBuf2.begin(), m_tmpBuf2.begin() + pd.m_nfft, dst);
+        return;
+      }
+      const Index scratchSize = pd.scratchSize();
+      if (Index(m_scratch.size()) < scratchSize)
+        m_scratch.resize(scratchSize);
+      pd.work(dst, src, &m_scratch[0]);
+    }
+
+  inline
+    void work(const PlanData & pd, std::vector<Complex> * dst, const Complex * src, int nfft)
+    {
+      dst->resize(nfft);
+      work(pd, &(*dst)[0], src);
+    }
+
+  // For even sizes, the even and odd samples are packed into the real and
+  // imaginary parts of a half length complex sequence, and the spectra of the
+  // two halves are separated and recombined after a single complex FFT.
+  static void realFwd(const RealPlan & rp, Complex * dst, const Scalar * src, Complex * tmp, Complex * scratch)
+    {
+      const int nfft = rp.nfft;
+      if ( nfft&1 ) {
+        for (int k=0;k<nfft;++k)
+          tmp[k] = Complex(src[k]);
+        rp.plan->work(tmp+nfft, tmp, scratch);
+        std::copy(tmp+nfft, tmp+nfft+(nfft>>1)+1, dst);
+      }else{
+        const int ncfft = nfft>>1;
+        const Complex * rtw = rp.twiddles;
+        const Complex * csrc = reinterpret_cast<const Complex*>(src);
+        Complex * out = (static_cast<const void*>(dst) == static_cast<const void*>(src)) ? tmp : dst;
+        rp.plan->work(out, csrc, scratch);
+        const Complex dc = out[0].real() + out[0].imag();
+        const Complex nyquist = out[0].real() - out[0].imag();
+        for (int k=1;k <= ncfft/2; ++k) {
+          const Complex fpk = out[k];
+          const Complex fpnk = conj(out[ncfft-k]);
+          const Complex f1k = fpk + fpnk;
+          const Complex tw = fft_mul(Complex(fpk - fpnk), rtw[k]);
+          dst[k] = (f1k + tw) * Scalar(.5);
+          dst[ncfft-k] = conj(f1k - tw) * Scalar(.5);
+        }
+        dst[0] = dc;
+        dst[ncfft] = nyquist;
+      }
+    }
+
+  static void realInv(const RealPlan & rp, Scalar * dst, const Complex * src, Complex * tmp, Complex * scratch)
+    {
+      const int nfft = rp.nfft;
+      if ( nfft&1 ) {
+        std::copy(src,src+(nfft>>1)+1,tmp);
+        for (int k=1;k<(nfft>>1)+1;++k)
+          tmp[nfft-k] = conj(tmp[k]);
+        rp.plan->work(tmp+nfft, tmp, scratch);
+        for (int k=0;k<nfft;++k)
+          dst[k] = tmp[nfft+k].real();
+      }else{
+        const int ncfft = nfft>>1;
+        const Complex * rtw = rp.twiddles;
+        tmp[0] = Complex( src[0].real() + src[ncfft].real(), src[0].real() - src[ncfft].real() );
+        for (int k = 1; k <= ncfft / 2; ++k) {
+          const Complex fk = src[k];
+          const Complex fnkc = conj(src[ncfft-k]);
+          const Complex fek = fk + fnkc;
+          const Complex fok = fft_mul(Complex(fk - fnkc), conj(rtw[k]));
+          tmp[k] = fek + fok;
+          tmp[ncfft-k] = conj(fek - fok);
+        }
+        rp.plan->work(reinterpret_cast<Complex*>(dst), tmp, scratch);
+      }
+    }
+
+  static void realWork(const RealPlan & rp, Complex * dst, const Scalar * src, Complex * tmp, Complex * scratch)
+    { realFwd(rp, dst, src, tmp, scratch); }
+
+  static void realWork(const RealPlan & rp, Scalar * dst, const Complex * src, Complex * tmp, Complex * scratch)
+    { realInv(rp, dst, src, tmp, scratch); }
+
+  // Transforms the complex signals [first, last) of a batch. Unless they are
+  // contiguous, the signals are processed PlanData::SixStepBatch at a time,
+  // interleaved so that the butterflies vectorize across them.
+  struct complex_batch_task
+  {
+    const PlanData * m_plan;
+    Complex * m_dst;
+    const Complex * m_src;
+    Index m_howmany, m_istride, m_idist, m_ostride, m_odist, m_block;
+
+    void operator()(Index first, Index last) const
+    {
+      const Index nfft = m_plan->m_nfft;
+      const Index begin = first * m_block;
+      const Index end = (std::min)(last * m_block, m_howmany);
+      const bool contiguous = m_istride == 1 && m_ostride == 1;
+      std::vector<Complex> buf(m_block * (2 * nfft + m_plan->scratchSize()));
+      Complex * in = &buf[0];
+      Complex * out = in + m_block * nfft;
+      Complex * scratch = out + m_block * nfft;
+      for (Index b0 = begin; b0 < end; b0 += m_block) {
+        const Index bs = (std::min)(m_block, end - b0);
+        if (contiguous) {
+          const Complex * src = m_src + b0 * m_idist;
+          Complex * dst = m_dst + b0 * m_odist;
+          if (dst == src) {
+            m_plan->work(out, src, scratch);
+            std::copy(out, out + nfft, dst);
+          } else {
+            m_plan->work(dst, src, scratch);
+          }
+          continue;
+        }
+        for (Index i = 0; i < nfft; ++i)
+          for (Index b = 0; b < bs; ++b)
+            in[i * bs + b] = m_src[(b0 + b) * m_idist + i * m_istride];
+        m_plan->work(out, in, scratch, bs);
+        for (Index k = 0; k < nfft; ++k)
+          for (Index b = 0; b < bs; ++b)
+            m_dst[(b0 + b) * m_odist + k * m_ostride] = out[k * bs + b];
+      }
+    }
+  };
+
+  template <typename Executor>
+  inline
+    void complex_batch(const PlanData & pd, Complex * dst, const Complex * src, Index howmany,
+                       Index istride, Index idist, Index ostride, Index odist, const Executor & exec)
+    {
+      const bool interleave = !(istride == 1 && ostride == 1) && pd.m_n1 == 0;
+      const Index block = interleave ? Index(PlanData::SixStepBatch) : 1;
+      complex_batch_task task = { &pd, dst, src, howmany, istride, idist, ostride, odist, block };
+      exec((howmany + block - 1) / block, task);
+    }
+
+  // Transforms the real signals (forward) or the half spectra (inverse)
+  // [first, last) of a batch.
+  template <typename Dst, typename Src>
+  struct real_batch_task
+  {
+    RealPlan m_plan;
+    Dst * m_dst;
+    const Src * m_src;
+    Index m_nin, m_nout, m_istride, m_idist, m_ostride, m_odist;
+
+    void operator()(Index first, Index last) const
+    {
+      std::vector<Complex> buf(m_plan.tmpSize() + m_plan.plan->scratchSize());
+      std::vector<Src> in(m_istride == 1 ? 0 : m_nin);
+      std::vector<Dst> out(m_ostride == 1 ? 0 : m_nout + 1);
+      for (Index b = first; b < last; ++b) {
+        const Src * src = m_src + b * m_idist;
+        Dst * dst = m_dst + b * m_odist;
+        if (m_istride != 1) {
+          for (Index i = 0; i < m_nin; ++i) in[i] = src[i * m_istride];
+          src = &in[0];
+        }
+        realWork(m_plan, m_ostride == 1 ? dst : &out[0], src, &buf[0], &buf[0] + m_plan.tmpSize());
+        if (m_ostride != 1)
+          for (Index k = 0; k < m_nout; ++k) dst[k * m_ostride] = out[k];
+      }
+    }
+  };
+
+  // exp(-i*pi*(k/ncfft + 1/2)) for k in [0, ncfft/2]
+  inline
+    const Complex * real_twiddles(int ncfft)
+    {
+      using std::acos;
+      std::vector<Complex> & twidref = m_realTwiddles[ncfft];// creates new if not there
+      if ( (int)twidref.size() != ncfft/2+1 ) {
+        twidref.resize(ncfft/2+1);
+        Scalar pi = acos( Scalar(-1) );
+        for (int k=0;k<=ncfft/2;++k)
+          twidref[k] = exp( Complex(0,-pi * (Scalar(k) / ncfft + Scalar(.5)) ) );
+      }
+      return &twidref[0];
+    }
+};
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+/* vim: set filetype=cpp et sw=2 ts=2 ai: */
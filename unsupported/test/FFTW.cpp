@@ -7,8 +7,12 @@
 // Public License v. 2.0. If a copy of the MPL was not distributed
 // with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
+#define EIGEN_USE_THREADS
 #include "main.h"
 #include <unsupported/Eigen/FFT>
+#if EIGEN_HAS_CXX11
+#include <unsupported/Eigen/CXX11/Tensor>
+#endif
 
 template <typename T> 
 std::complex<T> RandomCpx() { return std::complex<T>( (T)(rand()/(T)RAND_MAX - .5), (T)(rand()/(T)RAND_MAX - .5) ); }
@@ -177,7 +181,39 @@ void test_complex(int nfft)
   test_complex_generic<StdVectorContainer,T>(nfft);
   test_complex_generic<EigenVectorContainer,T>(nfft);
 }
-/*
+// Transforms too long for fft_rmse: check a roundtrip and a few bins only.
+// Such sizes exercise the cache blocked code paths of the default backend.
+template <typename T>
+void test_complex_large(int nfft)
+{
+    typedef typename FFT<T>::Complex Complex;
+    FFT<T> fft;
+
+    vector<Complex> inbuf(nfft);
+    vector<Complex> outbuf;
+    vector<Complex> buf2;
+    for (int k=0;k<nfft;++k)
+        inbuf[k]= Complex( (T)(rand()/(double)RAND_MAX - .5), (T)(rand()/(double)RAND_MAX - .5) );
+    fft.fwd( outbuf , inbuf);
+
+    long double pi = acos((long double)-1 );
+    long double totalpower=0;
+    long double difpower=0;
+    const int bins[] = {0, 1, 7, nfft/3, nfft/2, nfft-1};
+    for (int b=0;b<6;++b) {
+        complex<long double> acc = 0;
+        long double phinc = (long double)(-2.)* pi / nfft;
+        for (int k1=0;k1<nfft;++k1)
+            acc +=  promote( inbuf[k1] ) * exp( complex<long double>(0,(((long long)k1*bins[b])%nfft)*phinc) );
+        totalpower += numext::abs2(acc);
+        difpower += numext::abs2(acc - promote(outbuf[bins[b]]));
+    }
+    VERIFY( T(sqrt(difpower/totalpower)) < test_precision<T>()  );
+
+    fft.inv( buf2 , outbuf);
+    VERIFY( T(dif_rmse(inbuf,buf2)) < test_precision<T>()  );
+}
+
 template <typename T,int nrows,int ncols>
 void test_complex2d()
 {
@@ -205,9 +241,114 @@ void test_complex2d()
     VERIFY( (src-src2).norm() < test_precision<T>() );
     VERIFY( (dst-dst2).norm() < test_precision<T>() );
 }
-*/
 
 
+struct no_device {};
+
+template <typename FFT_, typename Dst, typename Src>
+void batch_fwd(FFT_& fft, Dst * dst, const Src * src, int nfft, int howmany, int stride, int dist, const no_device&)
+{
+    fft.fwd(dst, src, nfft, howmany, stride, dist, stride, dist);
+}
+
+template <typename FFT_, typename Dst, typename Src>
+void batch_inv(FFT_& fft, Dst * dst, const Src * src, int nfft, int howmany, int stride, int dist, const no_device&)
+{
+    fft.inv(dst, src, nfft, howmany, stride, dist, stride, dist);
+}
+
+template <typename FFT_, typename Dst, typename Src, typename Device>
+void batch_fwd(FFT_& fft, Dst * dst, const Src * src, int nfft, int howmany, int stride, int dist, const Device& device)
+{
+    fft.fwd(dst, src, nfft, howmany, stride, dist, stride, dist, device);
+}
+
+template <typename FFT_, typename Dst, typename Src, typename Device>
+void batch_inv(FFT_& fft, Dst * dst, const Src * src, int nfft, int howmany, int stride, int dist, const Device& device)
+{
+    fft.inv(dst, src, nfft, howmany, stride, dist, stride, dist, device);
+}
+
+template <typename T>
+vector<T> batch_signal(const vector<T> & buf, int b, int n, int stride, int dist)
+{
+    vector<T> signal(n);
+    for (int i=0;i<n;++i)
+        signal[i] = buf[b*dist + i*stride];
+    return signal;
+}
+
+// Compares batched transforms of signals stored along the rows and along the
+// columns of a row major howmany x nfft array to the single transforms.
+template <typename T, typename Device>
+void test_batch(int nfft, int howmany, const Device& device)
+{
+    typedef typename FFT<T>::Complex Complex;
+    FFT<T> fft;
+
+    vector<Complex> inbuf(nfft*howmany), outbuf(nfft*howmany), buf2(nfft*howmany);
+    vector<T> tbuf(nfft*howmany), tbuf2(nfft*howmany);
+    for (int k=0;k<nfft*howmany;++k) {
+        inbuf[k]= Complex( (T)(rand()/(double)RAND_MAX - .5), (T)(rand()/(double)RAND_MAX - .5) );
+        tbuf[k]= (T)( rand()/(double)RAND_MAX - .5);
+    }
+
+    for (int interleaved=0;interleaved<2;++interleaved) {
+        const int stride = interleaved ? howmany : 1;
+        const int dist = interleaved ? 1 : nfft;
+        vector<Complex> ref;
+
+        batch_fwd(fft, &outbuf[0], &inbuf[0], nfft, howmany, stride, dist, device);
+        for (int b=0;b<howmany;++b) {
+            fft.fwd(ref, batch_signal(inbuf, b, nfft, stride, dist));
+            VERIFY( T(dif_rmse(ref, batch_signal(outbuf, b, nfft, stride, dist))) < test_precision<T>() );
+        }
+        batch_inv(fft, &buf2[0], &outbuf[0], nfft, howmany, stride, dist, device);
+        VERIFY( T(dif_rmse(inbuf,buf2)) < test_precision<T>() );
+
+        // in place
+        buf2 = inbuf;
+        batch_fwd(fft, &buf2[0], &buf2[0], nfft, howmany, stride, dist, device);
+        VERIFY( T(dif_rmse(outbuf,buf2)) < test_precision<T>() );
+
+        for (int half=0;half<2;++half) {
+            if (half)
+                fft.SetFlag(fft.HalfSpectrum);
+            const int nbins = half ? (nfft>>1)+1 : nfft;
+            batch_fwd(fft, &outbuf[0], &tbuf[0], nfft, howmany, stride, dist, device);
+            for (int b=0;b<howmany;++b) {
+                fft.fwd(ref, batch_signal(tbuf, b, nfft, stride, dist));
+                VERIFY( T(dif_rmse(ref, batch_signal(outbuf, b, nbins, stride, dist))) < test_precision<T>() );
+            }
+            batch_inv(fft, &tbuf2[0], &outbuf[0], nfft, howmany, stride, dist, device);
+            VERIFY( T(dif_rmse(tbuf,tbuf2)) < test_precision<T>() );
+            fft.ClearFlag(fft.HalfSpectrum);
+        }
+    }
+}
+
+template <typename T>
+void test_batch(int nfft, int howmany)
+{
+    test_batch<T>(nfft, howmany, no_device());
+#if EIGEN_HAS_CXX11
+    Eigen::ThreadPool pool(3);
+    Eigen::ThreadPoolDevice device(&pool, 3);
+    test_batch<T>(nfft, howmany, device);
+
+    // 2-d transforms
+    typedef typename FFT<T>::Complex Complex;
+    FFT<T> fft;
+    Matrix<Complex,Dynamic,Dynamic,RowMajor> src(howmany,nfft), dst(howmany,nfft), dst2(howmany,nfft), src2(howmany,nfft);
+    src.setRandom();
+    fft.fwd2(dst.data(), src.data(), howmany, nfft);
+    fft.fwd2(dst2.data(), src.data(), howmany, nfft, device);
+    VERIFY_IS_APPROX(dst, dst2);
+    fft.inv2(src2.data(), dst2.data(), howmany, nfft, device);
+    VERIFY_IS_APPROX(src, src2);
+#endif
+}
+
 void test_return_by_value(int len)
 {
     VectorXf in;
@@ -228,8 +369,8 @@ void test_return_by_value(int len)
 void test_FFTW()
 {
   CALL_SUBTEST( test_return_by_value(32) );
-  //CALL_SUBTEST( ( test_complex2d<float,4,8> () ) ); CALL_SUBTEST( ( test_complex2d<double,4,8> () ) );
-  //CALL_SUBTEST( ( test_complex2d<long double,4,8> () ) );
+  CALL_SUBTEST( ( test_complex2d<float,4,8> () ) ); CALL_SUBTEST( ( test_complex2d<double,4,8> () ) );
+  CALL_SUBTEST( ( test_complex2d<float,15,12> () ) ); CALL_SUBTEST( ( test_complex2d<double,15,12> () ) );
   CALL_SUBTEST( test_complex<float>(32) ); CALL_SUBTEST( test_complex<double>(32) ); 
   CALL_SUBTEST( test_complex<float>(256) ); CALL_SUBTEST( test_complex<double>(256) ); 
   CALL_SUBTEST( test_complex<float>(3*8) ); CALL_SUBTEST( test_complex<double>(3*8) ); 
@@ -243,6 +384,15 @@ void test_FFTW()
   CALL_SUBTEST( test_scalar<float>(50) ); CALL_SUBTEST( test_scalar<double>(50) ); 
   CALL_SUBTEST( test_scalar<float>(256) ); CALL_SUBTEST( test_scalar<double>(256) ); 
   CALL_SUBTEST( test_scalar<float>(2*3*4*5*7) ); CALL_SUBTEST( test_scalar<double>(2*3*4*5*7) ); 
+  CALL_SUBTEST( test_scalar<float>(2*3*7) ); CALL_SUBTEST( test_scalar<double>(2*3*7) ); 
+  CALL_SUBTEST( test_scalar<float>(2*101) ); CALL_SUBTEST( test_scalar<double>(2*101) ); 
+
+  CALL_SUBTEST( test_batch<float>(64,37) ); CALL_SUBTEST( test_batch<double>(64,37) ); 
+  CALL_SUBTEST( test_batch<float>(30,5) ); CALL_SUBTEST( test_batch<double>(30,5) ); 
+  CALL_SUBTEST( test_batch<float>(45,20) ); CALL_SUBTEST( test_batch<double>(45,20) ); 
+
+  CALL_SUBTEST( test_complex_large<float>(1<<20) ); CALL_SUBTEST( test_complex_large<double>(1<<20) ); 
+  CALL_SUBTEST( test_complex_large<float>(3<<19) ); CALL_SUBTEST( test_complex_large<double>(3<<19) ); 
   
   #ifdef EIGEN_HAS_FFTWL
   CALL_SUBTEST( test_complex<long double>(32) );
@@ -0,0 +1,95 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2018 Eigen contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+#include <unsupported/Eigen/BatchedProduct>
+
+template<typename Scalar, int Rows, int Depth, int Cols>
+void batched_product_arrays(Index batchSize, Index rows = Rows, Index depth = Depth, Index cols = Cols)
+{
+  typedef Matrix<Scalar,Rows,Depth> LhsType;
+  typedef Matrix<Scalar,Depth,Cols> RhsType;
+  typedef Matrix<Scalar,Rows,Cols> DstType;
+
+  std::vector<LhsType,aligned_allocator<LhsType> > lhs(batchSize);
+  std::vector<RhsType,aligned_allocator<RhsType> > rhs(batchSize);
+  std::vector<DstType,aligned_allocator<DstType> > dst(batchSize);
+  for(Index k=0; k<batchSize; ++k)
+  {
+    lhs[k] = LhsType::Random(rows, depth);
+    rhs[k] = RhsType::Random(depth, cols);
+  }
+
+  batchedProduct(lhs, rhs, dst);
+  for(Index k=0; k<batchSize; ++k)
+    VERIFY_IS_APPROX(dst[k], (lhs[k] * rhs[k]).eval());
+
+  // same through the interleaved layout
+  InterleavedMatrixBatch<Scalar,Rows,Depth> ilhs(batchSize, rows, depth);
+  InterleavedMatrixBatch<Scalar,Depth,Cols> irhs(batchSize, depth, cols);
+  InterleavedMatrixBatch<Scalar,Rows,Cols> idst(batchSize, rows, cols);
+  VERIFY_IS_EQUAL(ilhs.size(), batchSize);
+  for(Index k=0; k<batchSize; ++k)
+  {
+    ilhs.set(k, lhs[k]);
+    irhs.set(k, rhs[k]);
+  }
+  for(Index k=0; k<batchSize; ++k)
+    VERIFY_IS_EQUAL(ilhs.get(k), lhs[k]);
+
+  batchedProduct(ilhs, irhs, idst);
+  for(Index k=0; k<batchSize; ++k)
+    VERIFY_IS_APPROX(idst.get(k), dst[k]);
+}
+
+template<typename Scalar, int Rows, int Depth, int Cols>
+void batched_product_strided(Index batchSize, Index rows = Rows, Index depth = Depth, Index cols = Cols)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> MatrixX;
+  // leave some padding between the matrices of the batch
+  const Index lhsStride = rows*depth + 1, rhsStride = depth*cols + 3, dstStride = rows*cols;
+  Matrix<Scalar,Dynamic,1> lhs = Matrix<Scalar,Dynamic,1>::Random(lhsStride*batchSize);
+  Matrix<Scalar,Dynamic,1> rhs = Matrix<Scalar,Dynamic,1>::Random(rhsStride*batchSize);
+  Matrix<Scalar,Dynamic,1> dst(dstStride*batchSize);
+
+  stridedBatchedProduct<Rows,Depth,Cols>(batchSize, rows, depth, cols,
+                                         lhs.data(), lhsStride, rhs.data(), rhsStride, dst.data(), dstStride);
+  for(Index k=0; k<batchSize; ++k)
+  {
+    MatrixX ref = Map<MatrixX>(lhs.data()+k*lhsStride, rows, depth) * Map<MatrixX>(rhs.data()+k*rhsStride, depth, cols);
+    VERIFY_IS_APPROX(Map<MatrixX>(dst.data()+k*dstStride, rows, cols), ref);
+  }
+
+  stridedBatchedProduct(batchSize, rows, depth, cols,
+                        lhs.data(), lhsStride, rhs.data(), rhsStride, dst.data(), dstStride);
+  for(Index k=0; k<batchSize; ++k)
+  {
+    MatrixX ref = Map<MatrixX>(lhs.data()+k*lhsStride, rows, depth) * Map<MatrixX>(rhs.data()+k*rhsStride, depth, cols);
+    VERIFY_IS_APPROX(Map<MatrixX>(dst.data()+k*dstStride, rows, cols), ref);
+  }
+}
+
+void test_batched_product()
+{
+  for(int i = 0; i < g_repeat; i++) {
+    Index batchSize = internal::random<Index>(1,100);
+    CALL_SUBTEST_1(( batched_product_arrays<float,4,4,4>(batchSize) ));
+    CALL_SUBTEST_1(( batched_product_arrays<float,3,5,2>(batchSize) ));
+    CALL_SUBTEST_2(( batched_product_arrays<double,8,8,8>(batchSize) ));
+    CALL_SUBTEST_2(( batched_product_arrays<double,Dynamic,Dynamic,Dynamic>(batchSize,
+                       internal::random<Index>(1,32), internal::random<Index>(1,32), internal::random<Index>(1,32)) ));
+    CALL_SUBTEST_3(( batched_product_arrays<std::complex<float>,6,6,6>(batchSize) ));
+    CALL_SUBTEST_3(( batched_product_arrays<std::complex<double>,5,3,4>(batchSize) ));
+    CALL_SUBTEST_4(( batched_product_strided<float,16,16,16>(batchSize) ));
+    CALL_SUBTEST_4(( batched_product_strided<double,7,3,5>(batchSize) ));
+    CALL_SUBTEST_4(( batched_product_strided<std::complex<double>,4,4,4>(batchSize) ));
+    CALL_SUBTEST_4(( batched_product_strided<float,Dynamic,Dynamic,Dynamic>(batchSize,
+                       internal::random<Index>(1,32), internal::random<Index>(1,32), internal::random<Index>(1,32)) ));
+  }
+}
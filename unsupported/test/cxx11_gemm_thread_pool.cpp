@@ -0,0 +1,146 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2018 Eigen contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#define EIGEN_USE_THREADS
+#define EIGEN_GEMM_THREADPOOL
+#include "main.h"
+#include "Eigen/CXX11/ThreadPool"
+
+// Counts the products actually dispatched to the pool, and records the number of tasks of the last one.
+class CountingGemmBackend : public ThreadPoolGemmBackend {
+ public:
+  explicit CountingGemmBackend(ThreadPoolInterface* pool)
+      : ThreadPoolGemmBackend(pool), calls(0), last_tasks(0) {}
+  bool run(int n, const std::function<void(int)>& task) {
+    ++calls;
+    last_tasks = n;
+    return ThreadPoolGemmBackend::run(n, task);
+  }
+  std::atomic<int> calls;
+  std::atomic<int> last_tasks;
+};
+
+template<typename MatrixType>
+static void test_product(Index rows, Index depth, Index cols)
+{
+  typedef Matrix<typename MatrixType::Scalar,Dynamic,Dynamic,ColMajor> RefType;
+  MatrixType a = MatrixType::Random(rows, depth);
+  MatrixType b = MatrixType::Random(depth, cols);
+  MatrixType c = MatrixType::Random(rows, cols);
+  RefType ref = RefType(c) + RefType(a).lazyProduct(RefType(b));
+  c.noalias() += a * b;
+  VERIFY_IS_APPROX(RefType(c), ref);
+}
+
+// Checks that the product is computed on the pool by at least min_tasks tasks. The products passed here have a
+// destination too narrow or too short to give every thread a panel of several register blocks, so the threads
+// cannot share the packed lhs and such a product can only run in parallel with the 2D tiled schedule.
+template<typename MatrixType>
+static void test_tiled_product(CountingGemmBackend& backend, Index rows, Index depth, Index cols, int min_tasks)
+{
+  const int calls = backend.calls;
+  test_product<MatrixType>(rows, depth, cols);
+  VERIFY_IS_EQUAL(int(backend.calls), calls+1);
+  VERIFY(backend.last_tasks >= min_tasks);
+}
+
+static void test_global_backend()
+{
+  ThreadPool pool(4);
+  CountingGemmBackend backend(&pool);
+  setGemmParallelBackend(&backend);
+  VERIFY_IS_EQUAL(gemmParallelBackend(), static_cast<GemmParallelBackend*>(&backend));
+  VERIFY_IS_EQUAL(nbThreads(), 4);
+
+  test_product<MatrixXf>(200, 150, 180);
+  test_product<MatrixXd>(97, 301, 203);
+  test_product<Matrix<double,Dynamic,Dynamic,RowMajor> >(203, 64, 301);
+  test_product<MatrixXcf>(130, 70, 111);
+  VERIFY(backend.calls > 0);
+
+  // tall-skinny and short-wide products are split into 2D tiles, and use all the threads
+  test_tiled_product<MatrixXd>(backend, 2000, 64, 8, 4);
+  test_tiled_product<MatrixXf>(backend, 7, 300, 1500, 4);
+  test_tiled_product<Matrix<float,Dynamic,Dynamic,RowMajor> >(backend, 1500, 100, 9, 4);
+  // a small destination with a large depth is split along the depth too
+  test_tiled_product<MatrixXd>(backend, 12, 20000, 8, 2);
+  test_tiled_product<Matrix<double,Dynamic,Dynamic,RowMajor> >(backend, 9, 10000, 14, 2);
+
+  // setNbThreads() still bounds the number of threads
+  setNbThreads(2);
+  VERIFY_IS_EQUAL(nbThreads(), 2);
+  test_product<MatrixXd>(150, 150, 150);
+  setNbThreads(0);
+
+  setGemmParallelBackend(0);
+  VERIFY(gemmParallelBackend() == 0);
+}
+
+static void test_scoped_backend()
+{
+  ThreadPool pool(3);
+  CountingGemmBackend backend(&pool);
+  {
+    ScopedGemmParallelBackend scope(&backend);
+    VERIFY_IS_EQUAL(gemmParallelBackend(), static_cast<GemmParallelBackend*>(&backend));
+    test_product<MatrixXf>(256, 128, 256);
+  }
+  VERIFY(gemmParallelBackend() == 0);
+  VERIFY(backend.calls > 0);
+
+  // The override is local to the calling thread.
+  const int calls = backend.calls;
+  ScopedGemmParallelBackend scope(&backend);
+  std::thread other([]() { test_product<MatrixXf>(256, 128, 256); });
+  other.join();
+  VERIFY_IS_EQUAL(int(backend.calls), calls);
+}
+
+static void test_nested_products()
+{
+  // Products computed from within the pool must not be dispatched to the pool again.
+  ThreadPool pool(2);
+  CountingGemmBackend backend(&pool);
+  setGemmParallelBackend(&backend);
+  std::atomic<bool> done(false);
+  pool.Schedule([&]() {
+    test_product<MatrixXd>(128, 128, 128);
+    done = true;
+  });
+  while (!done) std::this_thread::yield();
+  VERIFY_IS_EQUAL(int(backend.calls), 0);
+  setGemmParallelBackend(0);
+}
+
+static void test_concurrent_set_backend()
+{
+  // The global backend can be changed while another thread is running products.
+  ThreadPool pool(2);
+  CountingGemmBackend backend(&pool);
+  std::atomic<bool> done(false);
+  std::thread other([&]() {
+    for (int i = 0; i < 20; ++i) test_product<MatrixXf>(96, 64, 96);
+    done = true;
+  });
+  while (!done) {
+    setGemmParallelBackend(&backend);
+    std::this_thread::yield();
+    setGemmParallelBackend(0);
+  }
+  other.join();
+  VERIFY(gemmParallelBackend() == 0);
+}
+
+void test_cxx11_gemm_thread_pool()
+{
+  CALL_SUBTEST(test_global_backend());
+  CALL_SUBTEST(test_scoped_backend());
+  CALL_SUBTEST(test_nested_products());
+  CALL_SUBTEST(test_concurrent_set_backend());
+}
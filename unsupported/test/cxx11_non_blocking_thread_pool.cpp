@@ -116,10 +116,86 @@ static void test_cancel()
   tp.Cancel();
 }
 
+static void test_topology()
+{
+  std::vector<int> cpus = ThreadTopology::ParseCpuList("0-3,8,10-11\n");
+  VERIFY_IS_EQUAL(cpus.size(), size_t(7));
+  VERIFY_IS_EQUAL(cpus[3], 3);
+  VERIFY_IS_EQUAL(cpus[4], 8);
+  VERIFY_IS_EQUAL(cpus[6], 11);
+
+  ThreadTopology uniform = ThreadTopology::Uniform(2, 6);
+  VERIFY_IS_EQUAL(uniform.NumNodes(), 2);
+  VERIFY_IS_EQUAL(uniform.NumCpus(), 6);
+  VERIFY_IS_EQUAL(uniform.nodes[1][0], 3);
+
+  ThreadTopology detected = ThreadTopology::Detect();
+  VERIFY_GE(detected.NumNodes(), 1);
+  VERIFY_GE(detected.NumCpus(), detected.NumNodes());
+}
+
+static void test_numa_pool(const ThreadTopology& topology, ThreadAffinity affinity)
+{
+  const int kThreads = 8;
+  NonBlockingThreadPool tp(kThreads, topology, affinity);
+  VERIFY_IS_EQUAL(tp.NumThreads(), kThreads);
+  VERIFY_IS_EQUAL(tp.NumNodes(), topology.NumNodes());
+  int expected_start = 0;
+  for (int node = 0; node < tp.NumNodes(); ++node) {
+    int start, limit;
+    tp.NodeThreads(node, &start, &limit);
+    VERIFY_IS_EQUAL(start, expected_start);
+    VERIFY_LE(start, limit);
+    expected_start = limit;
+  }
+  VERIFY_IS_EQUAL(expected_start, kThreads);
+
+  // Tasks scheduled on one node must still be picked up by the idle threads
+  // of the other nodes.
+  for (int iter = 0; iter < 20; ++iter) {
+    std::atomic<int> running(0);
+    std::atomic<int> phase(0);
+    Barrier done(kThreads);
+    for (int i = 0; i < kThreads; ++i) {
+      tp.ScheduleOnNode([&]() {
+        running++;
+        while (phase < 1) {
+        }
+        done.Notify();
+      }, iter % tp.NumNodes());
+    }
+    while (running != kThreads) {
+    }
+    phase = 1;
+    done.Wait();
+  }
+
+  // Tasks scheduled with a hint from the workers.
+  std::atomic<int> count(0);
+  Barrier done(2 * kThreads);
+  for (int i = 0; i < kThreads; ++i) {
+    tp.ScheduleWithHint([&]() {
+      VERIFY_GE(tp.CurrentThreadId(), 0);
+      tp.ScheduleWithHint([&]() {
+        count++;
+        done.Notify();
+      }, kThreads - 1, kThreads);
+      count++;
+      done.Notify();
+    }, 0, 1);
+  }
+  done.Wait();
+  VERIFY_IS_EQUAL(count, 2 * kThreads);
+}
+
 void test_cxx11_non_blocking_thread_pool()
 {
   CALL_SUBTEST(test_create_destroy_empty_pool());
   CALL_SUBTEST(test_parallelism(true));
   CALL_SUBTEST(test_parallelism(false));
   CALL_SUBTEST(test_cancel());
+  CALL_SUBTEST(test_topology());
+  CALL_SUBTEST(test_numa_pool(ThreadTopology::Uniform(2, 4), kNoAffinity));
+  CALL_SUBTEST(test_numa_pool(ThreadTopology::Uniform(3, 6), kCpuAffinity));
+  CALL_SUBTEST(test_numa_pool(ThreadTopology::Detect(), kNodeAffinity));
 }
@@ -273,6 +273,95 @@ static void test_argmin_dim()
   }
 }
 
+template <int DataLayout>
+static void test_argmax_long_rows()
+{
+  // Rows that span several blocks of the vectorized search, with the extremum
+  // repeated in different blocks: the first occurrence must be returned.
+  const int num_rows = 5;
+  const int num_cols = internal::random<int>(3000, 5000);
+  const int inner_dim = (static_cast<int>(DataLayout) == static_cast<int>(ColMajor)) ? 0 : 1;
+  Tensor<float, 2, DataLayout> tensor(inner_dim == 0 ? num_cols : num_rows,
+                                      inner_dim == 0 ? num_rows : num_cols);
+  tensor.setRandom();
+  for (int row = 0; row < num_rows; ++row) {
+    const int first = internal::random<int>(0, num_cols - 1);
+    const int second = internal::random<int>(first, num_cols - 1);
+    const int third = internal::random<int>(0, num_cols - 1);
+    const int fourth = internal::random<int>(third, num_cols - 1);
+    for (int col : {first, second}) {
+      if (inner_dim == 0) tensor(col, row) = 2.0f; else tensor(row, col) = 2.0f;
+    }
+    for (int col : {third, fourth}) {
+      if (inner_dim == 0) tensor(col, row) = -2.0f; else tensor(row, col) = -2.0f;
+    }
+  }
+
+  Tensor<DenseIndex, 1, DataLayout> tensor_argmax = tensor.argmax(inner_dim);
+  Tensor<DenseIndex, 1, DataLayout> tensor_argmin = tensor.argmin(inner_dim);
+  for (int row = 0; row < num_rows; ++row) {
+    DenseIndex expected_max = 0;
+    DenseIndex expected_min = 0;
+    for (int col = 0; col < num_cols; ++col) {
+      const float value = inner_dim == 0 ? tensor(col, row) : tensor(row, col);
+      const float max_value = inner_dim == 0 ? tensor(expected_max, row) : tensor(row, expected_max);
+      const float min_value = inner_dim == 0 ? tensor(expected_min, row) : tensor(row, expected_min);
+      if (value > max_value) expected_max = col;
+      if (value < min_value) expected_min = col;
+    }
+    VERIFY_IS_EQUAL(tensor_argmax(row), expected_max);
+    VERIFY_IS_EQUAL(tensor_argmin(row), expected_min);
+  }
+
+  // Full reductions return the index of the coefficient in the tensor.
+  Tensor<DenseIndex, 0, DataLayout> full_argmax = tensor.argmax();
+  Tensor<DenseIndex, 0, DataLayout> full_argmin = tensor.argmin();
+  DenseIndex expected_max = 0;
+  DenseIndex expected_min = 0;
+  for (DenseIndex i = 0; i < tensor.size(); ++i) {
+    if (tensor.data()[i] > tensor.data()[expected_max]) expected_max = i;
+    if (tensor.data()[i] < tensor.data()[expected_min]) expected_min = i;
+  }
+  VERIFY_IS_EQUAL(full_argmax(), expected_max);
+  VERIFY_IS_EQUAL(full_argmin(), expected_min);
+}
+
+template <int DataLayout>
+static void test_argmax_nan()
+{
+  // NaNs are never selected, as by the tuple reducers, wherever they are.
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  Tensor<float, 1, DataLayout> small(3);
+  small.setValues({nan, 1.0f, 5.0f});
+  Tensor<DenseIndex, 0, DataLayout> small_argmax = small.argmax();
+  VERIFY_IS_EQUAL(small_argmax(), 2);
+  small.setValues({nan, 5.0f, 1.0f});
+  Tensor<DenseIndex, 0, DataLayout> small_argmin = small.argmin();
+  VERIFY_IS_EQUAL(small_argmin(), 2);
+
+  // Long enough for the vectorized search, with NaNs in its first packets.
+  Tensor<float, 1, DataLayout> tensor(internal::random<int>(3000, 5000));
+  tensor.setRandom();
+  for (int i = 0; i < 40; ++i) {
+    tensor(i) = nan;
+  }
+  for (int i = 0; i < 20; ++i) {
+    tensor(internal::random<int>(40, tensor.size() - 1)) = nan;
+  }
+  DenseIndex expected_max = 0;
+  DenseIndex expected_min = 0;
+  float max_value = NumTraits<float>::lowest();
+  float min_value = NumTraits<float>::highest();
+  for (DenseIndex i = 0; i < tensor.size(); ++i) {
+    if (tensor(i) > max_value) { max_value = tensor(i); expected_max = i; }
+    if (tensor(i) < min_value) { min_value = tensor(i); expected_min = i; }
+  }
+  Tensor<DenseIndex, 0, DataLayout> tensor_argmax = tensor.argmax();
+  Tensor<DenseIndex, 0, DataLayout> tensor_argmin = tensor.argmin();
+  VERIFY_IS_EQUAL(tensor_argmax(), expected_max);
+  VERIFY_IS_EQUAL(tensor_argmin(), expected_min);
+}
+
 void test_cxx11_tensor_argmax()
 {
   CALL_SUBTEST(test_simple_index_tuples<RowMajor>());
@@ -291,4 +380,8 @@ void test_cxx11_tensor_argmax()
   CALL_SUBTEST(test_argmax_dim<ColMajor>());
   CALL_SUBTEST(test_argmin_dim<RowMajor>());
   CALL_SUBTEST(test_argmin_dim<ColMajor>());
+  CALL_SUBTEST(test_argmax_long_rows<RowMajor>());
+  CALL_SUBTEST(test_argmax_long_rows<ColMajor>());
+  CALL_SUBTEST(test_argmax_nan<RowMajor>());
+  CALL_SUBTEST(test_argmax_nan<ColMajor>());
 }
@@ -510,6 +510,72 @@ static void test_const_inputs()
   VERIFY_IS_APPROX(mat3(1,1), mat1(1,0)*mat2(0,1) + mat1(1,1)*mat2(1,1) + mat1(1,2)*mat2(2,1));
 }
 
+// Takes the square root of each coefficient and adds the index of its first
+// dimension, which checks the block offsets passed to the output kernel.
+struct SqrtPlusRowOutputKernel {
+  template <typename Index, typename Scalar>
+  EIGEN_ALWAYS_INLINE void operator()(
+      const internal::blas_data_mapper<Scalar, Index, ColMajor>& output_mapper,
+      const TensorContractionParams& params, Index i, Index j,
+      Index num_rows, Index num_cols) const {
+    for (Index c = 0; c < num_cols; ++c) {
+      for (Index r = 0; r < num_rows; ++r) {
+        // RowMajor outputs are seen transposed.
+        const Index row = params.swapped_arguments ? j + c : i + r;
+        output_mapper(r, c) = numext::sqrt(output_mapper(r, c)) + Scalar(row);
+      }
+    }
+  }
+};
+
+template<int DataLayout>
+static void test_output_kernel()
+{
+  Tensor<float, 2, DataLayout> mat1(internal::random<int>(1, 600), 351);
+  Tensor<float, 2, DataLayout> mat2(351, internal::random<int>(1, 400));
+  // Keep the products positive.
+  mat1.setRandom();
+  mat2.setRandom();
+  mat1 = mat1.abs();
+  mat2 = mat2.abs();
+
+  Eigen::array<DimPair, 1> dims = {{DimPair(1, 0)}};
+  Tensor<float, 2, DataLayout> ref = mat1.contract(mat2, dims);
+  Tensor<float, 2, DataLayout> result =
+      mat1.contract(mat2, dims, SqrtPlusRowOutputKernel());
+
+  for (int i = 0; i < ref.dimension(0); ++i) {
+    for (int j = 0; j < ref.dimension(1); ++j) {
+      VERIFY_IS_APPROX(result(i, j), std::sqrt(ref(i, j)) + i);
+    }
+  }
+
+  // Matrix-vector products are evaluated by gemv.
+  Tensor<float, 1, DataLayout> vec(351);
+  vec.setRandom();
+  vec = vec.abs();
+  Tensor<float, 1, DataLayout> ref_vec = mat1.contract(vec, dims);
+  Tensor<float, 1, DataLayout> result_vec =
+      mat1.contract(vec, dims, SqrtPlusRowOutputKernel());
+  for (int i = 0; i < ref_vec.dimension(0); ++i) {
+    // A RowMajor matrix-vector product is a single row of the transposed
+    // output, whose column index is the index of the result.
+    VERIFY_IS_APPROX(result_vec(i), std::sqrt(ref_vec(i)) + i);
+  }
+
+  // The product over an empty dimension is zero, and still goes through the
+  // output kernel.
+  Tensor<float, 2, DataLayout> empty1(mat1.dimension(0), 0);
+  Tensor<float, 2, DataLayout> empty2(0, internal::random<int>(2, 40));
+  Tensor<float, 2, DataLayout> result_empty =
+      empty1.contract(empty2, dims, SqrtPlusRowOutputKernel());
+  for (int i = 0; i < result_empty.dimension(0); ++i) {
+    for (int j = 0; j < result_empty.dimension(1); ++j) {
+      VERIFY_IS_EQUAL(result_empty(i, j), float(i));
+    }
+  }
+}
+
 void test_cxx11_tensor_contraction()
 {
   CALL_SUBTEST(test_evals<ColMajor>());
@@ -542,4 +608,6 @@ void test_cxx11_tensor_contraction()
   CALL_SUBTEST(test_tensor_product<RowMajor>());
   CALL_SUBTEST(test_const_inputs<ColMajor>());
   CALL_SUBTEST(test_const_inputs<RowMajor>());
+  CALL_SUBTEST(test_output_kernel<ColMajor>());
+  CALL_SUBTEST(test_output_kernel<RowMajor>());
 }
@@ -136,6 +136,55 @@ static void test_strides() {
                                input(12)*kernel(2)));
 }
 
+template <int DataLayout>
+static void test_large_kernels() {
+  // Long lines exercise the vectorized cpu kernel, including its partial
+  // packets, for both unrolled and generic kernel sizes.
+  Tensor<float, 3, DataLayout> input(internal::random<int>(40, 70), 13, internal::random<int>(40, 70));
+  input.setRandom();
+
+  for (int kernel_size = 1; kernel_size <= 11; ++kernel_size) {
+    Tensor<float, 1, DataLayout> kernel(kernel_size);
+    kernel.setRandom();
+    for (ptrdiff_t dim = 0; dim < 3; ++dim) {
+      Eigen::array<ptrdiff_t, 1> dims;
+      dims[0] = dim;
+      Tensor<float, 3, DataLayout> result = input.convolve(kernel, dims);
+      for (int i = 0; i < result.dimension(0); ++i) {
+        for (int j = 0; j < result.dimension(1); ++j) {
+          for (int k = 0; k < result.dimension(2); ++k) {
+            float expected = 0.0f;
+            for (int l = 0; l < kernel_size; ++l) {
+              expected += input(i + (dim == 0 ? l : 0), j + (dim == 1 ? l : 0), k + (dim == 2 ? l : 0)) * kernel(l);
+            }
+            VERIFY_IS_APPROX(result(i, j, k), expected);
+          }
+        }
+      }
+    }
+  }
+
+  Tensor<float, 2, DataLayout> kernel(3, 4);
+  kernel.setRandom();
+  Eigen::array<ptrdiff_t, 2> dims;
+  dims[0] = 0;
+  dims[1] = 2;
+  Tensor<float, 3, DataLayout> result = input.convolve(kernel, dims);
+  for (int i = 0; i < result.dimension(0); ++i) {
+    for (int j = 0; j < result.dimension(1); ++j) {
+      for (int k = 0; k < result.dimension(2); ++k) {
+        float expected = 0.0f;
+        for (int l = 0; l < 3; ++l) {
+          for (int m = 0; m < 4; ++m) {
+            expected += input(i + l, j, k + m) * kernel(l, m);
+          }
+        }
+        VERIFY_IS_APPROX(result(i, j, k), expected);
+      }
+    }
+  }
+}
+
 void test_cxx11_tensor_convolution()
 {
   CALL_SUBTEST(test_evals<ColMajor>());
@@ -146,4 +195,6 @@ void test_cxx11_tensor_convolution()
   CALL_SUBTEST(test_modes<RowMajor>());
   CALL_SUBTEST(test_strides<ColMajor>());
   CALL_SUBTEST(test_strides<RowMajor>());
+  CALL_SUBTEST(test_large_kernels<ColMajor>());
+  CALL_SUBTEST(test_large_kernels<RowMajor>());
 }
@@ -0,0 +1,270 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2018 Eigen contributors
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#define EIGEN_USE_THREADS
+
+#include "main.h"
+
+#include <Eigen/CXX11/Tensor>
+
+using Eigen::Tensor;
+using Eigen::array;
+
+// The tensors used below are larger than the first level cache, so that the
+// expressions that prefer block access are evaluated one block at a time.
+
+template <int DataLayout, typename Device>
+static void test_block_shuffling(const Device& device)
+{
+  Tensor<float, 4, DataLayout> input(20, 17, 13, 11);
+  input.setRandom();
+  array<ptrdiff_t, 4> shuffles;
+  shuffles[0] = 3;
+  shuffles[1] = 0;
+  shuffles[2] = 2;
+  shuffles[3] = 1;
+
+  Tensor<float, 4, DataLayout> output(11, 20, 13, 17);
+  output.device(device) = input.shuffle(shuffles);
+  Tensor<float, 4, DataLayout> output2(11, 20, 13, 17);
+  output2.device(device) = (input * 2.0f).shuffle(shuffles) + output;
+
+  for (int i = 0; i < 20; ++i) {
+    for (int j = 0; j < 17; ++j) {
+      for (int k = 0; k < 13; ++k) {
+        for (int l = 0; l < 11; ++l) {
+          VERIFY_IS_EQUAL(output(l, i, k, j), input(i, j, k, l));
+          VERIFY_IS_APPROX(output2(l, i, k, j), 3.0f * input(i, j, k, l));
+        }
+      }
+    }
+  }
+}
+
+template <int DataLayout, typename Device>
+static void test_block_broadcasting(const Device& device)
+{
+  Tensor<float, 3, DataLayout> input(7, 5, 3);
+  input.setRandom();
+  array<ptrdiff_t, 3> broadcasts;
+  broadcasts[0] = 9;
+  broadcasts[1] = 11;
+  broadcasts[2] = 13;
+
+  Tensor<float, 3, DataLayout> output(63, 55, 39);
+  output.device(device) = input.broadcast(broadcasts);
+  // The input of the second broadcast has no raw data.
+  Tensor<float, 3, DataLayout> output2(63, 55, 39);
+  output2.device(device) = (input * 2.0f).broadcast(broadcasts);
+
+  for (int i = 0; i < 63; ++i) {
+    for (int j = 0; j < 55; ++j) {
+      for (int k = 0; k < 39; ++k) {
+        VERIFY_IS_EQUAL(output(i, j, k), input(i % 7, j % 5, k % 3));
+        VERIFY_IS_EQUAL(output2(i, j, k), 2.0f * input(i % 7, j % 5, k % 3));
+      }
+    }
+  }
+
+  // Broadcasting of a reshaped matrix.
+  Tensor<float, 2, DataLayout> matrix(40, 30);
+  matrix.setRandom();
+  array<ptrdiff_t, 3> dims;
+  dims[0] = 40;
+  dims[1] = 1;
+  dims[2] = 30;
+  broadcasts[0] = 1;
+  broadcasts[1] = 17;
+  broadcasts[2] = 1;
+  Tensor<float, 3, DataLayout> output3(40, 17, 30);
+  output3.device(device) = matrix.reshape(dims).broadcast(broadcasts);
+  for (int i = 0; i < 40; ++i) {
+    for (int j = 0; j < 17; ++j) {
+      for (int k = 0; k < 30; ++k) {
+        VERIFY_IS_EQUAL(output3(i, j, k), matrix(i, k));
+      }
+    }
+  }
+}
+
+template <int DataLayout, typename Device>
+static void test_block_slicing(const Device& device)
+{
+  Tensor<float, 3, DataLayout> input(40, 30, 20);
+  input.setRandom();
+  array<ptrdiff_t, 3> offsets;
+  offsets[0] = 3;
+  offsets[1] = 4;
+  offsets[2] = 5;
+  array<ptrdiff_t, 3> extents;
+  extents[0] = 35;
+  extents[1] = 25;
+  extents[2] = 15;
+
+  Tensor<float, 3, DataLayout> output(35, 25, 15);
+  output.device(device) = input.slice(offsets, extents);
+  for (int i = 0; i < 35; ++i) {
+    for (int j = 0; j < 25; ++j) {
+      for (int k = 0; k < 15; ++k) {
+        VERIFY_IS_EQUAL(output(i, j, k), input(i + 3, j + 4, k + 5));
+      }
+    }
+  }
+
+  // Assignment of a shuffled tensor to a slice.
+  Tensor<float, 3, DataLayout> source(15, 35, 25);
+  source.setRandom();
+  array<ptrdiff_t, 3> shuffles;
+  shuffles[0] = 1;
+  shuffles[1] = 2;
+  shuffles[2] = 0;
+  Tensor<float, 3, DataLayout> result = input;
+  result.slice(offsets, extents).device(device) = source.shuffle(shuffles);
+  for (int i = 0; i < 40; ++i) {
+    for (int j = 0; j < 30; ++j) {
+      for (int k = 0; k < 20; ++k) {
+        const bool inside = i >= 3 && i < 38 && j >= 4 && j < 29 && k >= 5;
+        if (inside) {
+          VERIFY_IS_EQUAL(result(i, j, k), source(k - 5, i - 3, j - 4));
+        } else {
+          VERIFY_IS_EQUAL(result(i, j, k), input(i, j, k));
+        }
+      }
+    }
+  }
+}
+
+template <int DataLayout, typename Device>
+static void test_block_chipping(const Device& device)
+{
+  Tensor<float, 4, DataLayout> input(50, 30, 20, 10);
+  input.setRandom();
+
+  Tensor<float, 3, DataLayout> output(50, 20, 10);
+  output.device(device) = input.chip(7, 1);
+  for (int i = 0; i < 50; ++i) {
+    for (int k = 0; k < 20; ++k) {
+      for (int l = 0; l < 10; ++l) {
+        VERIFY_IS_EQUAL(output(i, k, l), input(i, 7, k, l));
+      }
+    }
+  }
+
+  // Assignment of a shuffled tensor to a chip.
+  Tensor<float, 3, DataLayout> source(10, 50, 20);
+  source.setRandom();
+  array<ptrdiff_t, 3> shuffles;
+  shuffles[0] = 1;
+  shuffles[1] = 2;
+  shuffles[2] = 0;
+  Tensor<float, 4, DataLayout> result = input;
+  result.chip(7, 1).device(device) = source.shuffle(shuffles);
+  for (int i = 0; i < 50; ++i) {
+    for (int j = 0; j < 30; ++j) {
+      for (int k = 0; k < 20; ++k) {
+        for (int l = 0; l < 10; ++l) {
+          if (j == 7) {
+            VERIFY_IS_EQUAL(result(i, j, k, l), source(l, i, k));
+          } else {
+            VERIFY_IS_EQUAL(result(i, j, k, l), input(i, j, k, l));
+          }
+        }
+      }
+    }
+  }
+}
+
+template <int DataLayout, typename Device>
+static void test_block_padding(const Device& device)
+{
+  Tensor<float, 3, DataLayout> input(30, 40, 20);
+  input.setRandom();
+  array<std::pair<ptrdiff_t, ptrdiff_t>, 3> paddings;
+  paddings[0] = std::make_pair(2, 3);
+  paddings[1] = std::make_pair(0, 4);
+  paddings[2] = std::make_pair(1, 1);
+
+  Tensor<float, 3, DataLayout> output(35, 44, 22);
+  output.device(device) = input.pad(paddings, 1.5f);
+  Tensor<float, 3, DataLayout> output2(35, 44, 22);
+  output2.device(device) = (input * 2.0f).pad(paddings);
+
+  for (int i = 0; i < 35; ++i) {
+    for (int j = 0; j < 44; ++j) {
+      for (int k = 0; k < 22; ++k) {
+        const bool inside = i >= 2 && i < 32 && j < 40 && k >= 1 && k < 21;
+        if (inside) {
+          VERIFY_IS_EQUAL(output(i, j, k), input(i - 2, j, k - 1));
+          VERIFY_IS_EQUAL(output2(i, j, k), 2.0f * input(i - 2, j, k - 1));
+        } else {
+          VERIFY_IS_EQUAL(output(i, j, k), 1.5f);
+          VERIFY_IS_EQUAL(output2(i, j, k), 0.0f);
+        }
+      }
+    }
+  }
+}
+
+template <int DataLayout>
+static void test_block_mapper()
+{
+  typedef internal::TensorBlockMapper<int, Index, 3, DataLayout> TensorBlockMapper;
+  typedef typename TensorBlockMapper::Block TensorBlock;
+
+  const DSizes<Index, 3> dims(37, 23, 17);
+  const internal::TensorBlockShapeType shapes[2] = {internal::kUniformAllDims,
+                                                    internal::kSkewedInnerDims};
+  for (int s = 0; s < 2; ++s) {
+    const TensorBlockMapper block_mapper(dims, shapes[s], 100);
+    VERIFY(block_mapper.block_dims_total_size() <= 100);
+
+    // Every coefficient is incremented once per block that contains it.
+    Tensor<int, 3, DataLayout> coverage(37, 23, 17);
+    coverage.setZero();
+    std::vector<int> data(block_mapper.block_dims_total_size());
+    for (Index b = 0; b < block_mapper.total_block_count(); ++b) {
+      TensorBlock block = block_mapper.GetBlockForIndex(b, &data[0]);
+      internal::TensorBlockReader::Run(&block, coverage.data());
+      for (Index i = 0; i < block.block_sizes().TotalSize(); ++i) {
+        ++data[i];
+      }
+      internal::TensorBlockWriter::Run(block, coverage.data());
+    }
+    for (Index i = 0; i < coverage.size(); ++i) {
+      VERIFY_IS_EQUAL(coverage.data()[i], 1);
+    }
+  }
+}
+
+template <int DataLayout>
+static void test_block_evaluation()
+{
+  DefaultDevice default_device;
+  test_block_shuffling<DataLayout>(default_device);
+  test_block_broadcasting<DataLayout>(default_device);
+  test_block_slicing<DataLayout>(default_device);
+  test_block_chipping<DataLayout>(default_device);
+  test_block_padding<DataLayout>(default_device);
+
+  Eigen::ThreadPool pool(4);
+  Eigen::ThreadPoolDevice thread_pool_device(&pool, 4);
+  test_block_shuffling<DataLayout>(thread_pool_device);
+  test_block_broadcasting<DataLayout>(thread_pool_device);
+  test_block_slicing<DataLayout>(thread_pool_device);
+  test_block_chipping<DataLayout>(thread_pool_device);
+  test_block_padding<DataLayout>(thread_pool_device);
+}
+
+void test_cxx11_tensor_executor()
+{
+  CALL_SUBTEST(test_block_mapper<ColMajor>());
+  CALL_SUBTEST(test_block_mapper<RowMajor>());
+  CALL_SUBTEST(test_block_evaluation<ColMajor>());
+  CALL_SUBTEST(test_block_evaluation<RowMajor>());
+}
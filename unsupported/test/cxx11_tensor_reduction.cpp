@@ -484,6 +484,82 @@ static void test_reduce_middle_dims() {
   }
 }
 
+template <int DataLayout>
+static void test_mean_inner_and_outer_dims() {
+  Tensor<float, 3, DataLayout> in(19, 23, 31);
+  in.setRandom();
+  // Keep the means away from 0.
+  in = in + 2.0f;
+
+  // Reduce the first two dimensions, then the last two, with dimensions only
+  // known at runtime. The results are used in an expression, so they are
+  // evaluated into a temporary buffer.
+  array<int, 2> first_dims;
+  first_dims[0] = 0;
+  first_dims[1] = 1;
+  Tensor<float, 1, DataLayout> first = in.mean(first_dims) * 2.0f;
+  array<int, 2> last_dims;
+  last_dims[0] = 1;
+  last_dims[1] = 2;
+  Tensor<float, 1, DataLayout> last = in.mean(last_dims) * 2.0f;
+
+  for (int i = 0; i < 31; ++i) {
+    float expected = 0.0f;
+    for (int j = 0; j < 19; ++j) {
+      for (int k = 0; k < 23; ++k) {
+        expected += in(j, k, i);
+      }
+    }
+    VERIFY_IS_APPROX(first(i), 2.0f * expected / (19 * 23));
+  }
+  for (int i = 0; i < 19; ++i) {
+    float expected = 0.0f;
+    for (int j = 0; j < 23; ++j) {
+      for (int k = 0; k < 31; ++k) {
+        expected += in(i, j, k);
+      }
+    }
+    VERIFY_IS_APPROX(last(i), 2.0f * expected / (23 * 31));
+  }
+}
+
+// Float sums of many values are accumulated by a tree reduction, so their
+// rounding error doesn't grow linearly with the number of values.
+template <int DataLayout>
+static void test_sum_accuracy() {
+  const int num_values = 1 << 22;
+  Tensor<float, 2, DataLayout> in(DataLayout == ColMajor ? num_values : 2,
+                                  DataLayout == ColMajor ? 2 : num_values);
+  in.setRandom();
+  in = in * 0.5f + 1.0f;
+
+  const int reduced_dim = DataLayout == ColMajor ? 0 : 1;
+  double expected[2] = {0.0, 0.0};
+  for (int i = 0; i < 2; ++i) {
+    for (int j = 0; j < num_values; ++j) {
+      expected[i] += DataLayout == ColMajor ? in(j, i) : in(i, j);
+    }
+  }
+  const double tolerance = 5e-7;
+
+  Tensor<float, 0, DataLayout> full_sum = in.sum();
+  VERIFY_LE(numext::abs(full_sum() - (expected[0] + expected[1])),
+                                tolerance * (expected[0] + expected[1]));
+
+  array<int, 1> reduction_axis;
+  reduction_axis[0] = reduced_dim;
+  Tensor<float, 1, DataLayout> sums = in.sum(reduction_axis);
+  Tensor<float, 1, DataLayout> means = in.mean(reduction_axis);
+  Tensor<float, 1, DataLayout> kahan_sums =
+      in.reduce(reduction_axis, internal::KahanSumReducer<float>());
+  for (int i = 0; i < 2; ++i) {
+    VERIFY_LE(numext::abs(sums(i) - expected[i]), tolerance * expected[i]);
+    VERIFY_LE(numext::abs(means(i) - expected[i] / num_values),
+                                  tolerance * expected[i] / num_values);
+    VERIFY_LE(numext::abs(kahan_sums(i) - expected[i]), tolerance * expected[i]);
+  }
+}
+
 void test_cxx11_tensor_reduction() {
   CALL_SUBTEST(test_trivial_reductions<ColMajor>());
   CALL_SUBTEST(test_trivial_reductions<RowMajor>());
@@ -505,4 +581,8 @@ void test_cxx11_tensor_reduction() {
   CALL_SUBTEST(test_innermost_first_dims<RowMajor>());
   CALL_SUBTEST(test_reduce_middle_dims<ColMajor>());
   CALL_SUBTEST(test_reduce_middle_dims<RowMajor>());
+  CALL_SUBTEST(test_mean_inner_and_outer_dims<ColMajor>());
+  CALL_SUBTEST(test_mean_inner_and_outer_dims<RowMajor>());
+  CALL_SUBTEST(test_sum_accuracy<ColMajor>());
+  CALL_SUBTEST(test_sum_accuracy<RowMajor>());
 }
@@ -83,6 +83,32 @@ static void test_4d_scan()
   }
 }
 
+// Scans along each axis of a tensor whose lines are processed several at a
+// time when they are adjacent in memory.
+template <int DataLayout, bool Exclusive>
+static void test_3d_scan()
+{
+  Tensor<float, 3, DataLayout> tensor(17, 9, 13);
+  tensor.setRandom();
+
+  for (int axis = 0; axis < 3; ++axis) {
+    Tensor<float, 3, DataLayout> result = tensor.cumsum(axis, Exclusive);
+    for (int i = 0; i < 17; ++i) {
+      for (int j = 0; j < 9; ++j) {
+        for (int k = 0; k < 13; ++k) {
+          // The coefficients that come before (i,j,k) along the axis.
+          const int pos = axis == 0 ? i : (axis == 1 ? j : k);
+          float accum = 0;
+          for (int l = 0; l < pos + (Exclusive ? 0 : 1); ++l) {
+            accum += tensor(axis == 0 ? l : i, axis == 1 ? l : j, axis == 2 ? l : k);
+          }
+          VERIFY_IS_EQUAL(result(i, j, k), accum);
+        }
+      }
+    }
+  }
+}
+
 template <int DataLayout>
 static void test_tensor_maps() {
   int inputs[20];
@@ -98,6 +124,17 @@ static void test_tensor_maps() {
   }
 }
 
+template <int DataLayout>
+static void test_empty_scan() {
+  // Scans over an empty axis, and over a non-empty axis of an empty tensor.
+  Tensor<float, 2, DataLayout> tensor(0, 7);
+  for (int axis = 0; axis < 2; ++axis) {
+    Tensor<float, 2, DataLayout> result = tensor.cumsum(axis);
+    VERIFY_IS_EQUAL(result.dimension(0), 0);
+    VERIFY_IS_EQUAL(result.dimension(1), 7);
+  }
+}
+
 void test_cxx11_tensor_scan() {
   CALL_SUBTEST((test_1d_scan<ColMajor, float, true>()));
   CALL_SUBTEST((test_1d_scan<ColMajor, float, false>()));
@@ -105,6 +142,12 @@ void test_cxx11_tensor_scan() {
   CALL_SUBTEST((test_1d_scan<RowMajor, float, false>()));
   CALL_SUBTEST(test_4d_scan<ColMajor>());
   CALL_SUBTEST(test_4d_scan<RowMajor>());
+  CALL_SUBTEST((test_3d_scan<ColMajor, false>()));
+  CALL_SUBTEST((test_3d_scan<ColMajor, true>()));
+  CALL_SUBTEST((test_3d_scan<RowMajor, false>()));
+  CALL_SUBTEST((test_3d_scan<RowMajor, true>()));
   CALL_SUBTEST(test_tensor_maps<ColMajor>());
   CALL_SUBTEST(test_tensor_maps<RowMajor>());
+  CALL_SUBTEST(test_empty_scan<ColMajor>());
+  CALL_SUBTEST(test_empty_scan<RowMajor>());
 }
@@ -232,6 +232,155 @@ void test_multithread_contraction_agrees_with_singlethread() {
   }
 }
 
+template<int DataLayout>
+void test_multithread_contraction_bfloat16() {
+  int contract_size = internal::random<int>(1, 2000);
+
+  Tensor<bfloat16, 3, DataLayout> left(internal::random<int>(1, 80),
+                                       contract_size,
+                                       internal::random<int>(1, 20));
+
+  Tensor<bfloat16, 3, DataLayout> right(internal::random<int>(1, 25),
+                                        contract_size,
+                                        internal::random<int>(1, 37));
+
+  // Keep the values positive so that the products don't cancel out.
+  left.setRandom();
+  right.setRandom();
+  left = left.abs() + left.constant(bfloat16(0.5f));
+  right = right.abs() + right.constant(bfloat16(0.5f));
+
+  typedef Tensor<float, 1>::DimensionPair DimPair;
+  Eigen::array<DimPair, 1> dims({{DimPair(1, 1)}});
+
+  Eigen::ThreadPool tp(internal::random<int>(2, 11));
+  Eigen::ThreadPoolDevice thread_pool_device(&tp, internal::random<int>(2, 11));
+
+  Tensor<float, 4, DataLayout> ref =
+      left.template cast<float>().contract(right.template cast<float>(), dims);
+
+  Tensor<bfloat16, 4, DataLayout> tp_result(ref.dimensions());
+  tp_result.device(thread_pool_device) = left.contract(right, dims);
+
+  // The products are accumulated in float, so the result should be within a
+  // couple of bfloat16 ulps of the float contraction, independently of the
+  // contraction size.
+  for (ptrdiff_t i = 0; i < ref.size(); i++) {
+    VERIFY(numext::abs(float(tp_result.data()[i]) - ref.data()[i]) <=
+           1e-2f * ref.data()[i]);
+  }
+}
+
+// Takes the square root of each coefficient and adds the index of its first
+// dimension, which checks the block offsets passed to the output kernel.
+struct SqrtPlusRowOutputKernel {
+  template <typename Index, typename Scalar>
+  EIGEN_ALWAYS_INLINE void operator()(
+      const internal::blas_data_mapper<Scalar, Index, ColMajor>& output_mapper,
+      const TensorContractionParams& params, Index i, Index j,
+      Index num_rows, Index num_cols) const {
+    for (Index c = 0; c < num_cols; ++c) {
+      for (Index r = 0; r < num_rows; ++r) {
+        // RowMajor outputs are seen transposed.
+        const Index row = params.swapped_arguments ? j + c : i + r;
+        output_mapper(r, c) = Scalar(numext::sqrt(float(output_mapper(r, c))) + row);
+      }
+    }
+  }
+};
+
+template<int DataLayout>
+void test_multithread_contraction_with_output_kernel() {
+  typedef Tensor<float, 1>::DimensionPair DimPair;
+
+  const int num_threads = internal::random<int>(2, 11);
+  ThreadPool threads(num_threads);
+  Eigen::ThreadPoolDevice device(&threads, num_threads);
+
+  Tensor<float, 4, DataLayout> t_left(30, 50, 8, 31);
+  Tensor<float, 5, DataLayout> t_right(8, 31, 7, 20, 10);
+  Tensor<float, 5, DataLayout> t_result(30, 50, 7, 20, 10);
+
+  // Keep the products positive.
+  t_left.setRandom();
+  t_right.setRandom();
+  t_left = t_left.abs();
+  t_right = t_right.abs();
+
+  // this contraction should be equivalent to a single matrix multiplication
+  Eigen::array<DimPair, 2> dims({{DimPair(2, 0), DimPair(3, 1)}});
+
+  typedef Map<Matrix<float, Dynamic, Dynamic, DataLayout>> MapXf;
+  MapXf m_left(t_left.data(), 1500, 248);
+  MapXf m_right(t_right.data(), 248, 1400);
+  Matrix<float, Dynamic, Dynamic, DataLayout> m_result(1500, 1400);
+  m_result = m_left * m_right;
+
+  t_result.device(device) =
+      t_left.contract(t_right, dims, SqrtPlusRowOutputKernel());
+  for (Index i = 0; i < m_result.rows(); ++i) {
+    for (Index j = 0; j < m_result.cols(); ++j) {
+      VERIFY_IS_APPROX(t_result.data()[DataLayout == ColMajor ? i + j * 1500 : i * 1400 + j],
+                       std::sqrt(m_result(i, j)) + i);
+    }
+  }
+
+  // Asynchronous evaluation.
+  t_result.setZero();
+  Eigen::Barrier b(1);
+  t_result.device(device, [&b]() { b.Notify(); }) =
+      t_left.contract(t_right, dims, SqrtPlusRowOutputKernel());
+  b.Wait();
+  for (Index i = 0; i < m_result.rows(); ++i) {
+    for (Index j = 0; j < m_result.cols(); ++j) {
+      VERIFY_IS_APPROX(t_result.data()[DataLayout == ColMajor ? i + j * 1500 : i * 1400 + j],
+                       std::sqrt(m_result(i, j)) + i);
+    }
+  }
+
+  // bfloat16 contractions apply the kernel to the rounded output.
+  Tensor<bfloat16, 2, DataLayout> b_left(internal::random<int>(1, 80), 100);
+  Tensor<bfloat16, 2, DataLayout> b_right(100, internal::random<int>(1, 80));
+  b_left.setRandom();
+  b_right.setRandom();
+  b_left = b_left.abs();
+  b_right = b_right.abs();
+  Eigen::array<DimPair, 1> dims2({{DimPair(1, 0)}});
+  Tensor<float, 2, DataLayout> ref =
+      b_left.template cast<float>().contract(b_right.template cast<float>(), dims2);
+  Tensor<bfloat16, 2, DataLayout> b_result(ref.dimensions());
+  b_result.device(device) =
+      b_left.contract(b_right, dims2, SqrtPlusRowOutputKernel());
+  for (int i = 0; i < ref.dimension(0); ++i) {
+    for (int j = 0; j < ref.dimension(1); ++j) {
+      const float expected = std::sqrt(float(bfloat16(ref(i, j)))) + i;
+      VERIFY(numext::abs(float(b_result(i, j)) - expected) <= 2e-2f * expected);
+    }
+  }
+
+  // The product over an empty dimension is zero, and still goes through the
+  // output kernel, synchronously and asynchronously.
+  Tensor<float, 2, DataLayout> empty_left(internal::random<int>(1, 80), 0);
+  Tensor<float, 2, DataLayout> empty_right(0, internal::random<int>(2, 80));
+  Tensor<float, 2, DataLayout> empty_result(empty_left.dimension(0), empty_right.dimension(1));
+  for (int async = 0; async < 2; ++async) {
+    empty_result.setConstant(-1.0f);
+    if (async) {
+      Eigen::Barrier b2(1);
+      empty_result.device(device, [&b2]() { b2.Notify(); }) =
+          empty_left.contract(empty_right, dims2, SqrtPlusRowOutputKernel());
+      b2.Wait();
+    } else {
+      empty_result.device(device) =
+          empty_left.contract(empty_right, dims2, SqrtPlusRowOutputKernel());
+    }
+    for (int i = 0; i < empty_result.dimension(0); ++i) {
+      for (int j = 0; j < empty_result.dimension(1); ++j) {
+        VERIFY_IS_EQUAL(empty_result(i, j), float(i));
+      }
+    }
+  }
+}
 
 template<int DataLayout>
 void test_full_contraction() {
@@ -291,6 +440,253 @@ void test_multithreaded_reductions() {
   VERIFY_IS_APPROX(full_redux(), full_redux_tp());
 }
 
+// Checks a reduction of the given dimension of input against a naive
+// evaluation, when assigned directly to a tensor, when evaluated into a
+// temporary buffer and when evaluated asynchronously.
+template <int DataLayout, typename Reducer>
+static void check_partial_reduction(const Eigen::ThreadPoolDevice& device,
+                                    const Tensor<float, 2, DataLayout>& input,
+                                    int dim, const Reducer& reducer) {
+  array<int, 1> dims;
+  dims[0] = dim;
+  const int size = input.dimension(1 - dim);
+  Tensor<float, 1, DataLayout> expected(size);
+  for (int i = 0; i < size; ++i) {
+    Reducer r(reducer);
+    float accum = r.initialize();
+    for (int j = 0; j < input.dimension(dim); ++j) {
+      r.reduce(dim == 0 ? input(j, i) : input(i, j), &accum);
+    }
+    expected(i) = r.finalize(accum);
+  }
+
+  Tensor<float, 1, DataLayout> result(size);
+  result.device(device) = input.reduce(dims, reducer);
+  for (int i = 0; i < size; ++i) {
+    VERIFY_IS_APPROX(result(i), expected(i));
+  }
+
+  result.device(device) = input.reduce(dims, reducer) * 2.0f;
+  for (int i = 0; i < size; ++i) {
+    VERIFY_IS_APPROX(result(i), 2.0f * expected(i));
+  }
+
+  Eigen::Barrier barrier(1);
+  result.device(device, [&barrier]() { barrier.Notify(); }) = input.reduce(dims, reducer);
+  barrier.Wait();
+  for (int i = 0; i < size; ++i) {
+    VERIFY_IS_APPROX(result(i), expected(i));
+  }
+}
+
+template <int DataLayout>
+void test_multithreaded_partial_reductions() {
+  const int num_threads = internal::random<int>(3, 11);
+  ThreadPool thread_pool(num_threads);
+  Eigen::ThreadPoolDevice thread_pool_device(&thread_pool, num_threads);
+
+  // Many outputs, and a few long rows or columns, for which the reductions
+  // are split between the threads.
+  const int long_dim = internal::random<int>(2000, 5000);
+  const int shapes[3][2] = {
+      {internal::random<int>(13, 732), internal::random<int>(13, 732)},
+      {internal::random<int>(1, 3), long_dim},
+      {long_dim, internal::random<int>(1, 3)}};
+  for (int s = 0; s < 3; ++s) {
+    Tensor<float, 2, DataLayout> input(shapes[s][0], shapes[s][1]);
+    input.setRandom();
+    // Keep the products close to 1 and the sums away from 0.
+    input = input * 0.001f + 1.0f;
+    for (int dim = 0; dim < 2; ++dim) {
+      check_partial_reduction(thread_pool_device, input, dim, internal::SumReducer<float>());
+      check_partial_reduction(thread_pool_device, input, dim, internal::MeanReducer<float>());
+      check_partial_reduction(thread_pool_device, input, dim, internal::MaxReducer<float>());
+      check_partial_reduction(thread_pool_device, input, dim, internal::MinReducer<float>());
+      check_partial_reduction(thread_pool_device, input, dim, internal::ProdReducer<float>());
+    }
+  }
+}
+
+template<int DataLayout>
+void test_multithread_scan() {
+  const int num_threads = internal::random<int>(3, 11);
+  ThreadPool thread_pool(num_threads);
+  Eigen::ThreadPoolDevice thread_pool_device(&thread_pool, num_threads);
+
+  // Many independent lines.
+  Tensor<float, 3, DataLayout> t1(internal::random<int>(13, 63), 37, internal::random<int>(13, 63));
+  t1.setRandom();
+  for (int axis = 0; axis < 3; ++axis) {
+    for (int exclusive = 0; exclusive < 2; ++exclusive) {
+      Tensor<float, 3, DataLayout> st_result = t1.cumsum(axis, exclusive != 0);
+      Tensor<float, 3, DataLayout> tp_result(t1.dimensions());
+      tp_result.device(thread_pool_device) = t1.cumsum(axis, exclusive != 0);
+      for (int i = 0; i < t1.size(); ++i) {
+        VERIFY_IS_EQUAL(st_result.data()[i], tp_result.data()[i]);
+      }
+    }
+  }
+
+  // A few long lines, scanned in blocks. Integers keep the results exact.
+  Tensor<int, 2, DataLayout> t2(internal::random<int>(1, 2), internal::random<int>(100000, 200000));
+  t2 = t2.random().unaryExpr([](int x) { return x % 100; });
+  for (int exclusive = 0; exclusive < 2; ++exclusive) {
+    Tensor<int, 2, DataLayout> st_result = t2.cumsum(1, exclusive != 0);
+    Tensor<int, 2, DataLayout> tp_result(t2.dimensions());
+    tp_result.device(thread_pool_device) = t2.cumsum(1, exclusive != 0);
+    for (int i = 0; i < t2.size(); ++i) {
+      VERIFY_IS_EQUAL(st_result.data()[i], tp_result.data()[i]);
+    }
+  }
+  Tensor<float, 1, DataLayout> t3(internal::random<int>(100000, 200000));
+  t3.setRandom();
+  t3 = t3.abs() + 0.5f;
+  Tensor<float, 1, DataLayout> st_max = t3.scan(0, internal::MaxReducer<float>());
+  Tensor<float, 1, DataLayout> tp_max(t3.dimensions());
+  tp_max.device(thread_pool_device) = t3.scan(0, internal::MaxReducer<float>());
+  for (int i = 0; i < t3.size(); ++i) {
+    VERIFY_IS_EQUAL(st_max(i), tp_max(i));
+  }
+
+  // Empty axes.
+  Tensor<float, 2, DataLayout> t4(0, 37);
+  for (int axis = 0; axis < 2; ++axis) {
+    Tensor<float, 2, DataLayout> tp_result(t4.dimensions());
+    tp_result.device(thread_pool_device) = t4.cumsum(axis);
+    VERIFY_IS_EQUAL(tp_result.size(), 0);
+  }
+}
+
+
+template<int DataLayout>
+void test_multithread_convolution() {
+  const int num_threads = internal::random<int>(3, 11);
+  ThreadPool thread_pool(num_threads);
+  Eigen::ThreadPoolDevice thread_pool_device(&thread_pool, num_threads);
+
+  Tensor<float, 3, DataLayout> input(internal::random<int>(50, 150), 17, internal::random<int>(50, 150));
+  input.setRandom();
+
+  // Unrolled and generic kernel sizes, along every dimension.
+  for (int kernel_size = 3; kernel_size <= 8; ++kernel_size) {
+    Tensor<float, 1, DataLayout> kernel(kernel_size);
+    kernel.setRandom();
+    for (ptrdiff_t dim = 0; dim < 3; ++dim) {
+      Eigen::array<ptrdiff_t, 1> dims;
+      dims[0] = dim;
+      Tensor<float, 3, DataLayout> st_result = input.convolve(kernel, dims);
+      Tensor<float, 3, DataLayout> tp_result(st_result.dimensions());
+      tp_result.device(thread_pool_device) = input.convolve(kernel, dims);
+      for (int i = 0; i < st_result.size(); ++i) {
+        VERIFY_IS_APPROX(st_result.data()[i], tp_result.data()[i]);
+      }
+    }
+  }
+
+  // A 2d kernel used inside a larger expression, which buffers the result.
+  Tensor<float, 2, DataLayout> kernel(3, 3);
+  kernel.setRandom();
+  Eigen::array<ptrdiff_t, 2> dims;
+  dims[0] = 0;
+  dims[1] = 2;
+  Tensor<float, 3, DataLayout> st_result = input.convolve(kernel, dims) * 2.0f;
+  Tensor<float, 3, DataLayout> tp_result(st_result.dimensions());
+  tp_result.device(thread_pool_device) = input.convolve(kernel, dims) * 2.0f;
+  for (int i = 0; i < st_result.size(); ++i) {
+    VERIFY_IS_APPROX(st_result.data()[i], tp_result.data()[i]);
+  }
+
+  // A single long line, split between the threads.
+  Tensor<float, 1, DataLayout> signal(internal::random<int>(100000, 200000));
+  signal.setRandom();
+  Tensor<float, 1, DataLayout> filter(5);
+  filter.setRandom();
+  Eigen::array<ptrdiff_t, 1> dim0;
+  dim0[0] = 0;
+  Tensor<float, 1, DataLayout> st_signal = signal.convolve(filter, dim0);
+  Tensor<float, 1, DataLayout> tp_signal(st_signal.dimensions());
+  tp_signal.device(thread_pool_device) = signal.convolve(filter, dim0);
+  for (int i = 0; i < st_signal.size(); ++i) {
+    VERIFY_IS_APPROX(st_signal(i), tp_signal(i));
+  }
+
+  // Asynchronous evaluation.
+  Eigen::Barrier barrier(1);
+  tp_signal.setZero();
+  tp_signal.device(thread_pool_device, [&barrier]() { barrier.Notify(); }) = signal.convolve(filter, dim0);
+  barrier.Wait();
+  for (int i = 0; i < st_signal.size(); ++i) {
+    VERIFY_IS_APPROX(st_signal(i), tp_signal(i));
+  }
+}
+
+
+template<int DataLayout>
+void test_multithread_argmax() {
+  const int num_threads = internal::random<int>(3, 11);
+  ThreadPool thread_pool(num_threads);
+  Eigen::ThreadPoolDevice thread_pool_device(&thread_pool, num_threads);
+
+  // Many rows, and a few rows long enough to be split between the threads.
+  for (int num_rows : {internal::random<int>(50, 100), 2}) {
+    const int num_cols = num_rows == 2 ? internal::random<int>(100000, 200000) : internal::random<int>(500, 1500);
+    const int inner_dim = (static_cast<int>(DataLayout) == static_cast<int>(ColMajor)) ? 0 : 1;
+    Tensor<float, 2, DataLayout> t(inner_dim == 0 ? num_cols : num_rows,
+                                   inner_dim == 0 ? num_rows : num_cols);
+    t.setRandom();
+    for (int dim = 0; dim < 2; ++dim) {
+      Tensor<DenseIndex, 1, DataLayout> st_argmax = t.argmax(dim);
+      Tensor<DenseIndex, 1, DataLayout> tp_argmax(st_argmax.dimensions());
+      tp_argmax.device(thread_pool_device) = t.argmax(dim);
+      Tensor<DenseIndex, 1, DataLayout> st_argmin = t.argmin(dim);
+      Tensor<DenseIndex, 1, DataLayout> tp_argmin(st_argmin.dimensions());
+      tp_argmin.device(thread_pool_device) = t.argmin(dim);
+      for (int i = 0; i < st_argmax.size(); ++i) {
+        VERIFY_IS_EQUAL(st_argmax(i), tp_argmax(i));
+        VERIFY_IS_EQUAL(st_argmin(i), tp_argmin(i));
+      }
+    }
+
+    Tensor<DenseIndex, 0, DataLayout> st_full = t.argmax();
+    Tensor<DenseIndex, 0, DataLayout> tp_full;
+    tp_full.device(thread_pool_device) = t.argmax();
+    VERIFY_IS_EQUAL(st_full(), tp_full());
+
+    Eigen::Barrier barrier(1);
+    tp_full.device(thread_pool_device, [&barrier]() { barrier.Notify(); }) = t.argmax();
+    barrier.Wait();
+    VERIFY_IS_EQUAL(st_full(), tp_full());
+  }
+}
+
+
+template<int DataLayout>
+void test_multithread_topk() {
+  const int num_threads = internal::random<int>(3, 11);
+  ThreadPool thread_pool(num_threads);
+  Eigen::ThreadPoolDevice thread_pool_device(&thread_pool, num_threads);
+
+  Tensor<float, 3, DataLayout> t(internal::random<int>(20, 40), 11, internal::random<int>(500, 1000));
+  t.setRandom();
+  for (int dim = 0; dim < 3; ++dim) {
+    Tensor<Tuple<DenseIndex, float>, 3, DataLayout> st_result = t.topk(5, dim);
+    Tensor<Tuple<DenseIndex, float>, 3, DataLayout> tp_result(st_result.dimensions());
+    tp_result.device(thread_pool_device) = t.topk(5, dim);
+    for (int i = 0; i < st_result.size(); ++i) {
+      VERIFY_IS_EQUAL(st_result.data()[i].first, tp_result.data()[i].first);
+      VERIFY_IS_EQUAL(st_result.data()[i].second, tp_result.data()[i].second);
+    }
+
+    Eigen::Barrier barrier(1);
+    tp_result.device(thread_pool_device, [&barrier]() { barrier.Notify(); }) = t.topk(5, dim);
+    barrier.Wait();
+    for (int i = 0; i < st_result.size(); ++i) {
+      VERIFY_IS_EQUAL(st_result.data()[i].first, tp_result.data()[i].first);
+      VERIFY_IS_EQUAL(st_result.data()[i].second, tp_result.data()[i].second);
+    }
+  }
+}
+
 
 void test_memcpy() {
 
@@ -344,6 +740,252 @@ void test_multithread_shuffle()
   }
 }
 
+template<int DataLayout>
+void test_async_multithread_elementwise()
+{
+  Tensor<float, 3, DataLayout> in1(200, 30, 70);
+  Tensor<float, 3, DataLayout> in2(200, 30, 70);
+  Tensor<float, 3, DataLayout> out(200, 30, 70);
+
+  in1.setRandom();
+  in2.setRandom();
+
+  Eigen::ThreadPool tp(internal::random<int>(3, 11));
+  Eigen::ThreadPoolDevice thread_pool_device(&tp, internal::random<int>(3, 11));
+
+  Eigen::Barrier b(1);
+  out.device(thread_pool_device, [&b]() { b.Notify(); }) = in1 + in2 * 3.14f;
+  b.Wait();
+
+  for (int i = 0; i < 200; ++i) {
+    for (int j = 0; j < 30; ++j) {
+      for (int k = 0; k < 70; ++k) {
+        VERIFY_IS_APPROX(out(i, j, k), in1(i, j, k) + in2(i, j, k) * 3.14f);
+      }
+    }
+  }
+}
+
+template<int DataLayout>
+void test_async_multithread_shuffle_and_broadcast()
+{
+  Tensor<float, 4, DataLayout> tensor(37, 15, 17, 11);
+  tensor.setRandom();
+
+  const int num_threads = internal::random<int>(2, 11);
+  ThreadPool threads(num_threads);
+  Eigen::ThreadPoolDevice device(&threads, num_threads);
+
+  Tensor<float, 4, DataLayout> shuffle(17, 15, 11, 37);
+  array<ptrdiff_t, 4> shuffles = {{2, 1, 3, 0}};
+  Eigen::Barrier b1(1);
+  shuffle.device(device, [&b1]() { b1.Notify(); }) = tensor.shuffle(shuffles);
+  b1.Wait();
+
+  for (int i = 0; i < 37; ++i) {
+    for (int j = 0; j < 15; ++j) {
+      for (int k = 0; k < 17; ++k) {
+        for (int l = 0; l < 11; ++l) {
+          VERIFY_IS_EQUAL(tensor(i, j, k, l), shuffle(k, j, l, i));
+        }
+      }
+    }
+  }
+
+  Tensor<float, 2, DataLayout> matrix(7, 5);
+  matrix.setRandom();
+  array<ptrdiff_t, 2> broadcasts = {{9, 13}};
+  Tensor<float, 2, DataLayout> broadcast(63, 65);
+  Eigen::Barrier b2(1);
+  broadcast.device(device, [&b2]() { b2.Notify(); }) = (matrix * 2.0f).broadcast(broadcasts);
+  b2.Wait();
+
+  for (int i = 0; i < 63; ++i) {
+    for (int j = 0; j < 65; ++j) {
+      VERIFY_IS_EQUAL(broadcast(i, j), 2.0f * matrix(i % 7, j % 5));
+    }
+  }
+}
+
+template<int DataLayout>
+void test_async_multithread_contraction()
+{
+  Tensor<float, 4, DataLayout> t_left(30, 50, 37, 31);
+  Tensor<float, 5, DataLayout> t_right(37, 31, 70, 2, 10);
+  Tensor<float, 5, DataLayout> t_result(30, 50, 70, 2, 10);
+
+  t_left.setRandom();
+  t_right.setRandom();
+
+  // this contraction should be equivalent to a single matrix multiplication
+  typedef Tensor<float, 1>::DimensionPair DimPair;
+  Eigen::array<DimPair, 2> dims({{DimPair(2, 0), DimPair(3, 1)}});
+
+  typedef Map<Matrix<float, Dynamic, Dynamic, DataLayout>> MapXf;
+  MapXf m_left(t_left.data(), 1500, 1147);
+  MapXf m_right(t_right.data(), 1147, 1400);
+  Matrix<float, Dynamic, Dynamic, DataLayout> m_result(1500, 1400);
+
+  Eigen::ThreadPool tp(4);
+  Eigen::ThreadPoolDevice thread_pool_device(&tp, 4);
+
+  // compute results by separate methods
+  Eigen::Barrier b(1);
+  t_result.device(thread_pool_device, [&b]() { b.Notify(); }) = t_left.contract(t_right, dims);
+  m_result = m_left * m_right;
+  b.Wait();
+
+  for (ptrdiff_t i = 0; i < t_result.size(); i++) {
+    VERIFY(&t_result.data()[i] != &m_result.data()[i]);
+    if (fabsf(t_result(i) - m_result(i)) < 1e-4f) {
+      continue;
+    }
+    if (Eigen::internal::isApprox(t_result(i), m_result(i), 1e-4f)) {
+      continue;
+    }
+    std::cout << "mismatch detected at index " << i << ": " << t_result(i)
+              << " vs " <<  m_result(i) << std::endl;
+    assert(false);
+  }
+}
+
+template<int DataLayout>
+void test_async_multithreaded_reductions_and_forced_eval()
+{
+  const int num_threads = internal::random<int>(3, 11);
+  ThreadPool thread_pool(num_threads);
+  Eigen::ThreadPoolDevice thread_pool_device(&thread_pool, num_threads);
+
+  const int num_rows = internal::random<int>(13, 732);
+  const int num_cols = internal::random<int>(13, 732);
+  Tensor<float, 2, DataLayout> t1(num_rows, num_cols);
+  t1.setRandom();
+
+  Tensor<float, 0, DataLayout> full_redux;
+  full_redux = t1.sum();
+
+  Tensor<float, 0, DataLayout> full_redux_tp;
+  Eigen::Barrier b1(1);
+  full_redux_tp.device(thread_pool_device, [&b1]() { b1.Notify(); }) = t1.sum();
+  b1.Wait();
+
+  // Check that the single threaded and the asynchronous reductions return
+  // the same result.
+  VERIFY_IS_APPROX(full_redux(), full_redux_tp());
+
+  // The forced evaluation of the sub expression is itself asynchronous.
+  Tensor<float, 2, DataLayout> result(num_rows, num_cols);
+  Eigen::Barrier b2(1);
+  result.device(thread_pool_device, [&b2]() { b2.Notify(); }) = (t1 * 2.0f).eval() + t1;
+  b2.Wait();
+  for (int i = 0; i < num_rows; ++i) {
+    for (int j = 0; j < num_cols; ++j) {
+      VERIFY_IS_APPROX(result(i, j), 3.0f * t1(i, j));
+    }
+  }
+}
+
+
+// Counts the buffers that go through the allocator.
+class CountingAllocator : public Eigen::Allocator {
+ public:
+  CountingAllocator() : num_allocations_(0), num_deallocations_(0) {}
+  void* allocate(size_t num_bytes) const {
+    ++num_allocations_;
+    return internal::aligned_malloc(num_bytes);
+  }
+  void deallocate(void* buffer) const {
+    ++num_deallocations_;
+    internal::aligned_free(buffer);
+  }
+  int num_allocations() const { return num_allocations_; }
+  int num_deallocations() const { return num_deallocations_; }
+
+ private:
+  mutable std::atomic<int> num_allocations_;
+  mutable std::atomic<int> num_deallocations_;
+};
+
+void test_device_allocator()
+{
+  Tensor<float, 2> t1(40, 30);
+  t1.setRandom();
+  Tensor<float, 2> expected = (t1 * 2.0f).eval() + t1;
+
+  CountingAllocator allocator;
+  Eigen::DefaultDevice default_device(&allocator);
+  VERIFY(default_device.allocator() == &allocator);
+  Tensor<float, 2> result(40, 30);
+  result.device(default_device) = (t1 * 2.0f).eval() + t1;
+  VERIFY_IS_EQUAL(allocator.num_allocations(), 1);
+  VERIFY_IS_EQUAL(allocator.num_deallocations(), 1);
+  for (int i = 0; i < result.size(); ++i) {
+    VERIFY_IS_EQUAL(result(i), expected(i));
+  }
+
+  Eigen::ThreadPool tp(3);
+  Eigen::ThreadPoolDevice thread_pool_device(&tp, 3, &allocator);
+  VERIFY(thread_pool_device.allocator() == &allocator);
+  result.setZero();
+  result.device(thread_pool_device) = (t1 * 2.0f).eval() + t1;
+  VERIFY_IS_EQUAL(allocator.num_allocations(), 2);
+  VERIFY_IS_EQUAL(allocator.num_deallocations(), 2);
+  for (int i = 0; i < result.size(); ++i) {
+    VERIFY_IS_EQUAL(result(i), expected(i));
+  }
+}
+
+template<int DataLayout>
+void test_multithread_pool_allocator()
+{
+  const int num_threads = internal::random<int>(2, 8);
+  Eigen::ThreadPool tp(num_threads);
+  Eigen::PoolAllocator allocator;
+  Eigen::ThreadPoolDevice thread_pool_device(&tp, num_threads, &allocator);
+
+  Tensor<float, 2, DataLayout> t_left(120, 230);
+  Tensor<float, 2, DataLayout> t_right(230, 170);
+  t_left.setRandom();
+  t_right.setRandom();
+  typedef Tensor<float, 1>::DimensionPair DimPair;
+  Eigen::array<DimPair, 1> dims({{DimPair(1, 0)}});
+
+  Tensor<float, 2, DataLayout> expected(120, 170);
+  expected = t_left.contract(t_right, dims) + t_left.sum(Eigen::array<int, 1>({{1}})).eval()
+      .reshape(Eigen::array<int, 2>({{120, 1}})).broadcast(Eigen::array<int, 2>({{1, 170}}));
+
+  Tensor<float, 2, DataLayout> result(120, 170);
+  const int num_iterations = 5;
+  for (int iter = 0; iter < num_iterations; ++iter) {
+    result.setZero();
+    result.device(thread_pool_device) = t_left.contract(t_right, dims) + t_left.sum(Eigen::array<int, 1>({{1}})).eval()
+        .reshape(Eigen::array<int, 2>({{120, 1}})).broadcast(Eigen::array<int, 2>({{1, 170}}));
+    for (int i = 0; i < result.size(); ++i) {
+      VERIFY_IS_APPROX(result(i), expected(i));
+    }
+  }
+
+  // Every buffer was returned, and the later evaluations reused the blocks
+  // cached by the first one.
+  Eigen::PoolAllocator::Stats stats = allocator.stats();
+  VERIFY(stats.num_allocations >= 2 * num_iterations);
+  VERIFY_IS_EQUAL(stats.num_allocations, stats.num_deallocations);
+  VERIFY_IS_EQUAL(stats.bytes_in_use, size_t(0));
+  VERIFY(stats.peak_bytes_in_use > 0);
+  VERIFY(stats.num_cache_hits > 0);
+  VERIFY_IS_EQUAL(stats.num_cache_hits + stats.num_system_allocations, stats.num_allocations);
+  VERIFY(stats.bytes_cached > 0);
+
+  // Oversized requests bypass the caches.
+  void* large = allocator.allocate(Eigen::PoolAllocator::kMaxPooledBytes + 1);
+  VERIFY(large != NULL);
+  VERIFY_IS_EQUAL(allocator.stats().bytes_in_use, Eigen::PoolAllocator::kMaxPooledBytes + 1);
+  allocator.deallocate(large);
+  VERIFY_IS_EQUAL(allocator.stats().bytes_cached, stats.bytes_cached);
+
+  allocator.release();
+  VERIFY_IS_EQUAL(allocator.stats().bytes_cached, size_t(0));
+}
 
 void test_cxx11_tensor_thread_pool()
 {
@@ -355,6 +997,10 @@ void test_cxx11_tensor_thread_pool()
 
   CALL_SUBTEST_3(test_multithread_contraction_agrees_with_singlethread<ColMajor>());
   CALL_SUBTEST_3(test_multithread_contraction_agrees_with_singlethread<RowMajor>());
+  CALL_SUBTEST_3(test_multithread_contraction_bfloat16<ColMajor>());
+  CALL_SUBTEST_3(test_multithread_contraction_bfloat16<RowMajor>());
+  CALL_SUBTEST_3(test_multithread_contraction_with_output_kernel<ColMajor>());
+  CALL_SUBTEST_3(test_multithread_contraction_with_output_kernel<RowMajor>());
 
   // Exercise various cases that have been problematic in the past.
   CALL_SUBTEST_4(test_contraction_corner_cases<ColMajor>());
@@ -365,9 +1011,31 @@ void test_cxx11_tensor_thread_pool()
 
   CALL_SUBTEST_5(test_multithreaded_reductions<ColMajor>());
   CALL_SUBTEST_5(test_multithreaded_reductions<RowMajor>());
+  CALL_SUBTEST_5(test_multithreaded_partial_reductions<ColMajor>());
+  CALL_SUBTEST_5(test_multithreaded_partial_reductions<RowMajor>());
+  CALL_SUBTEST_5(test_multithread_scan<ColMajor>());
+  CALL_SUBTEST_5(test_multithread_scan<RowMajor>());
+  CALL_SUBTEST_5(test_multithread_convolution<ColMajor>());
+  CALL_SUBTEST_5(test_multithread_convolution<RowMajor>());
+  CALL_SUBTEST_5(test_multithread_argmax<ColMajor>());
+  CALL_SUBTEST_5(test_multithread_argmax<RowMajor>());
+  CALL_SUBTEST_5(test_multithread_topk<ColMajor>());
+  CALL_SUBTEST_5(test_multithread_topk<RowMajor>());
 
   CALL_SUBTEST_6(test_memcpy());
   CALL_SUBTEST_6(test_multithread_random());
   CALL_SUBTEST_6(test_multithread_shuffle<ColMajor>());
   CALL_SUBTEST_6(test_multithread_shuffle<RowMajor>());
+  CALL_SUBTEST_6(test_device_allocator());
+  CALL_SUBTEST_6(test_multithread_pool_allocator<ColMajor>());
+  CALL_SUBTEST_6(test_multithread_pool_allocator<RowMajor>());
+
+  CALL_SUBTEST_7(test_async_multithread_elementwise<ColMajor>());
+  CALL_SUBTEST_7(test_async_multithread_elementwise<RowMajor>());
+  CALL_SUBTEST_7(test_async_multithread_shuffle_and_broadcast<ColMajor>());
+  CALL_SUBTEST_7(test_async_multithread_shuffle_and_broadcast<RowMajor>());
+  CALL_SUBTEST_7(test_async_multithread_contraction<ColMajor>());
+  CALL_SUBTEST_7(test_async_multithread_contraction<RowMajor>());
+  CALL_SUBTEST_7(test_async_multithreaded_reductions_and_forced_eval<ColMajor>());
+  CALL_SUBTEST_7(test_async_multithreaded_reductions_and_forced_eval<RowMajor>());
 }
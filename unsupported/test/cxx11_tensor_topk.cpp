@@ -0,0 +1,120 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+
+#include <Eigen/CXX11/Tensor>
+
+using Eigen::Tensor;
+using Eigen::Tuple;
+
+template <int DataLayout>
+static void test_simple_topk()
+{
+  Tensor<float, 1, DataLayout> tensor(6);
+  tensor.setValues({3.0f, 1.0f, 4.0f, 1.0f, 5.0f, 4.0f});
+
+  Tensor<Tuple<DenseIndex, float>, 1, DataLayout> top = tensor.topk(4, 0);
+  VERIFY_IS_EQUAL(top.dimension(0), 4);
+  // Ties are ordered by increasing index.
+  VERIFY_IS_EQUAL(top(0).first, 4);
+  VERIFY_IS_EQUAL(top(0).second, 5.0f);
+  VERIFY_IS_EQUAL(top(1).first, 2);
+  VERIFY_IS_EQUAL(top(1).second, 4.0f);
+  VERIFY_IS_EQUAL(top(2).first, 5);
+  VERIFY_IS_EQUAL(top(2).second, 4.0f);
+  VERIFY_IS_EQUAL(top(3).first, 0);
+  VERIFY_IS_EQUAL(top(3).second, 3.0f);
+
+  Tensor<Tuple<DenseIndex, float>, 1, DataLayout> all = tensor.topk(6, 0);
+  VERIFY_IS_EQUAL(all(4).first, 1);
+  VERIFY_IS_EQUAL(all(5).first, 3);
+}
+
+template <int DataLayout, typename Scalar>
+static void check_topk(const Tensor<Scalar, 3, DataLayout>& tensor, int k, int dim)
+{
+  Tensor<Tuple<DenseIndex, Scalar>, 3, DataLayout> top = tensor.topk(k, dim);
+  for (int d = 0; d < 3; ++d) {
+    VERIFY_IS_EQUAL(top.dimension(d), d == dim ? k : tensor.dimension(d));
+  }
+
+  array<DenseIndex, 3> ix;
+  array<DenseIndex, 3> out;
+  for (ix[0] = 0; ix[0] < top.dimension(0); ++ix[0]) {
+    for (ix[1] = 0; ix[1] < top.dimension(1); ++ix[1]) {
+      for (ix[2] = 0; ix[2] < top.dimension(2); ++ix[2]) {
+        if (ix[dim] != 0) continue;
+        // Reference: stable sort of the line by decreasing value.
+        std::vector<std::pair<Scalar, DenseIndex> > line;
+        array<DenseIndex, 3> in = ix;
+        for (in[dim] = 0; in[dim] < tensor.dimension(dim); ++in[dim]) {
+          line.push_back(std::make_pair(tensor(in), in[dim]));
+        }
+        std::stable_sort(line.begin(), line.end(),
+                         [](const std::pair<Scalar, DenseIndex>& a, const std::pair<Scalar, DenseIndex>& b) {
+                           return a.first > b.first;
+                         });
+        out = ix;
+        for (out[dim] = 0; out[dim] < k; ++out[dim]) {
+          VERIFY_IS_EQUAL(top(out).first, line[out[dim]].second);
+          VERIFY_IS_EQUAL(top(out).second, line[out[dim]].first);
+        }
+      }
+    }
+  }
+}
+
+template <int DataLayout>
+static void test_topk_dims()
+{
+  Tensor<float, 3, DataLayout> tensor(internal::random<int>(20, 40), 7, internal::random<int>(100, 300));
+  tensor.setRandom();
+  Tensor<int, 3, DataLayout> integers(tensor.dimensions());
+  integers = integers.random().unaryExpr([](int x) { return x % 10; });
+
+  for (int dim = 0; dim < 3; ++dim) {
+    for (int k : {1, 3, 7}) {
+      check_topk(tensor, k, dim);
+      // Many ties.
+      check_topk(integers, k, dim);
+    }
+  }
+}
+
+template <int DataLayout>
+static void test_topk_in_expression()
+{
+  Tensor<float, 2, DataLayout> logits(13, 1000);
+  logits.setRandom();
+
+  // Extract the values and the indices of the result.
+  Tensor<float, 2, DataLayout> values = logits.topk(5, 1).unaryExpr(
+      [](const Tuple<DenseIndex, float>& t) { return t.second; });
+  Tensor<DenseIndex, 2, DataLayout> indices = logits.topk(5, 1).unaryExpr(
+      [](const Tuple<DenseIndex, float>& t) { return t.first; });
+  Tensor<DenseIndex, 1, DataLayout> argmax = logits.argmax(1);
+  for (int i = 0; i < 13; ++i) {
+    VERIFY_IS_EQUAL(indices(i, 0), argmax(i));
+    for (int j = 0; j < 5; ++j) {
+      VERIFY_IS_EQUAL(values(i, j), logits(i, indices(i, j)));
+      if (j > 0) {
+        VERIFY_LE(values(i, j), values(i, j - 1));
+      }
+    }
+  }
+}
+
+void test_cxx11_tensor_topk()
+{
+  CALL_SUBTEST(test_simple_topk<ColMajor>());
+  CALL_SUBTEST(test_simple_topk<RowMajor>());
+  CALL_SUBTEST(test_topk_dims<ColMajor>());
+  CALL_SUBTEST(test_topk_dims<RowMajor>());
+  CALL_SUBTEST(test_topk_in_expression<ColMajor>());
+  CALL_SUBTEST(test_topk_in_expression<RowMajor>());
+}
@@ -0,0 +1,3 @@
+#define EIGEN_KISSFFT_DEFAULT
+#define test_FFTW test_kissfft
+#include "FFTW.cpp"